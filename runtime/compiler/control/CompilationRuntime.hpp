@@ -250,6 +250,54 @@ class TR_JitSampleInfo
       uint32_t _increaseFactor;
    }; // class TR_JitSampleInfo
 
+// Predicts the compilation time and the scratch memory of compilation requests
+// and decides whether requests that exceed the per-thread budget should be
+// deferred or downgraded. The prediction is the bytecode size of the method
+// times the average cost per bytecode at the requested opt level, which is
+// learned from completed compilations, corrected by how far off the prediction
+// was for the last compilation of the same method.
+// An object of this type is embedded into TR::CompilationInfo which is zeroed
+// out at construction time; a zero average means no compilation at that opt
+// level has been measured yet and a default is used.
+class TR_CompilationAdmissionControl
+   {
+   public:
+      struct CostEstimate
+         {
+         uint32_t _timeMs;
+         uint32_t _scratchKB;
+         };
+
+      // Maximum number of times a request can be passed over in favor of cheaper requests
+      static const uint8_t MAX_DEFERRALS = 3;
+
+      CostEstimate estimateCost(TR_MethodToBeCompiled *entry) const;
+      bool exceedsTimeBudget(const CostEstimate &estimate) const { return estimate._timeMs > (uint32_t)TR::Options::_compAdmissionTimeBudgetMs; }
+      bool exceedsMemoryBudget(const CostEstimate &estimate, uint64_t freePhysicalMemoryB) const;
+
+      // Lowers the opt level of entry while the estimated cost is way over the budget.
+      // Recompilations are kept above the opt level of the body they replace.
+      // Must be called with the compilation queue monitor in hand.
+      void admit(TR_MethodToBeCompiled *entry, uint64_t freePhysicalMemoryB);
+      // Learns from a completed compilation. Races between compilation threads can
+      // lose updates, which is acceptable for a heuristic.
+      void recordCompilation(TR_MethodToBeCompiled *entry, TR_PersistentMethodInfo *methodInfo, TR_Hotness optLevel,
+                             uint64_t timeUs, uint64_t scratchBytes);
+      // Returns a request within the time budget from the front of the queue if the first request
+      // exceeds the budget and has not been deferred too often yet. Needs the compilation queue monitor.
+      TR_MethodToBeCompiled *findRequestToRunAhead(TR_MethodToBeCompiled *queue, TR_MethodToBeCompiled **prev);
+      void printStats() const;
+
+   private:
+      uint32_t getNsPerBytecode(TR_Hotness optLevel) const;
+      uint32_t getScratchBytesPerBytecode(TR_Hotness optLevel) const;
+
+      uint32_t _nsPerBytecode[scorching + 1];
+      uint32_t _scratchBytesPerBytecode[scorching + 1];
+      uint32_t _numDeferrals;
+      uint32_t _numDowngrades;
+   }; // class TR_CompilationAdmissionControl
+
 // The following class is used for tracking methods that have their invocation
 // count decremented due to a sample in interpreted code. When that happens
 // we add the method to a list. When a method needs to be compiled we check
@@ -714,6 +762,11 @@ public:
    TR_MethodToBeCompiled *addOutOfProcessMethodToBeCompiled(JITServer::ServerStream *stream);
 #endif /* defined(J9VM_OPT_JITSERVER) */
    void                   queueEntry(TR_MethodToBeCompiled *entry);
+   void                   dequeueEntry(TR_MethodToBeCompiled *prev, TR_MethodToBeCompiled *entry);
+   void                   ageQueuedEntries();
+   void                   recordQueueTime(TR_MethodToBeCompiled *entry);
+   static int32_t         queuePriorityLevel(uint16_t priority);
+   static const int32_t   NUM_QUEUE_PRIORITY_LEVELS = 11;
    void                   recycleCompilationEntry(TR_MethodToBeCompiled *cur);
 #if defined(J9VM_OPT_JITSERVER)
    void                   requeueOutOfProcessEntry(TR_MethodToBeCompiled *entry);
@@ -731,6 +784,14 @@ public:
    void setOverallCompCpuUtilization(int32_t c) { _overallCompCpuUtilization = c; }
    TR_YesNoMaybe exceedsCompCpuEntitlement() const { return _exceedsCompCpuEntitlement; }
    void setExceedsCompCpuEntitlement(TR_YesNoMaybe value) { _exceedsCompCpuEntitlement = value; }
+   // Maximum number of active compilation threads as decided by the cgroup CPU quota controller; 0 if there is no limit
+   int32_t getCgroupCompThreadLimit() const { return _cgroupCompThreadLimit; }
+   void setCgroupCompThreadLimit(int32_t limit) { _cgroupCompThreadLimit = limit; }
+   bool exceedsCgroupCompThreadLimit() const { return _cgroupCompThreadLimit > 0 && getNumCompThreadsActive() > _cgroupCompThreadLimit; }
+   bool isCgroupCpuThrottled() const { return _cgroupCpuThrottled; }
+   void setCgroupCpuThrottled(bool b) { _cgroupCpuThrottled = b; }
+   TR_CgroupCpuQuota &getCgroupCpuQuota() { return _cgroupCpuQuota; }
+   TR_CompilationAdmissionControl &getCompAdmissionControl() { return _compAdmissionControl; }
    int32_t computeCompThreadSleepTime(int32_t compilationTimeMs);
    bool                   isQueuedForCompilation(J9Method *, void *oldStartPC);
    void *                 startPCIfAlreadyCompiled(J9VMThread *, TR::IlGeneratorMethodDetails & details, void *oldStartPC);
@@ -825,6 +886,7 @@ public:
    void incrementMethodQueueSize();
    int32_t getPeakMethodQueueSize() const { return _maxQueueSize; }
    int32_t getNumQueuedFirstTimeCompilations() const { return _numQueuedFirstTimeCompilations; }
+   int32_t getNumQueuedAotLoads() const { return _numQueuedAotLoads; }
    void decNumGCRReqestsQueued(TR_MethodToBeCompiled *entry);
    void incNumGCRRequestsQueued(TR_MethodToBeCompiled *entry);
    int32_t getNumGCRRequestsQueued() const { return _numGCRQueued; }
@@ -1220,6 +1282,18 @@ private:
    TR::CompilationInfoPerThread **_arrayOfCompilationInfoPerThread; // First NULL entry means end of the array
    TR::CompilationInfoPerThread *_compInfoForDiagnosticCompilationThread; // compinfo for dump compilation thread
    TR_MethodToBeCompiled *_methodQueue;
+   // Bookkeeping for each priority level of the compilation queue (see queueEntry)
+   struct CompQueuePriorityLevel
+      {
+      TR_MethodToBeCompiled *_lastEntry; // NULL if the level is empty or its last entry is not known
+      int32_t                _numEntries;
+      uint32_t               _numDequeued;
+      uint64_t               _totalQueueTimeMs;
+      uint32_t               _maxQueueTimeMs;
+      };
+   CompQueuePriorityLevel _queuePriorityLevels[NUM_QUEUE_PRIORITY_LEVELS];
+   int32_t                _numQueuedEntriesWithOtherPriority;
+   uint64_t               _lastQueueAgingTime;
    TR_MethodToBeCompiled *_methodPool;
    int32_t                _methodPoolSize; // shouldn't this and _methodPool be static?
 
@@ -1253,6 +1327,7 @@ private:
    int32_t                _numQueuedMethods;
    int32_t                _maxQueueSize;
    int32_t                _numQueuedFirstTimeCompilations; // these have oldStartPC==0
+   int32_t                _numQueuedAotLoads; // first time compilations expected to be AOT loads
    int32_t                _queueWeight; // approximation on overhead to process the entire queue
    CpuUtilization*        _cpuUtil; // object to compute cpu utilization
    int32_t                _overallCompCpuUtilization; // In percentage points. Valid only if TR::Options::_compThreadCPUEntitlement has a positive value
@@ -1263,6 +1338,8 @@ private:
    bool                   _rampDownMCT; // flag that from now on we should not activate more than one compilation thread
                                         // Once set, the flag is never reset
    TR_YesNoMaybe          _exceedsCompCpuEntitlement;
+   int32_t                _cgroupCompThreadLimit; // written by the sampler thread only
+   bool                   _cgroupCpuThrottled; // the cgroup of the JVM was throttled during the last sampling interval
    J9VMThread            *_samplerThread; // The Os thread for this VM attached thread is stored at jitConfig->samplerThread
    TR_SamplerStates       _samplerState; // access is guarded by J9JavaVM->vmThreadListMutex
    TR_SamplerStates       _prevSamplerState; // previous state of the sampler thread
@@ -1289,6 +1366,7 @@ private:
    uint32_t               _statNumDowngradeInterpretedMethod;
    uint32_t               _statNumUpgradeJittedMethod;
    uint32_t               _statNumQueuePromotions;
+   uint32_t               _statNumAgedQueueEntries;
    uint32_t               _statNumGCRInducedCompilations;
    uint32_t               _statNumSamplingJProfilingBodies;
    uint32_t               _statNumJProfilingBodies;
@@ -1348,7 +1426,9 @@ private:
    TR_JProfilingQueue      _JProfilingQueue;
 
    TR_CpuEntitlement _cpuEntitlement;
+   TR_CgroupCpuQuota _cgroupCpuQuota;
    TR_JitSampleInfo  _jitSampleInfo;
+   TR_CompilationAdmissionControl _compAdmissionControl;
    TR_SharedCacheRelocationRuntime _sharedCacheReloRuntime;
    uintptr_t _vmStateOfCrashedThread; // Set by Jit Dump; used by diagnostic thread
 #if defined(J9VM_OPT_SHARED_CLASSES)
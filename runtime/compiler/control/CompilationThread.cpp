@@ -29,6 +29,10 @@
 #define J9OS_STRNCMP strncmp
 #endif
 
+#if defined(LINUX)
+#include <sys/mman.h> // for madvise
+#endif
+
 #include "control/CompilationThread.hpp"
 
 #include <exception>
@@ -60,6 +64,7 @@
 #include "env/jittypes.h"
 #include "env/ClassTableCriticalSection.hpp"
 #include "env/DependencyTable.hpp"
+#include "env/PersistedCompilationPlan.hpp"
 #include "env/PersistentCHTable.hpp"
 #include "env/VMAccessCriticalSection.hpp"
 #include "env/VerboseLog.hpp"
@@ -103,6 +108,7 @@
 #include "control/JITServerHelpers.hpp"
 #include "runtime/JITClientSession.hpp"
 #include "runtime/JITServerAOTDeserializer.hpp"
+#include "runtime/Listener.hpp"
 #include "runtime/OMRRSSReport.hpp"
 #include "net/ClientStream.hpp"
 #include "net/ServerStream.hpp"
@@ -138,6 +144,25 @@ extern "C" {
    }
 static void printCompFailureInfo(TR::Compilation * comp, const char * reason);
 
+// Priority levels used for compilation requests, from the highest to the lowest
+static const uint16_t compQueuePriorityLevels[] =
+   {
+   CP_MAX,
+   CP_SYNC_BELOW_MAX,
+   CP_SYNC_NORMAL,
+   CP_SYNC_MIN,
+   CP_ASYNC_MAX,
+   CP_ASYNC_BELOW_MAX,
+   CP_ASYNC_ABOVE_NORMAL,
+   CP_ASYNC_NORMAL,
+   CP_ASYNC_BELOW_NORMAL,
+   CP_ASYNC_ABOVE_MIN,
+   CP_MIN
+   };
+
+static_assert(sizeof(compQueuePriorityLevels) / sizeof(compQueuePriorityLevels[0]) == TR::CompilationInfo::NUM_QUEUE_PRIORITY_LEVELS,
+              "Number of compilation queue priority levels is wrong");
+
 #include "env/ut_j9jit.h"
 
 #if defined(TR_HOST_S390)
@@ -541,12 +566,24 @@ TR_YesNoMaybe TR::CompilationInfo::shouldActivateNewCompThread()
       if ((getNumCompThreadsActive() + 1) * 100 >= (TR::Options::_compThreadCPUEntitlement + 50))
          return TR_no;
       }
+   // Do not activate beyond the limit derived from the cgroup CPU quota
+   if (getCgroupCompThreadLimit() > 0 && getNumCompThreadsActive() >= getCgroupCompThreadLimit())
+      return TR_no;
    // Do not activate if we are low on physical memory
    bool incompleteInfo;
    uint64_t freePhysicalMemorySizeB = computeAndCacheFreePhysicalMemory(incompleteInfo);
    if (freePhysicalMemorySizeB != OMRPORT_MEMINFO_NOT_AVAILABLE &&
        freePhysicalMemorySizeB <= (uint64_t)TR::Options::getSafeReservePhysicalMemoryValue() + TR::Options::getScratchSpaceLowerBound())
       return TR_no;
+   // A burst of AOT loads (typical at startup with a warm shared class cache) has a very
+   // small queue weight because each load is cheap, so the weight based schedule below
+   // would leave all of them to a single thread. Relocations are independent of each other,
+   // so spread them over more threads when each active thread has a large backlog of loads.
+   if (TR::Options::_aotLoadBurstThreshold > 0 &&
+       getNumCompThreadsActive() < getNumTargetCPUs() - 1 &&
+       _numQueuedAotLoads > TR::Options::_aotLoadBurstThreshold * getNumCompThreadsActive())
+      return TR_yes;
+
    // Do not activate a new thread during graceperiod if AOT is used and first run because
    // we may have too many warm compilations at warm. However, there is no such risk for quickstart
    // Another exception: activate if second run in AOT mode
@@ -727,6 +764,8 @@ bool TR::CompilationInfo::shouldDowngradeCompReq(TR_MethodToBeCompiled *entry)
             {
             // Downgrade during CLP when queue grows too large
             if ((persistentInfo->isClassLoadingPhase() && getNumQueuedFirstTimeCompilations() > TR::Options::_qsziThresholdToDowngradeDuringCLP) ||
+                 // Downgrade while the cgroup of the JVM is throttled, so that compilations eat less of the CPU quota
+                isCgroupCpuThrottled() ||
                  // Downgrade if compilation queue is too large
                 (TR::Options::getCmdLineOptions()->getOption(TR_EnableDowngradeOnHugeQSZ) &&
                  getMethodQueueSize() >= TR::Options::_qszThresholdToDowngradeOptLevel) ||
@@ -1072,6 +1111,7 @@ TR::CompilationInfoPerThreadBase::CompilationInfoPerThreadBase(TR::CompilationIn
    _uninterruptableOperationDepth(0),
    _compilationThreadState(COMPTHREAD_UNINITIALIZED),
    _compilationShouldBeInterrupted(false),
+   _aotLoadToPrefetch(NULL),
 #if defined(J9VM_OPT_JITSERVER)
    _cachedClientDataPtr(NULL),
    _clientStream(NULL),
@@ -1992,6 +2032,7 @@ TR::CompilationInfo::updateCompQueueAccountingOnDequeue(TR_MethodToBeCompiled *e
       _numQueuedFirstTimeCompilations--;
       TR_ASSERT(_numQueuedFirstTimeCompilations >= 0, "_numQueuedFirstTimeCompilations is negative : %d", _numQueuedFirstTimeCompilations);
       }
+   recordQueueTime(entry);
    // Note: queue weight is handled separately because a method that is currently being
    // compiled is considered as bringing some weight to the processing backlog
    }
@@ -2084,10 +2125,7 @@ void TR::CompilationInfo::invalidateRequestsForNativeMethods(J9Class * clazz, J9
             }
 
          // detach from queue
-         if (prev)
-            prev->_next = cur->_next;
-         else
-            _methodQueue = cur->_next;
+         dequeueEntry(prev, cur);
          updateCompQueueAccountingOnDequeue(cur);
          // decrease the queue weight
          decreaseQueueWeightBy(cur->_weight);
@@ -2195,10 +2233,7 @@ void TR::CompilationInfo::invalidateRequestsForUnloadedMethods(TR_OpaqueClassBlo
                   }
                }
             // detach from queue
-            if (prev)
-               prev->_next = cur->_next;
-            else
-               _methodQueue = cur->_next;
+            dequeueEntry(prev, cur);
             updateCompQueueAccountingOnDequeue(cur);
             // decrease the queue weight
             decreaseQueueWeightBy(cur->_weight);
@@ -2558,7 +2593,7 @@ void TR::CompilationInfo::purgeMethodQueue(TR_CompilationErrorCode errorCode)
    while (_methodQueue)
       {
       TR_MethodToBeCompiled * cur = _methodQueue;
-      _methodQueue = cur->_next;
+      dequeueEntry(NULL, cur);
       updateCompQueueAccountingOnDequeue(cur);
       // decrease the queue weight
       decreaseQueueWeightBy(cur->_weight);
@@ -3607,6 +3642,21 @@ void TR::CompilationInfo::stopCompilationThreads()
       fprintf(stderr, "NumQueuePromotions=%u\n", _statNumQueuePromotions);
       }
 
+   if (printCompStats)
+      {
+      fprintf(stderr, "Compilation queue latency by priority:\n");
+      for (int32_t i = 0; i < NUM_QUEUE_PRIORITY_LEVELS; i++)
+         {
+         const CompQueuePriorityLevel &priorityLevel = _queuePriorityLevels[i];
+         if (priorityLevel._numDequeued > 0)
+            fprintf(stderr, "\tPriority=0x%04x Dequeued=%u AvgQueueTime=%" OMR_PRIu64 " ms MaxQueueTime=%u ms\n",
+                    compQueuePriorityLevels[i], priorityLevel._numDequeued,
+                    priorityLevel._totalQueueTimeMs / priorityLevel._numDequeued, priorityLevel._maxQueueTimeMs);
+         }
+      fprintf(stderr, "NumAgedQueueEntries=%u\n", _statNumAgedQueueEntries);
+      TR::Compiler->persistentAllocator().printAllocationStats();
+      }
+
 #if defined(J9VM_OPT_JITSERVER)
    static char *printJITServerIPMsgStats = feGetEnv("TR_PrintJITServerIPMsgStats");
    if (printJITServerIPMsgStats)
@@ -3631,6 +3681,8 @@ void TR::CompilationInfo::stopCompilationThreads()
          {
          fprintf(stderr, "Number of connections opened = %u\n", JITServer::ClientStream::getNumConnectionsOpened());
          fprintf(stderr, "Number of connections closed = %u\n", JITServer::ClientStream::getNumConnectionsClosed());
+         fprintf(stderr, "Number of connections reused = %u\n", JITServer::ClientStream::getNumConnectionsReused());
+         fprintf(stderr, "Number of SSL sessions resumed = %u\n", JITServer::ClientStream::getNumSSLSessionsResumed());
          }
       }
 
@@ -3649,6 +3701,9 @@ void TR::CompilationInfo::stopCompilationThreads()
       if (auto dependencyTable = getPersistentInfo()->getAOTDependencyTable())
          dependencyTable->printStats();
       }
+   static char *printCompAdmissionStats = feGetEnv("TR_PrintCompAdmissionStats");
+   if (printCompAdmissionStats)
+      getCompAdmissionControl().printStats();
 
 #ifdef STATS
    if (compBudgetSupport() || dynamicThreadPriority())
@@ -3775,6 +3830,7 @@ void TR::CompilationInfo::stopCompilationThreads()
 #if defined(J9VM_OPT_JITSERVER)
    if (getPersistentInfo()->getRemoteCompilationMode() == JITServer::CLIENT)
       {
+      JITServer::ClientStream::closePooledStreams();
       try
          {
          JITServer::ClientStream client(getPersistentInfo());
@@ -4408,7 +4464,13 @@ TR::CompilationInfoPerThread::processEntries()
    if (compInfo->getPersistentInfo()->getRemoteCompilationMode() == JITServer::CLIENT && !enableJITServerPerCompConn)
       {
       JITServer::ClientStream *client = getClientStream();
-      if (client)
+      // Keep the connection around for other compilation threads instead of closing it
+      if (client && JITServerHelpers::isServerAvailable() &&
+          JITServer::ClientStream::releaseToPool(client, compInfo->getPersistentInfo()))
+         {
+         setClientStream(NULL);
+         }
+      else if (client)
          {
          // Inform the server that client is closing the connection with a connectionTerminate message
          if (JITServerHelpers::isServerAvailable())
@@ -5017,10 +5079,17 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
       if (pc)
          cur->_oldStartPC = pc;
 
-      // If the priority has increased, use the new priority
+      // If the priority has increased, use the new priority.
+      // The request must be taken out of the queue first because the
+      // queue keeps track of the requests queued at each priority level
       //
+      bool mustReposition = false;
       if (cur->_priority < priority)
+         {
+         dequeueEntry(prev, cur);
          cur->_priority = priority;
+         mustReposition = true;
+         }
       // If the optimization level is higher, just upgrade
       // (unless the methods has excessive complexity)
       //
@@ -5037,12 +5106,8 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
          }
       // If the position in the queue is still correct, just return
       //
-      if (!prev || prev->_priority >= cur->_priority)
+      if (!mustReposition)
          return cur;
-
-      // Must re-position in the queue
-      //
-      prev->_next = cur->_next; // take it out of the queue
       }
 
    // If method is not yet in the queue prepare the queue entry
@@ -5267,33 +5332,191 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
    return cur;
    }
 
+//--------------------------- queuePriorityLevel -------------------------
+// Return the index of the given priority in compQueuePriorityLevels
+// or -1 if the priority is not one of the standard levels
+//------------------------------------------------------------------------
+int32_t TR::CompilationInfo::queuePriorityLevel(uint16_t priority)
+   {
+   for (int32_t i = 0; i < NUM_QUEUE_PRIORITY_LEVELS; i++)
+      {
+      if (compQueuePriorityLevels[i] == priority)
+         return i;
+      }
+   return -1;
+   }
+
 //--------------------------- queueEntry ---------------------------------
 // Insert the compilation request in the queue at the appropriate place
 // based on its priority. Must have compilationQueueMonitor in hand
+//
+// Requests are kept sorted by priority and are FIFO within the same
+// priority. Because we remember the last request queued at each priority
+// level, the insertion point is normally found without walking the queue.
 //------------------------------------------------------------------------
 void TR::CompilationInfo::queueEntry(TR_MethodToBeCompiled *entry)
    {
    TR_ASSERT_FATAL(entry->_freeTag & ENTRY_INITIALIZED, "queuing an entry which is not initialized\n");
 
    entry->_freeTag |= ENTRY_QUEUED;
+   // Requests that are re-positioned in the queue keep their original timestamp
+   if (entry->_timeQueued == 0)
+      entry->_timeQueued = (uint32_t)getPersistentInfo()->getElapsedTime();
 
-   if (!_methodQueue || _methodQueue->_priority < entry->_priority)
+   // Count the requests that will most likely be satisfied by an AOT load so
+   // that bursts of them can be spread over several compilation threads
+   if (entry->_methodIsInSharedCache == TR_yes && !entry->_oldStartPC && !entry->_doNotAOTCompile)
       {
-      entry->_next = _methodQueue;
-      _methodQueue = entry;
+      entry->_entryIsCountedAsAotLoad = true;
+      _numQueuedAotLoads++;
       }
-   else
+
+   // Find the request after which the new one must be inserted: the last request
+   // with the same priority or, if there is none, with the closest higher priority
+   int32_t level = queuePriorityLevel(entry->_priority);
+   TR_MethodToBeCompiled *prev = NULL;
+   bool insertionPointKnown = false;
+   if (level >= 0 && _numQueuedEntriesWithOtherPriority == 0)
       {
-      for (TR_MethodToBeCompiled *prev = _methodQueue; ; prev = prev->_next)
+      insertionPointKnown = true;
+      for (int32_t i = level; i >= 0; i--)
          {
-         if (!prev->_next || prev->_next->_priority < entry->_priority)
+         if (_queuePriorityLevels[i]._numEntries > 0)
             {
-            entry->_next = prev->_next;
-            prev->_next = entry;
+            prev = _queuePriorityLevels[i]._lastEntry;
+            insertionPointKnown = (prev != NULL); // Last entry not known if it was dequeued out of order
             break;
             }
          }
       }
+
+   if (!insertionPointKnown)
+      {
+      prev = NULL;
+      for (TR_MethodToBeCompiled *cur = _methodQueue; cur && cur->_priority >= entry->_priority; cur = cur->_next)
+         prev = cur;
+      }
+
+   if (prev)
+      {
+      entry->_next = prev->_next;
+      prev->_next = entry;
+      }
+   else
+      {
+      entry->_next = _methodQueue;
+      _methodQueue = entry;
+      }
+
+   // Either way, the new entry is now the last one with its priority
+   if (level >= 0)
+      {
+      _queuePriorityLevels[level]._numEntries++;
+      _queuePriorityLevels[level]._lastEntry = entry;
+      }
+   else
+      {
+      _numQueuedEntriesWithOtherPriority++;
+      }
+   }
+
+//--------------------------- dequeueEntry -------------------------------
+// Detach the given request from the queue; prev is the request in front of
+// it or NULL if the request is at the head of the queue.
+// Must have compilationQueueMonitor in hand. Callers that change the priority
+// of a queued request must take the request out first and queue it again.
+//------------------------------------------------------------------------
+void TR::CompilationInfo::dequeueEntry(TR_MethodToBeCompiled *prev, TR_MethodToBeCompiled *entry)
+   {
+   TR_ASSERT(prev ? prev->_next == entry : _methodQueue == entry, "prev is not the predecessor of entry %p", entry);
+   if (prev)
+      prev->_next = entry->_next;
+   else
+      _methodQueue = entry->_next;
+
+   if (entry->_entryIsCountedAsAotLoad)
+      {
+      entry->_entryIsCountedAsAotLoad = false;
+      _numQueuedAotLoads--;
+      TR_ASSERT(_numQueuedAotLoads >= 0, "_numQueuedAotLoads is negative : %d", _numQueuedAotLoads);
+      }
+
+   int32_t level = queuePriorityLevel(entry->_priority);
+   if (level >= 0)
+      {
+      CompQueuePriorityLevel &priorityLevel = _queuePriorityLevels[level];
+      TR_ASSERT(priorityLevel._numEntries > 0, "No entries queued with priority 0x%x", entry->_priority);
+      priorityLevel._numEntries--;
+      if (priorityLevel._numEntries == 0)
+         priorityLevel._lastEntry = NULL;
+      else if (priorityLevel._lastEntry == entry)
+         priorityLevel._lastEntry = (prev && prev->_priority == entry->_priority) ? prev : NULL;
+      }
+   else
+      {
+      _numQueuedEntriesWithOtherPriority--;
+      }
+   }
+
+//--------------------------- ageQueuedEntries ---------------------------
+// Raise by one level the priority of low priority asynchronous requests that
+// have been waiting in the queue for longer than _compQueueAgingThresholdMs,
+// so that they are not starved by a continuous stream of higher priority ones.
+// Aged requests never go above CP_ASYNC_ABOVE_NORMAL because the levels above
+// have special meaning (AOT loads, promoted requests).
+// Must have compilationQueueMonitor in hand
+//------------------------------------------------------------------------
+void TR::CompilationInfo::ageQueuedEntries()
+   {
+   uint64_t crtTime = getPersistentInfo()->getElapsedTime();
+   if (crtTime - _lastQueueAgingTime < (uint64_t)TR::Options::_compQueueAgingThresholdMs)
+      return;
+   _lastQueueAgingTime = crtTime;
+
+   int32_t maxAgedLevel = queuePriorityLevel(CP_ASYNC_ABOVE_NORMAL);
+   TR_MethodToBeCompiled *prev = NULL;
+   TR_MethodToBeCompiled *cur = _methodQueue;
+   while (cur)
+      {
+      TR_MethodToBeCompiled *next = cur->_next;
+      int32_t level = queuePriorityLevel(cur->_priority);
+      if (level > maxAgedLevel &&
+          (uint32_t)crtTime - cur->_timeQueued >= (uint32_t)TR::Options::_compQueueAgingThresholdMs)
+         {
+         dequeueEntry(prev, cur);
+         cur->_priority = compQueuePriorityLevels[level - 1];
+         queueEntry(cur);
+         _statNumAgedQueueEntries++;
+         // The entry moved towards the head of the queue; if it landed
+         // right where it was, it becomes the predecessor of next
+         if (prev ? prev->_next == cur : _methodQueue == cur)
+            prev = cur;
+         }
+      else
+         {
+         prev = cur;
+         }
+      cur = next;
+      }
+   }
+
+//--------------------------- recordQueueTime ----------------------------
+// Update the queuing latency statistics for the priority level of a
+// request that is being dequeued
+//------------------------------------------------------------------------
+void TR::CompilationInfo::recordQueueTime(TR_MethodToBeCompiled *entry)
+   {
+   int32_t level = queuePriorityLevel(entry->_priority);
+   if (level >= 0)
+      {
+      uint32_t queueTime = (uint32_t)getPersistentInfo()->getElapsedTime() - entry->_timeQueued;
+      CompQueuePriorityLevel &priorityLevel = _queuePriorityLevels[level];
+      priorityLevel._numDequeued++;
+      priorityLevel._totalQueueTimeMs += queueTime;
+      if (queueTime > priorityLevel._maxQueueTimeMs)
+         priorityLevel._maxQueueTimeMs = queueTime;
+      }
+   entry->_timeQueued = 0;
    }
 
 //--------------------------------- requeue ----------------------------------
@@ -5362,10 +5585,7 @@ TR::CompilationInfo::adjustCompilationEntryAndRequeue(
          if (cur->_priority < priority)
             {
             // take the method out
-            if (prev)
-               prev->_next = cur->_next;
-            else
-               _methodQueue = cur->_next;
+            dequeueEntry(prev, cur);
             // put it back at its proper place
             cur->_priority = priority;
             queueEntry(cur);
@@ -5410,27 +5630,10 @@ int32_t TR::CompilationInfo::promoteMethodInAsyncQueue(J9Method * method, void *
 #ifdef STATS
    fprintf(stderr, "Promoting method in queue QSZ=%d\n", getMethodQueueSize());
 #endif
+   // take the method out and put it back after the other promoted requests
+   dequeueEntry(prev, cur);
    cur->_priority = CP_ASYNC_MAX;
-
-   // take the method out
-   prev->_next = cur->_next;
-   // find insertion point
-   if (_methodQueue->_priority < CP_ASYNC_MAX) // common case
-      {
-      cur->_next = _methodQueue;
-      _methodQueue = cur;
-      // FIXME: how about the compilation lag
-      }
-   else
-      {
-      for (prev = _methodQueue; prev->_next; prev = prev->_next)
-         if (prev->_next->_priority < CP_ASYNC_MAX)
-            {
-            cur->_next = prev->_next;
-            prev->_next = cur;
-            break;
-            }
-      }
+   queueEntry(cur);
    return i;
    }
 
@@ -5468,16 +5671,9 @@ void TR::CompilationInfo::changeCompReqFromAsyncToSync(J9Method * method)
          {
          // Take the method out, increase its priority and insert it at the proper place
          //
+         dequeueEntry(prev, cur);
          cur->_priority = CP_SYNC_NORMAL;
-         if (prev)
-            {
-            prev->_next = cur->_next;
-            queueEntry(cur);
-            }
-         else // method already at the top of the queue
-            {
-            // Nothing to do
-            }
+         queueEntry(cur);
          }
       else
          {
@@ -5569,7 +5765,7 @@ TR::CompilationInfo::getNextMethodToBeCompiled(TR::CompilationInfoPerThread *com
       if (_methodQueue)
          {
          nextMethodToBeCompiled = _methodQueue;
-         _methodQueue = _methodQueue->_next;
+         dequeueEntry(NULL, nextMethodToBeCompiled);
 
          // See explanation at the start of this function of why it is important to ensure this
          TR_ASSERT_FATAL(nextMethodToBeCompiled->getMethodDetails().isJitDumpMethod(), "Diagnostic thread attempting to process non-JitDump compilation");
@@ -5581,10 +5777,15 @@ TR::CompilationInfo::getNextMethodToBeCompiled(TR::CompilationInfoPerThread *com
       {
       *compThreadAction = PROCESS_ENTRY;
 
+      if (TR::Options::_compQueueAgingThresholdMs > 0)
+         ageQueuedEntries();
+
       // Due to the above mentioned timing hole, a non-diagnostic compilation thread may still be trying to process
       // entries. We prevent it from processing JitDump compilation requests here.
       if (_methodQueue != NULL && !_methodQueue->getMethodDetails().isJitDumpMethod())
          {
+         TR_MethodToBeCompiled *cheaperEntry = NULL;
+         TR_MethodToBeCompiled *prevOfCheaperEntry = NULL;
          // If the request is sync or AOT load, take it now
          if (_methodQueue->_priority >= CP_SYNC_MIN // sync comp
             || _methodQueue->_methodIsInSharedCache == TR_yes // very cheap relocation
@@ -5594,7 +5795,7 @@ TR::CompilationInfo::getNextMethodToBeCompiled(TR::CompilationInfoPerThread *com
             )
             {
             nextMethodToBeCompiled = _methodQueue;
-            _methodQueue = _methodQueue->_next;
+            dequeueEntry(NULL, nextMethodToBeCompiled);
             }
          // Check if we need to throttle
          else if (exceedsCompCpuEntitlement() == TR_yes &&
@@ -5608,12 +5809,25 @@ TR::CompilationInfo::getNextMethodToBeCompiled(TR::CompilationInfoPerThread *com
             else
                *compThreadAction = THROTTLE_COMP_THREAD_EXCEED_CPU_ENTITLEMENT;
             }
+         // Give CPU back to the application when more compilation threads are active than
+         // the cgroup CPU quota allows. The limit is at least 1, so this is never the last thread.
+         else if (exceedsCgroupCompThreadLimit() && !compThreadCameOutOfSleep)
+            {
+            *compThreadAction = SUSPEND_COMP_THREAD_EXCEED_CPU_ENTITLEMENT;
+            }
+         // Let a cheaper request run ahead of one that exceeds the compilation time budget
+         else if (TR::Options::_compAdmissionTimeBudgetMs > 0 &&
+                  (cheaperEntry = getCompAdmissionControl().findRequestToRunAhead(_methodQueue, &prevOfCheaperEntry)) != NULL)
+            {
+            nextMethodToBeCompiled = cheaperEntry;
+            dequeueEntry(prevOfCheaperEntry, nextMethodToBeCompiled);
+            }
          // Avoid two concurrent hot compilations
          else if (getNumCompThreadsCompilingHotterMethods() <= 0 || // no hot compilation in progress
                   _methodQueue->_weight < TR::Options::_expensiveCompWeight) // This is a cheaper comp
             {
             nextMethodToBeCompiled = _methodQueue;
-            _methodQueue = _methodQueue->_next;
+            dequeueEntry(NULL, nextMethodToBeCompiled);
             }
          else // scan for a cold/warm method
             {
@@ -5624,7 +5838,7 @@ TR::CompilationInfo::getNextMethodToBeCompiled(TR::CompilationInfoPerThread *com
                   nextMethodToBeCompiled->_priority >= CP_SYNC_MIN ||       // sync comp
                   nextMethodToBeCompiled->_methodIsInSharedCache == TR_yes) // very cheap relocation
                   {
-                  prev->_next = nextMethodToBeCompiled->_next;
+                  dequeueEntry(prev, nextMethodToBeCompiled);
                   break;
                   }
                }
@@ -5687,6 +5901,41 @@ TR::CompilationInfo::getNextMethodToBeCompiled(TR::CompilationInfoPerThread *com
          if (nextMethodToBeCompiled) // A request has been dequeued
             {
             updateCompQueueAccountingOnDequeue(nextMethodToBeCompiled);
+
+            if (TR::Options::_compAdmissionTimeBudgetMs > 0)
+               {
+               bool compilesRemotely = false;
+#if defined(J9VM_OPT_JITSERVER)
+               // While a server is available, the expensive compilations of a client are
+               // done remotely, so the local time and memory budget does not apply to them
+               compilesRemotely = getPersistentInfo()->getRemoteCompilationMode() == JITServer::CLIENT &&
+                                  JITServerHelpers::isServerAvailable();
+#endif /* defined(J9VM_OPT_JITSERVER) */
+               if (!compilesRemotely)
+                  getCompAdmissionControl().admit(nextMethodToBeCompiled, getCachedFreePhysicalMemoryB());
+               }
+
+            // While this thread relocates an AOT body, let the OS read in the next one
+            if (TR::Options::_aotLoadBurstThreshold > 0)
+               {
+               const J9ROMMethod *romMethodToPrefetch = NULL;
+               if (nextMethodToBeCompiled->_methodIsInSharedCache == TR_yes)
+                  {
+                  // AOT loads are queued at high priority, so only look at the front of the queue
+                  int32_t numEntriesToScan = 8;
+                  for (TR_MethodToBeCompiled *cur = _methodQueue; cur && numEntriesToScan > 0; cur = cur->_next, numEntriesToScan--)
+                     {
+                     if (cur->_entryIsCountedAsAotLoad && cur->getMethodDetails().isOrdinaryMethod())
+                        {
+                        // The ROM method lives in the shared class cache, so it stays valid
+                        // even if the class gets unloaded before the prefetch is done
+                        romMethodToPrefetch = J9_ROM_METHOD_FROM_RAM_METHOD(cur->getMethodDetails().getMethod());
+                        break;
+                        }
+                     }
+                  }
+               compInfoPT->setAotLoadToPrefetch(romMethodToPrefetch);
+               }
             }
          }
       // When no request is in the main queue we can look in the low priority queue
@@ -6527,12 +6776,9 @@ void *TR::CompilationInfo::compileOnSeparateThread(J9VMThread * vmThread, TR::Il
             }
          if (reqMe && reqMe->_priority<CP_ASYNC_ABOVE_NORMAL)
             {
+            dequeueEntry(prevReq, reqMe);
             reqMe->_priority = CP_ASYNC_ABOVE_NORMAL;
-            if (prevReq && prevReq->_priority<CP_ASYNC_ABOVE_NORMAL)
-               {
-               prevReq->_next = reqMe->_next;
-               queueEntry(reqMe);
-               }
+            queueEntry(reqMe);
             }
          }
       }
@@ -7212,6 +7458,25 @@ TR::CompilationInfoPerThreadBase::findAotBodyInSCC(J9VMThread *vmThread, const J
       return NULL;
    }
 
+void
+TR::CompilationInfoPerThreadBase::prefetchAotBodyInSCC(J9VMThread *vmThread, const J9ROMMethod *romMethod)
+   {
+#if defined(LINUX) && defined(J9VM_INTERP_AOT_RUNTIME_SUPPORT) && defined(J9VM_OPT_SHARED_CLASSES)
+   const void *aotCachedMethod = findAotBodyInSCC(vmThread, romMethod);
+   if (!aotCachedMethod)
+      return;
+
+   // For a persistent shared class cache this starts an asynchronous read-ahead of the
+   // pages holding the body, so they are resident by the time the body gets relocated
+   PORT_ACCESS_FROM_JITCONFIG(_jitConfig);
+   uintptr_t pageSize = j9vmem_supported_page_sizes()[0];
+   const J9JITDataCacheHeader *cacheEntry = static_cast<const J9JITDataCacheHeader *>(aotCachedMethod);
+   uintptr_t start = (uintptr_t)aotCachedMethod & ~(pageSize - 1);
+   uintptr_t end = (uintptr_t)aotCachedMethod + cacheEntry->size;
+   madvise((void *)start, end - start, MADV_WILLNEED);
+#endif
+   }
+
 #if defined(J9VM_OPT_JITSERVER)
 
 bool
@@ -7489,6 +7754,12 @@ TR::CompilationInfoPerThreadBase::preCompilationTasks(J9VMThread * vmThread,
             entry->_doNotAOTCompile = true;
             }
 
+         if (_aotLoadToPrefetch)
+            {
+            prefetchAotBodyInSCC(vmThread, _aotLoadToPrefetch);
+            _aotLoadToPrefetch = NULL;
+            }
+
          if (*aotCachedMethod)
             {
 #ifdef COMPRESS_AOT_DATA
@@ -9501,6 +9772,20 @@ TR::CompilationInfoPerThreadBase::wrappedCompile(J9PortLibrary *portLib, void *
                // that if I take the time to compile method, why not do it sooner
                sc->addHint(method, TR_HintMethodCompiledDuringStartup);
                }
+
+            // Remember the final opt level of methods compiled at warm or above
+            // so that the next run can compile them early. The first compilation
+            // of a planned method takes its opt level from the plan, so recording
+            // it would only make the plan reinforce itself.
+            if (auto compilationPlan = that->getCompilationInfo()->getPersistentInfo()->getPersistedCompilationPlan())
+               {
+               TR_Hotness hotness = that->_methodBeingCompiled->_optimizationPlan->getOptLevel();
+               J9ROMMethod *romMethod = J9_ROM_METHOD_FROM_RAM_METHOD(method);
+               bool levelFromPlan = !that->_methodBeingCompiled->_oldStartPC &&
+                                    (compilationPlan->getPlannedOptLevel(romMethod) != unknownHotness);
+               if (hotness >= warm && hotness <= scorching && !levelFromPlan)
+                  compilationPlan->recordCompilation(romMethod, hotness);
+               }
             }
 
          // If this is a cold/warm compilation that takes too much memory
@@ -10930,6 +11215,19 @@ void TR::CompilationInfoPerThreadBase::logCompilationSuccess(
          cipt->setLastCompilationDuration(translationTime / 1000);
          }
 
+      // Teach the admission control how expensive compilations really are; remote
+      // compilations do not consume local resources and are not representative
+      if (TR::Options::_compAdmissionTimeBudgetMs > 0
+#if defined(J9VM_OPT_JITSERVER)
+         && !compiler->isOutOfProcessCompilation() && !_methodBeingCompiled->isRemoteCompReq()
+#endif /* defined(J9VM_OPT_JITSERVER) */
+         )
+         {
+         TR_PersistentMethodInfo *methodInfo = compiler->getRecompilationInfo() ? compiler->getRecompilationInfo()->getMethodInfo() : NULL;
+         _compInfo.getCompAdmissionControl().recordCompilation(_methodBeingCompiled, methodInfo, compiler->getMethodHotness(),
+                                                               translationTime, scratchSegmentProvider.regionBytesAllocated());
+         }
+
       uintptr_t gcDataBytes = _jitConfig->lastGCDataAllocSize;
       uintptr_t atlasBytes = _jitConfig->lastExceptionTableAllocSize;
 
@@ -12815,6 +13113,186 @@ void TR_JitSampleInfo::update(uint64_t crtTime, uint32_t crtGlobalSampleCounter)
    }
 
 
+uint32_t TR_CompilationAdmissionControl::getNsPerBytecode(TR_Hotness optLevel) const
+   {
+   // Starting points for the model, replaced over time by what compilations actually cost
+   static const uint32_t defaultNsPerBytecode[scorching + 1] = { 3000, 8000, 30000, 120000, 200000, 300000 };
+   return _nsPerBytecode[optLevel] ? _nsPerBytecode[optLevel] : defaultNsPerBytecode[optLevel];
+   }
+
+uint32_t TR_CompilationAdmissionControl::getScratchBytesPerBytecode(TR_Hotness optLevel) const
+   {
+   static const uint32_t defaultScratchBytesPerBytecode[scorching + 1] = { 2000, 4000, 12000, 30000, 50000, 60000 };
+   return _scratchBytesPerBytecode[optLevel] ? _scratchBytesPerBytecode[optLevel] : defaultScratchBytesPerBytecode[optLevel];
+   }
+
+TR_CompilationAdmissionControl::CostEstimate
+TR_CompilationAdmissionControl::estimateCost(TR_MethodToBeCompiled *entry) const
+   {
+   CostEstimate estimate = { 0, 0 };
+   TR::IlGeneratorMethodDetails &details = entry->getMethodDetails();
+   // Thunks, JNI natives and AOT loads are cheap; requests coming from
+   // a JITServer client refer to methods we cannot inspect
+   if (!details.isOrdinaryMethod() || entry->isJNINative() || entry->isOutOfProcessCompReq() ||
+       (entry->_methodIsInSharedCache == TR_yes && !entry->_oldStartPC))
+      return estimate;
+   TR_Hotness optLevel = entry->_optimizationPlan->getOptLevel();
+   if (optLevel < noOpt || optLevel > scorching)
+      return estimate;
+
+   uint64_t bytecodeSize = TR::CompilationInfo::getMethodBytecodeSize(details.getMethod());
+   uint64_t timeUs = bytecodeSize * getNsPerBytecode(optLevel) / 1000;
+   uint64_t scratchKB = bytecodeSize * getScratchBytesPerBytecode(optLevel) / 1024;
+   // For recompilations correct the estimate with how far off it was for the previous body
+   if (entry->_oldStartPC)
+      {
+      TR_PersistentMethodInfo *methodInfo = TR::Recompilation::getMethodInfoFromPC(entry->_oldStartPC);
+      if (methodInfo)
+         {
+         if (methodInfo->getCompTimeFactor())
+            timeUs = timeUs * methodInfo->getCompTimeFactor() / 100;
+         if (methodInfo->getCompMemoryFactor())
+            scratchKB = scratchKB * methodInfo->getCompMemoryFactor() / 100;
+         }
+      }
+   estimate._timeMs = (uint32_t)std::min<uint64_t>(timeUs / 1000, UINT_MAX);
+   estimate._scratchKB = (uint32_t)std::min<uint64_t>(scratchKB, UINT_MAX);
+   return estimate;
+   }
+
+TR_MethodToBeCompiled *
+TR_CompilationAdmissionControl::findRequestToRunAhead(TR_MethodToBeCompiled *queue, TR_MethodToBeCompiled **prev)
+   {
+   if (queue->_numAdmissionDeferrals >= MAX_DEFERRALS || !queue->_next || !exceedsTimeBudget(estimateCost(queue)))
+      return NULL;
+   // Only look at the front of the queue; the queue is sorted by priority
+   int32_t numEntriesToScan = 16;
+   TR_MethodToBeCompiled *prevEntry = queue;
+   for (TR_MethodToBeCompiled *cur = queue->_next; cur && numEntriesToScan > 0; prevEntry = cur, cur = cur->_next, numEntriesToScan--)
+      {
+      if (!cur->getMethodDetails().isJitDumpMethod() && !exceedsTimeBudget(estimateCost(cur)))
+         {
+         queue->_numAdmissionDeferrals++;
+         _numDeferrals++;
+         if (TR::Options::getVerboseOption(TR_VerboseCompilationDispatch))
+            TR_VerboseLog::writeLineLocked(TR_Vlog_DISPATCH, "Admission control deferred j9method=%p (deferral %u) in favor of j9method=%p",
+               queue->getMethodDetails().getMethod(), (uint32_t)queue->_numAdmissionDeferrals, cur->getMethodDetails().getMethod());
+         *prev = prevEntry;
+         return cur;
+         }
+      }
+   return NULL;
+   }
+
+bool TR_CompilationAdmissionControl::exceedsMemoryBudget(const CostEstimate &estimate, uint64_t freePhysicalMemoryB) const
+   {
+   uint64_t budgetKB = TR::Options::getScratchSpaceLimit() / 1024;
+   if (freePhysicalMemoryB != OMRPORT_MEMINFO_NOT_AVAILABLE && freePhysicalMemoryB != 0)
+      budgetKB = std::min<uint64_t>(budgetKB, freePhysicalMemoryB / 1024);
+   return estimate._scratchKB > budgetKB;
+   }
+
+void TR_CompilationAdmissionControl::admit(TR_MethodToBeCompiled *entry, uint64_t freePhysicalMemoryB)
+   {
+   TR_OptimizationPlan *plan = entry->_optimizationPlan;
+   // Fixed opt levels and profiling compilations are left alone; the latter
+   // exist to feed the compilation that follows them
+   if (!TR::Options::getCmdLineOptions()->allowRecompilation() || plan->insertInstrumentation())
+      return;
+   TR_Hotness originalOptLevel = plan->getOptLevel();
+   if (originalOptLevel <= cold || originalOptLevel > scorching)
+      return;
+
+   // A recompilation must produce a better body than the installed one: taking it down to the level
+   // of that body or below would only have sampling request it again. Such recompilations are
+   // left to be deferred by findRequestToRunAhead rather than downgraded below that level.
+   TR_Hotness minOptLevel = cold;
+   if (entry->_oldStartPC)
+      {
+      TR_PersistentJittedBodyInfo *bodyInfo = TR::Recompilation::getJittedBodyInfoFromPC(entry->_oldStartPC);
+      if (!bodyInfo)
+         return;
+      if (bodyInfo->getHotness() + 1 > minOptLevel)
+         minOptLevel = (TR_Hotness)(bodyInfo->getHotness() + 1);
+      }
+
+   CostEstimate estimate = estimateCost(entry);
+   uint64_t timeLimitMs = 4 * (uint64_t)TR::Options::_compAdmissionTimeBudgetMs;
+   while (plan->getOptLevel() > minOptLevel)
+      {
+      // Memory pressure can push a compilation down to cold; a compilation that is only
+      // expensive in time is not taken below warm to preserve steady state throughput
+      bool overMemory = exceedsMemoryBudget(estimate, freePhysicalMemoryB);
+      bool overTime = estimate._timeMs > timeLimitMs && plan->getOptLevel() > warm;
+      if (!overMemory && !overTime)
+         break;
+      plan->setOptLevel((TR_Hotness)(plan->getOptLevel() - 1));
+      estimate = estimateCost(entry);
+      }
+
+   TR_Hotness newOptLevel = plan->getOptLevel();
+   if (newOptLevel == originalOptLevel)
+      return;
+   _numDowngrades++;
+   if (entry->_oldStartPC)
+      {
+      // Keep the method info in sync so that the compilation is not upgraded back
+      TR_PersistentMethodInfo *methodInfo = TR::Recompilation::getMethodInfoFromPC(entry->_oldStartPC);
+      if (methodInfo)
+         methodInfo->setNextCompileLevel(newOptLevel, false);
+      }
+   else
+      {
+      // Allow the method to be upgraded once the body is installed
+      plan->setOptLevelDowngraded(true);
+      }
+   if (TR::Options::isAnyVerboseOptionSet(TR_VerbosePerformance, TR_VerboseCompilationDispatch))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "Admission control downgraded j9method=%p from %s to %s: estimated %u ms, %u KB scratch",
+         entry->getMethodDetails().getMethod(), TR::Compilation::getHotnessName(originalOptLevel),
+         TR::Compilation::getHotnessName(newOptLevel), estimate._timeMs, estimate._scratchKB);
+   }
+
+void TR_CompilationAdmissionControl::recordCompilation(TR_MethodToBeCompiled *entry, TR_PersistentMethodInfo *methodInfo,
+                                                       TR_Hotness optLevel, uint64_t timeUs, uint64_t scratchBytes)
+   {
+   TR::IlGeneratorMethodDetails &details = entry->getMethodDetails();
+   if (optLevel < noOpt || optLevel > scorching || !details.isOrdinaryMethod() || entry->isJNINative())
+      return;
+   uint64_t bytecodeSize = TR::CompilationInfo::getMethodBytecodeSize(details.getMethod());
+   if (bytecodeSize == 0)
+      return;
+
+   // Remember how far off the model was for this method, relative to the model before it learns from this sample
+   if (methodInfo)
+      {
+      uint64_t expectedTimeUs = bytecodeSize * getNsPerBytecode(optLevel) / 1000;
+      uint64_t expectedScratchBytes = bytecodeSize * getScratchBytesPerBytecode(optLevel);
+      uint64_t timeFactor = expectedTimeUs ? timeUs * 100 / expectedTimeUs : 100;
+      uint64_t memoryFactor = expectedScratchBytes ? scratchBytes * 100 / expectedScratchBytes : 100;
+      methodInfo->setCompCostFactors((uint16_t)std::min<uint64_t>(std::max<uint64_t>(timeFactor, 1), USHRT_MAX),
+                                     (uint16_t)std::min<uint64_t>(std::max<uint64_t>(memoryFactor, 1), USHRT_MAX));
+      }
+
+   // Small methods are dominated by fixed costs and would skew the per-bytecode averages
+   if (bytecodeSize < 64)
+      return;
+   uint64_t nsPerBytecode = std::min<uint64_t>(timeUs * 1000 / bytecodeSize, UINT_MAX);
+   uint64_t scratchBytesPerBytecode = std::min<uint64_t>(scratchBytes / bytecodeSize, UINT_MAX);
+   // Exponential moving average with a weight of 1/8 for the new sample
+   _nsPerBytecode[optLevel] = (uint32_t)(((uint64_t)getNsPerBytecode(optLevel) * 7 + nsPerBytecode) / 8);
+   _scratchBytesPerBytecode[optLevel] = (uint32_t)(((uint64_t)getScratchBytesPerBytecode(optLevel) * 7 + scratchBytesPerBytecode) / 8);
+   }
+
+void TR_CompilationAdmissionControl::printStats() const
+   {
+   fprintf(stderr, "Compilation admission control: budget=%d ms deferrals=%u downgrades=%u\n",
+      TR::Options::_compAdmissionTimeBudgetMs, _numDeferrals, _numDowngrades);
+   for (int32_t level = noOpt; level <= scorching; level++)
+      fprintf(stderr, "\t%-10s %8u ns/bytecode %8u scratch bytes/bytecode\n", TR::Compilation::getHotnessName((TR_Hotness)level),
+         getNsPerBytecode((TR_Hotness)level), getScratchBytesPerBytecode((TR_Hotness)level));
+   }
+
+
 void TR_InterpreterSamplingTracking::addOrUpdate(J9Method *method, int32_t cnt)
    {
    // get the compilation queue monitor
@@ -13327,7 +13805,16 @@ TR::CompilationInfo::requeueOutOfProcessEntry(TR_MethodToBeCompiled *entry)
 
    recycleCompilationEntry(entry);
 
-   if (entry->_stream && addOutOfProcessMethodToBeCompiled(entry->_stream))
+   if (!entry->_stream)
+      return;
+
+   // With -XX:+JITServerEventLoop the listener thread watches the connection until
+   // the client sends its next request, so that no compilation thread blocks on it
+   TR_Listener *listener = ((TR_JitPrivateConfig *)_jitConfig->privateConfig)->listener;
+   if (listener && listener->parkIdleStream(entry->_stream))
+      return;
+
+   if (addOutOfProcessMethodToBeCompiled(entry->_stream))
       {
       // successfully queued the new entry, so notify a thread
       getCompilationMonitor()->notifyAll();
@@ -185,6 +185,20 @@ class CompilationInfoPerThreadBase
                               TR_RelocationRuntime *reloRuntime);
    static const void* findAotBodyInSCC(J9VMThread *vmThread, const J9ROMMethod *romMethod);
 
+   /**
+    * @brief Hint the OS to read in the AOT body of the given method from the shared class cache
+    *
+    * @param[in] vmThread : the current J9VMThread
+    * @param[in] romMethod : a ROM method that resides in the shared class cache
+    */
+   void prefetchAotBodyInSCC(J9VMThread *vmThread, const J9ROMMethod *romMethod);
+
+   /**
+    * @brief Remember an AOT load that is queued behind the one this thread just took,
+    *        so that its body can be prefetched. Must have compilationQueueMonitor in hand.
+    */
+   void setAotLoadToPrefetch(const J9ROMMethod *romMethod) { _aotLoadToPrefetch = romMethod; }
+
 #if defined(J9VM_OPT_SHARED_CLASSES) && defined(J9VM_INTERP_AOT_RUNTIME_SUPPORT)
    TR_MethodMetaData *installAotCachedMethod(
                                 J9VMThread *vmThread,
@@ -405,6 +419,7 @@ class CompilationInfoPerThreadBase
    volatile CompilationThreadState _compilationThreadState;
    volatile CompilationThreadState _previousCompilationThreadState;
    volatile uint8_t             _compilationShouldBeInterrupted;
+   const J9ROMMethod *          _aotLoadToPrefetch; // next queued AOT load, if any, when bulk AOT loading
 
    static TR::FILE *_perfFile; // used on Linux for perl tool support
 
@@ -25,6 +25,7 @@
 #include "control/Options.hpp"
 #include "env/ClassLoaderTable.hpp"
 #include "env/DependencyTable.hpp"
+#include "env/PersistedCompilationPlan.hpp"
 #include "env/annotations/AnnotationBase.hpp"
 #include "env/ut_j9jit.h"
 #include "control/CompilationRuntime.hpp"
@@ -517,6 +518,15 @@ IDATA J9VMDllMain(J9JavaVM* vm, IDATA stage, void * reserved)
 #endif /* !defined(PERSISTENT_COLLECTIONS_UNSUPPORTED) */
                if (!persistentInfo->getAOTDependencyTable())
                   persistentInfo->setTrackAOTDependencies(false);
+
+#if !defined(PERSISTENT_COLLECTIONS_UNSUPPORTED)
+               if (TR::Options::_persistedCompilationPlanMaxEntries > 0)
+                  {
+                  TR_PersistedCompilationPlan *compilationPlan = new (PERSISTENT_NEW) TR_PersistedCompilationPlan(
+                     vm->internalVMFunctions->currentVMThread(vm), sharedCache, TR::Options::_persistedCompilationPlanMaxEntries);
+                  persistentInfo->setPersistedCompilationPlan(compilationPlan);
+                  }
+#endif /* !defined(PERSISTENT_COLLECTIONS_UNSUPPORTED) */
                }
             }
          else
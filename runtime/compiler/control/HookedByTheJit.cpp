@@ -58,6 +58,7 @@
 #include "env/ClassLoaderTable.hpp"
 #include "env/CompilerEnv.hpp"
 #include "env/DependencyTable.hpp"
+#include "env/PersistedCompilationPlan.hpp"
 #include "env/IO.hpp"
 #include "env/J2IThunk.hpp"
 #include "env/PersistentCHTable.hpp"
@@ -676,6 +677,14 @@ static void jitHookInitializeSendTarget(J9HookInterface * * hook, UDATA eventNum
                          count = J9ROMMETHOD_HAS_BACKWARDS_BRANCHES(romMethod) ? TR_DEFAULT_INITIAL_BCOUNT : TR_DEFAULT_INITIAL_COUNT;
                      }
                   }
+               // Methods that reached warm or above in the run that stored the
+               // compilation plan are compiled at their first invocation, which
+               // happens only once their class has been loaded and initialized
+               if (auto compilationPlan = compInfo->getPersistentInfo()->getPersistedCompilationPlan())
+                  {
+                  if (compilationPlan->getPlannedOptLevel(romMethod) != unknownHotness)
+                     count = 0;
+                  }
                }
             if (optionsAOT->getOption(TR_EnableSharedCacheTiming))
                {
@@ -4362,6 +4371,15 @@ void JitShutdown(J9JITConfig * jitConfig)
 
    TR::CompilationInfo * compInfo = TR::CompilationInfo::get(jitConfig);
 
+   // Compilation threads have been stopped, so the compilation plan is final
+   if (auto compilationPlan = compInfo->getPersistentInfo()->getPersistedCompilationPlan())
+      {
+      if (vmThread)
+         compilationPlan->persist(vmThread);
+      if (feGetEnv("TR_PrintCompilationPlanStats"))
+         compilationPlan->printStats();
+      }
+
 #if defined(J9VM_OPT_JITSERVER)
    PersistentUnorderedSet<std::string> *serverAOTMethodSet =
       (PersistentUnorderedSet<std::string> *) jitConfig->serverAOTMethodSet;
@@ -5730,6 +5748,71 @@ void CPUThrottleLogic(TR::CompilationInfo *compInfo, uint64_t crtTime)
       }
    }
 
+/// Adapts the number of active compilation threads to the CPU quota of the cgroup
+/// the JVM runs in. Compilation threads may use TR::Options::_cgroupCompCpuQuotaPercent
+/// of the quota. Whenever the cgroup gets throttled, the limit is lowered by one
+/// thread and warm compilations are downgraded; after several intervals without
+/// throttling the limit is raised again by one thread.
+static void cgroupCpuQuotaLogic(TR::CompilationInfo *compInfo, uint64_t crtTime)
+   {
+   static const int32_t CGROUP_THROTTLED_PERIODS_THRESHOLD = 10; // percent of CFS periods
+   static const int32_t CGROUP_UNTHROTTLED_INTERVALS_TO_RAISE_LIMIT = 4;
+   static bool initialized = false;
+   static int32_t numUnthrottledIntervals = 0;
+
+   TR_CgroupCpuQuota &cgroupCpuQuota = compInfo->getCgroupCpuQuota();
+   if (!initialized)
+      {
+      initialized = true;
+      cgroupCpuQuota.init(compInfo->getJITConfig());
+      if (TR::Options::isAnyVerboseOptionSet(TR_VerbosePerformance, TR_VerboseCompilationThreads))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "t=%6u cgroup CPU quota %s: %d%%",
+            (uint32_t)crtTime, cgroupCpuQuota.isFunctional() ? "detected" : "not available", cgroupCpuQuota.getQuotaCpuPercent());
+      }
+
+   int32_t oldLimit = compInfo->getCgroupCompThreadLimit();
+   bool wasThrottled = compInfo->isCgroupCpuThrottled();
+   int32_t newLimit = 0;
+   bool throttled = false;
+   if (cgroupCpuQuota.isFunctional() && cgroupCpuQuota.update() && cgroupCpuQuota.hasQuota())
+      {
+      int32_t maxLimit = cgroupCpuQuota.getQuotaCpuPercent() * TR::Options::_cgroupCompCpuQuotaPercent / 10000;
+      if (maxLimit < 1)
+         maxLimit = 1;
+      newLimit = (oldLimit > 0 && oldLimit < maxLimit) ? oldLimit : maxLimit;
+
+      throttled = cgroupCpuQuota.getThrottledPeriodsPercent() > CGROUP_THROTTLED_PERIODS_THRESHOLD;
+      if (throttled)
+         {
+         numUnthrottledIntervals = 0;
+         int32_t numActive = compInfo->getNumCompThreadsActive();
+         newLimit = (numActive < newLimit ? numActive : newLimit) - 1;
+         if (newLimit < 1)
+            newLimit = 1;
+         }
+      else if (++numUnthrottledIntervals >= CGROUP_UNTHROTTLED_INTERVALS_TO_RAISE_LIMIT)
+         {
+         numUnthrottledIntervals = 0;
+         if (newLimit < maxLimit)
+            newLimit++;
+         }
+      }
+   compInfo->setCgroupCompThreadLimit(newLimit);
+   compInfo->setCgroupCpuThrottled(throttled);
+
+   if ((newLimit != oldLimit || throttled != wasThrottled) &&
+       TR::Options::isAnyVerboseOptionSet(TR_VerbosePerformance, TR_VerboseCompilationThreads))
+      {
+      TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "t=%6u cgroup CPU quota=%d%% throttledPeriods=%d%% throttledTime=%llu us: compilation thread limit %d -> %d, downgrading %s",
+         (uint32_t)crtTime,
+         cgroupCpuQuota.getQuotaCpuPercent(),
+         cgroupCpuQuota.getThrottledPeriodsPercent(),
+         (unsigned long long)cgroupCpuQuota.getThrottledUsInLastInterval(),
+         oldLimit, newLimit,
+         throttled ? "ON" : "OFF");
+      }
+   }
+
 /// When many classes are loaded per second (like in Websphere startup)
 /// we would like to decrease the initial level of compilation from warm to cold
 /// The following fragment of code uses a heuristic to detect when we are
@@ -6934,6 +7017,13 @@ static int32_t J9THREAD_PROC samplerThreadProc(void * entryarg)
                CalculateOverallCompCPUUtilization(compInfo, crtTime, samplerThread);
                }
 
+            if (TR::Options::_cgroupCompCpuQuotaPercent > 0
+#if defined(J9VM_OPT_JITSERVER)
+                && persistentInfo->getRemoteCompilationMode() != JITServer::SERVER
+#endif /* defined(J9VM_OPT_JITSERVER) */
+               )
+               cgroupCpuQuotaLogic(compInfo, crtTime);
+
 #if defined(J9VM_OPT_JITSERVER)
 #if defined(LINUX)
             static uint64_t lastMallocTrimTime = 0;
@@ -30,6 +30,7 @@
 #include "control/RecompilationInfo.hpp"
 #include "control/CompilationController.hpp"
 #include "env/IO.hpp"
+#include "env/PersistedCompilationPlan.hpp"
 #include "env/TRMemory.hpp"
 #include "env/VerboseLog.hpp"
 #include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
@@ -65,7 +66,18 @@ void J9::CompilationStrategy::shutdown()
 TR_Hotness J9::CompilationStrategy::getInitialOptLevel(J9Method *j9method)
    {
    J9ROMMethod *romMethod = J9_ROM_METHOD_FROM_RAM_METHOD(j9method);
-   return TR::Options::getInitialHotnessLevel(J9ROMMETHOD_HAS_BACKWARDS_BRANCHES(romMethod) ? true : false);
+   TR_Hotness hotnessLevel = TR::Options::getInitialHotnessLevel(J9ROMMETHOD_HAS_BACKWARDS_BRANCHES(romMethod) ? true : false);
+
+   // Methods in the persisted compilation plan start directly at the opt level
+   // they reached in the run that stored the plan. Profiling and scorching
+   // compilations are left to the regular recompilation mechanisms.
+   if (auto compilationPlan = TR::CompilationController::getCompilationInfo()->getPersistentInfo()->getPersistedCompilationPlan())
+      {
+      TR_Hotness plannedLevel = compilationPlan->getPlannedOptLevel(romMethod);
+      if (plannedLevel != unknownHotness && plannedLevel > hotnessLevel)
+         hotnessLevel = plannedLevel > hot ? hot : plannedLevel;
+      }
+   return hotnessLevel;
    }
 
 
@@ -47,6 +47,7 @@
 #include "infra/SimpleRegex.hpp"
 #include "control/CompilationRuntime.hpp"
 #include "control/CompilationThread.hpp"
+#include "runtime/CodeCacheManager.hpp"
 #include "runtime/IProfiler.hpp"
 #if defined(J9VM_OPT_JITSERVER)
 #include "env/j9methodServer.hpp"
@@ -138,11 +139,14 @@ int32_t J9::Options::_highActiveThreadThreshold = -1;
 int32_t J9::Options::_veryHighActiveThreadThreshold = -1;
 int32_t J9::Options::_aotCachePersistenceMinDeltaMethods = 200;
 int32_t J9::Options::_aotCachePersistenceMinPeriodMs = 10000; // ms
+int32_t J9::Options::_aotCachePeerSyncPeriodMs = 5000; // ms
+int32_t J9::Options::_jitserverRebalancePeriodMs = 30000; // ms
 int32_t J9::Options::_jitserverMallocTrimInterval = 1000 * 30; // 30000ms = 30s
 int32_t J9::Options::_lowCompDensityModeEnterThreshold = 4; // Maximum number of compilations per 10 min of CPU required to enter low compilation density mode. Use 0 to disable feature
 int32_t J9::Options::_lowCompDensityModeExitThreshold = 15; // Minimum number of compilations per 10 min of CPU required to exit low compilation density mode
 int32_t J9::Options::_lowCompDensityModeExitLPQSize = 120;  // Minimum number of compilations in LPQ to take us out of low compilation density mode
 bool J9::Options::_aotCacheDisableGeneratedClassSupport = false;
+bool J9::Options::_enableJITServerPrefetch = false;
 TR::CompilationFilters *J9::Options::_JITServerAOTCacheStoreFilters = NULL;
 TR::CompilationFilters *J9::Options::_JITServerAOTCacheLoadFilters = NULL;
 TR::CompilationFilters *J9::Options::_JITServerRemoteExcludeFilters = NULL;
@@ -170,6 +174,7 @@ int32_t J9::Options::_iprofilerReactivateThreshold=10;
 int32_t J9::Options::_iprofilerIntToTotalSampleRatio=2;
 int32_t J9::Options::_iprofilerSamplesBeforeTurningOff = 1000000; // samples
 int32_t J9::Options::_iprofilerNumOutstandingBuffers = 10;
+int32_t J9::Options::_iprofilerNumParserThreads = 1;
 int32_t J9::Options::_iprofilerBufferMaxPercentageToDiscard = 0;
 int32_t J9::Options::_iProfilerBufferInterarrivalTimeToExitDeepIdle = 5000; // 5 seconds
 int32_t J9::Options::_iprofilerBufferSize = 1024;
@@ -197,6 +202,13 @@ int32_t J9::Options::_compYieldStatsThreshold = 1000; // usec
 int32_t J9::Options::_compYieldStatsHeartbeatPeriod = 0; // ms
 int32_t J9::Options::_numberOfUserClassesLoaded = 0;
 int32_t J9::Options::_compPriorityQSZThreshold = 200;
+int32_t J9::Options::_compQueueAgingThresholdMs = 0; // 0 means disabled
+int32_t J9::Options::_hotCodeCacheMinFreeKB = 0; // 0 means no code cache is designated for hot bodies
+int32_t J9::Options::_codeCacheHugePageMode = 0; // auto: explicit large pages if configured, THP hint otherwise
+int32_t J9::Options::_aotLoadBurstThreshold = 0; // 0 means AOT loads don't influence comp thread activation
+int32_t J9::Options::_persistedCompilationPlanMaxEntries = 0; // 0 means no compilation plan is recorded or replayed
+int32_t J9::Options::_cgroupCompCpuQuotaPercent = 0; // 0 means compilation threads are not controlled by the cgroup CPU quota
+int32_t J9::Options::_compAdmissionTimeBudgetMs = 0; // 0 means no admission control for compilations
 int32_t J9::Options::_numQueuedInvReqToDowngradeOptLevel = 20; // If more than 20 inv req are queued we compiled them at cold
 int32_t J9::Options::_qszThresholdToDowngradeOptLevel = -1; // not yet set
 int32_t J9::Options::_qsziThresholdToDowngradeDuringCLP = 0; // -1 or 0 disables the feature and reverts to old behavior
@@ -424,8 +436,14 @@ J9::ExternalOptionsMetadata J9::Options::_externalOptionsMetadata[J9::ExternalOp
    { "-XX:+TrackAOTDependencies",                   EXACT_MATCH,         -1, true  }, // = 77
    { "-XX:-TrackAOTDependencies",                   EXACT_MATCH,         -1, true  }, // = 78
    { "-XX:+JITServerUseProfileCache",               EXACT_MATCH,         -1, true  }, // = 79
-   { "-XX:-JITServerUseProfileCache",               EXACT_MATCH,         -1, true  }  // = 80
-   // TR_NumExternalOptions                                                              = 81
+   { "-XX:-JITServerUseProfileCache",               EXACT_MATCH,         -1, true  }, // = 80
+   { "-XX:+JITServerCompressMessages",              EXACT_MATCH,         -1, true  }, // = 81
+   { "-XX:-JITServerCompressMessages",              EXACT_MATCH,         -1, true  }, // = 82
+   { "-XX:+JITServerEventLoop",                     EXACT_MATCH,         -1, true  }, // = 83
+   { "-XX:-JITServerEventLoop",                     EXACT_MATCH,         -1, true  }, // = 84
+   { "-XX:JITServerAOTCachePeers=",                 STARTSWITH_MATCH,    -1, true  }, // = 85
+   { "-XX:JITServerAlternateAddresses=",            STARTSWITH_MATCH,    -1, true  }  // = 86
+   // TR_NumExternalOptions                                                              = 87
    };
 
 //************************************************************************
@@ -866,6 +884,17 @@ Options::resetJitConfigRuntimeFlag(const char *option, void *base, TR::OptionTab
    return option;
    }
 
+const char *
+Options::codeCacheHugePageModeOption(const char *option, void *base, TR::OptionTable *entry)
+   {
+   int32_t mode = (int32_t)TR::Options::getNumericValue(option);
+   // Returning NULL reports an error for this option
+   if (mode < J9::CodeCacheManager::HUGE_PAGES_AUTO || mode > J9::CodeCacheManager::HUGE_PAGES_NONE)
+      return 0;
+   *((int32_t *)entry->parm1) = mode;
+   return option;
+   }
+
 const char *
 Options::setJitConfigNumericValue(const char *option, void *base, TR::OptionTable *entry)
    {
@@ -892,7 +921,13 @@ TR::OptionTable OMR::Options::_feOptions[] = {
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_aotCachePersistenceMinDeltaMethods, 0, "F%d", NOT_IN_SUBSET },
    {"aotCachePersistenceMinPeriodMs=", "M<nnn>\tmiminum time between two consecutive JITServer AOT cache save operations (ms)",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_aotCachePersistenceMinPeriodMs, 0, "F%d", NOT_IN_SUBSET },
+   {"aotCachePeerSyncPeriodMs=", "M<nnn>\tminimum time between two consecutive attempts to pull new JITServer AOT cache entries from peers (ms)",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_aotCachePeerSyncPeriodMs, 0, "F%d", NOT_IN_SUBSET },
 #endif /* defined(J9VM_OPT_JITSERVER) */
+   {"aotLoadBurstThreshold=", "M<nnn>\tactivate another compilation thread when more than this many AOT loads "
+                              "are queued per active compilation thread, and prefetch the next queued AOT body from "
+                              "the shared class cache while relocating the current one. Default is 0 which means don't do it.",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_aotLoadBurstThreshold, 0, "F%d", NOT_IN_SUBSET},
    {"aotMethodCompilesThreshold=", "R<nnn>\tIf this many AOT methods are compiled before exceeding aotMethodThreshold, don't stop AOT compiling",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_aotMethodCompilesThreshold, 0, "F%d", NOT_IN_SUBSET},
    {"aotMethodThreshold=", "R<nnn>\tNumber of methods found in shared cache after which we stop AOTing",
@@ -908,6 +943,10 @@ TR::OptionTable OMR::Options::_feOptions[] = {
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_countForLoopyBootstrapMethods, 250, "F%d", NOT_IN_SUBSET },
    {"bigAppSampleThresholdAdjust=", "O\tadjust the hot and scorching threshold for certain 'big' apps",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_bigAppSampleThresholdAdjust, 0, "F%d", NOT_IN_SUBSET},
+   {"cgroupCompCpuQuotaPercent=", "M<nnn>\tmaximum share of the cgroup CPU quota, as a percentage, that compilation "
+                                  "threads may use; the number of active compilation threads is adapted to it and to "
+                                  "the throttling of the cgroup. 0 (default) disables the controller",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_cgroupCompCpuQuotaPercent, 0, "F%d", NOT_IN_SUBSET},
    {"classLoadPhaseInterval=", "O<nnn>\tnumber of sampling ticks before we run "
                                "again the code for a class loading phase detection",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_classLoadingPhaseInterval, 0, "P%d", NOT_IN_SUBSET},
@@ -925,10 +964,18 @@ TR::OptionTable OMR::Options::_feOptions[] = {
    {"clinit",             "D\tforce compilation of <clinit> methods", SET_JITCONFIG_RUNTIME_FLAG(J9JIT_COMPILE_CLINIT) },
    {"code=",              "C<nnn>\tcode cache size, in KB",
         TR::Options::setJitConfigNumericValue, offsetof(J9JITConfig, codeCacheKB), 0, "F%d (KB)"},
+   {"codeCacheHugePageMode=", "M<nnn>\thow code cache segments are backed by huge pages: 0 = explicit large pages if "
+                              "available, THP hint otherwise (default); 1 = THP only, with THP aligned segments; "
+                              "2 = explicit large pages only; 3 = default size pages only",
+        TR::Options::codeCacheHugePageModeOption, (intptr_t)&TR::Options::_codeCacheHugePageMode, 0, "F%d", NOT_IN_SUBSET},
    {"codepad=",              "C<nnn>\ttotal code cache pad size, in KB",
         TR::Options::setJitConfigNumericValue, offsetof(J9JITConfig, codeCachePadKB), 0, "F%d (KB)"},
    {"codetotal=",              "C<nnn>\ttotal code memory limit, in KB",
         TR::Options::setJitConfigNumericValue, offsetof(J9JITConfig, codeCacheTotalKB), 0, "F%d (KB)"},
+   {"compAdmissionTimeBudgetMs=", "M<nnn>\tper-thread budget for the estimated duration of a compilation, in ms. "
+                                  "Requests estimated to exceed it are deferred in favor of cheaper ones and downgraded if "
+                                  "far over budget or if their estimated scratch memory is not available. Default is 0 which means don't do it.",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_compAdmissionTimeBudgetMs, 0, "F%d", NOT_IN_SUBSET},
    {"compilationBudget=",      "O<nnn>\tnumber of usec. Used to better interleave compilation"
                                "with computation. Use 80000 as a starting point",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_compilationBudget, 0, "P%d", NOT_IN_SUBSET},
@@ -950,6 +997,9 @@ TR::OptionTable OMR::Options::_feOptions[] = {
    {"compilationYieldStatsThreshold=", "M<nnn>\tprint stats about compilation yield points if the "
                                        "threshold is exceeded. Default 1000 usec. ",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_compYieldStatsThreshold, 0, "F%d", NOT_IN_SUBSET},
+   {"compQueueAgingThresholdMs=", "M<nnn>\tasync compilation requests waiting in the queue for longer than this many ms "
+                                  "have their priority raised by one level. Default is 0 which means don't do it.",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_compQueueAgingThresholdMs, 0, "F%d", NOT_IN_SUBSET},
    {"compThreadPriority=",    "M<nnn>\tThe priority of the compilation thread. "
                               "Use an integer between 0 and 4. Default is 4 (highest priority)",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_compilationThreadPriorityCode, 0, "F%d", NOT_IN_SUBSET},
@@ -978,6 +1028,10 @@ TR::OptionTable OMR::Options::_feOptions[] = {
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_disableIProfilerClassUnloadThreshold, 0, "F%d", NOT_IN_SUBSET},
    {"dltPostponeThreshold=",      "M<nnn>\tNumber of dlt attempts inv. count for a method is seen not advancing",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_dltPostponeThreshold, 0, "F%d", NOT_IN_SUBSET },
+#if defined(J9VM_OPT_JITSERVER)
+   {"enableJITServerPrefetch", " \tJITServer: fetch the fields, statics and classes referenced by the bytecodes of a method in one message",
+        TR::Options::setStaticBool, (intptr_t)&TR::Options::_enableJITServerPrefetch, 1, "F%d", NOT_IN_SUBSET },
+#endif /* defined(J9VM_OPT_JITSERVER) */
    {"exclude=",           "D<xxx>\tdo not compile methods beginning with xxx", TR::Options::limitOption, 1, 0, "P%s"},
    {"expensiveCompWeight=", "M<nnn>\tweight of a comp request to be considered expensive",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_expensiveCompWeight, 0, "F%d", NOT_IN_SUBSET },
@@ -996,6 +1050,10 @@ TR::OptionTable OMR::Options::_feOptions[] = {
    {"highActiveThreadThreshold=", " \tDefines what is a high Threshold for active compilations",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_highActiveThreadThreshold, 0, "F%d"},
 #endif /* defined(J9VM_OPT_JITSERVER) */
+   {"hotCodeCacheMinFreeKB=", "M<nnn>\tplace hot and scorching method bodies into one designated code cache "
+                              "which is replaced once its contiguous free space drops below this many KB. "
+                              "Default is 0 which means hot bodies go wherever the next code cache reservation lands.",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_hotCodeCacheMinFreeKB, 0, "F%d", NOT_IN_SUBSET},
    {"HWProfilerAOTWarmOptLevelThreshold=", "O<nnn>\tAOT Warm Opt Level Threshold",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_hwprofilerAOTWarmOptLevelThreshold, 0, "F%d", NOT_IN_SUBSET},
    {"HWProfilerBufferMaxPercentageToDiscard=", "O<nnn>\tpercentage of HW profiling buffers "
@@ -1090,6 +1148,9 @@ TR::OptionTable OMR::Options::_feOptions[] = {
    {"iprofilerNumOutstandingBuffers=", "O<nnn>\tnumber of outstanding interpreter profiling buffers "
                                        "allowed in the system. Specify 0 to disable this optimization",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_iprofilerNumOutstandingBuffers, 0, "F%d", NOT_IN_SUBSET},
+   {"iprofilerNumParserThreads=", "O<nnn>\tnumber of threads parsing interpreter profiling buffers "
+                                  "handed over by application threads, including the IProfiler thread",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_iprofilerNumParserThreads, 0, "F%d", NOT_IN_SUBSET},
    {"iprofilerOffDivisionFactor=", "O<nnn>\tCounts Division factor when IProfiler is Off",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_IprofilerOffDivisionFactor, 0, "F%d", NOT_IN_SUBSET},
    {"iprofilerOffSubtractionFactor=", "O<nnn>\tCounts Subtraction factor when IProfiler is Off",
@@ -1109,6 +1170,8 @@ TR::OptionTable OMR::Options::_feOptions[] = {
         TR::Options::JITServerAOTCacheStoreLimitOption, 1, 0, "P%s"},
    {"jitserverMallocTrimInterval=", "M<nnn>\tmiminum time between two consecutive JITServer client malloc_trim invocations (ms)",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_jitserverMallocTrimInterval, 0, "F%d", NOT_IN_SUBSET },
+   {"jitserverRebalancePeriodMs=", "M<nnn>\tminimum time a JITServer client stays with the selected server before considering a less loaded alternate server (ms)",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_jitserverRebalancePeriodMs, 0, "F%d", NOT_IN_SUBSET },
 #endif /* defined(J9VM_OPT_JITSERVER) */
    {"jProfilingEnablementSampleThreshold=", "M<nnn>\tNumber of global samples to allow generation of JProfiling bodies",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_jProfilingEnablementSampleThreshold, 0, "F%d", NOT_IN_SUBSET },
@@ -1168,6 +1231,9 @@ TR::OptionTable OMR::Options::_feOptions[] = {
    {"oldAgeUnderLowMemory=", " \tDefines what an old JITServer cache entry means when memory is low",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_oldAgeUnderLowMemory,  0, "F%d" },
 #endif /* defined(J9VM_OPT_JITSERVER) */
+   {"persistedCompilationPlanMaxEntries=", "M<nnn>\tRecord up to <nnn> methods compiled at warm or above in the shared class cache "
+                                           "and compile them early in subsequent runs",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_persistedCompilationPlanMaxEntries, 0, "F%d", NOT_IN_SUBSET},
    {"profileAllTheTime=",    "R<nnn>\tInterpreter profiling will be on all the time",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_profileAllTheTime, 0, "F%d", NOT_IN_SUBSET},
    {"queuedInvReqThresholdToDowngradeOptLevel=", "M<nnn>\tDowngrade opt level if too many inv req",
@@ -1403,6 +1469,8 @@ J9::Options::JITServerParseCommonOptions(J9VMInitArgs *vmArgsArray, J9JavaVM *vm
    int32_t xxJITServerLogConnectionsArgIndex = getArgIndex(vm, J9::ExternalOptions::XXplusJITServerLogConnections, vmArgsArray, postRestore);
    int32_t xxDisableJITServerLogConnectionsArgIndex = getArgIndex(vm, J9::ExternalOptions::XXminusJITServerLogConnections, vmArgsArray, postRestore);
    int32_t xxJITServerAOTmxArgIndex = getArgIndex(vm, J9::ExternalOptions::XXJITServerAOTmxOption, vmArgsArray, postRestore);
+   int32_t xxJITServerCompressMessagesArgIndex = getArgIndex(vm, J9::ExternalOptions::XXplusJITServerCompressMessages, vmArgsArray, postRestore);
+   int32_t xxDisableJITServerCompressMessagesArgIndex = getArgIndex(vm, J9::ExternalOptions::XXminusJITServerCompressMessages, vmArgsArray, postRestore);
 
    if (xxJITServerPortArgIndex >= 0)
       {
@@ -1478,6 +1546,13 @@ J9::Options::JITServerParseCommonOptions(J9VMInitArgs *vmArgsArray, J9JavaVM *vm
       TR::Options::setVerboseOption(TR_VerboseJITServerConns);
       }
 
+   // At the client this requests compressed messages from the server; at the server it allows
+   // compression for clients that request it. Message compression is disabled by default.
+   if (xxJITServerCompressMessagesArgIndex > xxDisableJITServerCompressMessagesArgIndex)
+      compInfo->getPersistentInfo()->setJITServerUseMessageCompression(true);
+   else if (xxDisableJITServerCompressMessagesArgIndex > xxJITServerCompressMessagesArgIndex)
+      compInfo->getPersistentInfo()->setJITServerUseMessageCompression(false);
+
    if (xxJITServerAOTmxArgIndex >= 0)
       {
       uint32_t aotMaxBytes = 0;
@@ -2431,6 +2506,24 @@ bool J9::Options::preProcessJitServer(J9JavaVM *vm, J9JITConfig *jitConfig)
                compInfo->getPersistentInfo()->setJITServerAOTCacheDir(directory);
                }
             }
+
+         // Check if idle client connections should be watched by the listener thread
+         // instead of occupying a compilation thread until the next request arrives
+         int32_t xxJITServerEventLoopArgIndex = J9::Options::getExternalOptionIndex(J9::ExternalOptions::XXplusJITServerEventLoop);
+         int32_t xxDisableJITServerEventLoopArgIndex = J9::Options::getExternalOptionIndex(J9::ExternalOptions::XXminusJITServerEventLoop);
+         if (xxJITServerEventLoopArgIndex > xxDisableJITServerEventLoopArgIndex)
+            {
+            compInfo->getPersistentInfo()->setJITServerUseEventLoop(true);
+            }
+
+         // Get the list of peer servers to exchange AOT cache entries with, if any
+         int32_t xxJITServerAOTCachePeersArgIndex = J9::Options::getExternalOptionIndex(J9::ExternalOptions::XXJITServerAOTCachePeersOption);
+         if (xxJITServerAOTCachePeersArgIndex >= 0)
+            {
+            char *peers = NULL;
+            GET_OPTION_VALUE(xxJITServerAOTCachePeersArgIndex, '=', &peers);
+            compInfo->getPersistentInfo()->setJITServerAOTCachePeers(peers);
+            }
          }
       else // Client mode (possibly)
          {
@@ -2489,6 +2582,15 @@ bool J9::Options::preProcessJitServer(J9JavaVM *vm, J9JITConfig *jitConfig)
                compInfo->getPersistentInfo()->setJITServerAddress(address);
                }
 
+            int32_t xxJITServerAlternateAddressesArgIndex = J9::Options::getExternalOptionIndex(J9::ExternalOptions::XXJITServerAlternateAddressesOption);
+
+            if (xxJITServerAlternateAddressesArgIndex >= 0)
+               {
+               char *addresses = NULL;
+               GET_OPTION_VALUE(xxJITServerAlternateAddressesArgIndex, '=', &addresses);
+               compInfo->getPersistentInfo()->setJITServerAlternateAddresses(addresses);
+               }
+
             int32_t xxJITServerAOTCacheNameArgIndex = J9::Options::getExternalOptionIndex(J9::ExternalOptions::XXJITServerAOTCacheNameOption);
 
             if (xxJITServerAOTCacheNameArgIndex >= 0)
@@ -2853,6 +2955,9 @@ J9::Options::setupJITServerOptions()
          TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "JITServer Client Mode. Server address: %s port: %d. Connection Timeout %ums",
                persistentInfo->getJITServerAddress().c_str(), persistentInfo->getJITServerPort(),
                persistentInfo->getSocketTimeout());
+         if (!persistentInfo->getJITServerAlternateAddresses().empty())
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "JITServer alternate addresses: %s",
+                  persistentInfo->getJITServerAlternateAddresses().c_str());
          TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Identifier for current client JVM: %llu",
                (unsigned long long) compInfo->getPersistentInfo()->getClientUID());
          }
@@ -134,7 +134,13 @@ enum ExternalOptions
    XXminusTrackAOTDependencies                   = 78,
    XXplusJITServerUseProfileCache                = 79,
    XXminusJITServerUseProfileCache               = 80,
-   TR_NumExternalOptions                         = 81
+   XXplusJITServerCompressMessages               = 81,
+   XXminusJITServerCompressMessages              = 82,
+   XXplusJITServerEventLoop                      = 83,
+   XXminusJITServerEventLoop                     = 84,
+   XXJITServerAOTCachePeersOption                = 85,
+   XXJITServerAlternateAddressesOption           = 86,
+   TR_NumExternalOptions                         = 87
    };
 
 /**
@@ -320,6 +326,7 @@ class OMR_EXTENSIBLE Options : public OMR::OptionsConnector
    static int32_t _iprofilerIntToTotalSampleRatio;
    static int32_t _iprofilerSamplesBeforeTurningOff;
    static int32_t _iprofilerNumOutstandingBuffers;
+   static int32_t _iprofilerNumParserThreads;
    static int32_t _iprofilerBufferMaxPercentageToDiscard;
    static int32_t _iProfilerBufferInterarrivalTimeToExitDeepIdle; // ms
    static int32_t _iprofilerBufferSize; //iprofilerbuffer size in kb
@@ -398,6 +405,13 @@ class OMR_EXTENSIBLE Options : public OMR::OptionsConnector
    static int32_t _cpuUtilThresholdForStarvation;
    static int32_t _qszLimit; // maximum size of the compilation queue
    static int32_t _compPriorityQSZThreshold;
+   static int32_t _compQueueAgingThresholdMs;
+   static int32_t _hotCodeCacheMinFreeKB; // if > 0, hot bodies are steered into a designated code cache
+   static int32_t _codeCacheHugePageMode; // one of J9::CodeCacheManager::HugePageMode
+   static int32_t _aotLoadBurstThreshold; // if > 0, queued AOT loads per active comp thread that trigger activation of another one
+   static int32_t _persistedCompilationPlanMaxEntries; // if > 0, warm/hot compilations are recorded in the SCC and replayed at next startup
+   static int32_t _cgroupCompCpuQuotaPercent; // if > 0, share of the cgroup CPU quota that compilation threads may use
+   static int32_t _compAdmissionTimeBudgetMs; // if > 0, compilations estimated to take longer are deferred or downgraded
    static int32_t _GCRQueuedThresholdForCounting; // if too many GCR are queued we stop counting
    static int32_t _minimumSuperclassArraySize; //size of the minimum superclass array
 
@@ -420,11 +434,14 @@ class OMR_EXTENSIBLE Options : public OMR::OptionsConnector
    static const uint32_t DEFAULT_JITSERVER_TIMEOUT = 30000; // ms
    static int32_t _aotCachePersistenceMinDeltaMethods;
    static int32_t _aotCachePersistenceMinPeriodMs;
+   static int32_t _aotCachePeerSyncPeriodMs;
+   static int32_t _jitserverRebalancePeriodMs;
    static int32_t _jitserverMallocTrimInterval;
    static int32_t _lowCompDensityModeEnterThreshold;
    static int32_t _lowCompDensityModeExitThreshold;
    static int32_t _lowCompDensityModeExitLPQSize;
    static bool _aotCacheDisableGeneratedClassSupport;
+   static bool _enableJITServerPrefetch;
    static TR::CompilationFilters *_JITServerAOTCacheStoreFilters;
    static TR::CompilationFilters *_JITServerAOTCacheLoadFilters;
    static TR::CompilationFilters *_JITServerRemoteExcludeFilters;
@@ -563,6 +580,7 @@ class OMR_EXTENSIBLE Options : public OMR::OptionsConnector
    static const char *setJitConfigRuntimeFlag(const char *option, void *base, TR::OptionTable *entry);
    static const char *resetJitConfigRuntimeFlag(const char *option, void *base, TR::OptionTable *entry);
    static const char *setJitConfigNumericValue(const char *option, void *base, TR::OptionTable *entry);
+   static const char *codeCacheHugePageModeOption(const char *option, void *base, TR::OptionTable *entry);
 
    static bool useCompressedPointers();
    static const char *limitOption(const char *option, void *, TR::OptionTable *entry);
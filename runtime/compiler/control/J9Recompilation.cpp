@@ -590,7 +590,9 @@ TR_PersistentMethodInfo::TR_PersistentMethodInfo(TR::Compilation *comp) :
    _catchBlockCounter(0),
    _numberOfPreexistenceInvalidations(0),
    _numberOfInlinedMethodRedefinition(0),
-   _numPrexAssumptions(0)
+   _numPrexAssumptions(0),
+   _compTimeFactor(0),
+   _compMemoryFactor(0)
    {
    if (comp->getOption(TR_EnableHCR) && !comp->fej9()->isAOT_DEPRECATED_DO_NOT_USE())
       {
@@ -621,7 +623,9 @@ TR_PersistentMethodInfo::TR_PersistentMethodInfo(TR_OpaqueMethodBlock *methodInf
    _catchBlockCounter(0),
    _numberOfPreexistenceInvalidations(0),
    _numberOfInlinedMethodRedefinition(0),
-   _numPrexAssumptions(0)
+   _numPrexAssumptions(0),
+   _compTimeFactor(0),
+   _compMemoryFactor(0)
    {
    }
 
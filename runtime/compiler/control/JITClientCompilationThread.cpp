@@ -1898,6 +1898,55 @@ handleServerMessage(JITServer::ClientStream *client, TR_J9VM *fe, JITServer::Mes
          client->write(response, ramMethods, vTableOffsets, methodInfos, unresolvedInCPs);
          }
          break;
+      case MessageType::ResolvedMethod_getBytecodeManifestData:
+         {
+         auto recv = client->getRecvData<TR_ResolvedJ9Method *, std::vector<int32_t>, std::vector<uint8_t>, std::vector<int32_t>>();
+         TR_ResolvedJ9Method *method = std::get<0>(recv);
+         auto &fieldCPIndices = std::get<1>(recv);
+         auto &fieldFlags = std::get<2>(recv);
+         auto &classCPIndices = std::get<3>(recv);
+
+         // Answer every field/static reference like VM_getFields and
+         // ResolvedMethod_fieldAttributes/ResolvedMethod_staticAttributes would
+         int32_t numFields = fieldCPIndices.size();
+         std::vector<J9Class *> declaringClasses(numFields);
+         std::vector<UDATA> fields(numFields);
+         std::vector<TR_J9MethodFieldAttributes> attributes(numFields);
+         J9ConstantPool *cp = reinterpret_cast<J9ConstantPool *>(method->ramConstantPool());
+         for (int32_t i = 0; i < numFields; ++i)
+            {
+            int32_t cpIndex = fieldCPIndices[i];
+            bool isStatic = (fieldFlags[i] & TR_ResolvedJ9JITServerMethod::MANIFEST_FIELD_IS_STATIC) != 0;
+            bool isStore = (fieldFlags[i] & TR_ResolvedJ9JITServerMethod::MANIFEST_FIELD_IS_STORE) != 0;
+            fields[i] = findField(fe->vmThread(), cp, cpIndex, isStatic, &declaringClasses[i]);
+
+            TR::DataType type = TR::NoType;
+            bool volatileP = true;
+            bool isFinal = false;
+            bool isPrivate = false;
+            bool unresolvedInCP;
+            if (isStatic)
+               {
+               void *address;
+               bool result = method->staticAttributes(comp, cpIndex, &address, &type, &volatileP, &isFinal, &isPrivate, isStore, &unresolvedInCP, false);
+               attributes[i] = TR_J9MethodFieldAttributes(reinterpret_cast<uintptr_t>(address), type.getDataType(), volatileP, isFinal, isPrivate, unresolvedInCP, result);
+               }
+            else
+               {
+               U_32 fieldOffset;
+               bool result = method->fieldAttributes(comp, cpIndex, &fieldOffset, &type, &volatileP, &isFinal, &isPrivate, isStore, &unresolvedInCP, false);
+               attributes[i] = TR_J9MethodFieldAttributes(static_cast<uintptr_t>(fieldOffset), type.getDataType(), volatileP, isFinal, isPrivate, unresolvedInCP, result);
+               }
+            }
+
+         // Answer every class reference like ResolvedMethod_getClassFromConstantPool would
+         std::vector<TR_OpaqueClassBlock *> classes(classCPIndices.size());
+         for (size_t i = 0; i < classCPIndices.size(); ++i)
+            classes[i] = method->getClassFromConstantPool(comp, classCPIndices[i]);
+
+         client->write(response, declaringClasses, fields, attributes, classes);
+         }
+         break;
       case MessageType::ResolvedMethod_getConstantDynamicTypeFromCP:
          {
          auto recv = client->getRecvData<TR_ResolvedJ9Method *, int32_t>();
@@ -3332,13 +3381,35 @@ remoteCompile(J9VMThread *vmThread, TR::Compilation *compiler, TR_ResolvedMethod
    // For JitDump recompilations need to use the same stream as for the original compile
    JITServer::ClientStream *client = (enableJITServerPerCompConn && !details.isJitDumpMethod()) ? NULL
                                      : compInfoPT->getClientStream();
+   // With alternate servers configured, the client may have moved to another server since
+   // this stream was opened, because its server failed or became much more loaded than another one
+   if (client && !details.isJitDumpMethod() && !client->isConnectedToSelectedEndpoint(persistentInfo))
+      {
+      try
+         {
+         client->writeError(JITServer::MessageType::connectionTerminate, 0 /* placeholder */);
+         }
+      catch (const JITServer::StreamFailure &e)
+         {
+         if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "JITServer StreamFailure when sending connectionTerminate: %s", e.what());
+         }
+      client->~ClientStream();
+      TR_Memory::jitPersistentFree(client);
+      compInfoPT->setClientStream(NULL);
+      client = NULL;
+      }
+   JITServer::ClientStream::terminateSessionAtAbandonedEndpoint(persistentInfo);
    if (!client)
       {
       try
          {
          if (JITServerHelpers::isServerAvailable())
             {
-            client = new (PERSISTENT_NEW) JITServer::ClientStream(persistentInfo);
+            if (!enableJITServerPerCompConn)
+               client = JITServer::ClientStream::acquireFromPool(persistentInfo);
+            if (!client)
+               client = new (PERSISTENT_NEW) JITServer::ClientStream(persistentInfo);
             if (!enableJITServerPerCompConn)
                compInfoPT->setClientStream(client);
             }
@@ -3573,7 +3644,7 @@ remoteCompile(J9VMThread *vmThread, TR::Compilation *compiler, TR_ResolvedMethod
          auto recv = client->getRecvData<
             std::string, std::string, CHTableCommitData, std::vector<TR_OpaqueClassBlock*>, std::string,
             std::vector<TR_ResolvedJ9Method*>, TR_OptimizationPlan, std::vector<SerializedRuntimeAssumption>,
-            JITServer::ServerMemoryState, JITServer::ServerActiveThreadsState, std::vector<TR_OpaqueMethodBlock *>
+            JITServer::ServerMemoryState, JITServer::ServerActiveThreadsState, std::vector<TR_OpaqueMethodBlock *>, uint32_t
          >();
          statusCode = compilationOK;
          codeCacheStr = std::get<0>(recv);
@@ -3587,6 +3658,7 @@ remoteCompile(J9VMThread *vmThread, TR::Compilation *compiler, TR_ResolvedMethod
          JITServer::ServerMemoryState nextMemoryState = std::get<8>(recv);
          JITServer::ServerActiveThreadsState nextActiveThreadState = std::get<9>(recv);
          methodsRequiringTrampolines = std::get<10>(recv);
+         client->updateServerLoad(std::get<11>(recv));
 
          updateCompThreadActivationPolicy(compInfoPT, nextMemoryState, nextActiveThreadState);
 
@@ -3598,7 +3670,7 @@ remoteCompile(J9VMThread *vmThread, TR::Compilation *compiler, TR_ResolvedMethod
          auto recv = client->getRecvData<
             std::string, std::vector<std::string>, CHTableCommitData, std::vector<TR_OpaqueClassBlock*>, std::string,
             std::vector<TR_ResolvedJ9Method*>, TR_OptimizationPlan, std::vector<SerializedRuntimeAssumption>,
-            JITServer::ServerMemoryState, JITServer::ServerActiveThreadsState, std::vector<TR_OpaqueMethodBlock *>
+            JITServer::ServerMemoryState, JITServer::ServerActiveThreadsState, std::vector<TR_OpaqueMethodBlock *>, uint32_t
          >();
          auto &methodStr = std::get<0>(recv);
          auto &records = std::get<1>(recv);
@@ -3611,6 +3683,7 @@ remoteCompile(J9VMThread *vmThread, TR::Compilation *compiler, TR_ResolvedMethod
          JITServer::ServerMemoryState nextMemoryState = std::get<8>(recv);
          JITServer::ServerActiveThreadsState nextActiveThreadState = std::get<9>(recv);
          methodsRequiringTrampolines = std::get<10>(recv);
+         client->updateServerLoad(std::get<11>(recv));
 
          updateCompThreadActivationPolicy(compInfoPT, nextMemoryState, nextActiveThreadState);
 
@@ -3643,12 +3716,13 @@ remoteCompile(J9VMThread *vmThread, TR::Compilation *compiler, TR_ResolvedMethod
       else if (JITServer::MessageType::AOTCache_serializedAOTMethod == response)
          {
          auto recv = client->getRecvData<std::string, std::vector<std::string>, TR_OptimizationPlan,
-                                         JITServer::ServerMemoryState, JITServer::ServerActiveThreadsState>();
+                                         JITServer::ServerMemoryState, JITServer::ServerActiveThreadsState, uint32_t>();
          auto &methodStr = std::get<0>(recv);
          auto &records = std::get<1>(recv);
          modifiedOptPlan = std::get<2>(recv);
          JITServer::ServerMemoryState nextMemoryState = std::get<3>(recv);
          JITServer::ServerActiveThreadsState nextActiveThreadState = std::get<4>(recv);
+         client->updateServerLoad(std::get<5>(recv));
 
          updateCompThreadActivationPolicy(compInfoPT, nextMemoryState, nextActiveThreadState);
 
@@ -3810,6 +3884,9 @@ remoteCompile(J9VMThread *vmThread, TR::Compilation *compiler, TR_ResolvedMethod
       JITServerHelpers::postStreamFailure(OMRPORT_FROM_J9PORT(compInfoPT->getJitConfig()->javaVM->portLibrary), compInfo,
                                           e.retryConnectionImmediately(), false);
 
+      // Make the next compilation request go to another server, if there is one
+      JITServer::ClientStream::reportEndpointFailure(client->getEndpoint(), persistentInfo);
+
       if (!details.isJitDumpMethod())
          {
          client->~ClientStream();
@@ -41,6 +41,7 @@
 #include "runtime/CodeCache.hpp"
 #include "runtime/CodeCacheExceptions.hpp"
 #include "runtime/J9VMAccess.hpp"
+#include "runtime/MetricsServer.hpp"
 #include "runtime/RelocationTarget.hpp"
 
 #include "jitprotos.h"
@@ -111,6 +112,29 @@ computeServerActiveThreadsState(TR::CompilationInfo *compInfo)
    return activeThreadState;
    }
 
+/**
+ * @brief Helper method executed at the end of a compilation to summarize the load of the server
+ * in a single number that clients with alternate servers use to pick the least loaded one.
+ *
+ * The load is the number of active compilation threads plus queued requests, as a percentage
+ * of the "very high" active thread threshold. Running low on memory reports the server as heavily
+ * loaded regardless of the number of compilations, since it is about to reject requests.
+ */
+uint32_t
+computeServerLoad(TR::CompilationInfo *compInfo, JITServer::ServerMemoryState memoryState)
+   {
+   // As above, some imprecision is acceptable because this is a heuristic
+   int32_t numRequests = compInfo->getNumCompThreadsActive() + compInfo->getMethodQueueSize();
+   int32_t veryHighActiveThreadThreshold = std::max(TR::Options::getVeryHighActiveThreadThreshold(), 1);
+   uint32_t load = (uint32_t)std::max(numRequests, 0) * 100 / veryHighActiveThreadThreshold;
+
+   if (memoryState == JITServer::ServerMemoryState::VERY_LOW)
+      load = std::max(load, (uint32_t)100);
+   else if (memoryState == JITServer::ServerMemoryState::LOW)
+      load = std::max(load, (uint32_t)75);
+   return load;
+   }
+
 /**
  * @brief Method executed by JITServer to process the end of a compilation.
  */
@@ -165,6 +189,7 @@ outOfProcessCompilationEnd(TR_MethodToBeCompiled *entry, TR::Compilation *comp)
 
    JITServer::ServerMemoryState memoryState = computeServerMemoryState(compInfoPT->getCompilationInfo());
    JITServer::ServerActiveThreadsState activeThreadState = computeServerActiveThreadsState(compInfoPT->getCompilationInfo());
+   uint32_t serverLoad = computeServerLoad(compInfoPT->getCompilationInfo(), memoryState);
 
    // Send methods requring resolved trampolines in this compilation to the client
    std::vector<TR_OpaqueMethodBlock *> methodsRequiringTrampolines;
@@ -238,7 +263,8 @@ outOfProcessCompilationEnd(TR_MethodToBeCompiled *entry, TR::Compilation *comp)
          resolvedMirrorMethodsPersistIPInfo
             ? std::vector<TR_ResolvedJ9Method*>(resolvedMirrorMethodsPersistIPInfo->begin(), resolvedMirrorMethodsPersistIPInfo->end())
             : std::vector<TR_ResolvedJ9Method*>(),
-         *entry->_optimizationPlan, serializedRuntimeAssumptions, memoryState, activeThreadState, methodsRequiringTrampolines
+         *entry->_optimizationPlan, serializedRuntimeAssumptions, memoryState, activeThreadState, methodsRequiringTrampolines,
+         serverLoad
       );
       if (TR::Options::getVerboseOption(TR_VerboseJITServer))
          {
@@ -260,7 +286,8 @@ outOfProcessCompilationEnd(TR_MethodToBeCompiled *entry, TR::Compilation *comp)
          resolvedMirrorMethodsPersistIPInfo
             ? std::vector<TR_ResolvedJ9Method*>(resolvedMirrorMethodsPersistIPInfo->begin(), resolvedMirrorMethodsPersistIPInfo->end())
             : std::vector<TR_ResolvedJ9Method*>(),
-         *entry->_optimizationPlan, serializedRuntimeAssumptions, memoryState, activeThreadState, methodsRequiringTrampolines
+         *entry->_optimizationPlan, serializedRuntimeAssumptions, memoryState, activeThreadState, methodsRequiringTrampolines,
+         serverLoad
       );
       if (TR::Options::getVerboseOption(TR_VerboseJITServer))
          {
@@ -279,6 +306,10 @@ outOfProcessCompilationEnd(TR_MethodToBeCompiled *entry, TR::Compilation *comp)
       if (clientData->usesAOTCache())
          clientData->getAOTCache()->triggerAOTCacheStoreToFileIfNeeded();
       }
+
+   // Check whether we need to pull the methods added to this AOT cache by the peer servers
+   if (clientData->usesAOTCache() && compInfoPT->getCompilationInfo()->getJITServerAOTCacheMap()->hasPeers())
+      clientData->getAOTCache()->triggerPeerSyncIfNeeded();
    }
 
 TR::CompilationInfoPerThreadRemote::CompilationInfoPerThreadRemote(TR::CompilationInfo &compInfo, J9JITConfig *jitConfig, int32_t id, bool isDiagnosticThread)
@@ -544,10 +575,11 @@ TR::CompilationInfoPerThreadRemote::serveCachedAOTMethod(TR_MethodToBeCompiled &
       }
 
    //NOTE: Leaving optimization plan unchanged. This can be changed in the future.
+   JITServer::ServerMemoryState memoryState = computeServerMemoryState(getCompilationInfo());
    entry._stream->write(JITServer::MessageType::AOTCache_serializedAOTMethod,
                         std::string((const char *)&serializedMethod->data(), serializedMethod->data().size()),
-                        serializedRecords, *optPlan, computeServerMemoryState(getCompilationInfo()),
-                        computeServerActiveThreadsState(getCompilationInfo()));
+                        serializedRecords, *optPlan, memoryState, computeServerActiveThreadsState(getCompilationInfo()),
+                        computeServerLoad(getCompilationInfo(), memoryState));
    return true;
    }
 
@@ -1028,6 +1060,55 @@ TR::CompilationInfoPerThreadRemote::processAOTCacheMapRequest(const std::string&
    stream->write(JITServer::MessageType::AOTCacheMap_reply, methodSignaturesV);
    }
 
+/**
+ * @brief Private method that answers a request from a peer JITServer for a batch of AOT cache entries.
+ */
+void
+TR::CompilationInfoPerThreadRemote::processAOTCachePeerRequest(const std::string& aotCacheName,
+                                                               TR::CompilationInfo *compInfo,
+                                                               JITServer::ServerStream *stream,
+                                                               J9::J9SegmentProvider &scratchSegmentProvider)
+   {
+   static const size_t maxMethodsPerBatch = 1000;
+   uint64_t firstIndex = std::get<1>(stream->getRecvData<std::string, uint64_t>());
+
+   if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      {
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer,
+         "compThreadID=%d handling peer request for AOT cache %s methods starting at %llu",
+         getCompThreadId(), aotCacheName.c_str(), (unsigned long long)firstIndex);
+      }
+
+   std::string batch;
+   size_t numMethods = 0;
+   size_t numBatchMethods = 0;
+   // If the cache does not exist here, answer with an empty batch; the peer will ask again later.
+   // Peers must not create caches (or trigger loading them from file) that no local client uses.
+   if (auto aotCache = compInfo->getJITServerAOTCacheMap()->find(aotCacheName))
+      {
+      size_t segmentSize = scratchSegmentProvider.getPreferredSegmentSize();
+      if (!segmentSize)
+         segmentSize = 1 << 24/*16 MB*/;
+      TR::RawAllocator rawAllocator(compInfo->getJITConfig()->javaVM);
+      J9::SystemSegmentProvider segmentProvider(1 << 16/*64 KB*/, segmentSize, TR::Options::getScratchSpaceLimit(),
+                                                scratchSegmentProvider, rawAllocator);
+      TR::Region region(segmentProvider, rawAllocator);
+      TR_Memory trMemory(*compInfo->persistentMemory(), region);
+
+      batch = aotCache->serializeMethodsForPeer(firstIndex, maxMethodsPerBatch, numMethods, trMemory);
+      numBatchMethods = (firstIndex < numMethods) ? std::min(numMethods - (size_t)firstIndex, maxMethodsPerBatch) : 0;
+      }
+
+   if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      {
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer,
+         "Sending %zu of %zu AOT cache %s methods to peer in %zu bytes",
+         numBatchMethods, numMethods, aotCacheName.c_str(), batch.size());
+      }
+   stream->write(JITServer::MessageType::AOTCachePeer_reply, batch, (uint64_t)numBatchMethods, (uint64_t)numMethods,
+                 compInfo->getPersistentInfo()->getServerUID());
+   }
+
 /**
  * @brief Method executed by JITServer to process the compilation request.
  */
@@ -1048,16 +1129,19 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
    compInfo->setLastReqStartTime(compInfo->getPersistentInfo()->getElapsedTime());
 
 
-   if (stream == LOAD_AOTCACHE_REQUEST || stream == SAVE_AOTCACHE_REQUEST)
+   if (stream == LOAD_AOTCACHE_REQUEST || stream == SAVE_AOTCACHE_REQUEST || stream == SYNC_AOTCACHE_REQUEST)
       {
       // This is not a true compilation request, but rather a request to save/load an AOTCache to/from file
+      // or to pull new entries into an AOTCache from the peer servers
       compInfo->releaseCompMonitor(compThread);
       auto aotCacheMap = compInfo->getJITServerAOTCacheMap();
       TR_ASSERT(aotCacheMap, "aotCacheMap must exist if such a special request was issued");
       if (stream == LOAD_AOTCACHE_REQUEST)
          aotCacheMap->loadNextQueuedAOTCacheFromFile(scratchSegmentProvider);
-      else
+      else if (stream == SAVE_AOTCACHE_REQUEST)
          aotCacheMap->saveNextQueuedAOTCacheToFile();
+      else
+         aotCacheMap->syncNextQueuedAOTCacheWithPeers(scratchSegmentProvider);
 
       // We had the compilation monitor in hand when entering processEntry() and we must leave with it in hand
       compInfo->acquireCompMonitor(compThread);
@@ -1074,6 +1158,16 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
 
    _recompilationMethodInfo = NULL;
 
+   // Metrics are only collected when they can be exported
+   PORT_ACCESS_FROM_JITCONFIG(_jitConfig);
+   bool collectMetrics = compInfo->getPersistentInfo()->getJITServerMetricsPort() != 0;
+   if (collectMetrics)
+      CompilationMetrics::recordQueueWaitTime(j9time_usec_clock() - entry._entryTime);
+   uint64_t numBytesReceivedAtStart = stream->getNumBytesReceived();
+   uint64_t numBytesSentAtStart = stream->getNumBytesSent();
+   uint64_t numMessagesAfterRequest = 0;
+   uintptr_t requestReadTime = 0;
+
    // Release compMonitor before doing the blocking read
    compInfo->releaseCompMonitor(compThread);
 
@@ -1107,6 +1201,9 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
       std::string cacheName;
 
       auto messageType = stream->readCompileRequest(req, cacheName);
+      numMessagesAfterRequest = stream->getNumMessagesReceived();
+      if (collectMetrics)
+         requestReadTime = j9time_usec_clock();
 
       if (messageType == JITServer::MessageType::compilationRequest)
          {
@@ -1122,6 +1219,12 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
          abortCompilation = true;
          deleteStream = true;
          }
+      else if (messageType == JITServer::MessageType::AOTCachePeer_request)
+         {
+         processAOTCachePeerRequest(cacheName, compInfo, stream, scratchSegmentProvider);
+         abortCompilation = true;
+         deleteStream = true;
+         }
       else
          {
          TR_ASSERT_FATAL(false, "Unknown message type %d\n", messageType);
@@ -1360,6 +1463,13 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
    entry._newStartPC = startPC;
    // Update statistics regarding the compilation status (including compilationOK)
    compInfo->updateCompilationErrorStats((TR_CompilationErrorCode)entry._compErrCode);
+   // AOT cache hits are accounted for by the AOT cache metrics
+   if (collectMetrics && !aotCacheHit)
+      CompilationMetrics::recordCompilation(optPlan->getOptLevel(), j9time_usec_clock() - requestReadTime,
+                                            stream->getNumMessagesReceived() - numMessagesAfterRequest);
+   // The stream can be deleted below
+   uint64_t numBytesReceived = stream->getNumBytesReceived() - numBytesReceivedAtStart;
+   uint64_t numBytesSent = stream->getNumBytesSent() - numBytesSentAtStart;
 
    // Save the pointer to the plan before recycling the entry
    // Decrease the queue weight
@@ -1396,6 +1506,7 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
    // need to acquire the sequencing monitor when accessing numActiveThreads
    getClientData()->getSequencingMonitor()->enter();
    getClientData()->decNumActiveThreads();
+   getClientData()->addNetworkTraffic(numBytesReceived, numBytesSent);
    getClientData()->getSequencingMonitor()->exit();
    getClientData()->decInUse();  // We have the compMonitor so it's safe to access the inUse counter
    if (getClientData()->getInUse() == 0)
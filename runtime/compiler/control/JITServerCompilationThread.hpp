@@ -196,6 +196,11 @@ private:
                                   TR::CompilationInfo *compInfo,
                                   JITServer::ServerStream *stream);
 
+   void processAOTCachePeerRequest(const std::string& aotCacheName,
+                                   TR::CompilationInfo *compInfo,
+                                   JITServer::ServerStream *stream,
+                                   J9::J9SegmentProvider &scratchSegmentProvider);
+
    TR_PersistentMethodInfo *_recompilationMethodInfo;
    uint32_t _seqNo;
    uint32_t _expectedSeqNo; // this request is allowed to go if _expectedSeqNo is processed
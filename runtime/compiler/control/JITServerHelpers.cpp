@@ -41,6 +41,8 @@
 
 
 uint64_t     JITServerHelpers::_waitTimeMs = 0;
+uint32_t     JITServerHelpers::_numBytecodeManifests = 0;
+uint32_t     JITServerHelpers::_numPrefetchedQueries[] = {0};
 bool         JITServerHelpers::_serverAvailable = true;
 uint64_t     JITServerHelpers::_nextConnectionRetryTime = 0;
 TR::Monitor *JITServerHelpers::_clientStreamMonitor = NULL;
@@ -811,7 +813,7 @@ JITServerHelpers::printJITServerMsgStats(J9JITConfig *jitConfig, TR::Compilation
    j9tty_printf(PORTLIB, "JITServer Message Type Statistics:\n");
    j9tty_printf(PORTLIB, "Type# #called");
 #if defined(MESSAGE_SIZE_STATS)
-   j9tty_printf(PORTLIB, "\t\tMax\t\tMin\t\tMean\t\tStdDev\t\tSum");
+   j9tty_printf(PORTLIB, "\t\tMax\t\tMin\t\tMean\t\tStdDev\t\tSum\t\t#compressed\tWireSum");
 #endif /* defined(MESSAGE_SIZE_STATS) */
    j9tty_printf(PORTLIB, "\t\tTypeName\n");
 
@@ -823,8 +825,10 @@ JITServerHelpers::printJITServerMsgStats(J9JITConfig *jitConfig, TR::Compilation
          j9tty_printf(PORTLIB, "#%04d %7u", i, JITServer::CommunicationStream::_msgTypeCount[i]);
 #if defined(MESSAGE_SIZE_STATS)
          auto &stat = JITServer::CommunicationStream::_msgSizeStats[i];
-         j9tty_printf(PORTLIB, "\t%f\t%f\t%f\t%f\t%f",
-                      stat.maxVal(), stat.minVal(), stat.mean(), stat.stddev(), stat.sum());
+         auto &compressedStat = JITServer::CommunicationStream::_compressedMsgSizeStats[i];
+         j9tty_printf(PORTLIB, "\t%f\t%f\t%f\t%f\t%f\t%u\t\t%f",
+                      stat.maxVal(), stat.minVal(), stat.mean(), stat.stddev(), stat.sum(),
+                      compressedStat.samples(), compressedStat.sum());
 #endif /* defined(MESSAGE_SIZE_STATS) */
          j9tty_printf(PORTLIB, "\t\t%s\n", JITServer::messageNames[i]);
          totalMsgCount += JITServer::CommunicationStream::_msgTypeCount[i];
@@ -834,6 +838,32 @@ JITServerHelpers::printJITServerMsgStats(J9JITConfig *jitConfig, TR::Compilation
    j9tty_printf(PORTLIB, "Total number of messages: %llu\n", (unsigned long long)totalMsgCount);
    j9tty_printf(PORTLIB, "Total amount of data received: %llu bytes\n",
                 (unsigned long long)JITServer::CommunicationStream::_totalMsgSize);
+   if (JITServer::CommunicationStream::_numCompressedMsgs)
+      j9tty_printf(PORTLIB, "Compressed messages received: %u (%llu bytes on the wire, %llu bytes uncompressed)\n",
+                   JITServer::CommunicationStream::_numCompressedMsgs,
+                   (unsigned long long)JITServer::CommunicationStream::_totalCompressedMsgSize,
+                   (unsigned long long)JITServer::CommunicationStream::_totalUncompressedMsgSize);
+   if (JITServer::CommunicationStream::_numZeroCopyMsgs)
+      j9tty_printf(PORTLIB, "Messages sent with referenced payloads: %u (%llu payload bytes not copied)\n",
+                   JITServer::CommunicationStream::_numZeroCopyMsgs,
+                   (unsigned long long)JITServer::CommunicationStream::_totalZeroCopyBytes);
+
+   if (_numBytecodeManifests)
+      {
+      // Each manifest takes one round trip itself
+      uint64_t numPrefetchedQueries = 0;
+      j9tty_printf(PORTLIB, "Queries answered by %u bytecode manifests:\n", _numBytecodeManifests);
+      for (int i = 0; i < JITServer::MessageType_MAXTYPE; ++i)
+         {
+         if (_numPrefetchedQueries[i])
+            {
+            j9tty_printf(PORTLIB, "#%04d %7u\t\t%s\n", i, _numPrefetchedQueries[i], JITServer::messageNames[i]);
+            numPrefetchedQueries += _numPrefetchedQueries[i];
+            }
+         }
+      j9tty_printf(PORTLIB, "Round trips eliminated by bytecode manifests: %lld\n",
+                   (long long)numPrefetchedQueries - (long long)_numBytecodeManifests);
+      }
 
    uint32_t numCompilations = 0;
    uint32_t numDeserializedMethods = 0;
@@ -132,6 +132,11 @@ public:
    static bool isServerAvailable() { return _serverAvailable; }
 
    static void printJITServerMsgStats(J9JITConfig *, TR::CompilationInfo *);
+
+   // Number of bytecode manifests sent by the server (see TR_ResolvedJ9JITServerMethod::prefetchBytecodeManifest())
+   // and, per message type, the number of queries they answered in advance
+   static uint32_t _numBytecodeManifests;
+   static uint32_t _numPrefetchedQueries[JITServer::MessageType_MAXTYPE];
    static void printJITServerCHTableStats(J9JITConfig *, TR::CompilationInfo *);
    static void printJITServerCacheStats(J9JITConfig *, TR::CompilationInfo *);
 
@@ -63,6 +63,7 @@ void TR_MethodToBeCompiled::initialize(TR::IlGeneratorMethodDetails &details, vo
    if (_optimizationPlan)
       _optimizationPlan->setIsAotLoad(false);
    _entryTime = 0;
+   _timeQueued = 0;
    _compInfoPT = NULL;
    _aotCodeToBeRelocated = NULL;
 
@@ -85,6 +86,8 @@ void TR_MethodToBeCompiled::initialize(TR::IlGeneratorMethodDetails &details, vo
    _entryIsCountedAsInvRequest = false;
    _GCRrequest = false;
    _hasIncrementedNumCompThreadsCompilingHotterMethods = false;
+   _entryIsCountedAsAotLoad = false;
+   _numAdmissionDeferrals = 0;
 
    _weight = 0;
    _jitStateWhenQueued = UNDEFINED_STATE;
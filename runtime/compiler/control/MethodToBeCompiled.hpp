@@ -107,6 +107,9 @@ struct TR_MethodToBeCompiled
    // request is re-queued after a failed compilation. Once the compilation is finally successful, the timestamp
    // is used to compute the total compilation request latency (including queuing time and failed attempts).
    uintptr_t              _entryTime;
+   // Time when the request was queued (ms since JVM start). Used for queue aging and latency statistics;
+   // unlike _entryTime it is always set, and it is reset when the request leaves the queue.
+   uint32_t               _timeQueued;
    TR::CompilationInfoPerThreadBase *_compInfoPT; // pointer to the thread that is handling this request
    const void *           _aotCodeToBeRelocated;
 
@@ -148,6 +151,9 @@ struct TR_MethodToBeCompiled
                                        // the entry is queued, but change afterwards if method receives samples
                                        // to be upgraded to hot or scorching
    bool                   _hasIncrementedNumCompThreadsCompilingHotterMethods;
+   bool                   _entryIsCountedAsAotLoad; // set while the request is queued and counted
+                                                    // in CompilationInfo::_numQueuedAotLoads
+   uint8_t                _numAdmissionDeferrals; // times the request was passed over by compilation admission control
 
    int16_t                _index;
    uint8_t                _freeTag; // temporary to catch a nasty bug
@@ -200,6 +200,12 @@ class TR_PersistentMethodInfo
    int16_t getNumPrexAssumptions() {return _numPrexAssumptions;}
    void incNumPrexAssumptions() {_numPrexAssumptions++;}
 
+   // Cost of the last compilation of this method relative to the estimate of the
+   // compilation admission control, in percent; 0 if the method was never measured
+   uint16_t getCompTimeFactor() const { return _compTimeFactor; }
+   uint16_t getCompMemoryFactor() const { return _compMemoryFactor; }
+   void setCompCostFactors(uint16_t timeFactor, uint16_t memoryFactor) { _compTimeFactor = timeFactor; _compMemoryFactor = memoryFactor; }
+
    void addInvalidationReasons(TR_JitBodyInvalidations reasons)
       {
       _invalidationReasons.add(reasons);
@@ -329,6 +335,8 @@ class TR_PersistentMethodInfo
    uint8_t                         _numberOfPreexistenceInvalidations; // how many times this method has been invalidated due to preexistence
    uint8_t                         _numberOfInlinedMethodRedefinition; // how many times this method triggers recompilation because of its inlined callees being redefined
    int16_t                         _numPrexAssumptions;
+   uint16_t                        _compTimeFactor;
+   uint16_t                        _compMemoryFactor;
    TR_JitBodyInvalidations         _invalidationReasons;
 
    TR_PersistentProfileInfo       *_bestProfileInfo;
@@ -23,6 +23,8 @@
 #include "control/CompilationRuntime.hpp"
 
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include "jni.h"
 #include "j9.h"
 #include "j9port.h"
@@ -409,3 +411,92 @@ void TR_CpuEntitlement::computeAndCacheCpuEntitlement()
       }
    }
 
+void TR_CgroupCpuQuota::init(J9JITConfig *jitConfig)
+   {
+   _jitConfig = jitConfig;
+   _cpuSubsystemEnabled = false;
+   _quotaUs = -1;
+   _periodUs = 0;
+#if defined(LINUX)
+   OMRPORT_ACCESS_FROM_J9PORT(jitConfig->javaVM->portLibrary);
+   _cpuSubsystemEnabled = (OMR_CGROUP_SUBSYSTEM_CPU == omrsysinfo_cgroup_are_subsystems_enabled(OMR_CGROUP_SUBSYSTEM_CPU));
+   // Prime the counters so that the first interval covers only the time since init
+   if (_cpuSubsystemEnabled && !update())
+      _cpuSubsystemEnabled = false;
+   _lastIntervalPeriods = _lastIntervalThrottledPeriods = _lastIntervalThrottledUs = 0;
+#endif /* defined(LINUX) */
+   }
+
+bool TR_CgroupCpuQuota::readMetrics(uint64_t &periods, uint64_t &throttledPeriods, uint64_t &throttledUs)
+   {
+#if defined(LINUX)
+   // The port library hides the differences between the cgroup v1 and v2 layouts:
+   // cpu.cfs_quota_us/cpu.cfs_period_us or cpu.max, and the counters from cpu.stat
+   OMRPORT_ACCESS_FROM_J9PORT(_jitConfig->javaVM->portLibrary);
+   OMRCgroupMetricIteratorState cgroupState = {0};
+   if (0 != omrsysinfo_cgroup_subsystem_iterator_init(OMR_CGROUP_SUBSYSTEM_CPU, &cgroupState))
+      return false;
+
+   bool foundQuota = false;
+   bool foundPeriod = false;
+   bool foundPeriods = false;
+   periods = throttledPeriods = throttledUs = 0;
+   OMRCgroupMetricElement metricElement = {0};
+   while (0 != omrsysinfo_cgroup_subsystem_iterator_hasNext(&cgroupState))
+      {
+      const char *metricKey = NULL;
+      if (0 != omrsysinfo_cgroup_subsystem_iterator_metricKey(&cgroupState, &metricKey))
+         break;
+      if (0 != omrsysinfo_cgroup_subsystem_iterator_next(&cgroupState, &metricElement))
+         continue;
+      const char *value = metricElement.value;
+      if (!strcmp(metricKey, "CPU Quota"))
+         {
+         // A quota of "max" (v2) or -1 (v1) means there is no limit
+         _quotaUs = strcmp(value, "max") ? strtoll(value, NULL, 10) : -1;
+         foundQuota = true;
+         }
+      else if (!strcmp(metricKey, "CPU Period"))
+         {
+         _periodUs = strtoll(value, NULL, 10);
+         foundPeriod = true;
+         }
+      else if (!strcmp(metricKey, "Period intervals elapsed count"))
+         {
+         periods = strtoull(value, NULL, 10);
+         foundPeriods = true;
+         }
+      else if (!strcmp(metricKey, "Throttled count"))
+         {
+         throttledPeriods = strtoull(value, NULL, 10);
+         }
+      else if (!strcmp(metricKey, "Total throttle time"))
+         {
+         // Reported in ns by cgroup v1 and in us by cgroup v2
+         throttledUs = strtoull(value, NULL, 10);
+         if (metricElement.units && !strcmp(metricElement.units, "nanoseconds"))
+            throttledUs /= 1000;
+         }
+      }
+   omrsysinfo_cgroup_subsystem_iterator_destroy(&cgroupState);
+   return foundQuota && foundPeriod && foundPeriods;
+#else
+   return false;
+#endif /* defined(LINUX) */
+   }
+
+bool TR_CgroupCpuQuota::update()
+   {
+   uint64_t periods, throttledPeriods, throttledUs;
+   if (!_cpuSubsystemEnabled || !readMetrics(periods, throttledPeriods, throttledUs))
+      return false;
+
+   // Counters are reset if the cgroup is recreated; treat that as an empty interval
+   _lastIntervalPeriods = periods >= _periods ? periods - _periods : 0;
+   _lastIntervalThrottledPeriods = throttledPeriods >= _throttledPeriods ? throttledPeriods - _throttledPeriods : 0;
+   _lastIntervalThrottledUs = throttledUs >= _throttledUs ? throttledUs - _throttledUs : 0;
+   _periods = periods;
+   _throttledPeriods = throttledPeriods;
+   _throttledUs = throttledUs;
+   return true;
+   }
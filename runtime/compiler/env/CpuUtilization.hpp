@@ -221,4 +221,39 @@ private:
    J9JITConfig * _jitConfig;
    };
 
+// Reads the CFS bandwidth control settings (CPU quota and period) and the
+// throttling counters of the cgroup the JVM runs in, through the cgroup CPU
+// subsystem support of the port library (both cgroup v1 and v2 are handled there).
+// Like TR_CpuEntitlement, an object of this type is embedded into
+// TR::CompilationInfo and cannot have virtual functions.
+struct TR_CgroupCpuQuota
+   {
+public:
+   void init(J9JITConfig *jitConfig); // checks for the cgroup CPU subsystem; must be called before update()
+   bool update(); // rereads the quota and the counters; returns false if the information is not available
+
+   bool isFunctional() const { return _cpuSubsystemEnabled; }
+   bool hasQuota() const { return _quotaUs > 0 && _periodUs > 0; }
+   int32_t getQuotaCpuPercent() const { return hasQuota() ? (int32_t)(_quotaUs * 100 / _periodUs) : -1; } // 150 means 1.5 CPUs
+   // The following refer to the interval between the last two calls to update()
+   uint64_t getPeriodsInLastInterval() const { return _lastIntervalPeriods; }
+   uint64_t getThrottledPeriodsInLastInterval() const { return _lastIntervalThrottledPeriods; }
+   uint64_t getThrottledUsInLastInterval() const { return _lastIntervalThrottledUs; }
+   int32_t getThrottledPeriodsPercent() const { return _lastIntervalPeriods ? (int32_t)(_lastIntervalThrottledPeriods * 100 / _lastIntervalPeriods) : 0; }
+
+private:
+   bool readMetrics(uint64_t &periods, uint64_t &throttledPeriods, uint64_t &throttledUs);
+
+   J9JITConfig *_jitConfig;
+   bool     _cpuSubsystemEnabled; // false if no usable cgroup CPU controller was found
+   int64_t  _quotaUs; // -1 if there is no quota
+   int64_t  _periodUs;
+   uint64_t _periods;
+   uint64_t _throttledPeriods;
+   uint64_t _throttledUs;
+   uint64_t _lastIntervalPeriods;
+   uint64_t _lastIntervalThrottledPeriods;
+   uint64_t _lastIntervalThrottledUs;
+   };
+
 #endif // CPUUTILIZATION_HPP
@@ -43,6 +43,7 @@ class TR_PersistentMemory;
 class TR_PersistentCHTable;
 class TR_PersistentClassLoaderTable;
 class TR_AOTDependencyTable;
+class TR_PersistedCompilationPlan;
 class TR_MHJ2IThunkTable;
 namespace J9 { class Options; }
 
@@ -161,9 +162,11 @@ class PersistentInfo : public OMR::PersistentInfoConnector
          _runtimeInstrumentationEnabled(false),
          _runtimeInstrumentationRecompilationEnabled(false),
          _aotDependencyTable(NULL),
+         _persistedCompilationPlan(NULL),
          _trackAOTDependencies(false),
 #if defined(J9VM_OPT_JITSERVER)
          _JITServerAddress("localhost"),
+         _JITServerAlternateAddresses(),
          _JITServerPort(38400),
          _socketTimeoutMs(0),
          _clientUID(0),
@@ -182,6 +185,9 @@ class PersistentInfo : public OMR::PersistentInfoConnector
          _JITServerAOTCacheIgnoreLocalSCC(true),
          _doNotRequestJITServerAOTCacheLoad(false),
          _doNotRequestJITServerAOTCacheStore(false),
+         _JITServerUseMessageCompression(false),
+         _JITServerUseEventLoop(false),
+         _JITServerAOTCachePeers(),
 #endif /* defined(J9VM_OPT_JITSERVER) */
       OMR::PersistentInfoConnector(pm)
       {}
@@ -192,6 +198,9 @@ class PersistentInfo : public OMR::PersistentInfoConnector
    void setAOTDependencyTable(TR_AOTDependencyTable *table) { _aotDependencyTable = table; }
    TR_AOTDependencyTable *getAOTDependencyTable() const { return _aotDependencyTable; }
 
+   void setPersistedCompilationPlan(TR_PersistedCompilationPlan *plan) { _persistedCompilationPlan = plan; }
+   TR_PersistedCompilationPlan *getPersistedCompilationPlan() const { return _persistedCompilationPlan; }
+
    TR_OpaqueClassBlock **getVisitedSuperClasses() { return _visitedSuperClasses; }
    void clearVisitedSuperClasses() { _tooManySuperClasses = false; _numVisitedSuperClasses = 0; }
    void setVisitedSuperClasses(TR_OpaqueClassBlock **v) { _visitedSuperClasses = v; }
@@ -359,6 +368,8 @@ class PersistentInfo : public OMR::PersistentInfoConnector
    static JITServer::RemoteCompilationModes getRemoteCompilationMode() { return _remoteCompilationMode; }
    const std::string &getJITServerAddress() const { return _JITServerAddress; }
    void setJITServerAddress(const char *addr) { _JITServerAddress = addr; }
+   const std::string &getJITServerAlternateAddresses() const { return _JITServerAlternateAddresses; }
+   void setJITServerAlternateAddresses(const char *addrs) { _JITServerAlternateAddresses = addrs; }
    uint32_t getSocketTimeout() const { return _socketTimeoutMs; }
    void setSocketTimeout(uint32_t t) { _socketTimeoutMs = t; }
    uint32_t getJITServerPort() const { return _JITServerPort; }
@@ -395,6 +406,12 @@ class PersistentInfo : public OMR::PersistentInfoConnector
    void setDoNotRequestJITServerAOTCacheLoad(bool b) { _doNotRequestJITServerAOTCacheLoad = b; }
    bool doNotRequestJITServerAOTCacheStore() const { return _doNotRequestJITServerAOTCacheStore; }
    void setDoNotRequestJITServerAOTCacheStore(bool b) { _doNotRequestJITServerAOTCacheStore = b; }
+   bool getJITServerUseMessageCompression() const { return _JITServerUseMessageCompression; }
+   void setJITServerUseMessageCompression(bool b) { _JITServerUseMessageCompression = b; }
+   bool getJITServerUseEventLoop() const { return _JITServerUseEventLoop; }
+   void setJITServerUseEventLoop(bool b) { _JITServerUseEventLoop = b; }
+   const std::string &getJITServerAOTCachePeers() const { return _JITServerAOTCachePeers; }
+   void setJITServerAOTCachePeers(const char *peers) { _JITServerAOTCachePeers = peers; }
 #endif /* defined(J9VM_OPT_JITSERVER) */
 
    private:
@@ -408,6 +425,8 @@ class PersistentInfo : public OMR::PersistentInfoConnector
 
    TR_AOTDependencyTable *_aotDependencyTable;
 
+   TR_PersistedCompilationPlan *_persistedCompilationPlan;
+
    // these fields are RW
 
    TR_OpaqueClassBlock **_visitedSuperClasses;
@@ -485,6 +504,7 @@ class PersistentInfo : public OMR::PersistentInfoConnector
 
 #if defined(J9VM_OPT_JITSERVER)
    std::string _JITServerAddress;
+   std::string _JITServerAlternateAddresses; // At the client, comma-separated host[:port] list of servers to fail over to
    uint32_t    _JITServerPort;
    uint32_t    _socketTimeoutMs; // timeout for communication sockets used in out-of-process JIT compilation
    uint64_t    _clientUID;
@@ -506,6 +526,11 @@ class PersistentInfo : public OMR::PersistentInfoConnector
    bool        _doNotRequestJITServerAOTCacheLoad;
    // True if the client should not request AOT cache stores during this server connection
    bool        _doNotRequestJITServerAOTCacheStore;
+   // At the client, whether to ask the server for compressed messages; at the server, whether to allow it
+   bool        _JITServerUseMessageCompression;
+   // At the server, whether idle connections are parked with the listener thread between compilation requests
+   bool        _JITServerUseEventLoop;
+   std::string _JITServerAOTCachePeers; // At the server, comma-separated host:port list of peers to exchange AOT cache entries with
 #endif /* defined(J9VM_OPT_JITSERVER) */
    };
 
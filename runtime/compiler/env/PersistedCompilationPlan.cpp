@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "env/PersistedCompilationPlan.hpp"
+
+#include "control/Options.hpp"
+#include "env/J9SharedCache.hpp"
+#include "env/VerboseLog.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+#include "infra/String.hpp"
+
+#if !defined(PERSISTENT_COLLECTIONS_UNSUPPORTED)
+
+TR_PersistedCompilationPlan::TR_PersistedCompilationPlan(J9VMThread *vmThread, TR_J9SharedCache *sharedCache, size_t maxEntries) :
+   _sharedCache(sharedCache),
+   _monitor(TR::Monitor::create("JIT-PersistedCompilationPlanMonitor")),
+   _maxEntries(maxEntries),
+   _loadedGeneration(-1),
+   _persisted(false),
+   _loadedPlan(decltype(_loadedPlan)::allocator_type(TR::Compiler->persistentAllocator())),
+   _recordedPlan(decltype(_recordedPlan)::allocator_type(TR::Compiler->persistentAllocator())),
+   _numPlannedLookups(0),
+   _numEntriesPersisted(0)
+   {
+   if (vmThread)
+      load(vmThread);
+   }
+
+void
+TR_PersistedCompilationPlan::buildKey(char *buffer, size_t size, uint32_t slot)
+   {
+   TR::snprintfNoTrunc(buffer, size, "JITCompilationPlan:%u", slot);
+   }
+
+void
+TR_PersistedCompilationPlan::load(J9VMThread *vmThread)
+   {
+   // Keys are reused in rotation, and the data found for a key is the one
+   // stored last under it, so the latest generation is the highest one found
+   const Header *plan = NULL;
+   char key[64];
+   for (uint32_t slot = 0; slot < MAX_GENERATIONS; ++slot)
+      {
+      buildKey(key, sizeof(key), slot);
+      J9SharedDataDescriptor dataDescriptor;
+      dataDescriptor.address = NULL;
+      _sharedCache->sharedCacheConfig()->findSharedData(vmThread, key, strlen(key), J9SHR_DATA_TYPE_JITHINT, FALSE, &dataDescriptor, NULL);
+      if (!dataDescriptor.address)
+         continue;
+
+      auto header = (const Header *)dataDescriptor.address;
+      if ((dataDescriptor.length < sizeof(Header)) ||
+          (header->_version != VERSION) ||
+          (header->_generation % MAX_GENERATIONS != slot) ||
+          (dataDescriptor.length < sizeof(Header) + header->_numEntries * sizeof(Entry)))
+         continue;
+
+      if ((int32_t)header->_generation > _loadedGeneration)
+         {
+         plan = header;
+         _loadedGeneration = (int32_t)header->_generation;
+         }
+      }
+
+   if (!plan)
+      return;
+
+   try
+      {
+      auto entries = (const Entry *)(plan + 1);
+      for (uint32_t i = 0; i < plan->_numEntries; ++i)
+         {
+         // Ignore entries for ROM methods that are no longer in the cache
+         if (!_sharedCache->romMethodFromOffsetInSharedCache(entries[i]._romMethodOffset))
+            continue;
+         PlannedMethod plannedMethod = { (TR_Hotness)entries[i]._optLevel, entries[i]._age };
+         _loadedPlan.insert({ entries[i]._romMethodOffset, plannedMethod });
+         }
+      }
+   catch (std::exception &)
+      {
+      _loadedPlan.clear();
+      }
+
+   if (TR::Options::getVerboseOption(TR_VerboseCompileRequest))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "Compilation plan: loaded generation %d with %lu methods",
+                                     _loadedGeneration, _loadedPlan.size());
+   }
+
+TR_Hotness
+TR_PersistedCompilationPlan::getPlannedOptLevel(J9ROMMethod *romMethod)
+   {
+   if (_loadedPlan.empty())
+      return unknownHotness;
+
+   uintptr_t offset = 0;
+   if (!_sharedCache->isROMMethodInSharedCache(romMethod, &offset))
+      return unknownHotness;
+
+   auto it = _loadedPlan.find(offset);
+   if (it == _loadedPlan.end())
+      return unknownHotness;
+
+   _numPlannedLookups++; // statistics only; races are benign
+   return it->second._optLevel;
+   }
+
+void
+TR_PersistedCompilationPlan::recordCompilation(J9ROMMethod *romMethod, TR_Hotness optLevel)
+   {
+   uintptr_t offset = 0;
+   if (!_sharedCache->isROMMethodInSharedCache(romMethod, &offset))
+      return;
+
+   OMR::CriticalSection cs(_monitor);
+   if (_persisted)
+      return;
+
+   try
+      {
+      auto it = _recordedPlan.find(offset);
+      if (it != _recordedPlan.end())
+         {
+         // Keep the final opt level reached by the method
+         it->second = optLevel;
+         }
+      else if (_recordedPlan.size() < _maxEntries)
+         {
+         _recordedPlan.insert({ offset, optLevel });
+         }
+      }
+   catch (std::exception &)
+      {
+      // Failing to record a compilation only makes the plan less complete
+      }
+   }
+
+bool
+TR_PersistedCompilationPlan::isCarriedOver(uintptr_t romMethodOffset, const PlannedMethod &plannedMethod)
+   {
+   return (_recordedPlan.find(romMethodOffset) == _recordedPlan.end()) &&
+          (plannedMethod._age + 1 < MAX_UNCONFIRMED_GENERATIONS);
+   }
+
+void
+TR_PersistedCompilationPlan::persist(J9VMThread *vmThread)
+   {
+   OMR::CriticalSection cs(_monitor);
+   if (_persisted)
+      return;
+   _persisted = true;
+
+   if (_recordedPlan.empty() && _loadedPlan.empty())
+      return;
+
+   // Methods compiled in this run take precedence; the remaining room is
+   // filled with methods from the loaded plan that were not recorded this time
+   // around (e.g. because the run was shorter, or because they were only
+   // compiled at their planned level), unless they went unrecorded for too long
+   size_t numEntries = _recordedPlan.size();
+   for (auto &entry : _loadedPlan)
+      {
+      if (numEntries >= _maxEntries)
+         break;
+      if (isCarriedOver(entry.first, entry.second))
+         numEntries++;
+      }
+
+   size_t length = sizeof(Header) + numEntries * sizeof(Entry);
+   auto header = (Header *)TR_Memory::jitPersistentAlloc(length);
+   if (!header)
+      return;
+
+   header->_version = VERSION;
+   header->_generation = (uint32_t)(_loadedGeneration + 1);
+   header->_numEntries = (uint32_t)numEntries;
+   auto entries = (Entry *)(header + 1);
+   size_t i = 0;
+   for (auto &entry : _recordedPlan)
+      {
+      entries[i]._romMethodOffset = entry.first;
+      entries[i]._optLevel = entry.second;
+      entries[i]._age = 0;
+      i++;
+      }
+   for (auto &entry : _loadedPlan)
+      {
+      if (i >= numEntries)
+         break;
+      if (!isCarriedOver(entry.first, entry.second))
+         continue;
+      entries[i]._romMethodOffset = entry.first;
+      entries[i]._optLevel = entry.second._optLevel;
+      entries[i]._age = entry.second._age + 1;
+      i++;
+      }
+
+   char key[64];
+   buildKey(key, sizeof(key), header->_generation % MAX_GENERATIONS);
+
+   J9SharedDataDescriptor dataDescriptor;
+   dataDescriptor.address = (U_8 *)header;
+   dataDescriptor.length = length;
+   dataDescriptor.type = J9SHR_DATA_TYPE_JITHINT;
+   dataDescriptor.flags = 0;
+   bool stored = _sharedCache->storeSharedData(vmThread, key, &dataDescriptor) != NULL;
+   if (stored)
+      _numEntriesPersisted = (uint32_t)numEntries;
+
+   TR_Memory::jitPersistentFree(header);
+
+   if (TR::Options::getVerboseOption(TR_VerboseCompileRequest))
+      {
+      if (stored)
+         TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "Compilation plan: stored generation %d with %u methods",
+                                        _loadedGeneration + 1, _numEntriesPersisted);
+      else
+         TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "Compilation plan: could not store generation %d in the SCC",
+                                        _loadedGeneration + 1);
+      }
+   }
+
+void
+TR_PersistedCompilationPlan::printStats()
+   {
+   TR_VerboseLog::CriticalSection vlogLock;
+
+   TR_VerboseLog::writeLine(TR_Vlog_INFO, "Compilation plan: generation %d, %lu methods loaded, %u planned methods looked up",
+                            _loadedGeneration, _loadedPlan.size(), _numPlannedLookups);
+   TR_VerboseLog::writeLine(TR_Vlog_INFO, "Compilation plan: %lu methods recorded in this run, %u methods stored",
+                            _recordedPlan.size(), _numEntriesPersisted);
+   }
+
+#endif /* !defined(PERSISTENT_COLLECTIONS_UNSUPPORTED) */
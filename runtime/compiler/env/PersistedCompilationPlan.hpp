@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#ifndef PERSISTEDCOMPILATIONPLAN_INCL
+#define PERSISTEDCOMPILATIONPLAN_INCL
+
+#include "compile/CompilationTypes.hpp"
+#include "env/PersistentCollections.hpp"
+#include "env/TRMemory.hpp"
+#include "j9.h"
+
+namespace TR { class Monitor; }
+class TR_J9SharedCache;
+
+// The persisted compilation plan remembers which methods were compiled at warm
+// or above during a run, and at which opt level they ended up. The plan is
+// stored in the SCC at shutdown and loaded at the next startup, where planned
+// methods get an initial count of 0 and are compiled directly at their planned
+// opt level. Compilations are therefore still triggered by the first
+// invocation of each method, so replay naturally respects class loading and
+// initialization order.
+//
+// Each run stores a new generation of the plan. Data in the SCC cannot be
+// replaced, so generations are stored under MAX_GENERATIONS keys in rotation:
+// a reused key returns the data stored last under it, and the highest
+// generation found at startup wins.
+//
+// The first compilation of a planned method happens at its planned opt level,
+// so it says nothing about the current workload and is not recorded. Only
+// levels reached through the regular counting and sampling mechanisms are.
+// Planned methods that are not recorded again are carried over to the next
+// generation, but dropped once they went MAX_UNCONFIRMED_GENERATIONS
+// generations without being recorded, so that the plan follows the workload.
+// Profile-derived inlining decisions are not part of the plan: they come from
+// the IProfiler data that is already persisted in the SCC.
+#if defined(PERSISTENT_COLLECTIONS_UNSUPPORTED)
+
+class TR_PersistedCompilationPlan
+   {
+public:
+   TR_PersistedCompilationPlan(J9VMThread *vmThread, TR_J9SharedCache *sharedCache, size_t maxEntries) {}
+   TR_Hotness getPlannedOptLevel(J9ROMMethod *romMethod) { return unknownHotness; }
+   void recordCompilation(J9ROMMethod *romMethod, TR_Hotness optLevel) {}
+   void persist(J9VMThread *vmThread) {}
+   void printStats() {}
+   };
+
+#else
+
+class TR_PersistedCompilationPlan
+   {
+public:
+   TR_PERSISTENT_ALLOC(TR_Memory::PersistentInfo)
+
+   // Loads the latest generation of the plan from the SCC
+   TR_PersistedCompilationPlan(J9VMThread *vmThread, TR_J9SharedCache *sharedCache, size_t maxEntries);
+
+   // Returns the opt level romMethod was compiled at in the run that stored
+   // the plan, or unknownHotness if the method is not part of the plan
+   TR_Hotness getPlannedOptLevel(J9ROMMethod *romMethod);
+
+   // Remembers that romMethod was compiled at optLevel in this run. Must not
+   // be called for compilations whose opt level came from the plan.
+   void recordCompilation(J9ROMMethod *romMethod, TR_Hotness optLevel);
+
+   // Merges the methods recorded in this run into the loaded plan and stores
+   // the result in the SCC as a new generation. Called once, at shutdown.
+   void persist(J9VMThread *vmThread);
+
+   void printStats();
+
+   // Number of keys the generations of the plan are stored under in rotation
+   static const uint32_t MAX_GENERATIONS = 16;
+
+   // Number of consecutive generations a planned method is kept without
+   // having been recorded again
+   static const uint32_t MAX_UNCONFIRMED_GENERATIONS = 4;
+
+private:
+   struct Header
+      {
+      uint32_t _version;
+      uint32_t _generation;
+      uint32_t _numEntries;
+      };
+
+   struct Entry
+      {
+      uintptr_t _romMethodOffset;
+      uint32_t _optLevel;
+      uint32_t _age; // number of generations since the method was last recorded
+      };
+
+   struct PlannedMethod
+      {
+      TR_Hotness _optLevel;
+      uint32_t _age;
+      };
+
+   static const uint32_t VERSION = 3;
+
+   static void buildKey(char *buffer, size_t size, uint32_t slot);
+
+   void load(J9VMThread *vmThread);
+
+   // Whether a method of the loaded plan that was not recorded in this run
+   // is stored again in the next generation
+   bool isCarriedOver(uintptr_t romMethodOffset, const PlannedMethod &plannedMethod);
+
+   TR_J9SharedCache *const _sharedCache;
+   TR::Monitor *const _monitor;
+   const size_t _maxEntries;
+
+   // Generation of the plan that was loaded, -1 if none; the next one is
+   // _loadedGeneration + 1, stored under the key of slot
+   // (_loadedGeneration + 1) % MAX_GENERATIONS
+   int32_t _loadedGeneration;
+   bool _persisted;
+
+   // Plan loaded at startup (read-only after construction, so queries need
+   // no synchronization) and methods compiled during this run. Both are keyed
+   // by the offset of the ROM method in the SCC.
+   PersistentUnorderedMap<uintptr_t, PlannedMethod> _loadedPlan;
+   PersistentUnorderedMap<uintptr_t, TR_Hotness> _recordedPlan;
+
+   uint32_t _numPlannedLookups;
+   uint32_t _numEntriesPersisted;
+   };
+
+#endif /* defined(PERSISTENT_COLLECTIONS_UNSUPPORTED) */
+#endif
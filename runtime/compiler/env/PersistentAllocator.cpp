@@ -28,6 +28,7 @@
 #include "env/VerboseLog.hpp"
 #include "il/DataTypes.hpp"
 #include "infra/Monitor.hpp"
+#include "omrformatconsts.h"
 
 #ifdef LINUX
 #include <sys/mman.h> // for madvise
@@ -53,6 +54,8 @@ PersistentAllocator::PersistentAllocator(const PersistentAllocatorKit &creationK
                      MEMORY_TYPE_JIT_PERSISTENT | creationKit.memoryType,
                      creationKit.javaVM),
    _freeBlocks(),
+   _smallBlockCaches(),
+   _numLargeAllocations(0),
 #if defined(J9VM_OPT_JITSERVER)
    _isJITServer(creationKit.javaVM.internalVMFunctions->isJITServerEnabled(&creationKit.javaVM)),
 #endif
@@ -70,6 +73,12 @@ PersistentAllocator::PersistentAllocator(const PersistentAllocatorKit &creationK
    j9thread_monitor_init_with_name(&_segmentMonitor, 0, "JIT-PersistentAllocatorSegmentMonitor");
    if (!_smallBlockMonitor || !_largeBlockMonitor || !_segmentMonitor)
       throw std::bad_alloc();
+   for (size_t i = 0; i < NUM_SMALL_BLOCK_CACHES; i++)
+      {
+      j9thread_monitor_init_with_name(&_smallBlockCaches[i]._monitor, 0, "JIT-PersistentAllocatorSmallBlockCacheMonitor");
+      if (!_smallBlockCaches[i]._monitor)
+         throw std::bad_alloc();
+      }
    }
 
 PersistentAllocator::~PersistentAllocator() throw()
@@ -86,6 +95,11 @@ PersistentAllocator::~PersistentAllocator() throw()
    _largeBlockMonitor = NULL;
    j9thread_monitor_destroy(_segmentMonitor);
    _segmentMonitor = NULL;
+   for (size_t i = 0; i < NUM_SMALL_BLOCK_CACHES; i++)
+      {
+      j9thread_monitor_destroy(_smallBlockCaches[i]._monitor);
+      _smallBlockCaches[i]._monitor = NULL;
+      }
    }
 
 void *
@@ -102,6 +116,77 @@ PersistentAllocator::allocate(size_t size, void *hint)
    return alloc;
    }
 
+PersistentAllocator::SmallBlockCache &
+PersistentAllocator::getSmallBlockCache()
+   {
+   // Fibonacci hashing of the thread pointer; the low bits are mostly alignment
+   uint64_t const hash = (uint64_t)(uintptr_t)j9thread_self() * 0x9E3779B97F4A7C15ULL;
+   return _smallBlockCaches[hash >> (64 - SMALL_BLOCK_CACHE_BITS)];
+   }
+
+PersistentAllocator::Block *
+PersistentAllocator::allocateFromSmallBlockCache(size_t index)
+   {
+   SmallBlockCache &cache = getSmallBlockCache();
+   j9thread_monitor_enter(cache._monitor);
+   cache._numAllocations[index]++;
+   Block *block = cache._freeBlocks[index];
+   if (!block)
+      {
+      // Refill the cache with a batch of blocks from the shared list
+      uint32_t numBlocks = 0;
+      j9thread_monitor_enter(_smallBlockMonitor);
+      Block *first = _freeBlocks[index];
+      if (first)
+         {
+         Block *last = first;
+         for (numBlocks = 1; numBlocks < SMALL_BLOCK_CACHE_BATCH && last->next(); numBlocks++)
+            last = last->next();
+         _freeBlocks[index] = last->next();
+         last->setNext(NULL);
+         }
+      j9thread_monitor_exit(_smallBlockMonitor);
+      cache._freeBlocks[index] = first;
+      cache._numFreeBlocks[index] = numBlocks;
+      block = first;
+      }
+   if (block)
+      {
+      cache._freeBlocks[index] = block->next();
+      cache._numFreeBlocks[index]--;
+      block->setNext(NULL);
+      }
+   j9thread_monitor_exit(cache._monitor);
+   return block;
+   }
+
+void
+PersistentAllocator::freeToSmallBlockCache(Block * block)
+   {
+   size_t const index = freeBlocksIndex(block->size());
+   TR_ASSERT(index != LARGE_BLOCK_LIST_INDEX, "freeToSmallBlockCache should be used for small blocks");
+   SmallBlockCache &cache = getSmallBlockCache();
+   j9thread_monitor_enter(cache._monitor);
+   block->setNext(cache._freeBlocks[index]);
+   cache._freeBlocks[index] = block;
+   if (++cache._numFreeBlocks[index] > SMALL_BLOCK_CACHE_LIMIT)
+      {
+      // Return a batch of blocks to the shared list, where other threads can reuse them
+      Block *first = cache._freeBlocks[index];
+      Block *last = first;
+      for (uint32_t i = 1; i < SMALL_BLOCK_CACHE_BATCH; i++)
+         last = last->next();
+      cache._freeBlocks[index] = last->next();
+      cache._numFreeBlocks[index] -= SMALL_BLOCK_CACHE_BATCH;
+
+      j9thread_monitor_enter(_smallBlockMonitor);
+      last->setNext(_freeBlocks[index]);
+      _freeBlocks[index] = first;
+      j9thread_monitor_exit(_smallBlockMonitor);
+      }
+   j9thread_monitor_exit(cache._monitor);
+   }
+
 PersistentAllocator::Block *
 PersistentAllocator::allocateFromVariableSizeListLocked(size_t allocSize)
    {
@@ -230,19 +315,13 @@ PersistentAllocator::allocateInternal(size_t requestedSize)
    size_t const index = freeBlocksIndex(allocSize);
    if (index != LARGE_BLOCK_LIST_INDEX) // fixed-size-block chain
       {
-      j9thread_monitor_enter(_smallBlockMonitor);
-      Block *block = _freeBlocks[index];
+      Block *block = allocateFromSmallBlockCache(index);
       if (block)
          {
-         _freeBlocks[index] = block->next();
-         block->setNext(NULL);
-         j9thread_monitor_exit(_smallBlockMonitor);
          allocation = block + 1; // Return pointer after the header
          }
       else // Couldn't find suitable free block; need to allocate from segment
          {
-         j9thread_monitor_exit(_smallBlockMonitor);
-
          // Find the first persistent segment with enough free space
          j9thread_monitor_enter(_segmentMonitor);
          allocation = allocateFromSegmentLocked(allocSize);
@@ -252,6 +331,7 @@ PersistentAllocator::allocateInternal(size_t requestedSize)
    else // Variable size block allocation
       {
       j9thread_monitor_enter(_largeBlockMonitor);
+      _numLargeAllocations++;
       Block *block =
 #if defined(J9VM_OPT_JITSERVER)
          _isJITServer ? allocateFromIndexedListLocked(allocSize) :
@@ -646,9 +726,7 @@ PersistentAllocator::freeBlock(Block *block)
    size_t const index = freeBlocksIndex(block->size());
    if (index > LARGE_BLOCK_LIST_INDEX)
       {
-      j9thread_monitor_enter(_smallBlockMonitor);
-      freeFixedSizeBlock(block);
-      j9thread_monitor_exit(_smallBlockMonitor);
+      freeToSmallBlockCache(block);
       }
    else
       {
@@ -758,6 +836,23 @@ PersistentAllocator::disclaimAllSegments()
    return numSegDisclaimed;
    }
 
+void
+PersistentAllocator::printAllocationStats()
+   {
+   fprintf(stderr, "Persistent allocations by size class:\n");
+   for (size_t index = 0; index < PERSISTENT_BLOCK_SIZE_BUCKETS; index++)
+      {
+      if (index == LARGE_BLOCK_LIST_INDEX)
+         continue;
+      uint64_t numAllocations = 0;
+      for (size_t i = 0; i < NUM_SMALL_BLOCK_CACHES; i++)
+         numAllocations += _smallBlockCaches[i]._numAllocations[index];
+      if (numAllocations)
+         fprintf(stderr, "\t%4zu bytes: %" OMR_PRIu64 "\n", index * sizeof(void *), numAllocations);
+      }
+   fprintf(stderr, "\t%4zu+ bytes: %" OMR_PRIu64 "\n", PERSISTENT_BLOCK_SIZE_BUCKETS * sizeof(void *), _numLargeAllocations);
+   }
+
 void
 TR::PersistentAllocator::adviseDontNeedSegments()
    {
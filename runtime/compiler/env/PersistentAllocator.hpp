@@ -82,6 +82,9 @@ public:
    // be sure that these segments are not actually in use in that case.
    void adviseDontNeedSegments();
 
+   // Print the number of allocations for each size class
+   void printAllocationStats();
+
 private:
 
    // Persistent block header
@@ -116,6 +119,26 @@ private:
       return candidateBucket < PERSISTENT_BLOCK_SIZE_BUCKETS ? candidateBucket : LARGE_BLOCK_LIST_INDEX;
       }
 
+   // Small blocks are handed out through several caches, each with its own monitor.
+   // A thread always uses the cache selected by hashing its j9thread_t, so threads
+   // that allocate and free small blocks concurrently rarely contend on the same
+   // monitor. Empty caches are refilled with a batch of blocks from the shared lists
+   // in _freeBlocks, and caches that grow too long return a batch to those lists.
+   static const size_t SMALL_BLOCK_CACHE_BITS = 3;
+   static const size_t NUM_SMALL_BLOCK_CACHES = 1 << SMALL_BLOCK_CACHE_BITS;
+   static const uint32_t SMALL_BLOCK_CACHE_BATCH = 16;
+   static const uint32_t SMALL_BLOCK_CACHE_LIMIT = 4 * SMALL_BLOCK_CACHE_BATCH;
+   struct SmallBlockCache
+      {
+      J9ThreadMonitor *_monitor;
+      Block *_freeBlocks[PERSISTENT_BLOCK_SIZE_BUCKETS];
+      uint32_t _numFreeBlocks[PERSISTENT_BLOCK_SIZE_BUCKETS];
+      uint64_t _numAllocations[PERSISTENT_BLOCK_SIZE_BUCKETS]; // entry LARGE_BLOCK_LIST_INDEX is unused
+      };
+   SmallBlockCache &getSmallBlockCache();
+   Block * allocateFromSmallBlockCache(size_t index);
+   void freeToSmallBlockCache(Block * block);
+
    void * allocateInternal(size_t);
    Block * allocateFromVariableSizeListLocked(size_t allocSize);
    void * allocateFromSegmentLocked(size_t allocSize);
@@ -131,6 +154,8 @@ private:
    size_t const _minimumSegmentSize;
    SegmentAllocator _segmentAllocator;
    Block *_freeBlocks[PERSISTENT_BLOCK_SIZE_BUCKETS];
+   SmallBlockCache _smallBlockCaches[NUM_SMALL_BLOCK_CACHES];
+   uint64_t _numLargeAllocations; // protected by _largeBlockMonitor
    typedef TR::typed_allocator<TR::reference_wrapper<J9MemorySegment>, TR::RawAllocator> SegmentContainerAllocator;
    typedef std::deque<TR::reference_wrapper<J9MemorySegment>, SegmentContainerAllocator> SegmentContainer;
    SegmentContainer _segments;
@@ -5723,7 +5723,13 @@ TR_J9VMBase::getDesignatedCodeCache(TR::Compilation *comp) // MCT
    bool hadClassUnloadMonitor;
    bool hadVMAccess = releaseClassUnloadMonitorAndAcquireVMaccessIfNeeded(comp, &hadClassUnloadMonitor);
 
-   TR::CodeCache * result = TR::CodeCacheManager::instance()->reserveCodeCache(false, 0, compThreadID, &numReserved, comp->codeCacheKind());
+   TR::CodeCache * result = NULL;
+   // Bodies that sampling has promoted to hot or scorching are kept together in one
+   // code cache to reduce the number of pages (and iTLB entries) the hot code touches
+   if (comp && !comp->compileRelocatableCode() && comp->getMethodHotness() >= hot)
+      result = TR::CodeCacheManager::instance()->reserveHotCodeCache(0, compThreadID, comp->codeCacheKind());
+   if (!result)
+      result = TR::CodeCacheManager::instance()->reserveCodeCache(false, 0, compThreadID, &numReserved, comp->codeCacheKind());
 
    acquireClassUnloadMonitorAndReleaseVMAccessIfNeeded(comp, hadVMAccess, hadClassUnloadMonitor);
    if (!result)
@@ -6315,6 +6321,12 @@ TR_J9VMBase::canAllocateInlineClass(TR_OpaqueClassBlock *clazzOffset)
    if ((clazz->romClass->modifiers & (J9AccAbstract | J9AccInterface))
        || (clazz->classFlags & J9ClassContainsUnflattenedFlattenables))
       return false;
+
+   // Instances of classes pretenured by the GC must be allocated with the
+   // maximum object age so the first scavenge tenures them, which the inline
+   // allocation sequence does not do; the helper still allocates from the TLH
+   if (clazz->classFlags & J9ClassPretenure)
+      return false;
    return true;
    }
 
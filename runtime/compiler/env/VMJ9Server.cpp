@@ -29,6 +29,7 @@
 #include "runtime/CodeCache.hpp"
 #include "runtime/CodeCacheManager.hpp"
 #include "runtime/CodeCacheExceptions.hpp"
+#include "runtime/JITServerSharedROMClassCache.hpp"
 #include "control/JITServerHelpers.hpp"
 #include "env/JITServerPersistentCHTable.hpp"
 #include "exceptions/AOTFailure.hpp"
@@ -1155,9 +1156,11 @@ TR_J9ServerVM::canAllocateInlineClass(TR_OpaqueClassBlock *clazz)
          }
       else
          {
-         uintptr_t classFlags = 0;
-         JITServerHelpers::getAndCacheRAMClassInfo((J9Class*)clazz, _compInfoPT->getClientData(), stream, JITServerHelpers::CLASSINFO_CLASS_FLAGS, (void*)&classFlags);
-         return (classFlags & J9ClassContainsUnflattenedFlattenables) ? false : true;
+         // J9ClassPretenure is set and cleared by the client GC at any time, so the cached
+         // class flags cannot be used; get the current value from the client
+         stream->write(JITServer::MessageType::ClassEnv_classFlagsValue, clazz);
+         classFlags = std::get<0>(stream->read<uintptr_t>());
+         return (classFlags & (J9ClassContainsUnflattenedFlattenables | J9ClassPretenure)) ? false : true;
          }
       }
 
@@ -1627,18 +1630,55 @@ TR_J9ServerVM::reportHotField(int32_t reducedCpuUtil, J9Class* clazz, uint8_t fi
    stream->read<JITServer::Void>();
    }
 
+// Describes the instance layout of a cached class for looking up metadata obtained from other
+// clients in the shared ROMClass cache. Returns false if any of the superclasses is not cached.
+// Must be called with the ROMMapMonitor held so that the shared ROMClasses remain referenced.
+static bool
+getSharedClassLayout(ClientSessionData *clientData, const ClientSessionData::ClassInfo &classInfo, bool compressedRefs,
+                     std::vector<const J9ROMClass *> &superclasses, JITServerSharedROMClassCache::ClassLayout &layout)
+   {
+   superclasses.clear();
+   auto &classMap = clientData->getROMClassMap();
+   for (TR_OpaqueClassBlock *parent = classInfo._parentClass; parent; )
+      {
+      auto it = classMap.find((J9Class *)parent);
+      if (it == classMap.end())
+         return false;
+      superclasses.push_back(it->second._romClass);
+      parent = it->second._parentClass;
+      }
+
+   layout._superclasses = superclasses.data();
+   layout._numSuperclasses = superclasses.size();
+   layout._totalInstanceSize = classInfo._totalInstanceSize;
+   layout._byteOffsetToLockword = classInfo._byteOffsetToLockword;
+   layout._compressedRefs = compressedRefs;
+   return true;
+   }
+
 int32_t *
 TR_J9ServerVM::getReferenceSlotsInClass(TR::Compilation *comp, TR_OpaqueClassBlock *clazz)
    {
+   JITServer::ServerStream *stream = _compInfoPT->getMethodBeingCompiled()->_stream;
+   ClientSessionData *clientData = _compInfoPT->getClientData();
+   auto sharedROMClassCache = TR::CompilationInfo::get()->getJITServerSharedROMClassCache();
+   bool compressedRefs = sharedROMClassCache ? clientData->getOrCacheVMInfo(stream)->_compressObjectReferences : false;
+   std::vector<const J9ROMClass *> superclasses;
+   JITServerSharedROMClassCache::ClassLayout layout;
    bool classIsCached = true;
    // First check the cache
       {
-      OMR::CriticalSection getRemoteROMClass(_compInfoPT->getClientData()->getROMMapMonitor());
-      auto it = _compInfoPT->getClientData()->getROMClassMap().find(reinterpret_cast<J9Class *>(clazz));
-      if (it != _compInfoPT->getClientData()->getROMClassMap().end())
+      OMR::CriticalSection getRemoteROMClass(clientData->getROMMapMonitor());
+      auto it = clientData->getROMClassMap().find(reinterpret_cast<J9Class *>(clazz));
+      if (it != clientData->getROMClassMap().end())
          {
          // 'clazz' is cached. How about the reference slot info for this class?
          auto &refSlotsCache = it->second._referenceSlotsInClass;
+         // Another client with the same class hierarchy could have already provided this information
+         if (refSlotsCache.empty() && sharedROMClassCache &&
+             getSharedClassLayout(clientData, it->second, compressedRefs, superclasses, layout))
+            sharedROMClassCache->getReferenceSlots(it->second._romClass, layout, refSlotsCache);
+
          if (refSlotsCache.size() > 0)
             {
             // I have the reference fields cached. Copy them out.
@@ -1663,7 +1703,6 @@ TR_J9ServerVM::getReferenceSlotsInClass(TR::Compilation *comp, TR_OpaqueClassBlo
    int32_t numRefSlots = 0;
    int32_t *refSlots = NULL;
    // Send a message to the client to retrieve the desired data
-   JITServer::ServerStream *stream = _compInfoPT->getMethodBeingCompiled()->_stream;
    stream->write(JITServer::MessageType::VM_getReferenceSlotsInClass, clazz);
    auto recv = stream->read<std::string>();
    auto &slotsStr = std::get<0>(recv);
@@ -1679,9 +1718,9 @@ TR_J9ServerVM::getReferenceSlotsInClass(TR::Compilation *comp, TR_OpaqueClassBlo
    // If the class is cached, we can also cache the information about the reference slots.
    if (classIsCached)
       {
-      OMR::CriticalSection getRemoteROMClass(_compInfoPT->getClientData()->getROMMapMonitor());
-      auto it = _compInfoPT->getClientData()->getROMClassMap().find(reinterpret_cast<J9Class *>(clazz));
-      if (it != _compInfoPT->getClientData()->getROMClassMap().end())
+      OMR::CriticalSection getRemoteROMClass(clientData->getROMMapMonitor());
+      auto it = clientData->getROMClassMap().find(reinterpret_cast<J9Class *>(clazz));
+      if (it != clientData->getROMClassMap().end())
          {
          auto &refSlotsCache = it->second._referenceSlotsInClass;
          if (refSlots)
@@ -1692,6 +1731,11 @@ TR_J9ServerVM::getReferenceSlotsInClass(TR::Compilation *comp, TR_OpaqueClassBlo
             }
          // Add a 0 terminator for the sequence of reference slots.
          refSlotsCache.push_back(0);
+
+         // The layout must be recomputed since superclasses could have been unloaded in the meantime
+         if (sharedROMClassCache &&
+             getSharedClassLayout(clientData, it->second, compressedRefs, superclasses, layout))
+            sharedROMClassCache->cacheReferenceSlots(it->second._romClass, layout, refSlotsCache);
          }
       }
    return refSlots;
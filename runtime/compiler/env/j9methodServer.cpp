@@ -20,6 +20,7 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
  *******************************************************************************/
 
+#include <unordered_set>
 #include "j9methodServer.hpp"
 #include "control/CompilationRuntime.hpp"
 #include "control/CompilationThread.hpp"
@@ -30,6 +31,7 @@
 #include "exceptions/DataCacheError.hpp"
 #include "ilgen/J9ByteCodeIterator.hpp"
 #include "net/ServerStream.hpp"
+#include "runtime/JITServerSharedROMClassCache.hpp"
 
 
 static J9ROMMethod *
@@ -1824,6 +1826,152 @@ TR_ResolvedJ9JITServerMethod::cacheFields()
       }
    }
 
+void
+TR_ResolvedJ9JITServerMethod::prefetchBytecodeManifest()
+   {
+   auto serverVM = static_cast<TR_J9ServerVM *>(_fe);
+   auto compInfoPT = static_cast<TR::CompilationInfoPerThreadRemote *>(_fe->_compInfoPT);
+   TR::Compilation *comp = compInfoPT->getCompilation();
+
+   // Relocatable methods keep their field attributes in separate caches and need
+   // validation records for every query; keep using the regular path for them
+   if (comp->compileRelocatableCode())
+      {
+      cacheFields();
+      return;
+      }
+
+   // 1. Iterate through bytecodes and build the manifest of constant pool entries
+   // that ilgen is going to query and that are not cached yet:
+   // field and static references (field, declaring class and attributes) and class references.
+   // Only the first occurrence of each entry is added, which is also the one ilgen would query first.
+   bool doRuntimeResolve = compInfoPT->getClientData()->getRtResolve() && !comp->ilGenRequest().details().isMethodHandleThunk();
+   TR_J9ByteCodeIterator bci(0, this, _fe, comp);
+   J9Class *ramClass = constantPoolHdr();
+   std::vector<int32_t> fieldCPIndices;
+   std::vector<uint8_t> fieldFlags;
+   std::vector<int32_t> classCPIndices;
+   std::unordered_set<int32_t> seenCPIndices;
+   uint32_t numFieldsToCache = 0;
+   uint32_t numFieldAttributesToCache = 0;
+   uint32_t numStaticAttributesToCache = 0;
+   for (TR_J9ByteCode bc = bci.first(); bc != J9BCunknown; bc = bci.next())
+      {
+      uint8_t flags = 0;
+      bool isField = false;
+      bool isClass = false;
+      switch (bc)
+         {
+         case J9BCputfield:
+            flags |= MANIFEST_FIELD_IS_STORE;
+            // falling through on purpose
+         case J9BCgetfield:
+            isField = true;
+            break;
+         case J9BCputstatic:
+            flags |= MANIFEST_FIELD_IS_STORE;
+            // falling through on purpose
+         case J9BCgetstatic:
+            flags |= MANIFEST_FIELD_IS_STATIC;
+            isField = true;
+            break;
+         case J9BCnew:
+         case J9BCanewarray:
+         case J9BCmultianewarray:
+         case J9BCcheckcast:
+         case J9BCinstanceof:
+            isClass = !doRuntimeResolve;
+            break;
+         default:
+            break;
+         }
+      if (!isField && !isClass)
+         continue;
+
+      int32_t cpIndex = bci.next2Bytes();
+      if (!seenCPIndices.insert(cpIndex).second)
+         continue;
+
+      if (isField)
+         {
+         bool isStatic = (flags & MANIFEST_FIELD_IS_STATIC) != 0;
+         J9Class *declaringClass;
+         UDATA field;
+         TR_J9MethodFieldAttributes attributes;
+         bool fieldIsCached = serverVM->getCachedField(ramClass, cpIndex, &declaringClass, &field);
+         bool attributesAreCached = getCachedFieldAttributes(cpIndex, attributes, isStatic);
+         if (fieldIsCached && attributesAreCached)
+            continue;
+         if (!fieldIsCached)
+            numFieldsToCache++;
+         if (!attributesAreCached)
+            {
+            if (isStatic)
+               numStaticAttributesToCache++;
+            else
+               numFieldAttributesToCache++;
+            }
+         fieldCPIndices.push_back(cpIndex);
+         fieldFlags.push_back(flags);
+         }
+      else
+         {
+         OMR::CriticalSection getRemoteROMClass(compInfoPT->getClientData()->getROMMapMonitor());
+         auto &constantClassPoolCache = JITServerHelpers::getJ9ClassInfo(compInfoPT, _ramClass)._constantClassPoolCache;
+         if (constantClassPoolCache.find(cpIndex) == constantClassPoolCache.end())
+            classCPIndices.push_back(cpIndex);
+         }
+      }
+
+   // A single query is cheaper to make the regular way
+   int32_t numFields = fieldCPIndices.size();
+   int32_t numClasses = classCPIndices.size();
+   if (numFields + numClasses < 2)
+      return;
+
+   // 2. Send the manifest to the client, which answers all the entries in one message
+   _stream->write(JITServer::MessageType::ResolvedMethod_getBytecodeManifestData, _remoteMirror, fieldCPIndices, fieldFlags, classCPIndices);
+   auto recv = _stream->read<std::vector<J9Class *>, std::vector<UDATA>, std::vector<TR_J9MethodFieldAttributes>, std::vector<TR_OpaqueClassBlock *>>();
+   auto &declaringClasses = std::get<0>(recv);
+   auto &fields = std::get<1>(recv);
+   auto &attributes = std::get<2>(recv);
+   auto &classes = std::get<3>(recv);
+   TR_ASSERT(numFields == fields.size() && numFields == attributes.size(), "Number of received fields does not match the requested number");
+   TR_ASSERT(numClasses == classes.size(), "Number of received classes does not match the requested number");
+
+   // 3. Cache everything that was received. Attributes are only cached if no other
+   // thread did it in the meantime, because cacheFieldAttributes() expects new entries.
+   for (int32_t i = 0; i < numFields; ++i)
+      {
+      int32_t cpIndex = fieldCPIndices[i];
+      bool isStatic = (fieldFlags[i] & MANIFEST_FIELD_IS_STATIC) != 0;
+      TR_J9MethodFieldAttributes cachedAttributes;
+      if (!getCachedFieldAttributes(cpIndex, cachedAttributes, isStatic))
+         cacheFieldAttributes(cpIndex, attributes[i], isStatic);
+      }
+      {
+      OMR::CriticalSection getRemoteROMClass(compInfoPT->getClientData()->getROMMapMonitor());
+      for (int32_t i = 0; i < numFields; ++i)
+         serverVM->cacheField(ramClass, fieldCPIndices[i], declaringClasses[i], fields[i]);
+
+      auto &constantClassPoolCache = JITServerHelpers::getJ9ClassInfo(compInfoPT, _ramClass)._constantClassPoolCache;
+      for (int32_t i = 0; i < numClasses; ++i)
+         {
+         // Like getClassFromConstantPool(), only cache resolved classes
+         if (classes[i])
+            constantClassPoolCache.insert({classCPIndices[i], classes[i]});
+         }
+      }
+
+   // Account for the queries that were answered in advance
+   JITServerHelpers::_numBytecodeManifests++;
+   if (numFieldsToCache > 1)
+      JITServerHelpers::_numPrefetchedQueries[JITServer::MessageType::VM_getFields]++;
+   JITServerHelpers::_numPrefetchedQueries[JITServer::MessageType::ResolvedMethod_fieldAttributes] += numFieldAttributesToCache;
+   JITServerHelpers::_numPrefetchedQueries[JITServer::MessageType::ResolvedMethod_staticAttributes] += numStaticAttributesToCache;
+   JITServerHelpers::_numPrefetchedQueries[JITServer::MessageType::ResolvedMethod_getClassFromConstantPool] += numClasses;
+   }
+
 int32_t
 TR_ResolvedJ9JITServerMethod::collectImplementorsCapped(
    TR_OpaqueClassBlock *topClass,
@@ -2750,7 +2898,8 @@ TR_J9ServerMethod::TR_J9ServerMethod(TR_FrontEnd * fe, TR_Memory * trMemory, J9C
       {
       // look up parameters for construction of this method in a cache first
       OMR::CriticalSection getRemoteROMClass(compInfoPT->getClientData()->getROMMapMonitor());
-      auto &cache = JITServerHelpers::getJ9ClassInfo(compInfoPT, aClazz)._J9MethodNameCache;
+      auto &classInfo = JITServerHelpers::getJ9ClassInfo(compInfoPT, aClazz);
+      auto &cache = classInfo._J9MethodNameCache;
       // search the cache for existing method parameters
       auto it = cache.find(cpIndex);
       if (it != cache.end())
@@ -2761,6 +2910,19 @@ TR_J9ServerMethod::TR_J9ServerMethod(TR_FrontEnd * fe, TR_Memory * trMemory, J9C
          methodSignatureStr = params._methodSignatureStr;
          cached = true;
          }
+      else if (auto sharedROMClassCache = TR::CompilationInfo::get()->getJITServerSharedROMClassCache())
+         {
+         // The parameters only depend on the ROMClass, so another client could have provided them
+         J9MethodNameAndSignature params;
+         if (sharedROMClassCache->getMethodNameAndSignature(classInfo._romClass, cpIndex, params))
+            {
+            classNameStr = params._classNameStr;
+            methodNameStr = params._methodNameStr;
+            methodSignatureStr = params._methodSignatureStr;
+            cache.insert({cpIndex, params});
+            cached = true;
+            }
+         }
       }
 
    if (!cached)
@@ -2774,8 +2936,11 @@ TR_J9ServerMethod::TR_J9ServerMethod(TR_FrontEnd * fe, TR_Memory * trMemory, J9C
       methodSignatureStr = std::get<2>(recv);
 
       OMR::CriticalSection getRemoteROMClass(compInfoPT->getClientData()->getROMMapMonitor());
-      auto &cache = JITServerHelpers::getJ9ClassInfo(compInfoPT, aClazz)._J9MethodNameCache;
-      cache.insert({cpIndex, {classNameStr, methodNameStr, methodSignatureStr}});
+      auto &classInfo = JITServerHelpers::getJ9ClassInfo(compInfoPT, aClazz);
+      J9MethodNameAndSignature params = {classNameStr, methodNameStr, methodSignatureStr};
+      classInfo._J9MethodNameCache.insert({cpIndex, params});
+      if (auto sharedROMClassCache = TR::CompilationInfo::get()->getJITServerSharedROMClassCache())
+         sharedROMClassCache->cacheMethodNameAndSignature(classInfo._romClass, cpIndex, params);
       }
 
    _className = str2utf8(classNameStr.data(), classNameStr.length(), trMemory, heapAlloc);
@@ -232,6 +232,19 @@ public:
    bool addValidationRecordForCachedResolvedMethod(const TR_ResolvedMethodKey &key, TR_OpaqueMethodBlock *method);
    void cacheResolvedMethodsCallees(int32_t ttlForUnresolved = 2);
    void cacheFields();
+   /**
+      @brief Prefetch, in a single round trip, the constant pool data that ilgen will query for this method
+
+      Sends the client a manifest of the field, static and class references made by the bytecodes that are
+      not cached yet, and caches the answers. Subsumes cacheFields(). Enabled with -Xjit:enableJITServerPrefetch.
+   */
+   void prefetchBytecodeManifest();
+   // Flags describing a field or static reference in the manifest sent by prefetchBytecodeManifest()
+   enum ManifestFieldFlags : uint8_t
+      {
+      MANIFEST_FIELD_IS_STATIC = 0x1,
+      MANIFEST_FIELD_IS_STORE  = 0x2,
+      };
    int32_t collectImplementorsCapped(TR_OpaqueClassBlock *topClass, int32_t maxCount, int32_t cpIndexOrOffset, TR_YesNoMaybe useGetResolvedInterfaceMethod, TR_ResolvedMethod **implArray);
    bool isLambdaFormGeneratedMethod() { return _isLambdaFormGeneratedMethod; }
    static void packMethodInfo(TR_ResolvedJ9JITServerMethodInfo &methodInfo, TR_ResolvedJ9Method *resolvedMethod, TR_FrontEnd *fe);
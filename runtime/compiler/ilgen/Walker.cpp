@@ -216,7 +216,11 @@ TR::Block * TR_J9ByteCodeIlGenerator::walker(TR::Block * prevBlock)
 
       // Cache field info for every field/static loaded/stored in this method, which are later used by
       // jitFieldsAreSame/jitStaticAreSame when creating symbol references.
-      static_cast<TR_ResolvedJ9JITServerMethod *>(_methodSymbol->getResolvedMethod())->cacheFields();
+      // In prefetch mode, also get the field attributes and referenced classes in the same message.
+      if (TR::Options::_enableJITServerPrefetch)
+         static_cast<TR_ResolvedJ9JITServerMethod *>(_methodSymbol->getResolvedMethod())->prefetchBytecodeManifest();
+      else
+         static_cast<TR_ResolvedJ9JITServerMethod *>(_methodSymbol->getResolvedMethod())->cacheFields();
       }
 #endif
 
@@ -32,6 +32,7 @@
 #include <netinet/tcp.h>	/* for TCP_NODELAY option */
 #include <fcntl.h>
 #include <arpa/inet.h>
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h> /// gethostname, read, write
@@ -41,6 +42,17 @@ namespace JITServer
 {
 int ClientStream::_numConnectionsOpened = 0;
 int ClientStream::_numConnectionsClosed = 0;
+int ClientStream::_numConnectionsReused = 0;
+int ClientStream::_numSSLSessionsResumed = 0;
+SSL_SESSION *ClientStream::_sslSession = NULL;
+TR::Monitor *ClientStream::_poolMonitor = NULL;
+ClientStream *ClientStream::_pooledStreams = NULL;
+int ClientStream::_numPooledStreams = 0;
+ClientStream::ServerEndpoint *ClientStream::_endpoints = NULL;
+int ClientStream::_numEndpoints = 0;
+int ClientStream::_selectedEndpoint = 0;
+uint64_t ClientStream::_timeEndpointSelected = 0;
+int ClientStream::_abandonedEndpoint = -1;
 
 // used for checking server compatibility
 int ClientStream::_incompatibilityCount = 0;
@@ -52,6 +64,13 @@ const int ClientStream::INCOMPATIBILITY_COUNT_LIMIT = 1; // This needs to be sma
 // This is called during startup from rossa.cpp
 int ClientStream::static_init(TR::CompilationInfo *compInfo)
    {
+   _poolMonitor = TR::Monitor::create("JIT-JITServerClientStreamPoolMonitor");
+   if (!_poolMonitor)
+      return -1;
+
+   if (!initEndpoints(compInfo->getPersistentInfo()))
+      return -1;
+
    if (!CommunicationStream::useSSL())
       return 0;
 
@@ -128,6 +147,11 @@ int ClientStream::static_init(TR::CompilationInfo *compInfo)
 
 void ClientStream::freeSSLContext()
    {
+   if (_sslSession)
+      {
+      (*OSSL_SESSION_free)(_sslSession);
+      _sslSession = NULL;
+      }
    if (_sslCtx)
       {
       (*OSSL_CTX_free)(_sslCtx);
@@ -137,6 +161,173 @@ void ClientStream::freeSSLContext()
 
 SSL_CTX *ClientStream::_sslCtx = NULL;
 
+// Build the list of servers from -XX:JITServerAlternateAddresses=<host>[:<port>][,<host>[:<port>]...]
+// Endpoint 0 stands for the server given by -XX:JITServerAddress and -XX:JITServerPort.
+bool
+ClientStream::initEndpoints(TR::PersistentInfo *info)
+   {
+   const std::string &alternates = info->getJITServerAlternateAddresses();
+   size_t maxEndpoints = 1 + std::count(alternates.begin(), alternates.end(), ',') + (alternates.empty() ? 0 : 1);
+   _endpoints = (ServerEndpoint *)TR_Memory::jitPersistentAlloc(maxEndpoints * sizeof(ServerEndpoint));
+   if (!_endpoints)
+      return false;
+
+   new (&_endpoints[0]) ServerEndpoint();
+   _numEndpoints = 1;
+
+   size_t start = 0;
+   while (start < alternates.size())
+      {
+      size_t end = alternates.find(',', start);
+      if (end == std::string::npos)
+         end = alternates.size();
+      std::string address = alternates.substr(start, end - start);
+      start = end + 1;
+      if (address.empty())
+         continue;
+
+      uint32_t port = info->getJITServerPort();
+      size_t colon = address.rfind(':');
+      if (colon != std::string::npos)
+         {
+         char *endPtr = NULL;
+         unsigned long value = strtoul(address.c_str() + colon + 1, &endPtr, 10);
+         if ((*endPtr != '\0') || (value == 0) || (value > 65535))
+            {
+            if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+               TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Ignoring invalid JITServer alternate address '%s'", address.c_str());
+            continue;
+            }
+         port = (uint32_t)value;
+         address.erase(colon);
+         }
+
+      ServerEndpoint *endpoint = new (&_endpoints[_numEndpoints++]) ServerEndpoint();
+      endpoint->_address = address;
+      endpoint->_port = port;
+      }
+   return true;
+   }
+
+// Stay with the selected server until it fails or until the rebalance period expires.
+// At that point move to the least loaded server that has not failed recently,
+// but only if it is significantly less loaded than the selected one: each move costs
+// new connections and, at the new server, caching the client's data all over again.
+int
+ClientStream::selectEndpoint(TR::PersistentInfo *info)
+   {
+   if (_numEndpoints <= 1)
+      return 0;
+
+   uint64_t crtTime = info->getElapsedTime();
+   int current = _selectedEndpoint;
+   bool currentUsable = !isEndpointBackingOff(current, crtTime);
+   if (currentUsable && (crtTime - _timeEndpointSelected < (uint64_t)TR::Options::_jitserverRebalancePeriodMs))
+      return current;
+
+   int best = -1;
+   for (int i = 0; i < _numEndpoints; ++i)
+      {
+      if (!isEndpointBackingOff(i, crtTime) && ((best < 0) || (_endpoints[i]._load < _endpoints[best]._load)))
+         best = i;
+      }
+   // All servers failed recently; try the one that failed first
+   if (best < 0)
+      {
+      best = 0;
+      for (int i = 1; i < _numEndpoints; ++i)
+         {
+         if (_endpoints[i]._failureTime < _endpoints[best]._failureTime)
+            best = i;
+         }
+      }
+
+   if (currentUsable && (_endpoints[best]._load + ENDPOINT_LOAD_MARGIN > _endpoints[current]._load))
+      best = current;
+
+   if ((best != current) && TR::Options::getVerboseOption(TR_VerboseJITServer))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Switching from JITServer %s:%u (load %u%s) to JITServer %s:%u (load %u)",
+         getEndpointAddress(current, info).c_str(), getEndpointPort(current, info), _endpoints[current]._load,
+         currentUsable ? "" : ", failed", getEndpointAddress(best, info).c_str(), getEndpointPort(best, info), _endpoints[best]._load);
+
+   // Only a healthy server that was left because of its load still holds a session worth terminating;
+   // contacting a server that just failed would block the compilation thread until the connect times out
+   if ((best != current) && currentUsable)
+      _abandonedEndpoint = current;
+   _selectedEndpoint = best;
+   _timeEndpointSelected = crtTime;
+   return best;
+   }
+
+void
+ClientStream::terminateSessionAtAbandonedEndpoint(TR::PersistentInfo *info)
+   {
+   // Check first without acquiring the monitor
+   if ((_numEndpoints <= 1) || (_abandonedEndpoint < 0))
+      return;
+
+   int endpoint = -1;
+      {
+      OMR::CriticalSection takingEndpoint(_poolMonitor);
+      endpoint = _abandonedEndpoint;
+      _abandonedEndpoint = -1;
+      }
+   if ((endpoint < 0) || (endpoint == _selectedEndpoint))
+      return;
+
+   try
+      {
+      ClientStream client(info, endpoint);
+      client.writeError(MessageType::clientSessionTerminate, info->getClientUID());
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Sent clientSessionTerminate message to JITServer %s:%u",
+            getEndpointAddress(endpoint, info).c_str(), getEndpointPort(endpoint, info));
+      }
+   catch (const StreamFailure &e)
+      {
+      // If the server is down its session for this client is gone anyway; if it is only unreachable,
+      // it will discard the stale session data when it times out waiting for the missing requests
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "JITServer StreamFailure when sending clientSessionTerminate to JITServer %s:%u: %s",
+            getEndpointAddress(endpoint, info).c_str(), getEndpointPort(endpoint, info), e.what());
+      }
+   }
+
+int
+ClientStream::reportEndpointFailure(int endpoint, TR::PersistentInfo *info)
+   {
+   if ((_numEndpoints <= 1) || (endpoint < 0))
+      return endpoint;
+
+   OMR::CriticalSection failingEndpoint(_poolMonitor);
+   _endpoints[endpoint]._failureTime = std::max(info->getElapsedTime(), (uint64_t)1);
+   if (_abandonedEndpoint == endpoint)
+      _abandonedEndpoint = -1;
+   return selectEndpoint(info);
+   }
+
+bool
+ClientStream::isConnectedToSelectedEndpoint(TR::PersistentInfo *info)
+   {
+   if (_numEndpoints <= 1)
+      return true;
+
+   OMR::CriticalSection checkingEndpoint(_poolMonitor);
+   return _endpoint == selectEndpoint(info);
+   }
+
+void
+ClientStream::updateServerLoad(uint32_t load)
+   {
+   if ((_numEndpoints <= 1) || (_endpoint < 0))
+      return;
+
+   OMR::CriticalSection updatingLoad(_poolMonitor);
+   _endpoints[_endpoint]._load = load;
+   // The server has just answered, so it is no longer considered failed
+   _endpoints[_endpoint]._failureTime = 0;
+   }
+
 static int
 openConnection(const std::string &address, uint32_t port, uint32_t timeoutMs)
    {
@@ -228,8 +419,17 @@ openConnection(const std::string &address, uint32_t port, uint32_t timeoutMs)
    return sockfd;
    }
 
+static SSL *
+getSSL(BIO *bio)
+   {
+   SSL *ssl = NULL;
+   if ((*OBIO_ctrl)(bio, BIO_C_GET_SSL, false, (char *)&ssl) != 1) // BIO_get_ssl(bio, &ssl)
+      return NULL;
+   return ssl;
+   }
+
 static BIO *
-openSSLConnection(SSL_CTX *ctx, int connfd)
+openSSLConnection(SSL_CTX *ctx, int connfd, SSL_SESSION *&cachedSession, TR::Monitor *sessionMonitor, bool &sessionResumed)
    {
    if (!ctx)
       return NULL;
@@ -241,8 +441,8 @@ openSSLConnection(SSL_CTX *ctx, int connfd)
       throw JITServer::StreamFailure("Failed to make new BIO");
       }
 
-   SSL *ssl = NULL;
-   if ((*OBIO_ctrl)(bio, BIO_C_GET_SSL, false, (char *)&ssl) != 1) // BIO_get_ssl(bio, &ssl)
+   SSL *ssl = getSSL(bio);
+   if (!ssl)
       {
       (*OERR_print_errors_fp)(stderr);
       (*OBIO_free_all)(bio);
@@ -256,6 +456,15 @@ openSSLConnection(SSL_CTX *ctx, int connfd)
       throw JITServer::StreamFailure("Cannot set file descriptor for SSL");
       }
 
+   // Offer the session of a previous connection so that the server can skip the full handshake.
+   // If the server does not accept the session, a full handshake is performed as usual.
+   // SSL_set_session() takes its own reference to the session, so the monitor is only needed here.
+      {
+      OMR::CriticalSection settingSession(sessionMonitor);
+      if (cachedSession && ((*OSSL_set_session)(ssl, cachedSession) != 1))
+         (*OERR_print_errors_fp)(stderr);
+      }
+
    if ((*OSSL_connect)(ssl) != 1)
       {
       (*OERR_print_errors_fp)(stderr);
@@ -279,18 +488,222 @@ openSSLConnection(SSL_CTX *ctx, int connfd)
       throw JITServer::StreamFailure("Server certificate verification failed");
       }
 
+   sessionResumed = (*OSSL_session_reused)(ssl) == 1;
+
    if (TR::Options::getVerboseOption(TR_VerboseJITServer))
-      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "SSL connection on socket 0x%x, Version: %s, Cipher: %s",
-                                     connfd, (*OSSL_get_version)(ssl), (*OSSL_get_cipher)(ssl));
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "SSL connection on socket 0x%x, Version: %s, Cipher: %s, Session resumed: %d",
+                                     connfd, (*OSSL_get_version)(ssl), (*OSSL_get_cipher)(ssl), sessionResumed);
    return bio;
    }
 
 ClientStream::ClientStream(TR::PersistentInfo *info)
-   : CommunicationStream(), _versionCheckStatus(NOT_DONE)
+   : CommunicationStream(), _versionCheckStatus(NOT_DONE), _requestedFeatureFlags(0), _nextPooledStream(NULL), _timeReleasedToPool(0),
+     _endpoint(0)
+   {
+   if (info->getJITServerUseMessageCompression())
+      _requestedFeatureFlags |= JITServerMessageCompression;
+
+   if (_numEndpoints > 1)
+      {
+      OMR::CriticalSection selectingEndpoint(_poolMonitor);
+      _endpoint = selectEndpoint(info);
+      }
+
+   // If the selected server cannot be reached, fail over to the next one
+   // right away instead of failing the compilation request
+   int connfd = -1;
+   for (int attempt = 1; ; ++attempt)
+      {
+      try
+         {
+         connfd = openConnection(getEndpointAddress(_endpoint, info), getEndpointPort(_endpoint, info), info->getSocketTimeout());
+         break;
+         }
+      catch (const StreamFailure &e)
+         {
+         int failedEndpoint = _endpoint;
+         _endpoint = reportEndpointFailure(failedEndpoint, info);
+         if ((attempt >= _numEndpoints) || (_endpoint == failedEndpoint))
+            throw;
+         if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Could not connect to JITServer %s:%u (%s); trying JITServer %s:%u",
+               getEndpointAddress(failedEndpoint, info).c_str(), getEndpointPort(failedEndpoint, info), e.what(),
+               getEndpointAddress(_endpoint, info).c_str(), getEndpointPort(_endpoint, info));
+         }
+      }
+   initConnection(connfd);
+   }
+
+ClientStream::ClientStream(TR::PersistentInfo *info, int endpoint)
+   : CommunicationStream(), _versionCheckStatus(NOT_DONE), _requestedFeatureFlags(0), _nextPooledStream(NULL), _timeReleasedToPool(0),
+     _endpoint(endpoint)
    {
-   int connfd = openConnection(info->getJITServerAddress(), info->getJITServerPort(), info->getSocketTimeout());
-   BIO *ssl = openSSLConnection(_sslCtx, connfd);
+   int connfd = openConnection(getEndpointAddress(_endpoint, info), getEndpointPort(_endpoint, info), info->getSocketTimeout());
+   initConnection(connfd);
+   }
+
+void
+ClientStream::initConnection(int connfd)
+   {
+   BIO *ssl = NULL;
+   if (_sslCtx)
+      {
+      bool sessionResumed = false;
+      ssl = openSSLConnection(_sslCtx, connfd, _sslSession, _poolMonitor, sessionResumed);
+      if (sessionResumed)
+         _numSSLSessionsResumed++;
+      }
    initStream(connfd, ssl);
    _numConnectionsOpened++;
    }
+
+ClientStream::ClientStream(const std::string &address, uint32_t port, uint32_t timeoutMs)
+   : CommunicationStream(), _versionCheckStatus(NOT_DONE), _requestedFeatureFlags(0), _nextPooledStream(NULL), _timeReleasedToPool(0),
+     _endpoint(-1)
+   {
+   // Connections to explicitly given endpoints (e.g. JITServer peers) are not encrypted:
+   // the SSL context only exists at the client and is set up for its one server
+   int connfd = openConnection(address, port, timeoutMs);
+   initStream(connfd, NULL);
+   _numConnectionsOpened++;
+   }
+
+ClientStream::~ClientStream()
+   {
+   if (_ssl)
+      cacheSSLSession();
+   _numConnectionsClosed++;
+   }
+
+void
+ClientStream::cacheSSLSession()
+   {
+   // With TLS 1.3 the session ticket is only received after the handshake completes,
+   // so the session is taken from a connection that has been used, right before closing it
+   SSL *ssl = getSSL(_ssl);
+   if (!ssl)
+      return;
+   SSL_SESSION *session = (*OSSL_get1_session)(ssl);
+   if (!session)
+      return;
+
+   OMR::CriticalSection cachingSession(_poolMonitor);
+   if (_sslSession)
+      (*OSSL_SESSION_free)(_sslSession);
+   _sslSession = session;
+   }
+
+bool
+ClientStream::releaseToPool(ClientStream *stream, TR::PersistentInfo *info)
+   {
+   if (stream->getVersionCheckStatus() != PASSED)
+      return false;
+
+   OMR::CriticalSection releasingStream(_poolMonitor);
+   if ((_numPooledStreams >= MAX_POOLED_STREAMS) || (stream->_endpoint != _selectedEndpoint))
+      return false;
+
+   stream->_timeReleasedToPool = info->getElapsedTime();
+   stream->_nextPooledStream = _pooledStreams;
+   _pooledStreams = stream;
+   _numPooledStreams++;
+   return true;
+   }
+
+ClientStream *
+ClientStream::acquireFromPool(TR::PersistentInfo *info)
+   {
+   uint64_t maxIdleTime = info->getSocketTimeout() / 2;
+   uint64_t crtTime = info->getElapsedTime();
+   ClientStream *staleStreams = NULL;
+   ClientStream *stream = NULL;
+      {
+      OMR::CriticalSection acquiringStream(_poolMonitor);
+      int endpoint = selectEndpoint(info);
+      // The most recently released stream is at the head of the list,
+      // so all the streams that follow a stale one are stale as well.
+      // Streams connected to a server other than the selected one are discarded too.
+      ClientStream **link = &_pooledStreams;
+      while (*link)
+         {
+         ClientStream *s = *link;
+         if (crtTime - s->_timeReleasedToPool > maxIdleTime)
+            {
+            *link = NULL;
+            ClientStream *last = s;
+            _numPooledStreams--;
+            while (last->_nextPooledStream)
+               {
+               last = last->_nextPooledStream;
+               _numPooledStreams--;
+               }
+            last->_nextPooledStream = staleStreams;
+            staleStreams = s;
+            break;
+            }
+         if ((s->_endpoint == endpoint) && !stream)
+            {
+            *link = s->_nextPooledStream;
+            s->_nextPooledStream = NULL;
+            _numPooledStreams--;
+            _numConnectionsReused++;
+            stream = s;
+            }
+         else if (s->_endpoint != endpoint)
+            {
+            *link = s->_nextPooledStream;
+            s->_nextPooledStream = staleStreams;
+            staleStreams = s;
+            _numPooledStreams--;
+            }
+         else
+            {
+            link = &s->_nextPooledStream;
+            }
+         }
+      }
+
+   // Close stale streams outside the monitor; the server has already dropped them
+   // or, for streams connected to a server that is no longer selected, will see them closed
+   while (staleStreams)
+      {
+      ClientStream *next = staleStreams->_nextPooledStream;
+      staleStreams->~ClientStream();
+      TR_Memory::jitPersistentFree(staleStreams);
+      staleStreams = next;
+      }
+   return stream;
+   }
+
+void
+ClientStream::closePooledStreams()
+   {
+   if (!_poolMonitor)
+      return;
+
+   ClientStream *streams = NULL;
+      {
+      OMR::CriticalSection closingStreams(_poolMonitor);
+      streams = _pooledStreams;
+      _pooledStreams = NULL;
+      _numPooledStreams = 0;
+      }
+
+   while (streams)
+      {
+      ClientStream *next = streams->_nextPooledStream;
+      try
+         {
+         streams->writeError(MessageType::connectionTerminate, 0 /* placeholder */);
+         }
+      catch (const StreamFailure &e)
+         {
+         if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "JITServer StreamFailure when sending connectionTerminate: %s", e.what());
+         }
+      streams->~ClientStream();
+      TR_Memory::jitPersistentFree(streams);
+      streams = next;
+      }
+   }
 };
@@ -69,10 +69,11 @@ public:
    static void freeSSLContext();
 
    explicit ClientStream(TR::PersistentInfo *info);
-   virtual ~ClientStream()
-      {
-      _numConnectionsClosed++;
-      }
+   /**
+      @brief Open an unencrypted connection to the given endpoint instead of the configured JITServer
+   */
+   ClientStream(const std::string &address, uint32_t port, uint32_t timeoutMs);
+   virtual ~ClientStream();
 
    /**
       @brief Send a compilation request to the JITServer
@@ -85,7 +86,7 @@ public:
       {
       if (getVersionCheckStatus() == NOT_DONE)
          {
-         _cMsg.setFullVersion(getJITServerVersion(), CONFIGURATION_FLAGS);
+         _cMsg.setFullVersion(getJITServerVersion(), CONFIGURATION_FLAGS | _requestedFeatureFlags);
          write(MessageType::compilationRequest, args...);
          _cMsg.clearFullVersion();
          }
@@ -161,6 +162,9 @@ public:
    void setVersionCheckStatus()
       {
       _versionCheckStatus = PASSED;
+      // The server understands compressed messages now that it is known to be compatible
+      if (_requestedFeatureFlags & JITServerMessageCompression)
+         enableCompression();
       }
 
    /**
@@ -198,20 +202,148 @@ public:
       return _incompatibilityCount < INCOMPATIBILITY_COUNT_LIMIT;
       }
 
+   /**
+      @brief Park a connection that is no longer needed by its compilation thread
+
+      When a compilation thread is suspended, its connection is kept in a small pool
+      of idle connections instead of being closed, so that the next compilation thread
+      needing a connection can avoid a new connect() and, with TLS, a new handshake.
+
+      @return true if the stream was pooled; false if the caller still owns the stream and must close it
+   */
+   static bool releaseToPool(ClientStream *stream, TR::PersistentInfo *info);
+
+   /**
+      @brief Take an idle connection from the pool
+
+      Pooled connections that have been idle for more than half the socket timeout are closed
+      instead of being returned, because the server drops idle connections when its own
+      read timeout expires.
+
+      @return An idle connection or NULL if there is no suitable connection in the pool
+   */
+   static ClientStream *acquireFromPool(TR::PersistentInfo *info);
+
+   /**
+      @brief Close all pooled connections, informing the server with a connectionTerminate message
+   */
+   static void closePooledStreams();
+
+   /**
+      @brief Index of the server endpoint this stream is connected to
+
+      Endpoint 0 is the server given by -XX:JITServerAddress/-XX:JITServerPort;
+      the others come from -XX:JITServerAlternateAddresses, in order.
+   */
+   int getEndpoint() const { return _endpoint; }
+
+   /**
+      @brief Answer whether this stream should still be used for new compilation requests
+
+      Returns false when the client has switched to a different server since this stream
+      was opened, either because the server of this stream failed or because another
+      server reported a sufficiently lower load. The caller should then close the stream
+      and open a new one, which will connect to the newly selected server.
+   */
+   bool isConnectedToSelectedEndpoint(TR::PersistentInfo *info);
+
+   /**
+      @brief Record the load reported by the server in its response to a compilation request
+
+      @param [in] load Server load as computed by computeServerLoad(); 100 means the server is at
+                       its "very high" active thread threshold or is running out of memory
+   */
+   void updateServerLoad(uint32_t load);
+
+   /**
+      @brief Record that communication with the given endpoint failed
+
+      The endpoint is avoided for FAILED_ENDPOINT_BACKOFF_MS if there are alternate servers;
+      if it was the selected endpoint, the least loaded usable one becomes selected.
+
+      @return The endpoint selected after the failure; same as the failed one if there is no alternative
+   */
+   static int reportEndpointFailure(int endpoint, TR::PersistentInfo *info);
+
+   /**
+      @brief Delete the client session at the server that the client has just moved away from
+
+      The server keeps the session of this client and would assume that it is up to date
+      (unloaded classes, CHTable updates, etc.) if the client came back to it later.
+      Terminating the session makes the server ask for the full client state instead.
+      This is a no-op unless, since the last call, the client moved away from a healthy server because of its load;
+      a server left because it failed is not contacted.
+   */
+   static void terminateSessionAtAbandonedEndpoint(TR::PersistentInfo *info);
+
+   static int getNumEndpoints() { return _numEndpoints; }
+
    // Statistics
    static int getNumConnectionsOpened() { return _numConnectionsOpened; }
    static int getNumConnectionsClosed() { return _numConnectionsClosed; }
+   static int getNumConnectionsReused() { return _numConnectionsReused; }
+   static int getNumSSLSessionsResumed() { return _numSSLSessionsResumed; }
 
 private:
+   static const int MAX_POOLED_STREAMS = 8;
+   static const uint64_t FAILED_ENDPOINT_BACKOFF_MS = 10000; // ms
+   static const uint32_t ENDPOINT_LOAD_MARGIN = 25; // another server must be this much less loaded to switch to it
+
+   struct ServerEndpoint
+      {
+      std::string _address; // unused for endpoint 0, whose address can change at run time (e.g. on CRIU restore)
+      uint32_t _port;
+      uint32_t _load; // last load reported by the server
+      uint64_t _failureTime; // elapsed time (ms) of the last communication failure; 0 if none
+      };
+
+   // Connect to the given endpoint, without failing over to other ones
+   ClientStream(TR::PersistentInfo *info, int endpoint);
+   void initConnection(int connfd);
+   void cacheSSLSession();
+
+   static bool initEndpoints(TR::PersistentInfo *info);
+   static const std::string &getEndpointAddress(int endpoint, TR::PersistentInfo *info)
+      {
+      return (endpoint == 0) ? info->getJITServerAddress() : _endpoints[endpoint]._address;
+      }
+   static uint32_t getEndpointPort(int endpoint, TR::PersistentInfo *info)
+      {
+      return (endpoint == 0) ? info->getJITServerPort() : _endpoints[endpoint]._port;
+      }
+   static bool isEndpointBackingOff(int endpoint, uint64_t crtTime)
+      {
+      return _endpoints[endpoint]._failureTime && (crtTime - _endpoints[endpoint]._failureTime < FAILED_ENDPOINT_BACKOFF_MS);
+      }
+   // Must be called with _poolMonitor held
+   static int selectEndpoint(TR::PersistentInfo *info);
+
    static int _numConnectionsOpened;
    static int _numConnectionsClosed;
+   static int _numConnectionsReused;
+   static int _numSSLSessionsResumed;
    VersionCheckStatus _versionCheckStatus; // indicates whether a version checking has been performed
+   uint32_t _requestedFeatureFlags; // negotiable JITServerCompatibilityFlags sent with the first compilation request
+   ClientStream *_nextPooledStream;
+   uint64_t _timeReleasedToPool; // elapsed time (ms) when this stream was parked in the pool
+   int _endpoint; // index in _endpoints of the server this stream is connected to; -1 for explicitly given endpoints
    static int _incompatibilityCount;
    static uint64_t _incompatibleStartTime; // Time when version incomptibility has been detected
    static const uint64_t RETRY_COMPATIBILITY_INTERVAL_MS; // (ms) When we should perform again a version compatibilty check
    static const int INCOMPATIBILITY_COUNT_LIMIT;
 
    static SSL_CTX *_sslCtx;
+   static SSL_SESSION *_sslSession; // last resumable session, offered to the server on new connections
+   static TR::Monitor *_poolMonitor; // guards the pool of idle streams and _sslSession
+   static ClientStream *_pooledStreams;
+   static int _numPooledStreams;
+
+   // Servers this client can send compilation requests to; guarded by _poolMonitor
+   static ServerEndpoint *_endpoints;
+   static int _numEndpoints;
+   static int _selectedEndpoint;
+   static uint64_t _timeEndpointSelected; // elapsed time (ms) when _selectedEndpoint was last (re)evaluated
+   static int _abandonedEndpoint; // healthy endpoint the client moved away from, whose client session must be terminated; -1 if none
    };
 
 }
@@ -20,10 +20,13 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
  *******************************************************************************/
 
+#include <algorithm>
+#include <limits.h>
 #include "control/CompilationRuntime.hpp"
 #include "control/Options.hpp" // TR::Options::useCompressedPointers()
 #include "env/CompilerEnv.hpp" // for TR::Compiler->target.is64Bit()
 #include "net/CommunicationStream.hpp"
+#include "zlib.h"
 
 
 namespace JITServer
@@ -33,12 +36,31 @@ uint32_t CommunicationStream::CONFIGURATION_FLAGS = 0;
 
 uint32_t CommunicationStream::_msgTypeCount[] = {0};
 uint64_t CommunicationStream::_totalMsgSize = 0;
+uint32_t CommunicationStream::_numCompressedMsgs = 0;
+uint64_t CommunicationStream::_totalCompressedMsgSize = 0;
+uint64_t CommunicationStream::_totalUncompressedMsgSize = 0;
+uint32_t CommunicationStream::_numZeroCopyMsgs = 0;
+uint64_t CommunicationStream::_totalZeroCopyBytes = 0;
 uint32_t CommunicationStream::_lastReadError = 0;
 uint32_t CommunicationStream::_numConsecutiveReadErrorsOfSameType = 0;
 #if defined(MESSAGE_SIZE_STATS)
 TR_Stats CommunicationStream::_msgSizeStats[];
+TR_Stats CommunicationStream::_compressedMsgSizeStats[];
 #endif /* defined(MESSAGE_SIZE_STATS) */
 
+CommunicationStream::~CommunicationStream()
+   {
+   if (_ssl)
+      (*OBIO_free_all)(_ssl);
+   if (_connfd != -1)
+      close(_connfd);
+   if (_compressionBuffer)
+      {
+      _compressionBuffer->~MessageBuffer();
+      TR::Compiler->persistentGlobalAllocator().deallocate(_compressionBuffer);
+      }
+   }
+
 void
 CommunicationStream::initConfigurationFlags()
    {
@@ -85,21 +107,23 @@ CommunicationStream::readMessage(Message &msg)
       }
 
    // bytesRead >= sizeof(uint32_t)
-   uint32_t serializedSize = ((uint32_t *)buffer)[0];
-   if (bytesRead > serializedSize)
+   uint32_t frameSize = ((uint32_t *)buffer)[0];
+   bool isCompressed = (frameSize & COMPRESSED_MESSAGE_FLAG) != 0;
+   frameSize &= ~COMPRESSED_MESSAGE_FLAG;
+   if (bytesRead > frameSize)
       {
       throw JITServer::StreamFailure("JITServer I/O error: read more than the message size");
       }
 
-   // serializedSize >= bytesRead
-   uint32_t bytesLeftToRead = serializedSize - bytesRead;
+   // frameSize >= bytesRead
+   uint32_t bytesLeftToRead = frameSize - bytesRead;
 
    if (bytesLeftToRead > 0)
       {
-      if (serializedSize > bufferCapacity)
+      if (frameSize > bufferCapacity)
          {
          // bytesRead could be less than the buffer capacity.
-         msg.expandBuffer(serializedSize, bytesRead);
+         msg.expandBuffer(frameSize, bytesRead);
 
          // The buffer storage will change after the buffer is expanded.
          buffer = msg.getBufferStartForRead();
@@ -108,6 +132,8 @@ CommunicationStream::readMessage(Message &msg)
       readBlocking(buffer + bytesRead, bytesLeftToRead);
       }
 
+   uint32_t serializedSize = isCompressed ? decompressMessage(msg, frameSize) : frameSize;
+
    msg.setSerializedSize(serializedSize);
 
    // rebuild the message
@@ -116,20 +142,188 @@ CommunicationStream::readMessage(Message &msg)
    // Update message count and size statistics
    _msgTypeCount[msg.type()] += 1;
    _totalMsgSize += serializedSize;
+   _numMessagesReceived++;
+   _numBytesReceived += frameSize;
 #if defined(MESSAGE_SIZE_STATS)
    _msgSizeStats[msg.type()].update(serializedSize);
 #endif /* defined(MESSAGE_SIZE_STATS) */
+   if (isCompressed)
+      {
+      _numCompressedMsgs++;
+      _totalCompressedMsgSize += frameSize;
+      _totalUncompressedMsgSize += serializedSize;
+#if defined(MESSAGE_SIZE_STATS)
+      _compressedMsgSizeStats[msg.type()].update(frameSize);
+#endif /* defined(MESSAGE_SIZE_STATS) */
+      }
    }
 
 void
 CommunicationStream::writeMessage(Message &msg)
    {
    char *serialMsg = msg.serialize();
+   uint32_t serializedSize = msg.serializedSize();
+   uint32_t frameSize = 0;
+   if (_compressionEnabled && (serializedSize >= COMPRESSION_THRESHOLD))
+      frameSize = compressMessage(msg, serializedSize);
+
    // write serialized message to the socket
-   writeBlocking(serialMsg, msg.serializedSize());
+   if (frameSize)
+      {
+      writeBlocking(_compressionBuffer->getBufferStart(), frameSize);
+      }
+   else if (msg.hasExternalSegments())
+      {
+      writeSegmentsBlocking(msg);
+      _numZeroCopyMsgs++;
+      _totalZeroCopyBytes += msg.getExternalDataSize();
+      }
+   else
+      {
+      writeBlocking(serialMsg, serializedSize);
+      }
+   _numBytesSent += frameSize ? frameSize : serializedSize;
    msg.clearForWrite();
    }
 
+void
+CommunicationStream::writeSegmentsBlocking(const Message &msg)
+   {
+   if (_ssl)
+      {
+      // BIO_write has no gather variant; write the segments one by one
+      msg.forEachSerializedSegment([this](const char *data, uint32_t size) { writeBlocking(data, size); });
+      return;
+      }
+
+   _iovecs.clear();
+   msg.forEachSerializedSegment([this](const char *data, uint32_t size)
+      {
+      struct iovec segment;
+      segment.iov_base = const_cast<char *>(data);
+      segment.iov_len = size;
+      _iovecs.push_back(segment);
+      });
+
+   size_t curSegment = 0;
+   while (curSegment < _iovecs.size())
+      {
+      int numSegments = (int)std::min(_iovecs.size() - curSegment, (size_t)IOV_MAX);
+      ssize_t bytesWritten = writev(_connfd, &_iovecs[curSegment], numSegments);
+      if (bytesWritten <= 0)
+         {
+         if (EINTR != errno)
+            {
+            throw JITServer::StreamFailure("JITServer I/O error: write error: " + std::string(strerror(errno)));
+            }
+         continue;
+         }
+
+      // Skip the fully written segments and adjust the partially written one
+      while (bytesWritten > 0)
+         {
+         struct iovec &segment = _iovecs[curSegment];
+         if ((size_t)bytesWritten >= segment.iov_len)
+            {
+            bytesWritten -= segment.iov_len;
+            curSegment++;
+            }
+         else
+            {
+            segment.iov_base = static_cast<char *>(segment.iov_base) + bytesWritten;
+            segment.iov_len -= bytesWritten;
+            bytesWritten = 0;
+            }
+         }
+      }
+   }
+
+MessageBuffer *
+CommunicationStream::getCompressionBuffer()
+   {
+   if (!_compressionBuffer)
+      {
+      // Use the global allocator, like for the streams themselves, because at the server
+      // the first use of this buffer may happen inside a per-client allocation region
+      void *storage = TR::Compiler->persistentGlobalAllocator().allocate(sizeof(MessageBuffer));
+      _compressionBuffer = new (storage) MessageBuffer();
+      }
+   return _compressionBuffer;
+   }
+
+uint32_t
+CommunicationStream::compressMessage(const Message &msg, uint32_t serializedSize)
+   {
+   MessageBuffer *compressionBuffer = getCompressionBuffer();
+   uLong maxCompressedSize = compressBound(serializedSize);
+   // Do not bother if the result is not guaranteed to fit in the size field
+   if (maxCompressedSize + COMPRESSED_MESSAGE_HEADER_SIZE >= COMPRESSED_MESSAGE_FLAG)
+      return 0;
+
+   compressionBuffer->clear();
+   compressionBuffer->expandIfNeeded(COMPRESSED_MESSAGE_HEADER_SIZE + maxCompressedSize);
+   char *frame = compressionBuffer->getBufferStart();
+
+   // Deflate the segments of the message as a single stream, so that
+   // payloads held outside of the message buffer are not copied first
+   z_stream stream;
+   memset(&stream, 0, sizeof(stream));
+   if (deflateInit(&stream, Z_BEST_SPEED) != Z_OK)
+      return 0;
+   stream.next_out = (Bytef *)(frame + COMPRESSED_MESSAGE_HEADER_SIZE);
+   stream.avail_out = maxCompressedSize;
+
+   int rc = Z_OK;
+   msg.forEachSerializedSegment([&stream, &rc](const char *data, uint32_t size)
+      {
+      stream.next_in = (Bytef *)data;
+      stream.avail_in = size;
+      while ((rc == Z_OK) && (stream.avail_in > 0))
+         rc = deflate(&stream, Z_NO_FLUSH);
+      });
+   if (rc == Z_OK)
+      rc = deflate(&stream, Z_FINISH);
+   uLong compressedSize = stream.total_out;
+   deflateEnd(&stream);
+
+   if ((rc != Z_STREAM_END) || (compressedSize + COMPRESSED_MESSAGE_HEADER_SIZE >= serializedSize))
+      return 0;
+
+   uint32_t frameSize = COMPRESSED_MESSAGE_HEADER_SIZE + compressedSize;
+   ((uint32_t *)frame)[0] = frameSize | COMPRESSED_MESSAGE_FLAG;
+   ((uint32_t *)frame)[1] = serializedSize;
+   return frameSize;
+   }
+
+uint32_t
+CommunicationStream::decompressMessage(Message &msg, uint32_t frameSize)
+   {
+   if (frameSize < COMPRESSED_MESSAGE_HEADER_SIZE)
+      throw JITServer::StreamFailure("JITServer I/O error: compressed message is too small");
+
+   // Move the compressed frame out of the way so that the message can be inflated in place
+   MessageBuffer *compressionBuffer = getCompressionBuffer();
+   compressionBuffer->clear();
+   compressionBuffer->expandIfNeeded(frameSize);
+   char *frame = compressionBuffer->getBufferStart();
+   memcpy(frame, msg.getBufferStartForRead(), frameSize);
+
+   uint32_t serializedSize = ((uint32_t *)frame)[1];
+   uint64_t maxSerializedSize = (uint64_t)(frameSize - COMPRESSED_MESSAGE_HEADER_SIZE) * MAX_COMPRESSION_RATIO;
+   if ((serializedSize <= frameSize) || (serializedSize > maxSerializedSize))
+      throw JITServer::StreamFailure("JITServer I/O error: invalid size of compressed message: " + std::to_string(serializedSize));
+   if (serializedSize > msg.getBufferCapacity())
+      msg.expandBuffer(serializedSize, 0);
+
+   uLongf uncompressedSize = serializedSize;
+   int rc = uncompress((Bytef *)msg.getBufferStartForRead(), &uncompressedSize,
+                       (const Bytef *)(frame + COMPRESSED_MESSAGE_HEADER_SIZE), frameSize - COMPRESSED_MESSAGE_HEADER_SIZE);
+   if ((rc != Z_OK) || (uncompressedSize != serializedSize))
+      throw JITServer::StreamFailure("JITServer I/O error: failed to decompress message: " + std::to_string(rc));
+
+   return serializedSize;
+   }
+
 std::string
 CommunicationStream::showFullVersionIncompatibility(uint64_t serverFullVersion, uint64_t clientFullVersion)
    {
@@ -150,6 +344,9 @@ CommunicationStream::showFullVersionIncompatibility(uint64_t serverFullVersion,
       return "JDK version: server " + std::to_string(serverJDKVersion) +
              ", client " + std::to_string(clientJDKVersion);
 
+   serverFlags &= ~JITServerCompatibilityFlags::JITServerNegotiableFlagsMask;
+   clientFlags &= ~JITServerCompatibilityFlags::JITServerNegotiableFlagsMask;
+
    bool serverCompressesRefs = serverFlags & JITServerCompatibilityFlags::JITServerCompressedRef;
    bool clientCompressesRefs = clientFlags & JITServerCompatibilityFlags::JITServerCompressedRef;
    if (serverCompressesRefs != clientCompressesRefs)
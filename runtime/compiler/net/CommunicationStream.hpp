@@ -24,6 +24,8 @@
 #define COMMUNICATION_STREAM_H
 
 #include <unistd.h>
+#include <vector>
+#include <sys/uio.h>
 #include "infra/Statistics.hpp"
 #include "net/LoadSSLLibs.hpp"
 #include "net/Message.hpp"
@@ -35,10 +37,14 @@ namespace JITServer
 {
 // When adding another compatibility mask/flag, also add a new message in
 // CommunicationStream::showFullVersionIncompatibility that handles the new enum value.
+// Flags included in JITServerNegotiableFlagsMask do not need to match between client and server;
+// they are requests from the client that the server may or may not honor for the connection.
 enum JITServerCompatibilityFlags
    {
    JITServerJavaVersionMask    = 0x00000FFF,
    JITServerCompressedRef      = 0x00001000,
+   JITServerMessageCompression = 0x00002000,
+   JITServerNegotiableFlagsMask = JITServerMessageCompression,
    };
 
 class CommunicationStream
@@ -49,6 +55,11 @@ public:
 
    static uint32_t _msgTypeCount[MessageType::MessageType_MAXTYPE];
    static uint64_t _totalMsgSize;
+   static uint32_t _numCompressedMsgs; // number of compressed messages received
+   static uint64_t _totalCompressedMsgSize; // bytes received on the wire for compressed messages
+   static uint64_t _totalUncompressedMsgSize; // bytes of compressed messages after decompression
+   static uint32_t _numZeroCopyMsgs; // number of messages sent as a list of segments
+   static uint64_t _totalZeroCopyBytes; // payload bytes sent without being copied into a message buffer
    static uint32_t _lastReadError;
    static uint32_t _numConsecutiveReadErrorsOfSameType;
    // The max read retry should be 1 less than the max compile attempt so we do
@@ -56,6 +67,7 @@ public:
    static const uint32_t MAX_READ_RETRY = MAX_COMPILE_ATTEMPTS - 1;
 #if defined(MESSAGE_SIZE_STATS)
    static TR_Stats _msgSizeStats[MessageType::MessageType_MAXTYPE];
+   static TR_Stats _compressedMsgSizeStats[MessageType::MessageType_MAXTYPE]; // wire size of compressed messages
 #endif /* defined(MESSAGE_SIZE_STATS) */
 
    static void initConfigurationFlags();
@@ -76,6 +88,17 @@ public:
       {
       return Message::buildFullVersion(getJITServerVersion(), CONFIGURATION_FLAGS);
       }
+
+   /**
+      @brief Check whether the full version sent by a peer is compatible with ours
+
+      Negotiable flags are ignored because they do not affect how messages are interpreted.
+   */
+   static bool isCompatibleFullVersion(uint64_t peerFullVersion)
+      {
+      uint64_t negotiableFlags = ((uint64_t)JITServerNegotiableFlagsMask) << 32;
+      return (peerFullVersion & ~negotiableFlags) == getJITServerFullVersion();
+      }
    static std::string showFullVersionIncompatibility(uint64_t serverFullVersion, uint64_t clientFullVersion);
 
    static void printJITServerVersion()
@@ -89,16 +112,16 @@ public:
       return (_numConsecutiveReadErrorsOfSameType < MAX_READ_RETRY);
       }
 
+   // Traffic on this stream, as seen on the wire (i.e. after compression)
+   uint64_t getNumMessagesReceived() const { return _numMessagesReceived; }
+   uint64_t getNumBytesReceived() const { return _numBytesReceived; }
+   uint64_t getNumBytesSent() const { return _numBytesSent; }
+
 protected:
-   CommunicationStream() : _ssl(NULL), _connfd(-1) { }
+   CommunicationStream() : _ssl(NULL), _connfd(-1), _compressionEnabled(false), _compressionBuffer(NULL),
+                           _numMessagesReceived(0), _numBytesReceived(0), _numBytesSent(0) { }
 
-   virtual ~CommunicationStream()
-      {
-      if (_ssl)
-         (*OBIO_free_all)(_ssl);
-      if (_connfd != -1)
-         close(_connfd);
-      }
+   virtual ~CommunicationStream();
 
    void initStream(int connfd, BIO *ssl)
       {
@@ -113,11 +136,32 @@ protected:
 
    int getConnFD() const { return _connfd; }
 
+   /**
+      @brief Compress outgoing messages larger than COMPRESSION_THRESHOLD bytes
+
+      Must only be called after the peer has been found to be compatible,
+      because an incompatible peer would not be able to decode compressed messages.
+      Incoming compressed messages are always accepted.
+   */
+   void enableCompression() { _compressionEnabled = true; }
+   bool isCompressionEnabled() const { return _compressionEnabled; }
+
    BIO *_ssl; // SSL connection, null if not using SSL
    int _connfd;
    ServerMessage _sMsg;
    ClientMessage _cMsg;
 
+   // A compressed message is encoded as the size of the compressed frame (including the 8 byte header)
+   // with COMPRESSED_MESSAGE_FLAG set, followed by the size of the original message and the zlib data.
+   // The high bit is never set in the size of a regular message.
+   static const uint32_t COMPRESSED_MESSAGE_FLAG = 0x80000000;
+   static const uint32_t COMPRESSED_MESSAGE_HEADER_SIZE = 2 * sizeof(uint32_t);
+   // Smaller messages are sent uncompressed because the savings do not pay for the CPU time
+   static const uint32_t COMPRESSION_THRESHOLD = 4096;
+   // zlib cannot compress data by more than about 1032:1, so a frame announcing a larger
+   // original size is corrupt; rejecting it keeps a bad peer from making us allocate up to 4 GB
+   static const uint32_t MAX_COMPRESSION_RATIO = 1032;
+
    // When increasing a version number here (especially MINOR_NUMBER), please
    // also change the ID comment to a unique value, preferably one that has
    // been randomly generated, e.g. using
@@ -129,11 +173,42 @@ protected:
    // likely to lose an increment when merging/rebasing/etc.
    //
    static const uint8_t MAJOR_NUMBER = 1;
-   static const uint16_t MINOR_NUMBER = 88; // ID: J8MYSx3aPHFVfmu+fM3E
+   static const uint16_t MINOR_NUMBER = 93; // ID: fSWVa6d3rdp2h3/N5v4H
    static const uint8_t PATCH_NUMBER = 0;
    static uint32_t CONFIGURATION_FLAGS;
 
 private:
+   /**
+      @brief Deflate the serialized message into _compressionBuffer
+
+      @return The size of the compressed frame, or 0 if compression failed or did not reduce the size
+   */
+   uint32_t compressMessage(const Message &msg, uint32_t serializedSize);
+
+   /**
+      @brief Inflate the compressed frame stored at the start of the message buffer
+
+      On return the message buffer contains the original serialized message.
+
+      @return The serialized size of the original message
+   */
+   uint32_t decompressMessage(Message &msg, uint32_t frameSize);
+
+   MessageBuffer *getCompressionBuffer();
+
+   /**
+      @brief Write a message that references external segments, using a single
+      gather write per batch of segments for plain sockets
+   */
+   void writeSegmentsBlocking(const Message &msg);
+
+   bool _compressionEnabled;
+   MessageBuffer *_compressionBuffer; // scratch buffer for compressed frames, allocated on first use
+   std::vector<struct iovec> _iovecs; // scratch list of segments for gather writes
+   uint64_t _numMessagesReceived;
+   uint64_t _numBytesReceived;
+   uint64_t _numBytesSent;
+
    void readBlocking(char *data, size_t size)
       {
       size_t totalBytesRead = 0;
@@ -71,6 +71,11 @@ OSSL_connect_t * OSSL_connect = NULL;
 OSSL_get_peer_certificate_t * OSSL_get_peer_certificate = NULL;
 OSSL_get_verify_result_t * OSSL_get_verify_result = NULL;
 OSSL_get_error_t * OSSL_get_error = NULL;
+OSSL_ctrl_t * OSSL_ctrl = NULL;
+OSSL_get1_session_t * OSSL_get1_session = NULL;
+OSSL_set_session_t * OSSL_set_session = NULL;
+OSSL_session_reused_t * OSSL_session_reused = NULL;
+OSSL_SESSION_free_t * OSSL_SESSION_free = NULL;
 
 OSSL_CTX_new_t * OSSL_CTX_new = NULL;
 OSSL_CTX_set_session_id_context_t * OSSL_CTX_set_session_id_context = NULL;
@@ -142,6 +147,13 @@ long OSSL110_CTX_set_ecdh_auto(SSL_CTX *ctx, int onoff)
    return ((onoff) != 0);
    }
 
+#define OPENSSL102_SSL_CTRL_GET_SESSION_REUSED 8
+int OSSL102_session_reused(const SSL *ssl)
+   {
+   // In 1.0.2 SSL_session_reused() is a macro around SSL_ctrl()
+   return (int)(*OSSL_ctrl)((SSL *)ssl, OPENSSL102_SSL_CTRL_GET_SESSION_REUSED, 0, NULL);
+   }
+
 const char * handle_SSL_get_cipher(const SSL *ssl)
    {
    return (*OSSL_CIPHER_get_name)((*OSSL_get_current_cipher)(ssl));
@@ -379,6 +391,11 @@ void dbgPrintSymbols()
    printf(" SSL_get_peer_certificate %p\n", OSSL_get_peer_certificate);
    printf(" SSL_get_verify_result %p\n", OSSL_get_verify_result);
    printf(" SSL_get_error %p\n", OSSL_get_error);
+   printf(" SSL_ctrl %p\n", OSSL_ctrl);
+   printf(" SSL_get1_session %p\n", OSSL_get1_session);
+   printf(" SSL_set_session %p\n", OSSL_set_session);
+   printf(" SSL_session_reused %p\n", OSSL_session_reused);
+   printf(" SSL_SESSION_free %p\n", OSSL_SESSION_free);
 
    printf(" SSL_CTX_new %p\n", OSSL_CTX_new);
    printf(" SSL_CTX_set_session_id_context %p\n", OSSL_CTX_set_session_id_context);
@@ -461,6 +478,8 @@ bool loadLibsslAndFindSymbols()
       Osk_X509_INFO_num = &Osk102_X509_INFO_num;
       Osk_X509_INFO_value = &Osk102_X509_INFO_value;
       Osk_X509_INFO_pop_free = &Osk102_X509_INFO_pop_free;
+
+      OSSL_session_reused = &OSSL102_session_reused;
       }
    else
       {
@@ -483,6 +502,8 @@ bool loadLibsslAndFindSymbols()
       Osk_X509_INFO_num = &Osk110_X509_INFO_num;
       Osk_X509_INFO_value = &Osk110_X509_INFO_value;
       Osk_X509_INFO_pop_free = &Osk110_X509_INFO_pop_free;
+
+      OSSL_session_reused = (OSSL_session_reused_t *)findLibsslSymbol(handle, "SSL_session_reused");
       }
    if (3 == ossl_ver)
       {
@@ -511,6 +532,10 @@ bool loadLibsslAndFindSymbols()
    OSSL_connect = (OSSL_connect_t *)findLibsslSymbol(handle, "SSL_connect");
    OSSL_get_verify_result = (OSSL_get_verify_result_t *)findLibsslSymbol(handle, "SSL_get_verify_result");
    OSSL_get_error = (OSSL_get_error_t *)findLibsslSymbol(handle, "SSL_get_error");
+   OSSL_ctrl = (OSSL_ctrl_t *)findLibsslSymbol(handle, "SSL_ctrl");
+   OSSL_get1_session = (OSSL_get1_session_t *)findLibsslSymbol(handle, "SSL_get1_session");
+   OSSL_set_session = (OSSL_set_session_t *)findLibsslSymbol(handle, "SSL_set_session");
+   OSSL_SESSION_free = (OSSL_SESSION_free_t *)findLibsslSymbol(handle, "SSL_SESSION_free");
 
    OSSL_CTX_new = (OSSL_CTX_new_t *)findLibsslSymbol(handle, "SSL_CTX_new");
    OSSL_CTX_set_session_id_context = (OSSL_CTX_set_session_id_context_t *)findLibsslSymbol(handle, "SSL_CTX_set_session_id_context");
@@ -587,6 +612,11 @@ bool loadLibsslAndFindSymbols()
        (OSSL_get_peer_certificate == NULL) ||
        (OSSL_get_verify_result == NULL) ||
        (OSSL_get_error == NULL) ||
+       (OSSL_ctrl == NULL) ||
+       (OSSL_get1_session == NULL) ||
+       (OSSL_set_session == NULL) ||
+       (OSSL_session_reused == NULL) ||
+       (OSSL_SESSION_free == NULL) ||
 
        (OSSL_CTX_new == NULL) ||
        (OSSL_CTX_set_session_id_context == NULL) ||
@@ -78,6 +78,11 @@ typedef int OSSL_connect_t(SSL *ssl);
 typedef X509 * OSSL_get_peer_certificate_t(const SSL *ssl);
 typedef long OSSL_get_verify_result_t(const SSL *ssl);
 typedef int OSSL_get_error_t(const SSL *ssl, int ret);
+typedef long OSSL_ctrl_t(SSL *ssl, int cmd, long larg, void *parg);
+typedef SSL_SESSION * OSSL_get1_session_t(SSL *ssl);
+typedef int OSSL_set_session_t(SSL *ssl, SSL_SESSION *session);
+typedef int OSSL_session_reused_t(const SSL *ssl);
+typedef void OSSL_SESSION_free_t(SSL_SESSION *session);
 
 typedef SSL_CTX * OSSL_CTX_new_t(const SSL_METHOD *method);
 typedef int OSSL_CTX_set_session_id_context_t(SSL_CTX *ctx, const unsigned char *sid_ctx, unsigned int sid_ctx_len);
@@ -150,6 +155,11 @@ extern "C" OSSL_connect_t * OSSL_connect;
 extern "C" OSSL_get_peer_certificate_t * OSSL_get_peer_certificate;
 extern "C" OSSL_get_verify_result_t * OSSL_get_verify_result;
 extern "C" OSSL_get_error_t * OSSL_get_error;
+extern "C" OSSL_ctrl_t * OSSL_ctrl;
+extern "C" OSSL_get1_session_t * OSSL_get1_session;
+extern "C" OSSL_set_session_t * OSSL_set_session;
+extern "C" OSSL_session_reused_t * OSSL_session_reused;
+extern "C" OSSL_SESSION_free_t * OSSL_SESSION_free;
 
 extern "C" OSSLv23_server_method_t * OSSLv23_server_method;
 extern "C" OSSLv23_client_method_t * OSSLv23_client_method;
@@ -43,7 +43,7 @@ namespace JITServer
    };
 
 uint32_t
-Message::addData(const DataDescriptor &desc, const void *dataStart, bool needs64BitAlignment)
+Message::writeDescriptor(const DataDescriptor &desc, bool needs64BitAlignment, uint8_t &initialPadding)
    {
    // Write the descriptor itself
    uint32_t descOffset = _buffer.writeValue(desc);
@@ -51,7 +51,7 @@ Message::addData(const DataDescriptor &desc, const void *dataStart, bool needs64
    // If the data following the descriptor needs to be 64-bit aligned,
    // add some initial padding in the outgoing buffer and write the
    // offset to the real payload into the descriptor
-   uint8_t initialPadding = 0;
+   initialPadding = 0;
    if (needs64BitAlignment && !_buffer.is64BitAligned())
       {
       initialPadding = _buffer.alignCurrentPositionOn64Bit();
@@ -59,6 +59,14 @@ Message::addData(const DataDescriptor &desc, const void *dataStart, bool needs64
       DataDescriptor *serializedDescriptor = _buffer.getValueAtOffset<DataDescriptor>(descOffset);
       serializedDescriptor->addInitialPadding(initialPadding);
       }
+   return descOffset;
+   }
+
+uint32_t
+Message::addData(const DataDescriptor &desc, const void *dataStart, bool needs64BitAlignment)
+   {
+   uint8_t initialPadding = 0;
+   uint32_t descOffset = writeDescriptor(desc, needs64BitAlignment, initialPadding);
 
    // Write the real data and possibly some padding at the end
    _buffer.writeData(dataStart, desc.getPayloadSize(), desc.getPaddingSize()); 
@@ -66,6 +74,29 @@ Message::addData(const DataDescriptor &desc, const void *dataStart, bool needs64
    return desc.getTotalSize() + initialPadding;
    }
 
+uint32_t
+Message::addDataByReference(const DataDescriptor &desc, const void *dataStart, bool needs64BitAlignment)
+   {
+   uint32_t payloadSize = desc.getPayloadSize();
+   if (payloadSize < ZERO_COPY_THRESHOLD)
+      return addData(desc, dataStart, needs64BitAlignment);
+
+   uint8_t initialPadding = 0;
+   uint32_t descOffset = writeDescriptor(desc, needs64BitAlignment, initialPadding);
+
+   // The external part is a multiple of 8 bytes, so that positions in the MessageBuffer
+   // and positions on the wire have the same 64-bit alignment, which addData() relies on.
+   // The remaining tail of the payload and the padding are copied into the buffer.
+   uint32_t externalSize = payloadSize & ~((uint32_t)0x7);
+   ExternalSegment segment = { _buffer.size(), static_cast<const char *>(dataStart), externalSize };
+   _externalSegments.push_back(segment);
+   _externalDataSize += externalSize;
+
+   _buffer.writeData(static_cast<const char *>(dataStart) + externalSize, payloadSize - externalSize, desc.getPaddingSize());
+   _descriptorOffsets.push_back(descOffset);
+   return desc.getTotalSize() + initialPadding;
+   }
+
 void
 Message::deserialize()
    {
@@ -42,6 +42,11 @@ namespace JITServer
 
    Each message contains an offset to metadata and a vector of offsets to data descriptors,
    where each descriptor describes a single value sent inside the message.
+
+   Large payloads added with addDataByReference() are not copied into the MessageBuffer.
+   Instead, the message records an external segment pointing to the caller's memory and
+   the serialized message is sent as a list of segments (see forEachSerializedSegment()).
+   Such memory must stay valid and unchanged until the message is written out.
 */
 class Message
    {
@@ -209,7 +214,7 @@ public:
       uint32_t _size; // Size of the data segment, which can include nested data
       }; // struct DataDescriptor
 
-   Message()
+   Message() : _externalDataSize(0)
       {
       // Reserve space for encoding the size and MetaData.
       // These will be populated at a later time
@@ -239,6 +244,23 @@ public:
    */
    uint32_t addData(const DataDescriptor &desc, const void *dataStart, bool needs64BitAlignment = false);
 
+   /**
+      @brief Add a new data point to the message without copying large payloads.
+
+      Behaves like addData(), but if the payload is at least ZERO_COPY_THRESHOLD bytes,
+      only the descriptor and the last few bytes of the payload are written to the MessageBuffer.
+      The rest of the payload is recorded as an external segment that is written to the
+      network straight from dataStart. The payload can therefore not be read back
+      from the outgoing message.
+
+      @param desc Descriptor for the new data
+      @param dataStart Pointer to the new data; must remain valid until the message is written
+      @param needs64BitAlignment Whether data following the descriptor needs to be 64-bit aligned
+
+      @return The total amount of data written (including padding, but not including the descriptor)
+   */
+   uint32_t addDataByReference(const DataDescriptor &desc, const void *dataStart, bool needs64BitAlignment = false);
+
    /**
       @brief Allocate space for a descriptor in the MessageBuffer
       and update the message structure without writing any actual data.
@@ -303,14 +325,45 @@ public:
    */
    char *serialize()
       {
-      *_buffer.getValueAtOffset<uint32_t>(0) = _buffer.size();
+      *_buffer.getValueAtOffset<uint32_t>(0) = serializedSize();
       return _buffer.getBufferStart();
       }
 
    /**
-      @brief Return the size of the serialized message.
+      @brief Return the size of the serialized message, including external segments.
    */
-   uint32_t serializedSize() { return _buffer.size(); }
+   uint32_t serializedSize() { return _buffer.size() + _externalDataSize; }
+
+   /**
+      @brief Return true if the serialized message is split into several segments.
+   */
+   bool hasExternalSegments() const { return !_externalSegments.empty(); }
+
+   uint32_t getNumExternalSegments() const { return _externalSegments.size(); }
+   uint32_t getExternalDataSize() const { return _externalDataSize; }
+
+   /**
+      @brief Invoke fn(const char *data, uint32_t size) for each contiguous piece
+      of the serialized message, in the order in which they must be sent.
+
+      serialize() must be called first.
+   */
+   template <typename Fn>
+   void forEachSerializedSegment(Fn fn) const
+      {
+      const char *bufferStart = _buffer.getBufferStart();
+      uint32_t bufferOffset = 0;
+      for (size_t i = 0; i < _externalSegments.size(); ++i)
+         {
+         const ExternalSegment &segment = _externalSegments[i];
+         if (segment._bufferOffset > bufferOffset)
+            fn(bufferStart + bufferOffset, segment._bufferOffset - bufferOffset);
+         fn(segment._data, segment._size);
+         bufferOffset = segment._bufferOffset;
+         }
+      if (_buffer.size() > bufferOffset)
+         fn(bufferStart + bufferOffset, _buffer.size() - bufferOffset);
+      }
 
    /**
       @brief Rebuild the message from the MessageBuffer
@@ -363,20 +416,55 @@ public:
    void clearForRead()
       {
       _descriptorOffsets.clear();
+      clearExternalSegments();
       _buffer.clear();
       }
 
    void clearForWrite()
       {
       _descriptorOffsets.clear();
+      clearExternalSegments();
       _buffer.clear();
       _buffer.reserveValue<uint32_t>(); // For writing the size
       _buffer.reserveValue<MetaData>(); // For writing the metadata
       }
 
    void print();
+
+   // Payloads smaller than this are copied into the MessageBuffer even when added by reference
+   static const uint32_t ZERO_COPY_THRESHOLD = 16384;
+
 protected:
+   /**
+      @class ExternalSegment
+      @brief Payload bytes that are sent from the caller's memory instead of the MessageBuffer.
+
+      On the wire, the segment is inserted before the MessageBuffer byte at _bufferOffset.
+   */
+   struct ExternalSegment
+      {
+      uint32_t _bufferOffset;
+      const char *_data;
+      uint32_t _size;
+      };
+
+   /**
+      @brief Write a descriptor to the MessageBuffer, followed by the padding needed
+      to align the data on a 64-bit boundary if requested.
+
+      @return The offset to the descriptor
+   */
+   uint32_t writeDescriptor(const DataDescriptor &desc, bool needs64BitAlignment, uint8_t &initialPadding);
+
+   void clearExternalSegments()
+      {
+      _externalSegments.clear();
+      _externalDataSize = 0;
+      }
+
    std::vector<uint32_t> _descriptorOffsets;
+   std::vector<ExternalSegment> _externalSegments;
+   uint32_t _externalDataSize; // Sum of the sizes of all external segments
    MessageBuffer _buffer; // Buffer used for send/receive operations
    };
 
@@ -79,6 +79,7 @@ const char *messageNames[] =
    "ResolvedMethod_stringConstant",
    "ResolvedMethod_getResolvedVirtualMethod",
    "ResolvedMethod_getMultipleResolvedMethods",
+   "ResolvedMethod_getBytecodeManifestData",
 #if defined(J9VM_OPT_METHOD_HANDLE)
    "ResolvedMethod_varHandleMethodTypeTableEntryAddress",
    "ResolvedMethod_isUnresolvedVarHandleMethodTypeTableEntry",
@@ -263,7 +264,9 @@ const char *messageNames[] =
    "AOTCache_getROMClassBatch",
    "AOTCache_getRAMClassFromClassRecordBatch",
    "AOTCacheMap_request",
-   "AOTCacheMap_reply"
+   "AOTCacheMap_reply",
+   "AOTCachePeer_request",
+   "AOTCachePeer_reply"
    };
 
    static_assert(sizeof(messageNames) / sizeof(messageNames[0]) == MessageType_MAXTYPE,
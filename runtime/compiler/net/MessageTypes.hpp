@@ -85,6 +85,7 @@ enum MessageType : uint16_t
    ResolvedMethod_stringConstant,
    ResolvedMethod_getResolvedVirtualMethod,
    ResolvedMethod_getMultipleResolvedMethods,
+   ResolvedMethod_getBytecodeManifestData,
 #if defined(J9VM_OPT_METHOD_HANDLE)
    ResolvedMethod_varHandleMethodTypeTableEntryAddress,
    ResolvedMethod_isUnresolvedVarHandleMethodTypeTableEntry,
@@ -295,6 +296,10 @@ enum MessageType : uint16_t
    AOTCacheMap_request,
    AOTCacheMap_reply,
 
+   // Used by JITServer instances to pull new AOT cache entries from their peers
+   AOTCachePeer_request,
+   AOTCachePeer_reply,
+
 
    MessageType_MAXTYPE
    };
@@ -49,7 +49,8 @@ struct Void
 //
 // RawTypeConvert::onSend(Message &msg, const T&val) - given a value of type T,
 // serializes it into an instance of Message::DataDescriptor and adds it to the message.
-// Returns the number of data bytes written.
+// Returns the number of data bytes written. Large contiguous payloads may be referenced
+// rather than copied (see Message::addDataByReference), so val must outlive the write.
 template <typename T, typename = void> struct RawTypeConvert { };
 template <> struct RawTypeConvert<uint32_t>
    {
@@ -125,7 +126,8 @@ template <> struct RawTypeConvert<const std::string>
       }
    static inline uint32_t onSend(Message &msg, const std::string &value)
       {
-      return msg.addData(Message::DataDescriptor(Message::DataDescriptor::DataType::STRING, value.length()), &value[0]);
+      // Large strings (e.g. packed ROMClasses, serialized AOT methods) are sent without copying them into the message buffer
+      return msg.addDataByReference(Message::DataDescriptor(Message::DataDescriptor::DataType::STRING, value.length()), &value[0]);
       }
    };
 
@@ -198,7 +200,7 @@ template <typename T> struct RawTypeConvert<T, typename std::enable_if<std::is_s
             Message::DataDescriptor desc(Message::DataDescriptor::DataType::SIMPLE_VECTOR, payloadSize);
             // Need to store the size of an element in the descriptor
             desc.setVectorElementSize(elemSize);
-            return msg.addData(desc, value.data(), elemSize > 4);
+            return msg.addDataByReference(desc, value.data(), elemSize > 4);
             }
          }
       // Complex vectors here
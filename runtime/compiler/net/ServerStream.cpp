@@ -21,6 +21,7 @@
  *******************************************************************************/
 
 #include "ServerStream.hpp"
+#include "control/CompilationRuntime.hpp"
 
 namespace JITServer
 {
@@ -28,13 +29,25 @@ int ServerStream::_numConnectionsOpened = 0;
 int ServerStream::_numConnectionsClosed = 0;
 
 ServerStream::ServerStream(int connfd, BIO *ssl)
-   : CommunicationStream()
+   : CommunicationStream(), _prevParked(NULL), _nextParked(NULL), _timeParked(0)
    {
    initStream(connfd, ssl);
    _numConnectionsOpened++;
    _pClientSessionData = NULL;
    }
 
+void
+ServerStream::negotiateFeatures(uint32_t clientFlags)
+   {
+   if ((clientFlags & JITServerMessageCompression) && !isCompressionEnabled() &&
+       TR::CompilationInfo::get()->getPersistentInfo()->getJITServerUseMessageCompression())
+      {
+      enableCompression();
+      if (TR::Options::getVerboseOption(TR_VerboseJITServerConns))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Enabled message compression on socket 0x%x", getConnFD());
+      }
+   }
+
 static bool handleCreateSSLContextError(SSL_CTX *&ctx, const char *errMsg)
    {
    perror(errMsg);
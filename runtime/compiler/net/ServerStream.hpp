@@ -74,6 +74,25 @@ public:
       _pClientSessionData = NULL;
       }
 
+   /**
+      @brief Socket descriptor of the connection, used to wait for the next request without tying up a thread
+   */
+   int getSocketFD() const { return getConnFD(); }
+
+   /**
+      @brief Return true if some input was already read from the socket and buffered by SSL
+   */
+   bool hasBufferedInput() const
+      {
+      return _ssl && ((*OBIO_ctrl)(_ssl, BIO_CTRL_PENDING, 0, NULL) > 0);
+      }
+
+   // Links in the list of streams parked with the listener thread, and elapsed time (ms) when
+   // the stream was parked; managed by TR_Listener under the compilation monitor
+   ServerStream *_prevParked;
+   ServerStream *_nextParked;
+   uint64_t _timeParked;
+
    /**
       @brief Send a message to the client
 
@@ -159,9 +178,11 @@ public:
    MessageType readCompileRequest(std::tuple<T...> &req, std::string &cacheName)
       {
       readMessage(_cMsg);
-      if (_cMsg.fullVersion() != 0 && _cMsg.fullVersion() != getJITServerFullVersion())
+      if (_cMsg.fullVersion() != 0)
          {
-         throw StreamVersionIncompatible(showFullVersionIncompatibility(getJITServerFullVersion(), _cMsg.fullVersion()));
+         if (!isCompatibleFullVersion(_cMsg.fullVersion()))
+            throw StreamVersionIncompatible(showFullVersionIncompatibility(getJITServerFullVersion(), _cMsg.fullVersion()));
+         negotiateFeatures(_cMsg.fullVersion() >> 32);
          }
 
       switch (_cMsg.type())
@@ -185,6 +206,12 @@ public:
             cacheName = std::get<0>(getArgsRaw<std::string>(_cMsg));
             }
             break;
+         case MessageType::AOTCachePeer_request:
+            {
+            // The remaining arguments are retrieved by the request handler with getRecvData()
+            cacheName = std::get<0>(getArgsRaw<std::string, uint64_t>(_cMsg));
+            }
+            break;
          default:
             {
             throw StreamMessageTypeMismatch(MessageType::compilationRequest, _cMsg.type());
@@ -297,6 +324,13 @@ public:
                                 const std::string &sslRootCerts);
 
 private:
+   /**
+      @brief Enable the optional features requested by a compatible client for this connection
+
+      @param clientFlags The JITServerCompatibilityFlags sent by the client
+   */
+   void negotiateFeatures(uint32_t clientFlags);
+
    static int _numConnectionsOpened;
    static int _numConnectionsClosed;
    uint64_t _clientId;  // UID of client connected to this communication stream
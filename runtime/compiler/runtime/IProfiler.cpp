@@ -77,6 +77,7 @@
 #include "ilgen/J9ByteCodeIterator.hpp"
 #include "runtime/IProfiler.hpp"
 #include "runtime/J9Profiler.hpp"
+#include "AtomicSupport.hpp"
 #include "omrformatconsts.h"
 #if defined(J9VM_OPT_CRIU_SUPPORT)
 #include "runtime/CRRuntime.hpp"
@@ -116,6 +117,10 @@ static J9PortLibrary *staticPortLib = NULL;
 static uint32_t memoryConsumed = 0;
 
 TR::PersistentAllocator * TR_IProfiler::_allocator = NULL;
+TR_IProfiler::EntryChunk * volatile TR_IProfiler::_entryChunks = NULL;
+volatile uint32_t TR_IProfiler::_numEntryChunks = 0;
+volatile uint32_t TR_IProfiler::_numBytecodeEntriesAllocated = 0;
+volatile uint32_t TR_IProfiler::_bytecodeEntryBytesAllocated = 0;
 
 static
 void printHashedCallSite ( TR_IPHashedCallSite * hcs, ::FILE* fout = stderr, void* tag = NULL) {
@@ -600,13 +605,14 @@ TR_IProfiler::TR_IProfiler(J9JITConfig *jitConfig)
      _valueProfileMethod(NULL), _lightHashTableMonitor(0), _allowedToGiveInlinedInformation(true),
      _globalAllocationCount (0), _maxCallFrequency(0), _iprofilerThread(0), _iprofilerOSThread(NULL),
      _workingBufferTail(NULL), _numOutstandingBuffers(0), _numRequests(1), _numRequestsDropped(0), _numRequestsSkipped(0),
-     _numRequestsHandedToIProfilerThread(0), _iprofilerMonitor(NULL),
-     _crtProfilingBuffer(NULL), _iprofilerNumRecords(0), _numMethodHashEntries(0),
+     _numRequestsHandedToIProfilerThread(0), _numBuffersParsedByIProfilerThreads(0), _numBuffersInvalidated(0),
+     _iprofilerMonitor(NULL), _crtProfilingBuffer(NULL), _numParserThreads(0), _iprofilerNumRecords(0), _numMethodHashEntries(0),
      _iprofilerThreadLifetimeState(TR_IprofilerThreadLifetimeStates::IPROF_THR_NOT_CREATED)
    {
    PORT_ACCESS_FROM_JITCONFIG(jitConfig);
 
    _iprofilerBufferSize = (uint32_t)jitConfig->iprofilerBufferSize; //J9_PROFILING_BUFFER_SIZE;
+   memset(_parserThreads, 0, sizeof(_parserThreads));
    _portLib = jitConfig->javaVM->portLibrary;
    _vm = TR_J9VMBase::get(jitConfig, 0);
    staticPortLib = _portLib;
@@ -1086,6 +1092,9 @@ TR_IProfiler::findOrCreateEntry(int32_t bucket, uintptr_t pc, bool addIt)
    {
    TR_IPBytecodeHashTableEntry *entry = NULL;
 
+   // Entries are only ever added at the head of a bucket, so all the
+   // entries following this one are covered by the search below
+   TR_IPBytecodeHashTableEntry *searchedHead = _bcHashTable[bucket];
    entry = searchForSample(pc, bucket);
    // if we are just searching and we didn't find profile data for the
    // method just go back
@@ -1114,22 +1123,27 @@ TR_IProfiler::findOrCreateEntry(int32_t bucket, uintptr_t pc, bool addIt)
    if (!entry)
       return NULL;
 
-   // While the entry is being allocated, another thread could have added an entry with the same PC.
-   // If that happened, it's likely that the duplicate entry is at the head of this list.
-   // Check to see if that's the case. This technique does not eliminate the race completely
-   // but catches most of duplicate situations.
-   TR_IPBytecodeHashTableEntry *headEntry = _bcHashTable[bucket];
-   if (headEntry && headEntry->getPC() == pc)
+   // Buffers are parsed concurrently by application threads and IProfiler parser threads.
+   // Publish the entry with a compare-and-swap on the head of the bucket; if the head changed
+   // since the search, only the newly added entries need to be checked for a duplicate PC.
+   while (true)
       {
-      delete entry; // Newly allocated entry is not needed
-      return headEntry;
-      }
-
-   entry->setNext(_bcHashTable[bucket]);
-   FLUSH_MEMORY(TR::Compiler->target.isSMP());
-   _bcHashTable[bucket] = entry;
+      TR_IPBytecodeHashTableEntry *headEntry = _bcHashTable[bucket];
+      for (TR_IPBytecodeHashTableEntry *e = headEntry; e != searchedHead; e = e->getNext())
+         {
+         if (e->getPC() == pc)
+            {
+            delete entry; // Newly allocated entry is not needed; its chunk space is simply not reused
+            return e;
+            }
+         }
 
-   return entry;
+      entry->setNext(headEntry);
+      if ((uintptr_t)headEntry == VM_AtomicSupport::lockCompareExchange(reinterpret_cast<volatile uintptr_t *>(&_bcHashTable[bucket]),
+                                                                        (uintptr_t)headEntry, (uintptr_t)entry))
+         return entry;
+      searchedHead = headEntry;
+      }
    }
 
 TR_IPBCDataAllocation *
@@ -1177,6 +1191,7 @@ TR_IProfiler::findOrCreateMethodEntry(J9Method *callerMethod, J9Method *calleeMe
 
    // Search the hashtable
    int32_t bucket = methodHash((uintptr_t)calleeMethod);
+   TR_IPMethodHashTableEntry *searchedHead = _methodHashTable[bucket];
    entry = searchForMethodSample((TR_OpaqueMethodBlock*)calleeMethod, bucket);
 
    if (!addIt)
@@ -1193,15 +1208,34 @@ TR_IProfiler::findOrCreateMethodEntry(J9Method *callerMethod, J9Method *calleeMe
       if (entry)
          {
          memset(entry, 0, sizeof(TR_IPMethodHashTableEntry));
-         entry->_next = _methodHashTable[bucket];
          entry->_method = (TR_OpaqueMethodBlock *)calleeMethod;
          // Set-up the first caller which is embedded in the entry
          entry->_caller.setMethod((TR_OpaqueMethodBlock*)callerMethod);
          entry->_caller.setPCIndex(pcIndex);
          entry->_caller.incWeight();
 
-         FLUSH_MEMORY(TR::Compiler->target.isSMP());
-         _methodHashTable[bucket] = entry; // chain it
+         // Chain it with a compare-and-swap, same as for bytecode entries
+         while (true)
+            {
+            TR_IPMethodHashTableEntry *headEntry = _methodHashTable[bucket];
+            for (TR_IPMethodHashTableEntry *e = headEntry; e != searchedHead; e = e->_next)
+               {
+               if (e->_method == (TR_OpaqueMethodBlock *)calleeMethod)
+                  {
+                  // Another thread added the callee first; record the caller there instead
+                  _allocator->deallocate(entry);
+                  memoryConsumed -= (int32_t)sizeof(TR_IPMethodHashTableEntry);
+                  e->add((TR_OpaqueMethodBlock *)callerMethod, (TR_OpaqueMethodBlock *)calleeMethod, pcIndex);
+                  return e;
+                  }
+               }
+
+            entry->_next = headEntry;
+            if ((uintptr_t)headEntry == VM_AtomicSupport::lockCompareExchange(reinterpret_cast<volatile uintptr_t *>(&_methodHashTable[bucket]),
+                                                                              (uintptr_t)headEntry, (uintptr_t)entry))
+               break;
+            searchedHead = headEntry;
+            }
          _numMethodHashEntries++;
          }
       }
@@ -2595,9 +2629,16 @@ TR_IProfiler::outputStats()
       fprintf(stderr, "IProfiler: Number of buffers to be dropped             =%" OMR_PRIu64 "\n", _numRequestsDropped);
       fprintf(stderr, "IProfiler: Number of buffers discarded                 =%" OMR_PRIu64 "\n", _numRequestsSkipped);
       fprintf(stderr, "IProfiler: Number of buffers handed to iprofiler thread=%" OMR_PRIu64 "\n", _numRequestsHandedToIProfilerThread);
+      fprintf(stderr, "IProfiler: Number of buffers parsed by iprofiler threads=%" OMR_PRIu64 "\n", _numBuffersParsedByIProfilerThreads);
+      fprintf(stderr, "IProfiler: Number of buffers invalidated               =%" OMR_PRIu64 "\n", _numBuffersInvalidated);
       }
    fprintf(stderr, "IProfiler: Number of records processed=%" OMR_PRIu64 "\n", _iprofilerNumRecords);
    fprintf(stderr, "IProfiler: Number of hashtable entries=%u\n", countEntries());
+   fprintf(stderr, "IProfiler: Number of entry chunks=%u (%u KB)\n", _numEntryChunks, (uint32_t)(_numEntryChunks * (ENTRY_CHUNK_SIZE >> 10)));
+   // Compare the chunk footprint with what the same entries took as individual allocator blocks
+   fprintf(stderr, "IProfiler: Number of bytecode entries allocated=%u (%u KB in chunks, %u KB as allocator blocks)\n",
+           _numBytecodeEntriesAllocated, _bytecodeEntryBytesAllocated >> 10,
+           (uint32_t)((_bytecodeEntryBytesAllocated + (uint64_t)_numBytecodeEntriesAllocated * ALLOCATOR_BLOCK_HEADER_SIZE) >> 10));
    fprintf(stderr, "IProfiler: Number of methodHash entries=%u\n", _numMethodHashEntries);
    checkMethodHashTable();
    }
@@ -2606,13 +2647,53 @@ TR_IProfiler::outputStats()
 void *
 TR_IPBytecodeHashTableEntry::operator new (size_t size) throw()
    {
-   memoryConsumed += (int32_t)size;
-   return TR_IProfiler::allocator()->allocate(size, std::nothrow);
+   return TR_IProfiler::allocateBytecodeEntry(size);
    }
 
-void TR_IPBytecodeHashTableEntry::operator delete(void *p) throw()
+// Bump-allocate from the current entry chunk. Application threads and IProfiler
+// parser threads can create entries concurrently, so the chunk top and the list
+// of chunks are both updated with compare-and-swap, and the statistics atomically.
+void *
+TR_IProfiler::allocateBytecodeEntry(size_t size)
    {
-   TR_IProfiler::allocator()->deallocate(p);
+   size = (size + ENTRY_ALIGNMENT - 1) & ~(ENTRY_ALIGNMENT - 1);
+   TR_ASSERT_FATAL(size <= ENTRY_CHUNK_SIZE - sizeof(EntryChunk) - ENTRY_ALIGNMENT, "IProfiler entry of %u bytes does not fit in a chunk", (uint32_t)size);
+   while (true)
+      {
+      EntryChunk *chunk = _entryChunks;
+      if (chunk)
+         {
+         uintptr_t top = chunk->_top;
+         if (top + size <= chunk->_end)
+            {
+            if (top == VM_AtomicSupport::lockCompareExchange(&chunk->_top, top, top + size))
+               {
+               VM_AtomicSupport::addU32(&_numBytecodeEntriesAllocated, 1);
+               VM_AtomicSupport::addU32(&_bytecodeEntryBytesAllocated, (uint32_t)size);
+               return (void *)top;
+               }
+            continue;
+            }
+         }
+
+      EntryChunk *newChunk = (EntryChunk *)_allocator->allocate(ENTRY_CHUNK_SIZE, std::nothrow);
+      if (!newChunk)
+         return NULL;
+      newChunk->_next = chunk;
+      newChunk->_top = ((uintptr_t)(newChunk + 1) + ENTRY_ALIGNMENT - 1) & ~(uintptr_t)(ENTRY_ALIGNMENT - 1);
+      newChunk->_end = (uintptr_t)newChunk + ENTRY_CHUNK_SIZE;
+      if ((uintptr_t)chunk == VM_AtomicSupport::lockCompareExchange(reinterpret_cast<volatile uintptr_t *>(&_entryChunks),
+                                                                    (uintptr_t)chunk, (uintptr_t)newChunk))
+         {
+         VM_AtomicSupport::addU32(&memoryConsumed, (uint32_t)ENTRY_CHUNK_SIZE);
+         VM_AtomicSupport::addU32(&_numEntryChunks, 1);
+         }
+      else
+         {
+         // Another thread installed a new chunk first
+         _allocator->deallocate(newChunk);
+         }
+      }
    }
 
 #if defined(J9VM_OPT_JITSERVER)
@@ -3734,6 +3815,31 @@ static int32_t J9THREAD_PROC iprofilerThreadProc(void * entryarg)
    return 0;
    }
 
+static int32_t J9THREAD_PROC iprofilerParserThreadProc(void * entryarg)
+   {
+   TR_IProfiler::ParserThread *parserThread = (TR_IProfiler::ParserThread *)entryarg;
+   TR_IProfiler *iProfiler = parserThread->_iprofiler;
+   J9JavaVM * vm = parserThread->_javaVM;
+   J9VMThread *vmThread = NULL;
+
+   int rc = vm->internalVMFunctions->internalAttachCurrentThread(vm, &vmThread, NULL,
+                                  J9_PRIVATE_FLAGS_DAEMON_THREAD | J9_PRIVATE_FLAGS_NO_OBJECT |
+                                  J9_PRIVATE_FLAGS_SYSTEM_THREAD | J9_PRIVATE_FLAGS_ATTACHED_THREAD,
+                                  parserThread->_osThread);
+   if (rc == JNI_OK)
+      {
+      j9thread_set_name(j9thread_self(), "JIT IProfiler Parser");
+      parserThread->_vmThread = vmThread;
+      iProfiler->processWorkingQueueInParserThread(parserThread);
+      vm->internalVMFunctions->DetachCurrentThread((JavaVM *) vm);
+      parserThread->_vmThread = NULL;
+      }
+
+   // Does not return
+   iProfiler->parserThreadExited();
+   return 0;
+   }
+
 
 void TR_IProfiler::startIProfilerThread(J9JavaVM *javaVM)
    {
@@ -3776,6 +3882,37 @@ void TR_IProfiler::startIProfilerThread(J9JavaVM *javaVM)
             _iprofilerThread = NULL;
             _iprofilerMonitor = NULL;
             }
+         else
+            {
+            // Start the threads that help the IProfiler thread drain the working queue
+            int32_t maxParserThreads = MAX_PARSER_THREADS;
+            int32_t numParserThreads = std::min(TR::Options::_iprofilerNumParserThreads, maxParserThreads) - 1;
+            for (int32_t i = 0; i < numParserThreads; ++i)
+               {
+               ParserThread *parserThread = &_parserThreads[i];
+               parserThread->_iprofiler = this;
+               parserThread->_javaVM = javaVM;
+               parserThread->_vmThread = NULL;
+               parserThread->_crtProfilingBuffer = NULL;
+
+               _iprofilerMonitor->enter();
+               _numParserThreads++;
+               _iprofilerMonitor->exit();
+               if (javaVM->internalVMFunctions->createThreadWithCategory(&parserThread->_osThread,
+                                               TR::Options::_profilerStackSize << 10,
+                                               priority,
+                                               0,
+                                               &iprofilerParserThreadProc,
+                                               parserThread,
+                                               J9THREAD_CATEGORY_SYSTEM_JIT_THREAD))
+                  {
+                  _iprofilerMonitor->enter();
+                  _numParserThreads--;
+                  _iprofilerMonitor->exit();
+                  break;
+                  }
+               }
+            }
          }
       }
    else
@@ -3834,9 +3971,25 @@ void TR_IProfiler::stopIProfilerThread()
       _iprofilerMonitor->wait();
       }
 
+   // Parser threads must be gone before the buffers can be deallocated
+   while (_numParserThreads > 0)
+      {
+      _iprofilerMonitor->notifyAll();
+      _iprofilerMonitor->wait();
+      }
+
    _iprofilerMonitor->exit();
    }
 
+void
+TR_IProfiler::parserThreadExited()
+   {
+   _iprofilerMonitor->enter();
+   _numParserThreads--;
+   _iprofilerMonitor->notifyAll();
+   j9thread_exit((J9ThreadMonitor*)_iprofilerMonitor->getVMMonitor());
+   }
+
 // The following method is executed by the app thread and tries to post a
 // iprofiling buffer to the working queue, so that the iprofiling thread
 // can process it
@@ -3901,7 +4054,8 @@ TR_IProfiler::postIprofilingBufferToWorkingQueue(J9VMThread * vmThread, const U_
 // Method executed by the java thread when jitHookBytecodeProfiling() is called
 bool TR_IProfiler::processProfilingBuffer(J9VMThread *vmThread, const U_8* dataStart, UDATA size)
    {
-   if (_numOutstandingBuffers >= TR::Options::_iprofilerNumOutstandingBuffers ||
+   // Each parser thread can keep up with as many outstanding buffers as the IProfiler thread
+   if (_numOutstandingBuffers >= TR::Options::_iprofilerNumOutstandingBuffers * (1 + _numParserThreads) ||
        _compInfo->getPersistentInfo()->getLoadFactor() >= 1) // More active threads than CPUs
       {
       if (100*_numRequestsSkipped >= (uint64_t)TR::Options::_iprofilerBufferMaxPercentageToDiscard * _numRequests)
@@ -3937,6 +4091,7 @@ TR_IProfiler::discardFilledIProfilerBuffers()
       {
       _freeBufferList.add(_workingBufferList.pop());
       _numOutstandingBuffers--;
+      _numBuffersInvalidated++;
       }
    _workingBufferTail = NULL;
    }
@@ -3995,7 +4150,8 @@ TR_IProfiler::processWorkingQueue()
          // process the buffer after acquiring VM access
          acquireVMAccessNoSuspend(_iprofilerThread);   // blocking. Will wait for the entire GC
          // Check to see if GC has invalidated this buffer
-         if (_crtProfilingBuffer->isValid())
+         bool isValid = _crtProfilingBuffer->isValid();
+         if (isValid)
             {
             //fprintf(stderr, "IProfiler thread will process buffer %p of size %u\n", profilingBuffer->getBuffer(), profilingBuffer->getSize());
             parseBuffer(_iprofilerThread, _crtProfilingBuffer->getBuffer(), _crtProfilingBuffer->getSize());
@@ -4008,6 +4164,10 @@ TR_IProfiler::processWorkingQueue()
          _freeBufferList.add(_crtProfilingBuffer);
          _crtProfilingBuffer = NULL;
          _numOutstandingBuffers--;
+         if (isValid)
+            _numBuffersParsedByIProfilerThreads++;
+         else
+            _numBuffersInvalidated++;
          }
       else if (getIProfilerThreadLifetimeState() == TR_IProfiler::IPROF_THR_SUSPENDING)
          {
@@ -4044,6 +4204,51 @@ TR_IProfiler::processWorkingQueue()
       } while(true);
    }
 
+// This method is executed by the IProfiler parser threads
+void
+TR_IProfiler::processWorkingQueueInParserThread(ParserThread *parserThread)
+   {
+   J9VMThread *vmThread = parserThread->_vmThread;
+
+   _iprofilerMonitor->enter();
+   while (getIProfilerThreadLifetimeState() != TR_IProfiler::IPROF_THR_STOPPING &&
+          getIProfilerThreadLifetimeState() != TR_IProfiler::IPROF_THR_DESTROYED)
+      {
+      // Only help while the IProfiler thread is accepting work; in any other state
+      // (e.g. suspended for checkpoint) leave the working queue to the IProfiler thread
+      if (_workingBufferList.isEmpty() ||
+          (getIProfilerThreadLifetimeState() != TR_IProfiler::IPROF_THR_INITIALIZED &&
+           getIProfilerThreadLifetimeState() != TR_IProfiler::IPROF_THR_WAITING_FOR_WORK))
+         {
+         _iprofilerMonitor->wait();
+         continue;
+         }
+
+      IProfilerBuffer *buffer = _workingBufferList.pop();
+      if (_workingBufferList.isEmpty())
+         _workingBufferTail = NULL;
+      parserThread->_crtProfilingBuffer = buffer;
+      _iprofilerMonitor->exit();
+
+      // Same as the IProfiler thread: parse with VM access and skip the buffer if GC invalidated it
+      acquireVMAccessNoSuspend(vmThread);
+      bool isValid = buffer->isValid();
+      if (isValid)
+         parseBuffer(vmThread, buffer->getBuffer(), buffer->getSize());
+      releaseVMAccess(vmThread);
+
+      _iprofilerMonitor->enter();
+      _freeBufferList.add(buffer);
+      parserThread->_crtProfilingBuffer = NULL;
+      _numOutstandingBuffers--;
+      if (isValid)
+         _numBuffersParsedByIProfilerThreads++;
+      else
+         _numBuffersInvalidated++;
+      }
+   _iprofilerMonitor->exit();
+   }
+
 extern "C" void stopInterpreterProfiling(J9JITConfig *jitConfig);
 
 /* Lower value will more aggressively skip samples as the number of unloaded classes increases */
@@ -4422,6 +4627,11 @@ void TR_IProfiler::invalidateProfilingBuffers() // called for class unloading
    // mark the current buffer as invalid; set with exclusive VM access
    if (_crtProfilingBuffer)
       _crtProfilingBuffer->setIsInvalidated(true);
+   for (int32_t i = 0; i < MAX_PARSER_THREADS - 1; ++i)
+      {
+      if (_parserThreads[i]._crtProfilingBuffer)
+         _parserThreads[i]._crtProfilingBuffer->setIsInvalidated(true);
+      }
 
    // add buffers in working queue to free list
    discardFilledIProfilerBuffers();
@@ -205,7 +205,7 @@ class TR_IPBytecodeHashTableEntry
    {
 public:
    void * operator new (size_t size) throw();
-   void operator delete(void *p) throw();
+   void operator delete(void *p) throw() {} // memory is owned by the IProfiler entry chunks
    void * operator new (size_t size, void * placement) {return placement;}
    void operator delete(void *p, void *) {}
 
@@ -688,6 +688,7 @@ public:
    static TR::PersistentAllocator *createPersistentAllocator(J9JITConfig *);
    static TR::PersistentAllocator *allocator() { return _allocator;}
    static void setAllocator(TR::PersistentAllocator *allocator) { _allocator = allocator; }
+   static void *allocateBytecodeEntry(size_t size);
    static uint32_t getProfilerMemoryFootprint();
 
    uintptr_t getReceiverClassFromCGProfilingData(TR_ByteCodeInfo &bcInfo, TR::Compilation *comp);
@@ -752,12 +753,31 @@ public:
 
 
 public:
+   /**
+    * @brief Additional thread parsing buffers from the working queue in parallel with the IProfiler thread
+    *
+    * Parser threads only drain the working queue. The lifetime state (including suspension
+    * for checkpoint) is driven by the IProfiler thread; parser threads stop parsing whenever
+    * the IProfiler thread is not accepting work and exit when it is being stopped.
+    */
+   struct ParserThread
+      {
+      TR_IProfiler *_iprofiler;
+      J9JavaVM *_javaVM;
+      j9thread_t _osThread;
+      J9VMThread *_vmThread;
+      IProfilerBuffer *_crtProfilingBuffer; // profiling buffer being processed by this thread
+      };
+   static const int32_t MAX_PARSER_THREADS = 16; // including the IProfiler thread
+
    J9VMThread* getIProfilerThread() { return _iprofilerThread; }
    void setIProfilerThread(J9VMThread* thread) { _iprofilerThread = thread; }
    j9thread_t getIProfilerOSThread() { return _iprofilerOSThread; }
    TR::Monitor* getIProfilerMonitor() { return _iprofilerMonitor; }
    bool processProfilingBuffer(J9VMThread *vmThread, const U_8* dataStart, UDATA size);
    void processWorkingQueue();
+   void processWorkingQueueInParserThread(ParserThread *parserThread);
+   void parserThreadExited();
    IProfilerBuffer *getCrtProfilingBuffer() const { return _crtProfilingBuffer; }
    void setCrtProfilingBuffer(IProfilerBuffer *b) { _crtProfilingBuffer = b; }
    void jitProfileParseBuffer(J9VMThread *vmThread);
@@ -875,6 +895,23 @@ private:
 
    // data members
    static TR::PersistentAllocator *_allocator;
+
+   // Bytecode hash table entries are never freed individually, so they are carved out
+   // of large chunks instead of paying for an allocator block header and a monitor
+   // enter/exit on every entry. Entries created together also end up next to each other.
+   struct EntryChunk
+      {
+      EntryChunk *_next;
+      volatile uintptr_t _top;
+      uintptr_t _end;
+      };
+   static const size_t ENTRY_CHUNK_SIZE = 64 * 1024;
+   static const size_t ENTRY_ALIGNMENT = sizeof(uint64_t); // entries have 64-bit fields, also on 32-bit platforms
+   static const size_t ALLOCATOR_BLOCK_HEADER_SIZE = 2 * sizeof(uintptr_t); // header of a persistent allocator block, for the footprint statistics
+   static EntryChunk * volatile _entryChunks;
+   static volatile uint32_t _numEntryChunks;
+   static volatile uint32_t _numBytecodeEntriesAllocated; // includes entries discarded after losing an insertion race
+   static volatile uint32_t _bytecodeEntryBytesAllocated;
    J9PortLibrary                  *_portLib;
    bool                            _isIProfilingEnabled; // set to TRUE in constructor; set to FALSE in shutdown()
    TR_J9VMBase                    *_vm;
@@ -907,12 +944,16 @@ private:
    TR_LinkHead0<IProfilerBuffer>   _workingBufferList;
    IProfilerBuffer                *_workingBufferTail;
    IProfilerBuffer                *_crtProfilingBuffer; // profiling buffer being processes by iprofiling thread
+   ParserThread                    _parserThreads[MAX_PARSER_THREADS - 1];
+   int32_t                         _numParserThreads; // parser threads created and not yet exited; guarded by _iprofilerMonitor
    TR::Monitor                    *_iprofilerMonitor;
    volatile int32_t                _numOutstandingBuffers;
    uint64_t                        _numRequests;
    uint64_t                        _numRequestsDropped;
    uint64_t                        _numRequestsSkipped;
    uint64_t                        _numRequestsHandedToIProfilerThread;
+   uint64_t                        _numBuffersParsedByIProfilerThreads; // by the IProfiler thread and parser threads
+   uint64_t                        _numBuffersInvalidated; // handed over, but discarded due to class unloading or shutdown
    uint64_t                        _iprofilerNumRecords; // info stats only
 
    TR_IPMethodHashTableEntry       **_methodHashTable;
@@ -192,17 +192,9 @@ J9::CodeCache::initialize(TR::CodeCacheManager *manager,
       uintptr_t coldSectionStart = middle;
       // Since we want to use large pages for the warm area, its end needs to be large page aligned.
       // We cannot determine the size of the THP page with j9vmem_supported_page_sizes(),
-      // but we know that on x86, the size of a THP page is 2 MB. Round up/down as needed.
-#if defined(TR_TARGET_X86)
-      static const uintptr_t THP_SIZE = 2 * 1024 * 1024; // 2 MB
-#elif defined(TR_TARGET_S390)
-      static const uintptr_t THP_SIZE = 1 * 1024 * 1024; // 1 MB
-#else
-      // Power has 64 KB and 16 MB pages (16 MB is too large to be useful for disclaiming)
-      // ARM can have many sizes for its large pages: 64 K, 1 MB, 2 MB, 16 MB)
-      static const uintptr_t THP_SIZE = 65536; // 64K
-#endif
-      static const uintptr_t ROUNDING_VALUE = THP_SIZE/2 - 1;
+      // so use the per architecture value. Round up/down as needed.
+      const uintptr_t THP_SIZE = TR::CodeCacheManager::transparentHugePageSize();
+      const uintptr_t ROUNDING_VALUE = THP_SIZE/2 - 1;
       if (codeCacheSegment->segmentTop() - codeCacheSegment->segmentBase() >= 2 * THP_SIZE)
          {
          coldSectionStart = (middle + ROUNDING_VALUE) & ~ROUNDING_VALUE;
@@ -881,6 +873,23 @@ extern "C"
    }
 
 
+void
+J9::CodeCache::getFragmentationStats(CodeCacheFragmentationStats &stats)
+   {
+   memset(&stats, 0, sizeof(stats));
+
+   CacheCriticalSection walkFreeBlocks(self());
+   stats._freeContiguousBytes = self()->getFreeContiguousSpace();
+   for (OMR::CodeCacheFreeCacheBlock *block = _freeBlockList; block; block = block->_next)
+      {
+      stats._numFreeBlocks++;
+      stats._freeBlockBytes += block->_size;
+      if (block->_size > stats._largestFreeBlock)
+         stats._largestFreeBlock = block->_size;
+      }
+   }
+
+
 int32_t
 J9::CodeCache::disclaim(TR::CodeCacheManager *manager, bool canDisclaimOnSwap)
    {
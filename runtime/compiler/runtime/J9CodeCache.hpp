@@ -46,6 +46,35 @@ namespace TR { class CodeCacheManager; }
 namespace J9
 {
 
+/**
+ * @brief Free space statistics of a single code cache. Free space is either the
+ *        contiguous area between the warm and cold allocation pointers or blocks
+ *        on the free block list that were reclaimed from unloaded or recompiled
+ *        method bodies.
+ */
+struct CodeCacheFragmentationStats
+   {
+   size_t   _freeContiguousBytes; // space between the warm and cold allocation pointers
+   size_t   _freeBlockBytes;      // space held in the free block list
+   size_t   _largestFreeBlock;    // largest entry in the free block list
+   uint32_t _numFreeBlocks;
+
+   size_t totalFreeBytes() const { return _freeContiguousBytes + _freeBlockBytes; }
+
+   /**
+    * @brief Percentage of the free space that cannot be handed out as a single
+    *        allocation, i.e. 0 when all free space is one contiguous region
+    */
+   double fragmentationPercent() const
+      {
+      size_t totalFree = totalFreeBytes();
+      if (totalFree == 0)
+         return 0.0;
+      size_t largest = _freeContiguousBytes > _largestFreeBlock ? _freeContiguousBytes : _largestFreeBlock;
+      return (totalFree - largest) * 100.0 / totalFree;
+      }
+   };
+
 class OMR_EXTENSIBLE CodeCache : public OMR::CodeCacheConnector
    {
    TR::CodeCache *self();
@@ -107,6 +136,13 @@ public:
 
    int32_t disclaim(TR::CodeCacheManager *manager, bool canDisclaimOnSwap);
 
+  /**
+   * @brief Collect free space statistics for this code cache. Acquires the code cache mutex.
+   *
+   * @param[out] stats : free space found between the allocation pointers and on the free block list
+   */
+   void getFragmentationStats(CodeCacheFragmentationStats &stats);
+
    private:
    /**
     * @brief Restore trampoline pointers to their initial positions
@@ -60,6 +60,49 @@ TR::CodeCacheManager *J9::CodeCacheManager::_codeCacheManager = NULL;
 J9JavaVM *J9::CodeCacheManager::_javaVM = NULL;
 J9JITConfig *J9::CodeCacheManager::_jitConfig = NULL;
 
+size_t
+J9::CodeCacheManager::transparentHugePageSize()
+   {
+#if defined(TR_TARGET_X86)
+   return 2 * 1024 * 1024; // 2 MB
+#elif defined(TR_TARGET_S390)
+   return 1 * 1024 * 1024; // 1 MB
+#else
+   // Power has 64 KB and 16 MB pages (16 MB is too large to be useful for code)
+   // ARM can have many sizes for its large pages: 64 K, 1 MB, 2 MB, 16 MB)
+   return 64 * 1024; // 64K
+#endif
+   }
+
+#if defined(LINUX)
+/**
+ * @brief Read the system wide THP policy, e.g. "always [madvise] never"
+ *
+ * @return the selected policy, or "unknown" if it cannot be read
+ */
+static const char *
+getTransparentHugePageSetting(char *buffer, size_t bufferSize)
+   {
+   const char *setting = "unknown";
+   ::FILE *file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+   if (file)
+      {
+      if (fgets(buffer, (int)bufferSize, file))
+         {
+         char *start = strchr(buffer, '[');
+         char *end = start ? strchr(start, ']') : NULL;
+         if (end)
+            {
+            *end = '\0';
+            setting = start + 1;
+            }
+         }
+      fclose(file);
+      }
+   return setting;
+   }
+#endif /* LINUX */
+
 TR::CodeCacheManager *
 J9::CodeCacheManager::self()
    {
@@ -304,10 +347,23 @@ J9::CodeCacheManager::allocateCodeCacheSegment(size_t segmentSize,
 
    // Determine whether we are actually using large pages.
    // Note that config.largeCodePageSize() could be set at the default page size (given by pageSize[0])
+   int32_t hugePageMode = TR::Options::_codeCacheHugePageMode;
    size_t largeCodePageSize = 0;
-   if (config.largeCodePageSize() > pageSizes[0])
+   if (config.largeCodePageSize() > pageSizes[0] &&
+       hugePageMode != HUGE_PAGES_THP &&
+       hugePageMode != HUGE_PAGES_NONE)
       largeCodePageSize = config.largeCodePageSize();
 
+   // Without explicit large pages we can still ask the kernel for transparent huge pages.
+   // They only help if the kernel can map whole huge pages, so in HUGE_PAGES_THP mode the
+   // segment start and size are THP aligned; this keeps the repository and the trampolines
+   // at the end of each code cache within huge page boundaries.
+   bool useTHP = false;
+#if defined(LINUX)
+   useTHP = largeCodePageSize == 0 && (hugePageMode == HUGE_PAGES_AUTO || hugePageMode == HUGE_PAGES_THP);
+#endif
+   size_t thpAlignment = (useTHP && hugePageMode == HUGE_PAGES_THP) ? transparentHugePageSize() : 0;
+
    if (largeCodePageSize > 0)
       {
       vmemParams.pageSize = largeCodePageSize;
@@ -353,6 +409,8 @@ J9::CodeCacheManager::allocateCodeCacheSegment(size_t segmentSize,
    codeCacheSizeToAllocate = std::max(segmentSize, (config.codeCachePadKB() << 10));
    // For virtual allocations the size must always be a multiple of the page size
    codeCacheSizeToAllocate = (codeCacheSizeToAllocate + (vmemParams.pageSize-1)) & (~(vmemParams.pageSize-1));
+   if (thpAlignment > vmemParams.pageSize)
+      codeCacheSizeToAllocate = OMR::align(codeCacheSizeToAllocate, thpAlignment);
    vmemParams.byteAmount = codeCacheSizeToAllocate;
 
    // Fail code cache allocation, if the available physical memory is low
@@ -374,6 +432,12 @@ J9::CodeCacheManager::allocateCodeCacheSegment(size_t segmentSize,
 #endif
    if (largeCodePageSize > 0)
       alignment = largeCodePageSize;
+   else if (thpAlignment > alignment)
+      alignment = thpAlignment;
+
+   // A THP aligned start is needed even when we don't care where the segment lands
+   if (thpAlignment > 0)
+      vmemParams.alignmentInBytes = alignment;
 
    if (preferredStartAddress)
       {
@@ -497,8 +561,10 @@ J9::CodeCacheManager::allocateCodeCacheSegment(size_t segmentSize,
          TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, verboseLogString, codeCacheSegment->baseAddress, codeCacheSegment->heapTop, alignment, largeCodePageSize);
          }
 #ifdef LINUX
-      if (0 != madvise((void *)codeCacheSegment->baseAddress, (codeCacheSegment->heapTop - codeCacheSegment->baseAddress), MADV_HUGEPAGE))
+      if (useTHP &&
+          0 != madvise((void *)codeCacheSegment->baseAddress, (codeCacheSegment->heapTop - codeCacheSegment->baseAddress), MADV_HUGEPAGE))
          {
+         useTHP = false;
          if (config.verboseCodeCache() || TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerbosePerformance))
             {
             TR_VerboseLog::writeLineLocked(TR_Vlog_PERF,"Warning: madvise failed while providing hint to use large pages for code cache");
@@ -506,6 +572,34 @@ J9::CodeCacheManager::allocateCodeCacheSegment(size_t segmentSize,
          }
 #endif // LINUX
 
+      if (config.verboseCodeCache() || TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerbosePerformance))
+         {
+         size_t effectivePageSize = codeCacheSegment->vmemIdentifier.pageSize;
+         if (effectivePageSize > pageSizes[0])
+            {
+            TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "Code cache segment %p is backed by explicit large pages of size %zu",
+                                           codeCacheSegment->baseAddress, effectivePageSize);
+            }
+#ifdef LINUX
+         else if (useTHP)
+            {
+            char buffer[64];
+            const char *thpSetting = getTransparentHugePageSetting(buffer, sizeof(buffer));
+            bool thpEnabled = !strcmp(thpSetting, "always") || !strcmp(thpSetting, "madvise");
+            bool thpAligned = OMR::alignedNoCheck((uintptr_t)codeCacheSegment->baseAddress, transparentHugePageSize());
+            if (thpEnabled && thpAligned)
+               effectivePageSize = transparentHugePageSize();
+            TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "Code cache segment %p uses transparent huge pages (system setting: %s, THP aligned: %d); effective page size %zu",
+                                           codeCacheSegment->baseAddress, thpSetting, thpAligned, effectivePageSize);
+            }
+#endif // LINUX
+         else
+            {
+            TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "Code cache segment %p is backed by default pages of size %zu",
+                                           codeCacheSegment->baseAddress, effectivePageSize);
+            }
+         }
+
       if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerbosePerformance))
          TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "Allocated new code cache segment %p starting at address %p",
                                         codeCacheSegment,
@@ -784,6 +878,7 @@ J9::CodeCacheManager::printMccStats()
    {
    self()->printRemainingSpaceInCodeCaches();
    self()->printOccupancyStats();
+   self()->printFragmentationStats();
    }
 
 
@@ -811,6 +906,70 @@ J9::CodeCacheManager::printOccupancyStats()
    }
 
 
+void
+J9::CodeCacheManager::printFragmentationStats()
+   {
+   CacheListCriticalSection scanCacheList(self());
+   for (TR::CodeCache *codeCache = self()->getFirstCodeCache(); codeCache; codeCache = codeCache->next())
+      {
+      J9::CodeCacheFragmentationStats stats;
+      codeCache->getFragmentationStats(stats);
+      fprintf(stderr, "cache %p%s: contiguousFree=%" OMR_PRIuSIZE " freeBlocks=%u freeBlockBytes=%" OMR_PRIuSIZE " largestFreeBlock=%" OMR_PRIuSIZE " fragmentation=%5.2f%%\n",
+              codeCache, codeCache == _hotCodeCache ? " (hot)" : "",
+              stats._freeContiguousBytes, stats._numFreeBlocks, stats._freeBlockBytes, stats._largestFreeBlock,
+              stats.fragmentationPercent());
+      }
+   fprintf(stderr, "Hot code cache: reservations=%u designations=%u\n", _numHotCodeCacheReservations, _numHotCodeCacheDesignations);
+   }
+
+
+TR::CodeCache *
+J9::CodeCacheManager::reserveHotCodeCache(size_t sizeEstimate, int32_t compThreadID, TR::CodeCacheKind kind)
+   {
+   if (TR::Options::_hotCodeCacheMinFreeKB <= 0 || self()->getCodeCacheFull())
+      return NULL;
+
+   size_t minFreeSpace = std::max((size_t)TR::Options::_hotCodeCacheMinFreeKB * 1024, sizeEstimate);
+
+   CacheListCriticalSection scanCacheList(self());
+   TR::CodeCache *hotCache = _hotCodeCache;
+   if (!hotCache || hotCache->getKind() != kind || hotCache->getFreeContiguousSpace() < minFreeSpace)
+      {
+      // The current hot code cache is (nearly) exhausted or of another kind; designate the unreserved
+      // cache of the requested kind with the most contiguous room so that subsequent hot bodies stay together
+      TR::CodeCache *bestCache = NULL;
+      for (TR::CodeCache *codeCache = self()->getFirstCodeCache(); codeCache; codeCache = codeCache->next())
+         {
+         if (codeCache->isReserved() || codeCache->getKind() != kind || codeCache->getFreeContiguousSpace() < minFreeSpace)
+            continue;
+         if (!bestCache || codeCache->getFreeContiguousSpace() > bestCache->getFreeContiguousSpace())
+            bestCache = codeCache;
+         }
+      if (!bestCache)
+         return NULL;
+
+      if (bestCache != hotCache)
+         {
+         _hotCodeCache = bestCache;
+         _numHotCodeCacheDesignations++;
+         if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerboseCodeCache))
+            {
+            TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "Designated code cache %p as hot code cache (previous %p); contiguous free space %" OMR_PRIuSIZE " bytes",
+                                           bestCache, hotCache, bestCache->getFreeContiguousSpace());
+            }
+         hotCache = bestCache;
+         }
+      }
+
+   if (hotCache->isReserved())
+      return NULL;
+
+   hotCache->reserve(compThreadID);
+   _numHotCodeCacheReservations++;
+   return hotCache;
+   }
+
+
 int32_t
 J9::CodeCacheManager::disclaimAllCodeCaches()
    {
@@ -53,7 +53,10 @@ class OMR_EXTENSIBLE CodeCacheManager : public OMR::CodeCacheManagerConnector
 public:
    CodeCacheManager(TR_FrontEnd *fe, TR::RawAllocator rawAllocator) :
       OMR::CodeCacheManagerConnector(rawAllocator),
-      _fe(fe)
+      _fe(fe),
+      _hotCodeCache(NULL),
+      _numHotCodeCacheReservations(0),
+      _numHotCodeCacheDesignations(0)
       {
       _codeCacheManager = reinterpret_cast<TR::CodeCacheManager *>(this);
       _disclaimEnabled = TR::Options::getCmdLineOptions()->getOption(TR_EnableCodeCacheDisclaiming);
@@ -100,6 +103,23 @@ public:
 
    void reportCodeLoadEvents();
 
+   /**
+    * @brief How the code cache segments are backed by huge pages; selected with -Xjit:codeCacheHugePageMode=
+    */
+   enum HugePageMode
+      {
+      HUGE_PAGES_AUTO = 0,      // explicit large pages (hugetlbfs) if configured, otherwise a THP hint
+      HUGE_PAGES_THP = 1,       // transparent huge pages only; segments are THP aligned and sized
+      HUGE_PAGES_HUGETLBFS = 2, // explicit large pages only; no THP hint
+      HUGE_PAGES_NONE = 3,      // default size pages only
+      };
+
+   /**
+    * @brief Size of a transparent huge page on the target platform. The port library
+    *        cannot report it, so a per architecture value is used.
+    */
+   static size_t transparentHugePageSize();
+
    static const uint32_t SAFE_DISTANCE_REPOSITORY_JITLIBRARY = 64 * 1024 * 1024;  // 64MB to account for some safe JIT library size
    static const uintptr_t MAX_DISTANCE_NEAR_JITLIBRARY_TO_AVOID_TRAMPOLINE = 0x80000000 - 64 * 1024 * 1024; // 2GB - 64MB
 
@@ -154,6 +174,31 @@ public:
     * @brief Print occupancy stats for each code cache
     */
    void printOccupancyStats();
+
+   /**
+    * @brief Print free space and fragmentation statistics for each code cache
+    */
+   void printFragmentationStats();
+
+   /**
+    * @brief Try to reserve the code cache designated for hot method bodies so that
+    *        hot and scorching bodies end up packed together instead of being spread
+    *        over every code cache. If the designated cache has less than
+    *        hotCodeCacheMinFreeKB of contiguous free space left, or is not of the requested
+    *        kind, the unreserved code cache of that kind with the most contiguous free space
+    *        becomes the new hot code cache.
+    *        Acquires codeCacheList.mutex.
+    *
+    * @param[in] sizeEstimate : expected size of the method body in bytes
+    * @param[in] compThreadID : ID of the compilation thread doing the reservation
+    * @param[in] kind : the kind of code cache required by the compilation
+    *
+    * @return the reserved hot code cache; NULL if none could be reserved, in which
+    *         case the caller should fall back to reserveCodeCache()
+    */
+   TR::CodeCache *reserveHotCodeCache(size_t sizeEstimate, int32_t compThreadID, TR::CodeCacheKind kind);
+
+   TR::CodeCache *getHotCodeCache() const { return _hotCodeCache; }
    bool isDisclaimEnabled() const { return _disclaimEnabled; }
    void setDisclaimEnabled(bool value)  { _disclaimEnabled = value; }
    int32_t disclaimAllCodeCaches();
@@ -164,6 +209,9 @@ private :
    static J9JITConfig *_jitConfig;
    static J9JavaVM *_javaVM;
    bool  _disclaimEnabled; // If true, code cache can be disclaimed to a file or swap
+   TR::CodeCache *_hotCodeCache; // code cache preferred for hot and scorching bodies; protected by codeCacheList.mutex
+   uint32_t _numHotCodeCacheReservations;
+   uint32_t _numHotCodeCacheDesignations;
    };
 
 } // namespace J9
@@ -76,6 +76,8 @@ ClientSessionData::ClientSessionData(uint64_t clientUID, uint32_t seqNo, TR_Pers
    _javaLangClassPtr = NULL;
    _inUse = 1;
    _numActiveThreads = 0;
+   _numBytesReceived = 0;
+   _numBytesSent = 0;
    _romMapMonitor = TR::Monitor::create("JIT-JITServerROMMapMonitor");
    _classMapMonitor = TR::Monitor::create("JIT-JITServerClassMapMonitor");
    _DLTSetMonitor = TR::Monitor::create("JIT-JITServerDLTSetMonitor");
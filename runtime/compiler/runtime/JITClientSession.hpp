@@ -463,6 +463,10 @@ public:
    int32_t getNumActiveThreads() const { return _numActiveThreads; }
    void incNumActiveThreads() { ++_numActiveThreads; }
    void decNumActiveThreads() { --_numActiveThreads; }
+   // Network traffic of all compilations for this client. Must be updated with the sequencing monitor in hand
+   void addNetworkTraffic(uint64_t bytesReceived, uint64_t bytesSent) { _numBytesReceived += bytesReceived; _numBytesSent += bytesSent; }
+   uint64_t getNumBytesReceived() const { return _numBytesReceived; }
+   uint64_t getNumBytesSent() const { return _numBytesSent; }
    void printStats();
 
    void markForDeletion() { _markedForDeletion = true; }
@@ -631,6 +635,8 @@ private:
    int32_t _numActiveThreads; // Number of threads working on compilations for this client
                               // This is smaller or equal to _inUse because some threads
                               // could be just starting or waiting in _OOSequenceEntryList
+   uint64_t _numBytesReceived;
+   uint64_t _numBytesSent;
    VMInfo *_vmInfo; // info specific to a client VM that does not change, NULL means not set
    bool _markedForDeletion; //Client Session is marked for deletion. When the inUse count will become zero this will be deleted.
    TR_AddressSet *_unloadedClassAddresses; // Per-client versions of the unloaded class and method addresses kept in J9PersistentInfo
@@ -730,6 +736,8 @@ class ClientSessionHT
    void purgeOldDataIfNeeded();
    void printStats();
    uint32_t size() const { return _clientSessionMap.size(); }
+   // Must be accessed with the compilation monitor in hand
+   const PersistentUnorderedMap<uint64_t, ClientSessionData*> &getClientSessionMap() const { return _clientSessionMap; }
 
    private:
    PersistentUnorderedMap<uint64_t, ClientSessionData*> _clientSessionMap;
@@ -20,9 +20,16 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
  *******************************************************************************/
 
+#include <algorithm>
+#include <fcntl.h>
+#include <iterator>
 #include <string.h>
 #include <string>
 #include <cstdio> // for rename()
+#include <sys/file.h> // for flock()
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "control/CompilationRuntime.hpp"
 #include "env/J9SegmentProvider.hpp"
 #include "env/StackMemoryRegion.hpp"
@@ -31,12 +38,38 @@
 #include "runtime/JITServerAOTCache.hpp"
 #include "runtime/JITServerProfileCache.hpp"
 #include "runtime/JITServerSharedROMClassCache.hpp"
+#include "net/ClientStream.hpp"
 #include "net/CommunicationStream.hpp"
 
+// Sequential reader over the contents of a memory-mapped AOT cache file
+struct JITServerAOTCacheFileCursor
+   {
+   JITServerAOTCacheFileCursor(const uint8_t *start, size_t size) : _start(start), _current(start), _end(start + size) { }
+
+   bool read(void *dst, size_t bytes)
+      {
+      if (bytes > remaining())
+         return false;
+      memcpy(dst, _current, bytes);
+      _current += bytes;
+      return true;
+      }
+
+   size_t remaining() const { return _end - _current; }
+   size_t offset() const { return _current - _start; }
+
+   const uint8_t *const _start;
+   const uint8_t *_current;
+   const uint8_t *const _end;
+   };
+
 struct JITServerAOTCacheReadContext
    {
    JITServerAOTCacheReadContext(const JITServerAOTCacheHeader &header, TR::StackMemoryRegion &stackMemoryRegion);
 
+   // Make room for the record IDs introduced by a delta segment
+   void grow(const JITServerAOTCacheHeader &header);
+
    Vector<AOTCacheClassLoaderRecord *> _classLoaderRecords;
    Vector<AOTCacheClassRecord *> _classRecords;
    Vector<AOTCacheMethodRecord *> _methodRecords;
@@ -67,17 +100,18 @@ AOTCacheRecord::free(void *ptr)
 
 // Read a single AOT cache record R from a cache file
 template<class R> R *
-AOTCacheRecord::readRecord(FILE *f, const JITServerAOTCacheReadContext &context)
+AOTCacheRecord::readRecord(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context)
    {
    typename R::SerializationRecord header;
-   if (1 != fread(&header, sizeof(header), 1, f))
+   if (!cursor.read(&header, sizeof(header)))
       {
       if (TR::Options::getVerboseOption(TR_VerboseJITServer))
          TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Could not read %s record header", R::getRecordName());
       return NULL;
       }
 
-   if (!header.isValidHeader(context))
+   // The whole file is mapped, so a size that runs past its end can be rejected before allocating the record
+   if (!header.isValidHeader(context) || (header.size() < sizeof(header)) || (header.size() - sizeof(header) > cursor.remaining()))
       {
       if (TR::Options::getVerboseOption(TR_VerboseJITServer))
          TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Header for %s record is invalid", R::getRecordName());
@@ -90,7 +124,7 @@ AOTCacheRecord::readRecord(FILE *f, const JITServerAOTCacheReadContext &context)
    size_t variableDataBytes = record->dataAddr()->size() - sizeof(header);
    if (0 != variableDataBytes)
       {
-      if (1 != fread((uint8_t *)record->dataAddr() + sizeof(header), variableDataBytes, 1, f))
+      if (!cursor.read((uint8_t *)record->dataAddr() + sizeof(header), variableDataBytes))
          {
          if (TR::Options::getVerboseOption(TR_VerboseJITServer))
             TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Unable to read variable part of %s record", R::getRecordName());
@@ -154,6 +188,15 @@ ClassSerializationRecord::ClassSerializationRecord(
    JITServerHelpers::getFullClassName(_name, nameLength, romClass, baseComponent, numDimensions, isGenerated());
    }
 
+ClassSerializationRecord::ClassSerializationRecord(uintptr_t id, uintptr_t classLoaderId,
+                                                   const ClassSerializationRecord &other) :
+   AOTSerializationRecord(size(other._nameLength), id, AOTSerializationRecordType::Class),
+   _classLoaderId(classLoaderId), _hash(other._hash),
+   _romClassSize(other._romClassSize), _nameLength(other._nameLength)
+   {
+   memcpy(_name, other._name, _nameLength);
+   }
+
 ClassSerializationRecord::ClassSerializationRecord() :
    AOTSerializationRecord(0, 0, AOTSerializationRecordType::Class),
    _classLoaderId(0), _hash(), _romClassSize(0), _nameLength(0)
@@ -180,6 +223,13 @@ AOTCacheClassRecord::AOTCacheClassRecord(
    {
    }
 
+AOTCacheClassRecord::AOTCacheClassRecord(uintptr_t id, const AOTCacheClassLoaderRecord *classLoaderRecord,
+                                         const ClassSerializationRecord &peerRecord) :
+   _classLoaderRecord(classLoaderRecord),
+   _data(id, classLoaderRecord->data().id(), peerRecord)
+   {
+   }
+
 AOTCacheClassRecord::AOTCacheClassRecord(const JITServerAOTCacheReadContext &context, const ClassSerializationRecord &header) :
    _classLoaderRecord(context._classLoaderRecords[header.classLoaderId()])
    {
@@ -196,6 +246,14 @@ AOTCacheClassRecord::create(uintptr_t id, const AOTCacheClassLoaderRecord *class
                                         romClass, baseComponent, numDimensions, nameLength);
    }
 
+AOTCacheClassRecord *
+AOTCacheClassRecord::create(uintptr_t id, const AOTCacheClassLoaderRecord *classLoaderRecord,
+                            const ClassSerializationRecord &peerRecord)
+   {
+   void *ptr = AOTCacheRecord::allocate(size(peerRecord.nameLength()));
+   return new (ptr) AOTCacheClassRecord(id, classLoaderRecord, peerRecord);
+   }
+
 void
 AOTCacheClassRecord::subRecordsDo(const std::function<void(const AOTCacheRecord *)> &f) const
    {
@@ -773,6 +831,10 @@ JITServerAOTCache::JITServerAOTCache(const std::string &name, J9JavaVM *javaVM)
    _minNumAOTMethodsToSave(TR::Options::_aotCachePersistenceMinDeltaMethods),
    _saveOperationInProgress(false), // protected by the _cachedMethodMonitor
    _excludedFromSavingToFile(false),
+   _persistedState(),
+   _timePrevPeerSync(0),
+   _peerSyncInProgress(false),
+   _peerSyncState(decltype(_peerSyncState)::allocator_type(TR::Compiler->persistentGlobalAllocator())),
    _numCacheBypasses(0), _numCacheHits(0), _numCacheMisses(0),
    _numDeserializedMethods(0), _numDeserializationFailures(0), _numGeneratedClasses(0)
    {
@@ -818,6 +880,19 @@ JITServerAOTCacheReadContext::JITServerAOTCacheReadContext(const JITServerAOTCac
    {
    }
 
+void
+JITServerAOTCacheReadContext::grow(const JITServerAOTCacheHeader &header)
+   {
+   // IDs are never reused, so the next IDs in later segments can only be larger
+   _classLoaderRecords.resize(std::max(_classLoaderRecords.size(), header._nextClassLoaderId), NULL);
+   _classRecords.resize(std::max(_classRecords.size(), header._nextClassId), NULL);
+   _methodRecords.resize(std::max(_methodRecords.size(), header._nextMethodId), NULL);
+   _classChainRecords.resize(std::max(_classChainRecords.size(), header._nextClassChainId), NULL);
+   _wellKnownClassesRecords.resize(std::max(_wellKnownClassesRecords.size(), header._nextWellKnownClassesId), NULL);
+   _aotHeaderRecords.resize(std::max(_aotHeaderRecords.size(), header._nextAOTHeaderId), NULL);
+   _thunkRecords.resize(std::max(_thunkRecords.size(), header._nextThunkId), NULL);
+   }
+
 const AOTCacheClassLoaderRecord *
 JITServerAOTCache::getClassLoaderRecord(const uint8_t *name, size_t nameLength)
    {
@@ -939,6 +1014,38 @@ JITServerAOTCache::getClassRecord(const AOTCacheClassLoaderRecord *classLoaderRe
    return record;
    }
 
+const AOTCacheClassRecord *
+JITServerAOTCache::getClassRecord(const AOTCacheClassLoaderRecord *classLoaderRecord,
+                                  const ClassSerializationRecord &peerRecord)
+   {
+   OMR::CriticalSection cs(_classMonitor);
+
+   auto it = _classMap.find({ classLoaderRecord, &peerRecord.hash() });
+   if (it != _classMap.end())
+      return it->second;
+
+   if (!JITServerAOTCacheMap::cacheHasSpace())
+      return NULL;
+
+   auto record = AOTCacheClassRecord::create(_nextClassId, classLoaderRecord, peerRecord);
+   addToMap(_classMap, _classHead, _classTail, it, getRecordKey(record), record);
+   ++_nextClassId;
+
+   if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      {
+      const ClassSerializationRecord *c = &record->data();
+      char buffer[ROMCLASS_HASH_BYTES * 2 + 1];
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer,
+         "AOT cache %s: created class ID %zu -> %.*s size %u hash %s class loader ID %zu from peer record",
+         _name.c_str(), c->id(), RECORD_NAME(c), c->romClassSize(), c->hash().toString(buffer, sizeof(buffer)),
+         classLoaderRecord->data().id()
+      );
+      }
+
+   _numGeneratedClasses += record->data().isGenerated() ? 1 : 0;
+   return record;
+   }
+
 const AOTCacheMethodRecord *
 JITServerAOTCache::getMethodRecord(const AOTCacheClassRecord *definingClassRecord,
                                    uint32_t index, const J9ROMMethod *romMethod)
@@ -961,10 +1068,16 @@ JITServerAOTCache::getMethodRecord(const AOTCacheClassRecord *definingClassRecor
    if (TR::Options::getVerboseOption(TR_VerboseJITServer))
       {
       const ClassSerializationRecord *c = &definingClassRecord->data();
-      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer,
-         "AOT cache %s: created method ID %zu -> %.*s.%.*s%.*s index %u class ID %zu",
-         _name.c_str(), record->data().id(), RECORD_NAME(c), ROMMETHOD_NAS(romMethod), index, c->id()
-      );
+      if (romMethod)
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer,
+            "AOT cache %s: created method ID %zu -> %.*s.%.*s%.*s index %u class ID %zu",
+            _name.c_str(), record->data().id(), RECORD_NAME(c), ROMMETHOD_NAS(romMethod), index, c->id()
+         );
+      else
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer,
+            "AOT cache %s: created method ID %zu -> %.*s index %u class ID %zu",
+            _name.c_str(), record->data().id(), RECORD_NAME(c), index, c->id()
+         );
       }
 
    return record;
@@ -1279,11 +1392,13 @@ JITServerAOTCache::printStats(FILE *f) const
    }
 
 
-// Write at most numRecordsToWrite to the given stream from the linked list starting at head.
+// Write at most numRecordsToWrite to the given stream from the linked list starting at head,
+// skipping the records up to and including tail (which were already written to the file).
+// On return, tail points to the last record written.
 static bool
-writeRecordList(FILE *f, const AOTCacheRecord *head, size_t numRecordsToWrite)
+writeRecordList(FILE *f, const AOTCacheRecord *head, const AOTCacheRecord *&tail, size_t numRecordsToWrite)
    {
-   const AOTCacheRecord *current = head;
+   const AOTCacheRecord *current = tail ? tail->getNextRecord() : head;
    size_t recordsWritten = 0;
    while (current && (recordsWritten < numRecordsToWrite))
       {
@@ -1295,6 +1410,7 @@ writeRecordList(FILE *f, const AOTCacheRecord *head, size_t numRecordsToWrite)
          return false;
          }
       ++recordsWritten;
+      tail = current;
       current = current->getNextRecord();
       }
    TR_ASSERT(recordsWritten == numRecordsToWrite, "Expected to write %zu records, wrote %zu", numRecordsToWrite, recordsWritten);
@@ -1303,9 +1419,9 @@ writeRecordList(FILE *f, const AOTCacheRecord *head, size_t numRecordsToWrite)
    }
 
 static bool
-writeCachedMethodList(FILE *f, const CachedAOTMethod *head, size_t numRecordsToWrite)
+writeCachedMethodList(FILE *f, const CachedAOTMethod *head, const CachedAOTMethod *&tail, size_t numRecordsToWrite)
    {
-   const CachedAOTMethod *current = head;
+   const CachedAOTMethod *current = tail ? tail->getNextRecord() : head;
    size_t recordsWritten = 0;
    while (current && (recordsWritten < numRecordsToWrite))
       {
@@ -1317,6 +1433,7 @@ writeCachedMethodList(FILE *f, const CachedAOTMethod *head, size_t numRecordsToW
          return false;
          }
       ++recordsWritten;
+      tail = current;
       current = current->getNextRecord();
       }
    TR_ASSERT(recordsWritten == numRecordsToWrite, "Expected to write %zu records, wrote %zu", numRecordsToWrite, recordsWritten);
@@ -1331,93 +1448,126 @@ static void getCurrentAOTCacheVersion(JITServerAOTCacheVersion &version)
    version._jitserverVersion = JITServer::CommunicationStream::getJITServerFullVersion();
    }
 
-// Write a full AOT cache snapshot to a stream. After the header information, the
-// AOTSerializationRecord or SerializedAOTMethod data (depending on record type) in each
-// record traversal is written directly to the stream in sections, since the full AOT record
-// can be reconstructed from only this information. These sections are ordered so that, when
-// reading the snapshot, the dependencies of each record will already have been read by the
-// time we get to that record.
-// Return the number of AOT methods written to the snapshot or 0 on failure.
+// Write an AOT cache snapshot segment to a stream at its current position. The segment contains
+// all the records that are not yet described by the persisted state; if the state is empty,
+// this is a full snapshot. After the header information, the AOTSerializationRecord or
+// SerializedAOTMethod data (depending on record type) in each record traversal is written directly
+// to the stream in sections, since the full AOT record can be reconstructed from only this information.
+// These sections are ordered so that, when reading the snapshot, the dependencies of each record will
+// already have been read by the time we get to that record.
+// On success, the persisted state is updated to include the records just written.
+// Return the total number of AOT methods stored in the snapshot or 0 on failure.
 size_t
-JITServerAOTCache::writeCache(FILE *f) const
+JITServerAOTCache::writeCache(FILE *f, JITServerAOTCachePersistedState &state) const
    {
-   JITServerAOTCacheHeader header = {0};
-   getCurrentAOTCacheVersion(header._version);
-   header._serverUID = TR::CompilationInfo::get()->getPersistentInfo()->getServerUID();
+   JITServerAOTCacheHeader total = {0};
 
    // It is possible for a record and its dependencies to be added between .size() calls,
    // so we must reverse the order in which we read the map sizes (compared to their write order)
    // to ensure that those dependencies are not excluded from serialization.
       {
       OMR::CriticalSection cs(_cachedMethodMonitor);
-      header._numCachedAOTMethods = _cachedMethodMap.size();
+      total._numCachedAOTMethods = _cachedMethodMap.size();
       }
-   if (header._numCachedAOTMethods == 0)
+   if (total._numCachedAOTMethods <= state._header._numCachedAOTMethods)
       {
-      TR_ASSERT_FATAL(false, "Expected to write at least one method to the AOT cache file");
+      TR_ASSERT_FATAL(state._fileBytes != 0, "Expected to write at least one method to the AOT cache file");
       return 0;
       }
       {
       OMR::CriticalSection cs(_thunkMonitor);
-      header._numThunkRecords = _thunkMap.size();
-      header._nextThunkId = _nextThunkId;
+      total._numThunkRecords = _thunkMap.size();
+      total._nextThunkId = _nextThunkId;
       }
       {
       OMR::CriticalSection cs(_aotHeaderMonitor);
-      header._numAOTHeaderRecords = _aotHeaderMap.size();
-      header._nextAOTHeaderId = _nextAOTHeaderId;
+      total._numAOTHeaderRecords = _aotHeaderMap.size();
+      total._nextAOTHeaderId = _nextAOTHeaderId;
       }
       {
       OMR::CriticalSection cs(_wellKnownClassesMonitor);
-      header._numWellKnownClassesRecords = _wellKnownClassesMap.size();
-      header._nextWellKnownClassesId = _nextWellKnownClassesId;
+      total._numWellKnownClassesRecords = _wellKnownClassesMap.size();
+      total._nextWellKnownClassesId = _nextWellKnownClassesId;
       }
       {
       OMR::CriticalSection cs(_classChainMonitor);
-      header._numClassChainRecords = _classChainMap.size();
-      header._nextClassChainId = _nextClassChainId;
+      total._numClassChainRecords = _classChainMap.size();
+      total._nextClassChainId = _nextClassChainId;
       }
       {
       OMR::CriticalSection cs(_methodMonitor);
-      header._numMethodRecords = _methodMap.size();
-      header._nextMethodId = _nextMethodId;
+      total._numMethodRecords = _methodMap.size();
+      total._nextMethodId = _nextMethodId;
       }
       {
       OMR::CriticalSection cs(_classMonitor);
-      header._numClassRecords = _classMap.size();
-      header._nextClassId = _nextClassId;
+      total._numClassRecords = _classMap.size();
+      total._nextClassId = _nextClassId;
       }
       {
       OMR::CriticalSection cs(_classLoaderMonitor);
-      header._numClassLoaderRecords = _classLoaderMap.size();
-      header._nextClassLoaderId = _nextClassLoaderId;
+      total._numClassLoaderRecords = _classLoaderMap.size();
+      total._nextClassLoaderId = _nextClassLoaderId;
       }
 
-   if (1 != fwrite(&header, sizeof(JITServerAOTCacheHeader), 1, f))
+   // The segment header describes the difference between the current and the persisted record counts
+   const JITServerAOTCacheHeader &persisted = state._header;
+   JITServerAOTCacheHeader header = total;
+   getCurrentAOTCacheVersion(header._version);
+   header._serverUID = TR::CompilationInfo::get()->getPersistentInfo()->getServerUID();
+   header._numClassLoaderRecords -= persisted._numClassLoaderRecords;
+   header._numClassRecords -= persisted._numClassRecords;
+   header._numMethodRecords -= persisted._numMethodRecords;
+   header._numClassChainRecords -= persisted._numClassChainRecords;
+   header._numWellKnownClassesRecords -= persisted._numWellKnownClassesRecords;
+   header._numAOTHeaderRecords -= persisted._numAOTHeaderRecords;
+   header._numThunkRecords -= persisted._numThunkRecords;
+   header._numCachedAOTMethods -= persisted._numCachedAOTMethods;
+
+   long segmentStart = ftell(f);
+   if ((segmentStart < 0) || (1 != fwrite(&header, sizeof(JITServerAOTCacheHeader), 1, f)))
       {
       if (TR::Options::getVerboseOption(TR_VerboseJITServer))
          TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Unable to write cache file header");
       return 0;
       }
 
-   if (!writeRecordList(f, _classLoaderHead, header._numClassLoaderRecords))
+   JITServerAOTCachePersistedState newState = state;
+   if (!writeRecordList(f, _classLoaderHead, newState._classLoaderTail, header._numClassLoaderRecords))
+      return 0;
+   if (!writeRecordList(f, _classHead, newState._classTail, header._numClassRecords))
+      return 0;
+   if (!writeRecordList(f, _methodHead, newState._methodTail, header._numMethodRecords))
       return 0;
-   if (!writeRecordList(f, _classHead, header._numClassRecords))
+   if (!writeRecordList(f, _classChainHead, newState._classChainTail, header._numClassChainRecords))
       return 0;
-   if (!writeRecordList(f, _methodHead, header._numMethodRecords))
+   if (!writeRecordList(f, _wellKnownClassesHead, newState._wellKnownClassesTail, header._numWellKnownClassesRecords))
       return 0;
-   if (!writeRecordList(f, _classChainHead, header._numClassChainRecords))
+   if (!writeRecordList(f, _aotHeaderHead, newState._aotHeaderTail, header._numAOTHeaderRecords))
       return 0;
-   if (!writeRecordList(f, _wellKnownClassesHead, header._numWellKnownClassesRecords))
+   if (!writeRecordList(f, _thunkHead, newState._thunkTail, header._numThunkRecords))
       return 0;
-   if (!writeRecordList(f, _aotHeaderHead, header._numAOTHeaderRecords))
+   if (!writeCachedMethodList(f, _cachedMethodHead, newState._cachedMethodTail, header._numCachedAOTMethods))
       return 0;
-   if (!writeRecordList(f, _thunkHead, header._numThunkRecords))
+
+   // Now that the size of the segment is known, patch it into the header
+   long segmentEnd = ftell(f);
+   if (segmentEnd < 0)
       return 0;
-   if (!writeCachedMethodList(f, _cachedMethodHead, header._numCachedAOTMethods))
+   header._segmentBytes = segmentEnd - segmentStart;
+   if ((0 != fseek(f, segmentStart, SEEK_SET)) ||
+       (1 != fwrite(&header, sizeof(JITServerAOTCacheHeader), 1, f)) ||
+       (0 != fseek(f, segmentEnd, SEEK_SET)))
+      {
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Unable to write cache file header");
       return 0;
+      }
 
-   return header._numCachedAOTMethods;
+   newState._header = total;
+   newState._fileBytes = segmentEnd;
+   state = newState;
+   return total._numCachedAOTMethods;
    }
 
 // Tests whether or not the given AOT snapshot is compatible with the server.
@@ -1432,16 +1582,17 @@ isCompatibleSnapshotVersion(const JITServerAOTCacheVersion &version)
           (version._jitserverVersion == currentVersion._jitserverVersion);
    }
 
-// Read an AOT cache snapshot, returning NULL if the cache is ill-formed or
-// incompatible with the running server.
+// Read an AOT cache snapshot from a memory-mapped file, returning NULL if the cache is
+// ill-formed or incompatible with the running server.
 JITServerAOTCache *
-JITServerAOTCache::readCache(FILE *f, const std::string &name, TR_Memory &trMemory)
+JITServerAOTCache::readCache(const uint8_t *fileStart, size_t fileBytes, const std::string &name, TR_Memory &trMemory)
    {
    if (!JITServerAOTCacheMap::cacheHasSpace())
       return NULL;
 
+   JITServerAOTCacheFileCursor cursor(fileStart, fileBytes);
    JITServerAOTCacheHeader header = {0};
-   if (1 != fread(&header, sizeof(JITServerAOTCacheHeader), 1, f))
+   if (!cursor.read(&header, sizeof(JITServerAOTCacheHeader)))
       {
       if (TR::Options::getVerboseOption(TR_VerboseJITServer))
          TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Unable to read cache file header");
@@ -1479,7 +1630,7 @@ JITServerAOTCache::readCache(FILE *f, const std::string &name, TR_Memory &trMemo
    bool readSuccess = false;
    try
       {
-      readSuccess = cache->readCache(f, header, trMemory);
+      readSuccess = cache->readCache(cursor, header, trMemory);
       }
    catch (const std::exception &e)
       {
@@ -1502,7 +1653,7 @@ JITServerAOTCache::readCache(FILE *f, const std::string &name, TR_Memory &trMemo
 // Read numRecordsToRead records of an AOTSerializationRecord subclass V from a stream, also
 // updating the map, record traversal, and scratch Vector associated with V.
 template<typename K, typename V, typename H> bool
-JITServerAOTCache::readRecords(FILE *f,
+JITServerAOTCache::readRecords(JITServerAOTCacheFileCursor &cursor,
                                JITServerAOTCacheReadContext &context,
                                size_t numRecordsToRead,
                                PersistentUnorderedMap<K, V *, H> &map,
@@ -1515,7 +1666,7 @@ JITServerAOTCache::readRecords(FILE *f,
       if (!JITServerAOTCacheMap::cacheHasSpace())
          return false;
 
-      V *record = AOTCacheRecord::readRecord<V>(f, context);
+      V *record = AOTCacheRecord::readRecord<V>(cursor, context);
       if (!record)
          return false;
 
@@ -1536,17 +1687,96 @@ JITServerAOTCache::readRecords(FILE *f,
    return true;
    }
 
+// Read the base segment of a snapshot and then any delta segments appended to it. A failure in the
+// base segment invalidates the whole snapshot. Since every segment stores its records in dependency
+// order, a damaged delta segment (e.g. one that was only partially written) can simply be ignored
+// along with everything after it; the file will then be rewritten from scratch by the next save.
 bool
-JITServerAOTCache::readCache(FILE *f, const JITServerAOTCacheHeader &header, TR_Memory &trMemory)
+JITServerAOTCache::readCache(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheHeader &header, TR_Memory &trMemory)
    {
-   _classLoaderMap.reserve(header._numClassLoaderRecords);
-   _classMap.reserve(header._numClassRecords);
-   _methodMap.reserve(header._numMethodRecords);
-   _classChainMap.reserve(header._numClassChainRecords);
-   _wellKnownClassesMap.reserve(header._numWellKnownClassesRecords);
-   _aotHeaderMap.reserve(header._numAOTHeaderRecords);
-   _thunkMap.reserve(header._numThunkRecords);
-   _cachedMethodMap.reserve(header._numCachedAOTMethods);
+   TR::StackMemoryRegion stackMemoryRegion(trMemory);
+   JITServerAOTCacheReadContext context(header, stackMemoryRegion);
+
+   if (!readCacheSegment(cursor, header, context))
+      return false;
+   if (cursor.offset() != header._segmentBytes)
+      {
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Size of base segment does not match cache file header");
+      return false;
+      }
+
+   size_t numSegments = 1;
+   bool complete = true;
+   while (cursor.remaining() != 0)
+      {
+      size_t segmentStart = cursor.offset();
+      JITServerAOTCacheHeader segmentHeader = {0};
+      if (!cursor.read(&segmentHeader, sizeof(JITServerAOTCacheHeader)) ||
+          !isCompatibleSnapshotVersion(segmentHeader._version) ||
+          (segmentHeader._segmentBytes < sizeof(JITServerAOTCacheHeader)) ||
+          (segmentHeader._segmentBytes - sizeof(JITServerAOTCacheHeader) > cursor.remaining()))
+         {
+         complete = false;
+         break;
+         }
+
+      context.grow(segmentHeader);
+      if (!readCacheSegment(cursor, segmentHeader, context) ||
+          (cursor.offset() - segmentStart != segmentHeader._segmentBytes))
+         {
+         complete = false;
+         break;
+         }
+      ++numSegments;
+      }
+
+   if (complete)
+      {
+      // Later save operations can append to this file as long as nobody else changes it
+      _persistedState._header = header;
+      _persistedState._header._numClassLoaderRecords = _classLoaderMap.size();
+      _persistedState._header._numClassRecords = _classMap.size();
+      _persistedState._header._numMethodRecords = _methodMap.size();
+      _persistedState._header._numClassChainRecords = _classChainMap.size();
+      _persistedState._header._numWellKnownClassesRecords = _wellKnownClassesMap.size();
+      _persistedState._header._numAOTHeaderRecords = _aotHeaderMap.size();
+      _persistedState._header._numThunkRecords = _thunkMap.size();
+      _persistedState._header._numCachedAOTMethods = _cachedMethodMap.size();
+      _persistedState._classLoaderTail = _classLoaderTail;
+      _persistedState._classTail = _classTail;
+      _persistedState._methodTail = _methodTail;
+      _persistedState._classChainTail = _classChainTail;
+      _persistedState._wellKnownClassesTail = _wellKnownClassesTail;
+      _persistedState._aotHeaderTail = _aotHeaderTail;
+      _persistedState._thunkTail = _thunkTail;
+      _persistedState._cachedMethodTail = _cachedMethodTail;
+      _persistedState._fileBytes = cursor.offset();
+      }
+   else if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      {
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Ignoring damaged segment at offset %zu of cache file for cache '%s'",
+                                     cursor.offset(), _name.c_str());
+      }
+
+   if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Read %zu segments with %zu methods for cache '%s'",
+                                     numSegments, _cachedMethodMap.size(), _name.c_str());
+   return true;
+   }
+
+bool
+JITServerAOTCache::readCacheSegment(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheHeader &header,
+                                    JITServerAOTCacheReadContext &context)
+   {
+   _classLoaderMap.reserve(_classLoaderMap.size() + header._numClassLoaderRecords);
+   _classMap.reserve(_classMap.size() + header._numClassRecords);
+   _methodMap.reserve(_methodMap.size() + header._numMethodRecords);
+   _classChainMap.reserve(_classChainMap.size() + header._numClassChainRecords);
+   _wellKnownClassesMap.reserve(_wellKnownClassesMap.size() + header._numWellKnownClassesRecords);
+   _aotHeaderMap.reserve(_aotHeaderMap.size() + header._numAOTHeaderRecords);
+   _thunkMap.reserve(_thunkMap.size() + header._numThunkRecords);
+   _cachedMethodMap.reserve(_cachedMethodMap.size() + header._numCachedAOTMethods);
 
    _nextClassLoaderId = header._nextClassLoaderId;
    _nextClassId = header._nextClassId;
@@ -1556,23 +1786,20 @@ JITServerAOTCache::readCache(FILE *f, const JITServerAOTCacheHeader &header, TR_
    _nextAOTHeaderId = header._nextAOTHeaderId;
    _nextThunkId = header._nextThunkId;
 
-   TR::StackMemoryRegion stackMemoryRegion(trMemory);
-   JITServerAOTCacheReadContext context(header, stackMemoryRegion);
-
-   if (!readRecords(f, context, header._numClassLoaderRecords, _classLoaderMap, _classLoaderHead, _classLoaderTail, context._classLoaderRecords))
+   if (!readRecords(cursor, context, header._numClassLoaderRecords, _classLoaderMap, _classLoaderHead, _classLoaderTail, context._classLoaderRecords))
       return false;
-   if (!readRecords(f, context, header._numClassRecords, _classMap, _classHead, _classTail, context._classRecords))
+   if (!readRecords(cursor, context, header._numClassRecords, _classMap, _classHead, _classTail, context._classRecords))
       return false;
-   if (!readRecords(f, context, header._numMethodRecords, _methodMap, _methodHead, _methodTail, context._methodRecords))
+   if (!readRecords(cursor, context, header._numMethodRecords, _methodMap, _methodHead, _methodTail, context._methodRecords))
       return false;
-   if (!readRecords(f, context, header._numClassChainRecords, _classChainMap, _classChainHead, _classChainTail, context._classChainRecords))
+   if (!readRecords(cursor, context, header._numClassChainRecords, _classChainMap, _classChainHead, _classChainTail, context._classChainRecords))
       return false;
-   if (!readRecords(f, context, header._numWellKnownClassesRecords, _wellKnownClassesMap, _wellKnownClassesHead,
+   if (!readRecords(cursor, context, header._numWellKnownClassesRecords, _wellKnownClassesMap, _wellKnownClassesHead,
                     _wellKnownClassesTail, context._wellKnownClassesRecords))
       return false;
-   if (!readRecords(f, context, header._numAOTHeaderRecords, _aotHeaderMap, _aotHeaderHead, _aotHeaderTail, context._aotHeaderRecords))
+   if (!readRecords(cursor, context, header._numAOTHeaderRecords, _aotHeaderMap, _aotHeaderHead, _aotHeaderTail, context._aotHeaderRecords))
       return false;
-   if (!readRecords(f, context, header._numThunkRecords, _thunkMap, _thunkHead, _thunkTail, context._thunkRecords))
+   if (!readRecords(cursor, context, header._numThunkRecords, _thunkMap, _thunkHead, _thunkTail, context._thunkRecords))
       return false;
 
    for (size_t i = 0; i < header._numCachedAOTMethods; ++i)
@@ -1580,7 +1807,7 @@ JITServerAOTCache::readCache(FILE *f, const JITServerAOTCacheHeader &header, TR_
       if (!JITServerAOTCacheMap::cacheHasSpace())
          return false;
 
-      auto record = AOTCacheRecord::readRecord<CachedAOTMethod>(f, context);
+      auto record = AOTCacheRecord::readRecord<CachedAOTMethod>(cursor, context);
       if (!record)
          return false;
 
@@ -1608,6 +1835,21 @@ JITServerAOTCache::getNumCachedMethods() const
    }
 
 
+// Place a special compilation request in the queue. Any I/O operation
+// should be done asynchronously on a compilation thread.
+static bool
+queueSpecialAOTCacheRequest(TR::CompilationInfo *compInfo, JITServer::ServerStream *request)
+   {
+   OMR::CriticalSection compilationMonitorLock(compInfo->getCompilationMonitor());
+   if (compInfo->getPersistentInfo()->getDisableFurtherCompilation())
+      return false;
+   if (!compInfo->addOutOfProcessMethodToBeCompiled(request /*stream*/))
+      return false;
+   // Successfully queued the new entry, so notify a thread
+   compInfo->getCompilationMonitor()->notifyAll();
+   return true;
+   }
+
 bool
 JITServerAOTCache::triggerAOTCacheStoreToFileIfNeeded()
    {
@@ -1636,26 +1878,12 @@ JITServerAOTCache::triggerAOTCacheStoreToFileIfNeeded()
    // Memorize which AOT cache to save to file
    aotCacheMap->queueAOTCacheForSavingToFile(_name);
 
-   // Place a special compilation request in the queue
-   // Any I/O operation should be done asynchronously on a new compilation thread
-   bool queuedRequest = false;
-      {
-      OMR::CriticalSection compilationMonitorLock(compInfo->getCompilationMonitor());
-      if (!compInfo->getPersistentInfo()->getDisableFurtherCompilation())
-         {
-         // Setting the stream to SAVE_AOT_CACHE_REQUEST means that this is not a true
-         // compilation request, but rather a request to save a cache to a file
-         if (compInfo->addOutOfProcessMethodToBeCompiled(SAVE_AOTCACHE_REQUEST /*stream*/))
-            {
-            // Successfully queued the new entry, so notify a thread
-            compInfo->getCompilationMonitor()->notifyAll();
-            if (TR::Options::getVerboseOption(TR_VerboseJITServer))
-               TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: t=%llu Queued comp request to save cache '%s' to file in the background",
-                                              compInfo->getPersistentInfo()->getElapsedTime(), _name.c_str());
-            queuedRequest = true;
-            }
-         }
-      }
+   // Setting the stream to SAVE_AOT_CACHE_REQUEST means that this is not a true
+   // compilation request, but rather a request to save a cache to a file
+   bool queuedRequest = queueSpecialAOTCacheRequest(compInfo, SAVE_AOTCACHE_REQUEST);
+   if (queuedRequest && TR::Options::getVerboseOption(TR_VerboseJITServer))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: t=%llu Queued comp request to save cache '%s' to file in the background",
+                                     compInfo->getPersistentInfo()->getElapsedTime(), _name.c_str());
    if (!queuedRequest)
       {
       // We don't need to acquire the monitor here because only the thread that set
@@ -1683,6 +1911,23 @@ JITServerAOTCache::finalizeSaveOperation(bool success, size_t numMethodsSavedToF
    }
 
 
+// Return the number of AOT methods stored in a snapshot file positioned right after the base segment header,
+// skipping over the records of each segment and stopping at the first incomplete or incompatible one.
+static size_t
+getNumMethodsInSnapshot(FILE *f, const JITServerAOTCacheHeader &header)
+   {
+   size_t numMethods = header._numCachedAOTMethods;
+   JITServerAOTCacheHeader segmentHeader = header;
+   while ((segmentHeader._segmentBytes >= sizeof(JITServerAOTCacheHeader)) &&
+          (0 == fseek(f, segmentHeader._segmentBytes - sizeof(JITServerAOTCacheHeader), SEEK_CUR)) &&
+          (1 == fread(&segmentHeader, sizeof(JITServerAOTCacheHeader), 1, f)) &&
+          isCompatibleSnapshotVersion(segmentHeader._version))
+      {
+      numMethods += segmentHeader._numCachedAOTMethods;
+      }
+   return numMethods;
+   }
+
 bool
 JITServerAOTCache::isAOTCacheBetterThanSnapshot(const std::string &cacheFileName, size_t numExtraMethods)
    {
@@ -1702,19 +1947,20 @@ JITServerAOTCache::isAOTCacheBetterThanSnapshot(const std::string &cacheFileName
                TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Found incompatible AOT cache file %s. Will overwrite.", cacheFileName.c_str());
             doSave = true;
             }
-         else // Header is compatible, check the number of methods
+         else // Header is compatible, check the number of methods in all the segments
             {
-            if (getNumCachedMethods() >= header._numCachedAOTMethods + numExtraMethods)
+            size_t numMethodsInFile = getNumMethodsInSnapshot(cacheFile, header);
+            if (getNumCachedMethods() >= numMethodsInFile + numExtraMethods)
                {
                // We have better data than the existing snaphot, so overwrite it
                doSave = true;
                }
             else // Existing snapshot has more methods (or same as us)
                {
-               setMinNumAOTMethodsToSave(header._numCachedAOTMethods + TR::Options::_aotCachePersistenceMinDeltaMethods);
+               setMinNumAOTMethodsToSave(numMethodsInFile + TR::Options::_aotCachePersistenceMinDeltaMethods);
                if (TR::Options::getVerboseOption(TR_VerboseJITServer))
                   TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Save operation aborted for cache '%s' because we don't have %zu more methods than existing snapshot: %zu vs %zu.",
-                                                 name().c_str(), numExtraMethods, getNumCachedMethods(), header._numCachedAOTMethods);
+                                                 name().c_str(), numExtraMethods, getNumCachedMethods(), numMethodsInFile);
                }
             }
          }
@@ -1743,6 +1989,376 @@ JITServerAOTCache::isAOTCacheBetterThanSnapshot(const std::string &cacheFileName
    }
 
 
+size_t
+JITServerAOTCache::appendToCacheFile(const std::string &cacheFileName)
+   {
+   if (0 == _persistedState._fileBytes)
+      return 0;
+
+   int fd = open(cacheFileName.c_str(), O_RDWR);
+   if (fd < 0)
+      return 0;
+
+   // Appending is only safe if the file is still the one we last wrote or read: check that it
+   // has not been replaced (renamed over) or extended by another server. The lock excludes other
+   // appenders and readers that have the file mapped while we extend it.
+   struct stat fdStat, pathStat;
+   if ((0 != flock(fd, LOCK_EX)) ||
+       (0 != fstat(fd, &fdStat)) ||
+       (0 != stat(cacheFileName.c_str(), &pathStat)) ||
+       (fdStat.st_ino != pathStat.st_ino) || (fdStat.st_dev != pathStat.st_dev) ||
+       ((size_t)fdStat.st_size != _persistedState._fileBytes))
+      {
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: File %s was changed by another server; cannot append to it",
+                                        cacheFileName.c_str());
+      close(fd); // also releases the lock
+      return 0;
+      }
+
+   FILE *f = fdopen(fd, "r+b");
+   if (!f)
+      {
+      close(fd);
+      return 0;
+      }
+
+   size_t numMethods = 0;
+   JITServerAOTCachePersistedState newState = _persistedState;
+   if (0 == fseek(f, 0, SEEK_END))
+      numMethods = writeCache(f, newState);
+   if ((0 != fflush(f)) || (0 == numMethods))
+      {
+      // Drop any partially written segment so that the file stays usable
+      numMethods = 0;
+      if (0 != ftruncate(fd, _persistedState._fileBytes))
+         _persistedState._fileBytes = 0; // The next save operation must rewrite the file
+      }
+   fclose(f);
+
+   if (numMethods)
+      _persistedState = newState;
+   return numMethods;
+   }
+
+
+bool
+JITServerAOTCache::triggerPeerSyncIfNeeded()
+   {
+   TR::CompilationInfo *compInfo = TR::CompilationInfo::get();
+   auto aotCacheMap = compInfo->getJITServerAOTCacheMap();
+
+      {
+      OMR::CriticalSection cs(_cachedMethodMonitor);
+      if (_peerSyncInProgress)
+         return false;
+      if (compInfo->getPersistentInfo()->getElapsedTime() < _timePrevPeerSync + TR::Options::_aotCachePeerSyncPeriodMs)
+         return false;
+      _peerSyncInProgress = true;
+      }
+
+   aotCacheMap->queueAOTCacheForPeerSync(_name);
+   if (!queueSpecialAOTCacheRequest(compInfo, SYNC_AOTCACHE_REQUEST))
+      {
+      // No request will dequeue the name; leaving it would make the next request sync this cache instead of its own
+      aotCacheMap->unqueueAOTCacheForPeerSync(_name);
+      // Only the thread that set _peerSyncInProgress can reset it if a request was not queued
+      _peerSyncInProgress = false;
+      return false;
+      }
+
+   if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: t=%llu Queued comp request to sync cache '%s' with peers in the background",
+                                     compInfo->getPersistentInfo()->getElapsedTime(), _name.c_str());
+   return true;
+   }
+
+void
+JITServerAOTCache::finalizePeerSync()
+   {
+   OMR::CriticalSection cs(_cachedMethodMonitor);
+   _timePrevPeerSync = TR::CompilationInfo::get()->getPersistentInfo()->getElapsedTime();
+   _peerSyncInProgress = false;
+   }
+
+std::string
+JITServerAOTCache::serializeMethodsForPeer(size_t firstIndex, size_t maxMethods, size_t &numMethods, TR_Memory &trMemory) const
+   {
+   TR::StackMemoryRegion stackMemoryRegion(trMemory);
+
+   // Cached methods and records are never modified or freed once added, so we only
+   // need to hold the monitors while reading the traversal pointers
+   VectorAllocator<const CachedAOTMethod *> methodsAllocator(trMemory.currentStackRegion());
+   Vector<const CachedAOTMethod *> methods(methodsAllocator);
+      {
+      OMR::CriticalSection cs(_cachedMethodMonitor);
+      numMethods = _cachedMethodMap.size();
+      const CachedAOTMethod *current = _cachedMethodHead;
+      for (size_t i = 0; current && (i < firstIndex); ++i)
+         current = current->getNextRecord();
+      for (; current && (methods.size() < maxMethods); current = current->getNextRecord())
+         methods.push_back(current);
+      }
+
+   // The AOT header records of the methods collected above are already in the list
+   VectorAllocator<const AOTCacheAOTHeaderRecord *> aotHeadersAllocator(trMemory.currentStackRegion());
+   Vector<const AOTCacheAOTHeaderRecord *> aotHeaders(aotHeadersAllocator);
+      {
+      OMR::CriticalSection cs(_aotHeaderMonitor);
+      for (const AOTCacheRecord *r = _aotHeaderHead; r; r = r->getNextRecord())
+         aotHeaders.push_back((const AOTCacheAOTHeaderRecord *)r);
+      }
+
+   VectorAllocator<const AOTSerializationRecord *> recordsAllocator(trMemory.currentStackRegion());
+   Vector<const AOTSerializationRecord *> records(recordsAllocator);
+   UnorderedSetAllocator<const AOTCacheRecord *> newRecordsAllocator(trMemory.currentStackRegion());
+   UnorderedSet<const AOTCacheRecord *> newRecords(newRecordsAllocator);
+   // The peer does not know any of our records
+   KnownIdSet knownIds(KnownIdSet::allocator_type(TR::Compiler->persistentAllocator()));
+
+   size_t batchSize = sizeof(JITServerAOTCachePeerBatchHeader);
+   for (auto method : methods)
+      {
+      addRecord(method->definingClassChainRecord(), records, newRecords, knownIds);
+      for (auto aotHeader : aotHeaders)
+         {
+         if (aotHeader->data().id() == method->data().aotHeaderId())
+            {
+            addRecord(aotHeader, records, newRecords, knownIds);
+            break;
+            }
+         }
+      for (size_t i = 0; i < method->data().numRecords(); ++i)
+         addRecord(method->records()[i], records, newRecords, knownIds);
+      batchSize += method->data().size();
+      }
+   for (auto record : records)
+      batchSize += record->size();
+
+   JITServerAOTCachePeerBatchHeader header = {0};
+   getCurrentAOTCacheVersion(header._version);
+   header._numRecords = records.size();
+   header._numMethods = methods.size();
+
+   std::string batch(batchSize, '\0');
+   uint8_t *current = (uint8_t *)&batch[0];
+   memcpy(current, &header, sizeof(header));
+   current += sizeof(header);
+   for (auto record : records)
+      {
+      memcpy(current, record, record->size());
+      current += record->size();
+      }
+   for (auto method : methods)
+      {
+      memcpy(current, &method->data(), method->data().size());
+      current += method->data().size();
+      }
+   TR_ASSERT_FATAL(current == (uint8_t *)&batch[0] + batchSize, "Peer batch size mismatch");
+
+   return batch;
+   }
+
+// Check that the variable-sized portion of a serialization record received from a peer fits within the record
+static bool
+isValidPeerRecord(const AOTSerializationRecord *record)
+   {
+   switch (record->type())
+      {
+      case AOTSerializationRecordType::ClassLoader:
+         {
+         auto r = (const ClassLoaderSerializationRecord *)record;
+         return (record->size() >= sizeof(*r)) && r->nameLength() && (r->nameLength() <= record->size() - sizeof(*r));
+         }
+      case AOTSerializationRecordType::Class:
+         {
+         auto r = (const ClassSerializationRecord *)record;
+         return (record->size() >= sizeof(*r)) && (r->nameLength() <= record->size() - sizeof(*r));
+         }
+      case AOTSerializationRecordType::Method:
+         return record->size() >= sizeof(MethodSerializationRecord);
+      case AOTSerializationRecordType::ClassChain:
+         {
+         auto r = (const ClassChainSerializationRecord *)record;
+         return (record->size() >= sizeof(*r)) && r->list().length() &&
+                (r->list().length() <= (record->size() - sizeof(*r)) / sizeof(uintptr_t));
+         }
+      case AOTSerializationRecordType::WellKnownClasses:
+         {
+         auto r = (const WellKnownClassesSerializationRecord *)record;
+         return (record->size() >= sizeof(*r)) &&
+                (r->list().length() <= (record->size() - sizeof(*r)) / sizeof(uintptr_t));
+         }
+      case AOTSerializationRecordType::AOTHeader:
+         return record->size() >= sizeof(AOTHeaderSerializationRecord);
+      case AOTSerializationRecordType::Thunk:
+         {
+         auto r = (const ThunkSerializationRecord *)record;
+         return (record->size() >= sizeof(*r)) &&
+                ((uint64_t)r->signatureSize() + r->thunkSize() <= record->size() - sizeof(*r));
+         }
+      default:
+         return false;
+      }
+   }
+
+int64_t
+JITServerAOTCache::importPeerMethods(const std::string &batch, TR_Memory &trMemory)
+   {
+   const uint8_t *current = (const uint8_t *)batch.data();
+   const uint8_t *end = current + batch.size();
+
+   JITServerAOTCachePeerBatchHeader header;
+   if (batch.size() < sizeof(header))
+      return -1;
+   memcpy(&header, current, sizeof(header));
+   if (!isCompatibleSnapshotVersion(header._version))
+      return -1;
+   current += sizeof(header);
+
+   TR::StackMemoryRegion stackMemoryRegion(trMemory);
+   // Maps the ID and type of each record received from the peer to the equivalent local record
+   UnorderedMapAllocator<uintptr_t, const AOTCacheRecord *> localRecordsAllocator(trMemory.currentStackRegion());
+   UnorderedMap<uintptr_t, const AOTCacheRecord *> localRecords(localRecordsAllocator);
+   auto lookup = [&](uintptr_t id, AOTSerializationRecordType type) -> const AOTCacheRecord *
+      {
+      if (!id)
+         return NULL;
+      auto it = localRecords.find(AOTSerializationRecord::idAndType(id, type));
+      return (it != localRecords.end()) ? it->second : NULL;
+      };
+
+   for (size_t i = 0; i < header._numRecords; ++i)
+      {
+      if ((size_t)(end - current) < sizeof(AOTSerializationRecord))
+         return -1;
+      auto record = (const AOTSerializationRecord *)current;
+      if ((record->size() > (size_t)(end - current)) || !record->id() || !isValidPeerRecord(record))
+         return -1;
+      current += record->size();
+
+      // Records are sent in dependency order, so the sub-records of this record have already been imported
+      const AOTCacheRecord *localRecord = NULL;
+      switch (record->type())
+         {
+         case AOTSerializationRecordType::ClassLoader:
+            {
+            auto r = (const ClassLoaderSerializationRecord *)record;
+            localRecord = getClassLoaderRecord(r->name(), r->nameLength());
+            break;
+            }
+         case AOTSerializationRecordType::Class:
+            {
+            auto r = (const ClassSerializationRecord *)record;
+            auto loaderRecord = (const AOTCacheClassLoaderRecord *)lookup(r->classLoaderId(), AOTSerializationRecordType::ClassLoader);
+            if (!loaderRecord)
+               return -1;
+            localRecord = getClassRecord(loaderRecord, *r);
+            break;
+            }
+         case AOTSerializationRecordType::Method:
+            {
+            auto r = (const MethodSerializationRecord *)record;
+            auto classRecord = (const AOTCacheClassRecord *)lookup(r->definingClassId(), AOTSerializationRecordType::Class);
+            if (!classRecord)
+               return -1;
+            localRecord = getMethodRecord(classRecord, r->index(), NULL);
+            break;
+            }
+         case AOTSerializationRecordType::ClassChain:
+            {
+            auto r = (const ClassChainSerializationRecord *)record;
+            VectorAllocator<const AOTCacheClassRecord *> classRecordsAllocator(trMemory.currentStackRegion());
+            Vector<const AOTCacheClassRecord *> classRecords(r->list().length(), NULL, classRecordsAllocator);
+            for (size_t j = 0; j < r->list().length(); ++j)
+               {
+               classRecords[j] = (const AOTCacheClassRecord *)lookup(r->list().ids()[j], AOTSerializationRecordType::Class);
+               if (!classRecords[j])
+                  return -1;
+               }
+            localRecord = getClassChainRecord(classRecords.data(), classRecords.size());
+            break;
+            }
+         case AOTSerializationRecordType::WellKnownClasses:
+            {
+            auto r = (const WellKnownClassesSerializationRecord *)record;
+            VectorAllocator<const AOTCacheClassChainRecord *> chainRecordsAllocator(trMemory.currentStackRegion());
+            Vector<const AOTCacheClassChainRecord *> chainRecords(r->list().length(), NULL, chainRecordsAllocator);
+            for (size_t j = 0; j < r->list().length(); ++j)
+               {
+               chainRecords[j] = (const AOTCacheClassChainRecord *)lookup(r->list().ids()[j], AOTSerializationRecordType::ClassChain);
+               if (!chainRecords[j])
+                  return -1;
+               }
+            localRecord = getWellKnownClassesRecord(chainRecords.data(), chainRecords.size(), r->includedClasses());
+            break;
+            }
+         case AOTSerializationRecordType::AOTHeader:
+            {
+            auto r = (const AOTHeaderSerializationRecord *)record;
+            localRecord = getAOTHeaderRecord(r->header(), 0);
+            break;
+            }
+         case AOTSerializationRecordType::Thunk:
+            {
+            auto r = (const ThunkSerializationRecord *)record;
+            localRecord = createAndStoreThunk(r->signature(), r->signatureSize(), r->thunkStart(), r->thunkSize());
+            break;
+            }
+         default:
+            return -1;
+         }
+
+      // The local cache ran out of space; the methods that depend on this record cannot be stored
+      if (!localRecord)
+         return 0;
+      localRecords.insert({ record->idAndType(), localRecord });
+      }
+
+   size_t numStoredMethods = 0;
+   VectorAllocator<std::pair<const AOTCacheRecord *, uintptr_t>> methodRecordsAllocator(trMemory.currentStackRegion());
+   for (size_t i = 0; i < header._numMethods; ++i)
+      {
+      if ((size_t)(end - current) < sizeof(SerializedAOTMethod))
+         return -1;
+      auto method = (const SerializedAOTMethod *)current;
+      size_t varSizedBytes = method->size() - sizeof(SerializedAOTMethod);
+      if ((method->size() > (size_t)(end - current)) || (method->size() < sizeof(SerializedAOTMethod)) ||
+          (method->numRecords() > varSizedBytes / sizeof(SerializedSCCOffset)) ||
+          (method->codeSize() > varSizedBytes) || (method->dataSize() > varSizedBytes) || (method->signatureSize() > varSizedBytes) ||
+          ((const uint8_t *)method->signature() + method->signatureSize() > method->end()))
+         return -1;
+      current += method->size();
+
+      auto chainRecord = (const AOTCacheClassChainRecord *)lookup(method->definingClassChainId(), AOTSerializationRecordType::ClassChain);
+      auto aotHeaderRecord = (const AOTCacheAOTHeaderRecord *)lookup(method->aotHeaderId(), AOTSerializationRecordType::AOTHeader);
+      if (!chainRecord || !aotHeaderRecord)
+         return -1;
+
+      Vector<std::pair<const AOTCacheRecord *, uintptr_t>> methodRecords(methodRecordsAllocator);
+      methodRecords.reserve(method->numRecords());
+      for (size_t j = 0; j < method->numRecords(); ++j)
+         {
+         const SerializedSCCOffset &offset = method->offsets()[j];
+         auto localRecord = lookup(offset.recordId(), offset.recordType());
+         if (!localRecord)
+            return -1;
+         methodRecords.push_back({ localRecord, offset.reloDataOffset() });
+         }
+
+      // The signature is not null-terminated in the serialized method
+      std::string signature(method->signature(), method->signatureSize());
+      const CachedAOTMethod *newMethod = NULL;
+      if (storeMethod(chainRecord, method->index(), method->optLevel(), aotHeaderRecord, methodRecords,
+                      method->code(), method->codeSize(), method->data(), method->dataSize(),
+                      signature.c_str(), 0, newMethod))
+         ++numStoredMethods;
+      }
+
+   return numStoredMethods;
+   }
+
+
 bool
 JITServerAOTCacheMap::cacheHasSpace()
    {
@@ -1778,10 +2394,43 @@ JITServerAOTCacheMap::JITServerAOTCacheMap() :
    _cachesToLoadQueue(decltype(_cachesToLoadQueue)::allocator_type(TR::Compiler->persistentGlobalAllocator())),
    _cachesExcludedFromLoading(decltype(_cachesExcludedFromLoading)::allocator_type(TR::Compiler->persistentGlobalAllocator())),
    _cachesToSaveQueue(decltype(_cachesToSaveQueue)::allocator_type(TR::Compiler->persistentGlobalAllocator())),
+   _cachesToSyncQueue(decltype(_cachesToSyncQueue)::allocator_type(TR::Compiler->persistentGlobalAllocator())),
+   _peers(decltype(_peers)::allocator_type(TR::Compiler->persistentGlobalAllocator())),
    _monitor(TR::Monitor::create("JIT-JITServerAOTCacheMapMonitor"))
    {
    if (!_monitor)
       throw std::bad_alloc();
+
+   // Parse the comma-separated list of <host>:<port> peers
+   const std::string &peers = TR::CompilationInfo::get()->getPersistentInfo()->getJITServerAOTCachePeers();
+   if (peers.empty())
+      return;
+   if (JITServer::CommunicationStream::useSSL())
+      {
+      // Peer connections are not encrypted, so they cannot be used when the server requires TLS
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Syncing with peers is not supported with TLS; ignoring the peer list");
+      return;
+      }
+   size_t start = 0;
+   while (start < peers.size())
+      {
+      size_t end = peers.find(',', start);
+      if (end == std::string::npos)
+         end = peers.size();
+      std::string peer = peers.substr(start, end - start);
+      size_t colon = peer.rfind(':');
+      int port = (colon != std::string::npos) ? atoi(peer.c_str() + colon + 1) : 0;
+      if ((colon != std::string::npos) && (colon > 0) && (port > 0) && (port <= 65535))
+         {
+         _peers.push_back({ peer.substr(0, colon), (uint32_t)port });
+         }
+      else if (!peer.empty() && TR::Options::getVerboseOption(TR_VerboseJITServer))
+         {
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Ignoring invalid peer '%s'; expected <host>:<port>", peer.c_str());
+         }
+      start = end + 1;
+      }
    }
 
 
@@ -1815,6 +2464,161 @@ JITServerAOTCacheMap::queueAOTCacheForSavingToFile(const std::string &cacheName)
    }
 
 
+void
+JITServerAOTCacheMap::queueAOTCacheForPeerSync(const std::string &cacheName)
+   {
+   OMR::CriticalSection cs(_monitor);
+   _cachesToSyncQueue.push_back(cacheName);
+   }
+
+
+void
+JITServerAOTCacheMap::unqueueAOTCacheForPeerSync(const std::string &cacheName)
+   {
+   OMR::CriticalSection cs(_monitor);
+   // Remove the most recent occurrence, i.e. the one added by the caller
+   for (auto it = _cachesToSyncQueue.rbegin(); it != _cachesToSyncQueue.rend(); ++it)
+      {
+      if (*it == cacheName)
+         {
+         _cachesToSyncQueue.erase(std::next(it).base());
+         break;
+         }
+      }
+   }
+
+
+// Whether the peer at the given address is this server itself; such an entry is expected
+// when all the servers of a deployment are started with the same peer list
+static bool
+isOwnAddress(const std::string &address, uint32_t port, TR::PersistentInfo *persistentInfo)
+   {
+   if (port != persistentInfo->getJITServerPort())
+      return false;
+   if ((address == "localhost") || (address == "127.0.0.1") || (address == "::1"))
+      return true;
+   char hostName[256];
+   if (0 != gethostname(hostName, sizeof(hostName)))
+      return false;
+   hostName[sizeof(hostName) - 1] = '\0';
+   return address == hostName;
+   }
+
+
+void
+JITServerAOTCacheMap::syncNextQueuedAOTCacheWithPeers(J9::J9SegmentProvider &scratchSegmentProvider)
+   {
+   std::string cacheName;
+   JITServerAOTCache *cache = NULL;
+      {
+      OMR::CriticalSection cs(_monitor);
+      if (_cachesToSyncQueue.empty())
+         return;
+      cacheName = _cachesToSyncQueue.front();
+      _cachesToSyncQueue.pop_front();
+      auto it = _map.find(cacheName);
+      TR_ASSERT(it != _map.end(), "AOT Caches are never deleted in the current implementation");
+      cache = it->second;
+      }
+
+   TR::CompilationInfo *compInfo = TR::CompilationInfo::get();
+   TR::PersistentInfo *persistentInfo = compInfo->getPersistentInfo();
+   size_t segmentSize = scratchSegmentProvider.getPreferredSegmentSize();
+   if (!segmentSize)
+      segmentSize = 1 << 24/*16 MB*/;
+   TR::RawAllocator rawAllocator(compInfo->getJITConfig()->javaVM);
+   J9::SystemSegmentProvider segmentProvider(1 << 16/*64 KB*/, segmentSize, TR::Options::getScratchSpaceLimit(), scratchSegmentProvider, rawAllocator);
+   TR::Region region(segmentProvider, rawAllocator);
+   TR_Memory trMemory(*compInfo->persistentMemory(), region);
+
+   size_t numImportedMethods = 0;
+   for (size_t i = 0; i < _peers.size(); ++i)
+      {
+      const std::string &address = _peers[i].first;
+      uint32_t port = _peers[i].second;
+      // The UID of a peer changes when it restarts, in which case its method list is pulled again from the start
+      std::pair<uint64_t, uint64_t> &state = cache->peerSyncState(i);
+      if (isOwnAddress(address, port, persistentInfo))
+         continue;
+      if (state.first == persistentInfo->getServerUID())
+         continue; // This entry is the current server itself, under an address not recognized above
+
+      JITServer::ClientStream *stream = NULL;
+      try
+         {
+         uint64_t numPeerMethods = 0;
+         do
+            {
+            // The peer closes the connection after answering each request
+            stream = new (PERSISTENT_NEW) JITServer::ClientStream(address, port, persistentInfo->getSocketTimeout());
+            stream->write(JITServer::MessageType::AOTCachePeer_request, cacheName, state.second);
+            stream->read();
+            auto recv = stream->getRecvData<std::string, uint64_t, uint64_t, uint64_t>();
+            stream->~ClientStream();
+            TR_Memory::jitPersistentFree(stream);
+            stream = NULL;
+
+            const std::string &batch = std::get<0>(recv);
+            uint64_t numBatchMethods = std::get<1>(recv);
+            numPeerMethods = std::get<2>(recv);
+            uint64_t peerUID = std::get<3>(recv);
+
+            if (peerUID == persistentInfo->getServerUID())
+               {
+               state.first = peerUID;
+               break;
+               }
+            if (peerUID != state.first)
+               {
+               // First contact with this peer, or the peer restarted since the last sync.
+               // Unless this batch was already requested from the start of the list, ask again.
+               bool fromStart = (state.second == 0);
+               state = { peerUID, 0 };
+               if (!fromStart)
+                  continue;
+               }
+            if (!numBatchMethods)
+               break;
+
+            int64_t numStored = cache->importPeerMethods(batch, trMemory);
+            if (numStored < 0)
+               {
+               if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+                  TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache %s: Ignoring malformed batch of methods from peer %s:%u",
+                                                 cacheName.c_str(), address.c_str(), port);
+               break;
+               }
+            numImportedMethods += numStored;
+            state.second += numBatchMethods;
+            }
+         while (state.second < numPeerMethods);
+         }
+      catch (const JITServer::StreamFailure &e)
+         {
+         if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache %s: Failed to sync with peer %s:%u: %s",
+                                           cacheName.c_str(), address.c_str(), port, e.what());
+         }
+      catch (const std::exception &e)
+         {
+         if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache %s: Exception while syncing with peer %s:%u: %s",
+                                           cacheName.c_str(), address.c_str(), port, e.what());
+         }
+      if (stream)
+         {
+         stream->~ClientStream();
+         TR_Memory::jitPersistentFree(stream);
+         }
+      }
+
+   cache->finalizePeerSync();
+   if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: t=%llu Imported %zu methods into cache '%s' from peers",
+                                     persistentInfo->getElapsedTime(), numImportedMethods, cacheName.c_str());
+   }
+
+
 bool
 JITServerAOTCacheMap::saveNextQueuedAOTCacheToFile()
    {
@@ -1846,11 +2650,24 @@ JITServerAOTCacheMap::saveNextQueuedAOTCacheToFile()
       {
       std::string cacheFileName = buildCacheFileName(compInfo->getPersistentInfo()->getJITServerAOTCacheDir(), cacheName);
 
+      PORT_ACCESS_FROM_JITCONFIG(compInfo->getJITConfig());
+      OMRPORT_ACCESS_FROM_J9PORT(PORTLIB);
+
+      // If nobody else has changed the file since we last wrote or read it, only the new records need to be written
+      uint64_t appendStartTime = TR::Options::getVerboseOption(TR_VerboseJITServer) ? j9time_hires_clock() : 0;
+      if ((numAOTMethodsWritten = cache->appendToCacheFile(cacheFileName)) != 0)
+         {
+         success = true;
+         if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+            {
+            uint64_t durationUsec = j9time_hires_delta(appendStartTime, j9time_hires_clock(), J9PORT_TIME_DELTA_IN_MICROSECONDS);
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: t=%llu Appended new records of cache '%s' to file %s. %zu methods in file; append took %llu usec",
+                                           compInfo->getPersistentInfo()->getElapsedTime(), cacheName.c_str(), cacheFileName.c_str(), numAOTMethodsWritten, durationUsec);
+            }
+         }
       // If a similarly named AOT cache file already exists, must determine if it's a better snapshot or not
-      if (cache->isAOTCacheBetterThanSnapshot(cacheFileName, TR::Options::_aotCachePersistenceMinDeltaMethods))
+      else if (cache->isAOTCacheBetterThanSnapshot(cacheFileName, TR::Options::_aotCachePersistenceMinDeltaMethods))
          {
-         PORT_ACCESS_FROM_JITCONFIG(compInfo->getJITConfig());
-         OMRPORT_ACCESS_FROM_J9PORT(PORTLIB);
          uint64_t startTime = TR::Options::getVerboseOption(TR_VerboseJITServer) ? j9time_hires_clock() : 0;
 
          // Create a temporary file based on the UID of this server and the cache name
@@ -1859,7 +2676,8 @@ JITServerAOTCacheMap::saveNextQueuedAOTCacheToFile()
          FILE *newCacheFile = fopen(tempFileName.c_str(), "wb");
          if (newCacheFile)
             {
-            if ((numAOTMethodsWritten = cache->writeCache(newCacheFile)) != 0)
+            JITServerAOTCachePersistedState newState = {};
+            if ((numAOTMethodsWritten = cache->writeCache(newCacheFile, newState)) != 0)
                {
                fclose(newCacheFile);
                newCacheFile = NULL;
@@ -1871,6 +2689,8 @@ JITServerAOTCacheMap::saveNextQueuedAOTCacheToFile()
                   if (0 == rename(tempFileName.c_str(), cacheFileName.c_str()))
                      {
                      success = true;
+                     // Subsequent save operations can append to the new file
+                     cache->setPersistedState(newState);
 
                      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
                         {
@@ -1949,19 +2769,27 @@ JITServerAOTCacheMap::loadNextQueuedAOTCacheFromFile(J9::J9SegmentProvider &scra
       }
 
    JITServerAOTCache *cache = NULL;
-   FILE *cacheFile = NULL;
+   int cacheFileFd = -1;
+   void *mappedFile = MAP_FAILED;
+   size_t mappedBytes = 0;
    try
       {
       TR::CompilationInfo *compInfo = TR::CompilationInfo::get();
       std::string cacheFileName = buildCacheFileName(compInfo->getPersistentInfo()->getJITServerAOTCacheDir(), cacheName);
 
-      // Open the AOT cache file and create a new JITServerAOTCache object
-      FILE *cacheFile = fopen(cacheFileName.c_str(), "rb");
-      if (cacheFile)
+      // Map the AOT cache file and create a new JITServerAOTCache object from its contents.
+      // The shared lock keeps other servers from appending to the file while we parse it.
+      struct stat fileStat;
+      cacheFileFd = open(cacheFileName.c_str(), O_RDONLY);
+      if ((cacheFileFd >= 0) && (0 == flock(cacheFileFd, LOCK_SH)) && (0 == fstat(cacheFileFd, &fileStat)) &&
+          ((size_t)fileStat.st_size >= sizeof(JITServerAOTCacheHeader)) &&
+          (MAP_FAILED != (mappedFile = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, cacheFileFd, 0))))
          {
+         mappedBytes = fileStat.st_size;
+         madvise(mappedFile, mappedBytes, MADV_SEQUENTIAL);
          if (TR::Options::getVerboseOption(TR_VerboseJITServer))
-            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: t=%llu Opened file %s to load cache '%s' from file",
-                                           compInfo->getPersistentInfo()->getElapsedTime(), cacheFileName.c_str(), cacheName.c_str());
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: t=%llu Mapped file %s (%zu bytes) to load cache '%s' from file",
+                                           compInfo->getPersistentInfo()->getElapsedTime(), cacheFileName.c_str(), mappedBytes, cacheName.c_str());
          size_t segmentSize = scratchSegmentProvider.getPreferredSegmentSize();
          if (!segmentSize)
             segmentSize = 1 << 24/*16 MB*/;
@@ -1970,9 +2798,12 @@ JITServerAOTCacheMap::loadNextQueuedAOTCacheFromFile(J9::J9SegmentProvider &scra
          TR::Region region(segmentProvider, rawAllocator);
          TR_Memory trMemory(*compInfo->persistentMemory(), region);
 
-         cache = JITServerAOTCache::readCache(cacheFile, cacheName, trMemory); // This should not throw
-         fclose(cacheFile); // filestream not needed anymore
-         cacheFile = NULL;
+         cache = JITServerAOTCache::readCache((const uint8_t *)mappedFile, mappedBytes, cacheName, trMemory); // This should not throw
+         // The records were copied into persistent memory, so the mapping is not needed anymore
+         munmap(mappedFile, mappedBytes);
+         mappedFile = MAP_FAILED;
+         close(cacheFileFd);
+         cacheFileFd = -1;
 
          if (cache)
             {
@@ -1990,10 +2821,15 @@ JITServerAOTCacheMap::loadNextQueuedAOTCacheFromFile(J9::J9SegmentProvider &scra
                TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Failed to create cache '%s' from file", cacheName.c_str());
             }
          }
-      else // Cannot open the AOT cache file
+      else // Cannot open or map the AOT cache file
          {
          if (TR::Options::getVerboseOption(TR_VerboseJITServer))
-            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Failed to open cache file %s: %s", cacheFileName.c_str(), strerror(errno));
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: Failed to map cache file %s: %s", cacheFileName.c_str(), strerror(errno));
+         if (cacheFileFd >= 0)
+            {
+            close(cacheFileFd);
+            cacheFileFd = -1;
+            }
          }
       }
    catch(const std::exception& e)
@@ -2002,10 +2838,15 @@ JITServerAOTCacheMap::loadNextQueuedAOTCacheFromFile(J9::J9SegmentProvider &scra
          {
          TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "AOT cache: exception caught when trying to read-in cache '%s': %s", cacheName.c_str(), e.what());
          }
-      if (cacheFile)
+      if (MAP_FAILED != mappedFile)
          {
-         fclose(cacheFile);
-         cacheFile = NULL;
+         munmap(mappedFile, mappedBytes);
+         mappedFile = MAP_FAILED;
+         }
+      if (cacheFileFd >= 0)
+         {
+         close(cacheFileFd);
+         cacheFileFd = -1;
          }
       if (cache)
          {
@@ -2024,6 +2865,15 @@ JITServerAOTCacheMap::loadNextQueuedAOTCacheFromFile(J9::J9SegmentProvider &scra
    }
 
 
+JITServerAOTCache *
+JITServerAOTCacheMap::find(const std::string &name)
+   {
+   OMR::CriticalSection cs(_monitor);
+   auto it = _map.find(name);
+   return (it != _map.end()) ? it->second : NULL;
+   }
+
+
 JITServerAOTCache *
 JITServerAOTCacheMap::get(const std::string &name, uint64_t clientUID, bool &pending)
    {
@@ -2114,6 +2964,21 @@ JITServerAOTCacheMap::getNumDeserializedMethods() const
    return result;
    }
 
+void
+JITServerAOTCacheMap::getAccessStats(size_t &numHits, size_t &numMisses, size_t &numBypasses) const
+   {
+   numHits = 0;
+   numMisses = 0;
+   numBypasses = 0;
+   OMR::CriticalSection cs(_monitor);
+   for (auto &it : _map)
+      {
+      numHits += it.second->getNumCacheHits();
+      numMisses += it.second->getNumCacheMisses();
+      numBypasses += it.second->getNumCacheBypasses();
+      }
+   }
+
 void
 JITServerAOTCacheMap::printStats(FILE *f) const
    {
@@ -32,7 +32,7 @@
 
 class JITServerSharedProfileCache;
 
-static const uint32_t JITSERVER_AOTCACHE_VERSION = 1;
+static const uint32_t JITSERVER_AOTCACHE_VERSION = 2;
 static const char JITSERVER_AOTCACHE_EYECATCHER[] = "AOTCACHE";
 // the eye-catcher is not null-terminated in the snapshot files
 static const size_t JITSERVER_AOTCACHE_EYECATCHER_LENGTH = sizeof(JITSERVER_AOTCACHE_EYECATCHER) - 1;
@@ -49,7 +49,12 @@ struct JITServerAOTCacheVersion
    uint64_t _jitserverVersion;
    };
 
-// The header information for an AOT cache snapshot.
+// The header information for an AOT cache snapshot segment.
+//
+// A snapshot file consists of a full base segment followed by zero or more delta
+// segments appended by later save operations. Each segment starts with this header;
+// the record counts describe only the records stored in that segment, while the
+// next IDs are cumulative over all the segments up to and including it.
 struct JITServerAOTCacheHeader
    {
    JITServerAOTCacheVersion _version;
@@ -69,8 +74,37 @@ struct JITServerAOTCacheHeader
    size_t _nextWellKnownClassesId;
    size_t _nextAOTHeaderId;
    size_t _nextThunkId;
+   size_t _segmentBytes; // including this header
    };
 
+class AOTCacheRecord;
+class CachedAOTMethod;
+
+// Describes the prefix of each record traversal that is already stored in the cache file,
+// so that a save operation only needs to append the records added since then.
+struct JITServerAOTCachePersistedState
+   {
+   JITServerAOTCacheHeader _header; // cumulative record counts and next IDs
+   const AOTCacheRecord *_classLoaderTail;
+   const AOTCacheRecord *_classTail;
+   const AOTCacheRecord *_methodTail;
+   const AOTCacheRecord *_classChainTail;
+   const AOTCacheRecord *_wellKnownClassesTail;
+   const AOTCacheRecord *_aotHeaderTail;
+   const AOTCacheRecord *_thunkTail;
+   const CachedAOTMethod *_cachedMethodTail;
+   size_t _fileBytes; // 0 if the file is unknown or must be rewritten from scratch
+   };
+
+// Header of a batch of AOT methods exchanged between JITServer peers
+struct JITServerAOTCachePeerBatchHeader
+   {
+   JITServerAOTCacheVersion _version;
+   size_t _numRecords;
+   size_t _numMethods;
+   };
+
+struct JITServerAOTCacheFileCursor;
 struct AOTCacheClassLoaderRecord;
 struct AOTCacheClassRecord;
 struct AOTCacheMethodRecord;
@@ -80,6 +114,7 @@ struct AOTCacheAOTHeaderRecord;
 
 #define LOAD_AOTCACHE_REQUEST (JITServer::ServerStream *)0x1
 #define SAVE_AOTCACHE_REQUEST (JITServer::ServerStream *)0x3 // pointers cannot have the last bit set
+#define SYNC_AOTCACHE_REQUEST (JITServer::ServerStream *)0x5
 
 // Base class for serialization record "wrappers" stored at the server.
 //
@@ -116,7 +151,7 @@ public:
    static void *allocate(size_t size);
    static void free(void *ptr);
 
-   template<class R> static R *readRecord(FILE *f, const JITServerAOTCacheReadContext &context);
+   template<class R> static R *readRecord(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    AOTCacheRecord *getNextRecord() const { return _nextRecord; }
    void setNextRecord(AOTCacheRecord *record) { _nextRecord = record; }
@@ -145,7 +180,7 @@ public:
 private:
    using SerializationRecord = ClassLoaderSerializationRecord;
 
-   friend AOTCacheClassLoaderRecord *AOTCacheRecord::readRecord<>(FILE *f, const JITServerAOTCacheReadContext &context);
+   friend AOTCacheClassLoaderRecord *AOTCacheRecord::readRecord<>(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    AOTCacheClassLoaderRecord(uintptr_t id, const uint8_t *name, size_t nameLength);
    AOTCacheClassLoaderRecord(const JITServerAOTCacheReadContext &context, const ClassLoaderSerializationRecord &header) {}
@@ -173,17 +208,21 @@ public:
    static AOTCacheClassRecord *create(uintptr_t id, const AOTCacheClassLoaderRecord *classLoaderRecord,
                                       const JITServerROMClassHash &hash, uint32_t romClassSize, bool generated,
                                       const J9ROMClass *romClass, const J9ROMClass *baseComponent, uint32_t numDimensions);
+   // Create a copy of a class record received from a peer server, with local IDs
+   static AOTCacheClassRecord *create(uintptr_t id, const AOTCacheClassLoaderRecord *classLoaderRecord,
+                                      const ClassSerializationRecord &peerRecord);
 
    void subRecordsDo(const std::function<void(const AOTCacheRecord *)> &f) const override;
 
 private:
    using SerializationRecord = ClassSerializationRecord;
 
-   friend AOTCacheClassRecord *AOTCacheRecord::readRecord<>(FILE *f, const JITServerAOTCacheReadContext &context);
+   friend AOTCacheClassRecord *AOTCacheRecord::readRecord<>(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    AOTCacheClassRecord(uintptr_t id, const AOTCacheClassLoaderRecord *classLoaderRecord, const JITServerROMClassHash &hash,
                        uint32_t romClassSize, bool generated, const J9ROMClass *romClass,
                        const J9ROMClass *baseComponent, uint32_t numDimensions, uint32_t nameLength);
+   AOTCacheClassRecord(uintptr_t id, const AOTCacheClassLoaderRecord *classLoaderRecord, const ClassSerializationRecord &peerRecord);
    AOTCacheClassRecord(const JITServerAOTCacheReadContext &context, const ClassSerializationRecord &header);
 
    static size_t size(uint32_t nameLength)
@@ -212,7 +251,7 @@ public:
 private:
    using SerializationRecord = MethodSerializationRecord;
 
-   friend AOTCacheMethodRecord *AOTCacheRecord::readRecord<>(FILE *f, const JITServerAOTCacheReadContext &context);
+   friend AOTCacheMethodRecord *AOTCacheRecord::readRecord<>(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    AOTCacheMethodRecord(uintptr_t id, const AOTCacheClassRecord *definingClassRecord, uint32_t index);
    AOTCacheMethodRecord(const JITServerAOTCacheReadContext &context, const MethodSerializationRecord &header);
@@ -256,7 +295,7 @@ private:
 
    using SerializationRecord = ClassChainSerializationRecord;
 
-   friend AOTCacheClassChainRecord *AOTCacheRecord::readRecord<>(FILE *f, const JITServerAOTCacheReadContext &context);
+   friend AOTCacheClassChainRecord *AOTCacheRecord::readRecord<>(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    virtual bool setSubrecordPointers(const JITServerAOTCacheReadContext &context) override;
 
@@ -296,7 +335,7 @@ private:
 
    using SerializationRecord = WellKnownClassesSerializationRecord;
 
-   friend AOTCacheWellKnownClassesRecord *AOTCacheRecord::readRecord<>(FILE *f, const JITServerAOTCacheReadContext &context);
+   friend AOTCacheWellKnownClassesRecord *AOTCacheRecord::readRecord<>(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    virtual bool setSubrecordPointers(const JITServerAOTCacheReadContext &context) override;
 
@@ -317,7 +356,7 @@ public:
 private:
    using SerializationRecord = AOTHeaderSerializationRecord;
 
-   friend AOTCacheAOTHeaderRecord *AOTCacheRecord::readRecord<>(FILE *f, const JITServerAOTCacheReadContext &context);
+   friend AOTCacheAOTHeaderRecord *AOTCacheRecord::readRecord<>(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    AOTCacheAOTHeaderRecord(uintptr_t id, const TR_AOTHeader *header);
    AOTCacheAOTHeaderRecord(const JITServerAOTCacheReadContext &context, const AOTHeaderSerializationRecord &header) {}
@@ -340,7 +379,7 @@ public:
 private:
    using SerializationRecord = ThunkSerializationRecord;
 
-   friend AOTCacheThunkRecord *AOTCacheRecord::readRecord<>(FILE *f, const JITServerAOTCacheReadContext &context);
+   friend AOTCacheThunkRecord *AOTCacheRecord::readRecord<>(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    AOTCacheThunkRecord(uintptr_t id, const uint8_t *signature, uint32_t signatureSize, const uint8_t *thunkStart, uint32_t thunkSize);
    AOTCacheThunkRecord(const JITServerAOTCacheReadContext &context, const ThunkSerializationRecord &header) {}
@@ -388,7 +427,7 @@ public:
 private:
    using SerializationRecord = SerializedAOTMethod;
 
-   friend CachedAOTMethod *AOTCacheRecord::readRecord<>(FILE *f, const JITServerAOTCacheReadContext &context);
+   friend CachedAOTMethod *AOTCacheRecord::readRecord<>(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheReadContext &context);
 
    CachedAOTMethod(const AOTCacheClassChainRecord *definingClassChainRecord, uint32_t index,
                    TR_Hotness optLevel, const AOTCacheAOTHeaderRecord *aotHeaderRecord,
@@ -441,6 +480,10 @@ public:
    const AOTCacheClassRecord *getClassRecord(const AOTCacheClassLoaderRecord *loaderRecord, const J9ROMClass *romClass,
                                              const J9ROMClass *baseComponent, uint32_t numDimensions,
                                              J9::J9SegmentProvider *scratchSegmentProvider = NULL);
+   // Used when importing records from a peer server, where the ROMClass is not available
+   const AOTCacheClassRecord *getClassRecord(const AOTCacheClassLoaderRecord *loaderRecord,
+                                             const ClassSerializationRecord &peerRecord);
+   // romMethod is only used for logging and can be NULL
    const AOTCacheMethodRecord *getMethodRecord(const AOTCacheClassRecord *definingClassRecord,
                                                uint32_t index, const J9ROMMethod *romMethod);
    const AOTCacheClassChainRecord *getClassChainRecord(const AOTCacheClassRecord *const *classRecords, size_t length);
@@ -485,14 +528,17 @@ public:
 
    void incNumCacheBypasses() { ++_numCacheBypasses; }
    void incNumCacheMisses() { ++_numCacheMisses; }
+   size_t getNumCacheBypasses() const { return _numCacheBypasses; }
+   size_t getNumCacheHits() const { return _numCacheHits; }
+   size_t getNumCacheMisses() const { return _numCacheMisses; }
    size_t getNumDeserializedMethods() const { return _numDeserializedMethods; }
    void incNumDeserializedMethods() { ++_numDeserializedMethods; }
    void incNumDeserializationFailures() { ++_numDeserializationFailures; }
 
    void printStats(FILE *f) const;
 
-   size_t writeCache(FILE *f) const;
-   static JITServerAOTCache *readCache(FILE *f, const std::string &name, TR_Memory &trMemory);
+   size_t writeCache(FILE *f, JITServerAOTCachePersistedState &state) const;
+   static JITServerAOTCache *readCache(const uint8_t *fileStart, size_t fileBytes, const std::string &name, TR_Memory &trMemory);
    size_t getNumCachedMethods() const;
    void setMinNumAOTMethodsToSave(size_t num) { _minNumAOTMethodsToSave = num; }
 
@@ -514,6 +560,18 @@ public:
    bool triggerAOTCacheStoreToFileIfNeeded();
    void finalizeSaveOperation(bool success, size_t numMethodsSavedToFile);
    void excludeCacheFromSavingToFile() { _excludedFromSavingToFile = true; }
+   void setPersistedState(const JITServerAOTCachePersistedState &state) { _persistedState = state; }
+
+  /**
+   * @brief Append the records added since the last save or load operation to the cache file.
+   *
+   * This is only possible if the file has not been modified by anyone else since we last
+   * wrote or read it; otherwise the caller must fall back to rewriting the whole file.
+   * Must only be called by the thread that owns the current save operation.
+   *
+   * @return the total number of AOT methods stored in the file, or 0 if nothing was appended
+   */
+   size_t appendToCacheFile(const std::string &cacheFileName);
 
    /**
       @brief Determine if current in-memory AOT cache is "better" than the one on file.
@@ -529,6 +587,52 @@ public:
    */
    bool isAOTCacheBetterThanSnapshot(const std::string &cacheFileName, size_t numExtraMethods);
 
+  /**
+   * @brief If enough time has passed since the last attempt, queue a request to pull
+   *        the AOT methods added to this cache by the peer servers since then.
+   *
+   * Only one peer sync operation can be in progress for a cache at any given time.
+   *
+   * @return true if the sync operation was launched, false otherwise
+   */
+   bool triggerPeerSyncIfNeeded();
+   void finalizePeerSync();
+
+  /**
+   * @brief Serialize a batch of cached AOT methods to be sent to a peer server.
+   *
+   * The result consists of a JITServerAOTCachePeerBatchHeader, followed by all the serialization
+   * records that the methods depend on (in dependency order, including the AOT header records),
+   * followed by the serialized methods themselves. Methods are numbered in the order in which
+   * they were added to the cache, which never changes since cached methods are never removed.
+   *
+   * @param firstIndex Position of the first method to serialize
+   * @param maxMethods Maximum number of methods to serialize
+   * @param numMethods Output: total number of methods currently in the cache
+   * @return The serialized batch
+   */
+   std::string serializeMethodsForPeer(size_t firstIndex, size_t maxMethods, size_t &numMethods, TR_Memory &trMemory) const;
+
+  /**
+   * @brief Add the methods from a batch received from a peer server to this cache.
+   *
+   * Peer record IDs are translated into the IDs of the equivalent local records,
+   * which are looked up by key or created if they don't exist yet. Methods that are
+   * already cached for the same key are skipped.
+   *
+   * @return the number of newly stored methods, or -1 if the batch is malformed
+   */
+   int64_t importPeerMethods(const std::string &batch, TR_Memory &trMemory);
+
+   // UID of each peer and the position in its method list up to which its methods were already imported.
+   // Only accessed by the thread that owns the current peer sync operation.
+   std::pair<uint64_t/*peerUID*/, uint64_t/*nextIndex*/> &peerSyncState(size_t peerIndex)
+      {
+      if (peerIndex >= _peerSyncState.size())
+         _peerSyncState.resize(peerIndex + 1, { 0, 0 });
+      return _peerSyncState[peerIndex];
+      }
+
    CachedAOTMethod *getCachedMethodHead() { return _cachedMethodHead; }
    TR::Monitor *getCachedMethodMonitor() { return _cachedMethodMonitor; }
 
@@ -602,14 +706,17 @@ private:
    static StringKey getRecordKey(const AOTCacheThunkRecord *record)
       { return { record->data().signature(), record->data().signatureSize() }; }
 
-   // Helper method used in getSerializationRecords()
+   // Helper method used in getSerializationRecords() and serializeMethodsForPeer()
    void addRecord(const AOTCacheRecord *record, Vector<const AOTSerializationRecord *> &result,
                   UnorderedSet<const AOTCacheRecord *> &newRecords, const KnownIdSet &knownIds) const;
    // Read a cache snapshot into an empty cache
-   bool readCache(FILE *f, const JITServerAOTCacheHeader &header, TR_Memory &trMemory);
+   bool readCache(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheHeader &header, TR_Memory &trMemory);
+   // Read one snapshot segment on top of the records read from the previous segments
+   bool readCacheSegment(JITServerAOTCacheFileCursor &cursor, const JITServerAOTCacheHeader &header,
+                         JITServerAOTCacheReadContext &context);
 
    template<typename K, typename V, typename H>
-   static bool readRecords(FILE *f, JITServerAOTCacheReadContext &context, size_t numRecordsToRead,
+   static bool readRecords(JITServerAOTCacheFileCursor &cursor, JITServerAOTCacheReadContext &context, size_t numRecordsToRead,
                            PersistentUnorderedMap<K, V *, H> &map, V *&traversalHead, V *&traversalTail, Vector<V *> &records);
 
    const std::string _name;
@@ -669,6 +776,10 @@ private:
    size_t _minNumAOTMethodsToSave;    // Minimum number of AOT methods present in the cache before considering a save operation
    bool _saveOperationInProgress;     // True if an AOTCache save operation is in progress
    bool _excludedFromSavingToFile;    // True if this cache is excluded from saving to file
+   JITServerAOTCachePersistedState _persistedState; // Only accessed by the thread performing a save or load operation
+   uint64_t _timePrevPeerSync;        // Millis when this cache was last synchronized with the peers
+   bool _peerSyncInProgress;          // True if a peer sync operation is in progress; protected by the _cachedMethodMonitor
+   PersistentVector<std::pair<uint64_t, uint64_t>> _peerSyncState;
 
    // Statistics
    size_t _numCacheBypasses;
@@ -722,7 +833,38 @@ public:
       @return Pointer to the named AOT cache, or NULL if the cache could not be created right away (or at all)
    */
    JITServerAOTCache *get(const std::string &name, uint64_t clientUID, bool &pending);
+
+   /**
+      @brief Obtain a pointer to a named AOT cache, without creating or loading it if it doesn't exist.
+
+      @param name  Name of the cache to look up
+      @return Pointer to the named AOT cache, or NULL if it is not in memory
+   */
+   JITServerAOTCache *find(const std::string &name);
+
+   bool hasPeers() const { return !_peers.empty(); }
+   /**
+      @brief Enqueue the given AOT cache name to be synchronized with the peer servers, later-on.
+   */
+   void queueAOTCacheForPeerSync(const std::string &cacheName);
+
+   /**
+      @brief Remove the given AOT cache name from the peer sync queue; used when the request
+      that would have processed it could not be queued.
+   */
+   void unqueueAOTCacheForPeerSync(const std::string &cacheName);
+
+   /**
+      @brief Pull the AOT methods added by each peer server to the next AOT cache that is queued for peer sync.
+
+      Each peer is asked for batches of methods starting at the position reached by the previous sync,
+      until the whole method list of the peer was received. Peer connections are not encrypted.
+      Any exceptions thrown by this method are caught and logged.
+   */
+   void syncNextQueuedAOTCacheWithPeers(J9::J9SegmentProvider &scratchSegmentProvider);
    size_t getNumDeserializedMethods() const;
+   // Totals across all the caches
+   void getAccessStats(size_t &numHits, size_t &numMisses, size_t &numBypasses) const;
 
    static void setCacheMaxBytes(size_t bytes) { _cacheMaxBytes = bytes; }
    static bool cacheHasSpace();
@@ -753,6 +895,13 @@ private:
    // possibly overwriting an existent file
    PersistentList<std::string> _cachesToSaveQueue;
 
+   // _cachesToSyncQueue is used to remember the caches that need to be synchronized with the peer servers
+   PersistentList<std::string> _cachesToSyncQueue;
+
+   // Set up at startup from the -XX:JITServerAOTCachePeers option and never modified afterwards.
+   // The list can include this server itself; such entries are detected by server UID and skipped.
+   PersistentVector<std::pair<std::string/*address*/, uint32_t/*port*/>> _peers;
+
    TR::Monitor *const _monitor;
 
    static size_t _cacheMaxBytes;
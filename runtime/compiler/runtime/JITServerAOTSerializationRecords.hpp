@@ -162,6 +162,8 @@ private:
    ClassSerializationRecord(uintptr_t id, uintptr_t classLoaderId, const JITServerROMClassHash &hash,
                             uint32_t romClassSize, bool generated, const J9ROMClass *romClass,
                             const J9ROMClass *baseComponent, uint32_t numDimensions, uint32_t nameLength);
+   // Copy of a record received from a peer server, with its IDs replaced by local ones
+   ClassSerializationRecord(uintptr_t id, uintptr_t classLoaderId, const ClassSerializationRecord &other);
    ClassSerializationRecord();
 
    static size_t size(uint32_t nameLength)
@@ -23,6 +23,7 @@
 #include "control/CompilationRuntime.hpp"
 #include "env/CompilerEnv.hpp"
 #include "infra/CriticalSection.hpp"
+#include "runtime/JITClientSession.hpp"
 #include "runtime/JITServerSharedROMClassCache.hpp"
 
 
@@ -31,7 +32,7 @@
 struct JITServerSharedROMClassCache::Entry
    {
    Entry(const J9ROMClass *romClass) :
-      _refCount(1), _hash(NULL), _eyeCatcher(JITSERVER_SHARED_ROMCLASS_EYECATCHER)
+      _refCount(1), _hash(NULL), _metadata(NULL), _eyeCatcher(JITSERVER_SHARED_ROMCLASS_EYECATCHER)
       {
       memcpy(_data, romClass, romClass->romSize);
       }
@@ -60,27 +61,111 @@ struct JITServerSharedROMClassCache::Entry
    //NOTE: The entity pointed to by _hash is not owned by this Entry,
    //      and must not be deleted when the Entry is destroyed.
    const JITServerROMClassHash *_hash;
+   // Created on demand; protected by the partition monitor
+   Metadata *_metadata;
    const size_t _eyeCatcher;
    uint8_t _data[];// embedded J9ROMClass
    };
 
 
+struct JITServerSharedROMClassCache::LayoutRecord
+   {
+   LayoutRecord(const ClassLayout &layout, const PersistentVector<int32_t> &referenceSlots,
+                TR_PersistentMemory *persistentMemory) :
+      _superclassHashes(decltype(_superclassHashes)::allocator_type(persistentMemory->_persistentAllocator.get())),
+      _totalInstanceSize(layout._totalInstanceSize), _byteOffsetToLockword(layout._byteOffsetToLockword),
+      _compressedRefs(layout._compressedRefs),
+      _referenceSlots(referenceSlots.begin(), referenceSlots.end(),
+                      decltype(_referenceSlots)::allocator_type(persistentMemory->_persistentAllocator.get()))
+      {
+      _superclassHashes.reserve(layout._numSuperclasses);
+      for (size_t i = 0; i < layout._numSuperclasses; ++i)
+         _superclassHashes.push_back(getHash(layout._superclasses[i]));
+      }
+
+   // Superclasses are compared by hash rather than by pointer since a shared ROMClass
+   // can be freed and its memory reused for a different class while this record exists
+   bool matches(const ClassLayout &layout) const
+      {
+      if ((_totalInstanceSize != layout._totalInstanceSize) ||
+          (_byteOffsetToLockword != layout._byteOffsetToLockword) ||
+          (_compressedRefs != layout._compressedRefs) ||
+          (_superclassHashes.size() != layout._numSuperclasses))
+         return false;
+      for (size_t i = 0; i < layout._numSuperclasses; ++i)
+         {
+         if (_superclassHashes[i] != getHash(layout._superclasses[i]))
+            return false;
+         }
+      return true;
+      }
+
+   PersistentVector<JITServerROMClassHash> _superclassHashes;
+   uintptr_t _totalInstanceSize;
+   uint32_t _byteOffsetToLockword;
+   bool _compressedRefs;
+   PersistentVector<int32_t> _referenceSlots;
+   };
+
+
+struct JITServerSharedROMClassCache::Metadata
+   {
+   // A class with the same ROMClass can have a different layout in different clients
+   // (e.g. if it extends different versions of a library class), but it is rare
+   static const size_t MAX_LAYOUTS = 4;
+
+   Metadata(TR_PersistentMemory *persistentMemory) :
+      _methodNames(decltype(_methodNames)::allocator_type(persistentMemory->_persistentAllocator.get())),
+      _layouts(decltype(_layouts)::allocator_type(persistentMemory->_persistentAllocator.get())) { }
+
+   PersistentUnorderedMap<int32_t, J9MethodNameAndSignature> _methodNames; // key is a cpIndex
+   PersistentVector<LayoutRecord> _layouts;
+   };
+
+
 struct JITServerSharedROMClassCache::Partition
    {
    Partition(TR_PersistentMemory *persistentMemory, TR::Monitor *monitor) :
       _persistentMemory(persistentMemory), _monitor(monitor),
       _map(decltype(_map)::allocator_type(persistentMemory->_persistentAllocator.get())),
-      _maxSize(0) { }
+      _maxSize(0), _numMetadataHits(0) { }
 
    ~Partition()
       {
       for (const auto &kv : _map)
+         {
+         freeMetadata(kv.second);
          _persistentMemory->freePersistentMemory(kv.second);
+         }
       }
 
    J9ROMClass *getOrCreate(const J9ROMClass *packedROMClass, const JITServerROMClassHash &hash);
    void release(Entry *entry);
 
+   // Must be called with the monitor held
+   Metadata &getOrCreateMetadata(Entry *entry)
+      {
+      if (!entry->_metadata)
+         {
+         void *ptr = _persistentMemory->allocatePersistentMemory(sizeof(Metadata), TR_Memory::ROMClass);
+         if (!ptr)
+            throw std::bad_alloc();
+         entry->_metadata = new (ptr) Metadata(_persistentMemory);
+         }
+      return *entry->_metadata;
+      }
+
+   // Cached method names are allocated with the global heap, so the destructor must be called
+   void freeMetadata(Entry *entry)
+      {
+      if (entry->_metadata)
+         {
+         entry->_metadata->~Metadata();
+         _persistentMemory->freePersistentMemory(entry->_metadata);
+         entry->_metadata = NULL;
+         }
+      }
+
    TR_PersistentMemory *const _persistentMemory;
    TR::Monitor *const _monitor;
    // To avoid comparing the ROMClass contents inside a critical section when
@@ -89,6 +174,7 @@ struct JITServerSharedROMClassCache::Partition
    // the critical section, and key hashing and comparison are very quick.
    PersistentUnorderedMap<JITServerROMClassHash, Entry *> _map;
    size_t _maxSize;
+   size_t _numMetadataHits;
    };
 
 
@@ -165,14 +251,18 @@ JITServerSharedROMClassCache::shutdown(bool lastClient)
 
    TR_ASSERT(isInitialized(), "Must be initialized");
 
-   size_t numClasses = 0, maxClasses = 0;
+   size_t numClasses = 0, maxClasses = 0, numMetadataHits = 0;
    // There should be no ROMClasses left in the cache if there are no clients using them,
    // unless the shared profile cache feature is active.
    for (size_t i = 0; i < _numPartitions; ++i)
       {
       numClasses += _partitions[i]._map.size();
       maxClasses += _partitions[i]._maxSize;
+      numMetadataHits += _partitions[i]._numMetadataHits;
       }
+   if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Shared ROMClass cache answered %zu queries with metadata from other clients",
+                                     numMetadataHits);
    if (lastClient)
       {
       // Must only be called when the last client session is destroyed
@@ -246,6 +336,74 @@ JITServerSharedROMClassCache::getHash(const J9ROMClass *romClass)
    return *Entry::get(romClass)->_hash;
    }
 
+bool
+JITServerSharedROMClassCache::getMethodNameAndSignature(const J9ROMClass *romClass, int32_t cpIndex,
+                                                        J9MethodNameAndSignature &result)
+   {
+   auto entry = Entry::get(romClass);
+   auto &partition = getPartition(*entry->_hash);
+   OMR::CriticalSection sharedROMClassCache(partition._monitor);
+   if (!entry->_metadata)
+      return false;
+
+   auto it = entry->_metadata->_methodNames.find(cpIndex);
+   if (it == entry->_metadata->_methodNames.end())
+      return false;
+   result = it->second;
+   ++partition._numMetadataHits;
+   return true;
+   }
+
+void
+JITServerSharedROMClassCache::cacheMethodNameAndSignature(const J9ROMClass *romClass, int32_t cpIndex,
+                                                          const J9MethodNameAndSignature &value)
+   {
+   auto entry = Entry::get(romClass);
+   auto &partition = getPartition(*entry->_hash);
+   OMR::CriticalSection sharedROMClassCache(partition._monitor);
+   partition.getOrCreateMetadata(entry)._methodNames.insert({ cpIndex, value });
+   }
+
+bool
+JITServerSharedROMClassCache::getReferenceSlots(const J9ROMClass *romClass, const ClassLayout &layout,
+                                                PersistentVector<int32_t> &result)
+   {
+   auto entry = Entry::get(romClass);
+   auto &partition = getPartition(*entry->_hash);
+   OMR::CriticalSection sharedROMClassCache(partition._monitor);
+   if (!entry->_metadata)
+      return false;
+
+   for (const auto &record : entry->_metadata->_layouts)
+      {
+      if (record.matches(layout))
+         {
+         result.assign(record._referenceSlots.begin(), record._referenceSlots.end());
+         ++partition._numMetadataHits;
+         return true;
+         }
+      }
+   return false;
+   }
+
+void
+JITServerSharedROMClassCache::cacheReferenceSlots(const J9ROMClass *romClass, const ClassLayout &layout,
+                                                  const PersistentVector<int32_t> &value)
+   {
+   auto entry = Entry::get(romClass);
+   auto &partition = getPartition(*entry->_hash);
+   OMR::CriticalSection sharedROMClassCache(partition._monitor);
+   auto &layouts = partition.getOrCreateMetadata(entry)._layouts;
+   if (layouts.size() >= Metadata::MAX_LAYOUTS)
+      return;
+   for (const auto &record : layouts)
+      {
+      if (record.matches(layout))
+         return;// Another client already cached it
+      }
+   layouts.push_back(LayoutRecord(layout, value, _persistentMemory));
+   }
+
 void
 JITServerSharedROMClassCache::printContent() const
    {
@@ -342,5 +500,6 @@ JITServerSharedROMClassCache::Partition::release(JITServerSharedROMClassCache::E
       _map.erase(it);
       }
 
+   freeMetadata(entry);
    _persistentMemory->freePersistentMemory(entry);
    }
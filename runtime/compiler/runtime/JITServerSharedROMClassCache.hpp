@@ -27,9 +27,16 @@
 #include "infra/Monitor.hpp"
 #include "runtime/JITServerROMClassHash.hpp"
 
+struct J9MethodNameAndSignature;
 
 // Stores a single copy of each distinct ROMClass that is shared by multiple
 // client sessions in order to reduce JITServer memory usage.
+//
+// Each entry can also hold compile-time metadata derived from the ROMClass
+// that was obtained from one client and is valid for every client that loads
+// an identical class, so that replicas of the same application don't have to
+// send the same answers over and over again. Only data that does not contain
+// client-side pointers can be stored this way.
 class JITServerSharedROMClassCache
    {
 public:
@@ -55,11 +62,35 @@ public:
 
    bool isInitialized() const { return _persistentMemory != NULL; }
 
+   // Describes the instance layout of a class. Field offsets are fully determined by the
+   // ROMClasses of the class and all its superclasses, given the same object model settings.
+   struct ClassLayout
+      {
+      const J9ROMClass *const *_superclasses; // Shared ROMClasses, starting with the direct superclass
+      size_t _numSuperclasses;
+      uintptr_t _totalInstanceSize;
+      uint32_t _byteOffsetToLockword;
+      bool _compressedRefs;
+      };
+
+   // The following methods can only be called for shared ROMClasses that are referenced
+   // by the caller (i.e. cached in its client session) for the duration of the call.
+
+   // Get or cache the class name, method name and signature of the method ref at cpIndex
+   bool getMethodNameAndSignature(const J9ROMClass *romClass, int32_t cpIndex, J9MethodNameAndSignature &result);
+   void cacheMethodNameAndSignature(const J9ROMClass *romClass, int32_t cpIndex, const J9MethodNameAndSignature &value);
+
+   // Get or cache the zero-terminated list of reference slots of a class with the given layout
+   bool getReferenceSlots(const J9ROMClass *romClass, const ClassLayout &layout, PersistentVector<int32_t> &result);
+   void cacheReferenceSlots(const J9ROMClass *romClass, const ClassLayout &layout, const PersistentVector<int32_t> &value);
+
    // Print cache content for debugging purposes (ROMMethods pointers, names and hashes)
    void printContent() const;
 
 private:
    struct Entry;
+   struct Metadata;
+   struct LayoutRecord;
    struct Partition;
 
    // To reduce lock contention, the cache is divided into a number of
@@ -28,6 +28,7 @@
 #include <netinet/tcp.h>	/* for TCP_NODELAY option */
 #include <openssl/err.h>
 #include <poll.h>
+#include <sys/epoll.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -38,6 +39,7 @@
 #include "env/TRMemory.hpp"
 #include "env/VMJ9.h"
 #include "env/VerboseLog.hpp"
+#include "infra/CriticalSection.hpp"
 #include "net/CommunicationStream.hpp"
 #include "net/LoadSSLLibs.hpp"
 #include "net/ServerStream.hpp"
@@ -183,10 +185,149 @@ openCommunicationSocket(uint32_t port, uint32_t &boundPort)
 
 TR_Listener::TR_Listener()
    : _listenerThread(NULL), _listenerMonitor(NULL), _listenerOSThread(NULL),
-   _listenerThreadAttachAttempted(false), _listenerThreadExitFlag(false)
+   _listenerThreadAttachAttempted(false), _listenerThreadExitFlag(false),
+   _eventLoopFd(-1), _numStreamsParked(0), _numStreamsWokenUp(0), _numStreamsEvicted(0),
+   _parkedStreams(NULL), _timeLastEviction(0)
    {
    }
 
+bool
+TR_Listener::parkIdleStream(JITServer::ServerStream *stream)
+   {
+   if (_eventLoopFd < 0)
+      return false;
+
+   // Data already decrypted by SSL would not make the socket readable again
+   if (stream->hasBufferedInput())
+      return false;
+
+   struct epoll_event event;
+   event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+   event.data.ptr = stream;
+   if (epoll_ctl(_eventLoopFd, EPOLL_CTL_ADD, stream->getSocketFD(), &event) < 0)
+      {
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Could not park idle connection on socket 0x%x: errno=%d: %s",
+                                        stream->getSocketFD(), errno, strerror(errno));
+      return false;
+      }
+   stream->_timeParked = getCompilationInfo(jitConfig)->getPersistentInfo()->getElapsedTime();
+   stream->_prevParked = NULL;
+   stream->_nextParked = _parkedStreams;
+   if (_parkedStreams)
+      _parkedStreams->_prevParked = stream;
+   _parkedStreams = stream;
+   _numStreamsParked++;
+   return true;
+   }
+
+void
+TR_Listener::unparkStream(JITServer::ServerStream *stream)
+   {
+   epoll_ctl(_eventLoopFd, EPOLL_CTL_DEL, stream->getSocketFD(), NULL);
+   if (stream->_prevParked)
+      stream->_prevParked->_nextParked = stream->_nextParked;
+   else
+      _parkedStreams = stream->_nextParked;
+   if (stream->_nextParked)
+      stream->_nextParked->_prevParked = stream->_prevParked;
+   stream->_prevParked = NULL;
+   stream->_nextParked = NULL;
+   }
+
+void
+TR_Listener::dispatchReadyStreams(BaseCompileDispatcher *compiler)
+   {
+   struct epoll_event events[OPENJ9_LISTENER_MAX_EVENTS];
+   int numEvents = 0;
+   do
+      {
+      numEvents = epoll_wait(_eventLoopFd, events, OPENJ9_LISTENER_MAX_EVENTS, 0);
+      } while ((numEvents < 0) && (EINTR == errno));
+
+   if (numEvents <= 0)
+      return;
+
+      {
+      // The registration is one-shot; remove it so that the stream can be parked again after this request.
+      // Errors and hang-ups are dispatched as well: the compilation thread will fail to read and delete the stream.
+      OMR::CriticalSection unparkReadyStreams(getCompilationInfo(jitConfig)->getCompilationMonitor());
+      for (int i = 0; i < numEvents; ++i)
+         unparkStream(static_cast<JITServer::ServerStream *>(events[i].data.ptr));
+      }
+
+   for (int i = 0; i < numEvents; ++i)
+      {
+      _numStreamsWokenUp++;
+      compiler->compile(static_cast<JITServer::ServerStream *>(events[i].data.ptr));
+      }
+   }
+
+void
+TR_Listener::evictIdleStreams(TR::CompilationInfo *compInfo)
+   {
+   uint64_t crtTime = compInfo->getPersistentInfo()->getElapsedTime();
+   uint32_t timeoutMs = compInfo->getPersistentInfo()->getSocketTimeout();
+   if (0 == timeoutMs)
+      return;
+   JITServer::ServerStream *evictedStreams = NULL;
+      {
+      OMR::CriticalSection evictStreams(compInfo->getCompilationMonitor());
+      JITServer::ServerStream *stream = _parkedStreams;
+      while (stream)
+         {
+         JITServer::ServerStream *next = stream->_nextParked;
+         if (crtTime - stream->_timeParked > timeoutMs)
+            {
+            unparkStream(stream);
+            stream->_nextParked = evictedStreams;
+            evictedStreams = stream;
+            }
+         stream = next;
+         }
+      }
+
+   // Close the connections outside the monitor
+   while (evictedStreams)
+      {
+      JITServer::ServerStream *stream = evictedStreams;
+      evictedStreams = stream->_nextParked;
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "t=%lu Closing connection on socket 0x%x idle for more than %u ms",
+                                        (unsigned long)crtTime, stream->getSocketFD(), timeoutMs);
+      stream->~ServerStream();
+      TR::Compiler->persistentGlobalAllocator().deallocate(stream);
+      _numStreamsEvicted++;
+      }
+   }
+
+void
+TR_Listener::deleteParkedStreams(TR::CompilationInfo *compInfo)
+   {
+   JITServer::ServerStream *parkedStreams = NULL;
+      {
+      // Compilation threads that finish from now on will requeue their streams instead
+      OMR::CriticalSection eventLoopTeardown(compInfo->getCompilationMonitor());
+      while (_parkedStreams)
+         {
+         JITServer::ServerStream *stream = _parkedStreams;
+         unparkStream(stream);
+         stream->_nextParked = parkedStreams;
+         parkedStreams = stream;
+         }
+      close(_eventLoopFd);
+      _eventLoopFd = -1;
+      }
+
+   while (parkedStreams)
+      {
+      JITServer::ServerStream *stream = parkedStreams;
+      parkedStreams = stream->_nextParked;
+      stream->~ServerStream();
+      TR::Compiler->persistentGlobalAllocator().deallocate(stream);
+      }
+   }
+
 void
 TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
    {
@@ -247,13 +388,34 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
          }
       }
 
-   // The following array accomodates two descriptors: healthSockfd and sockfd.
+   // Create the epoll instance used to watch idle connections between compilation requests
+   if (info->getJITServerUseEventLoop())
+      {
+      int eventLoopFd = epoll_create1(EPOLL_CLOEXEC);
+      if (eventLoopFd < 0)
+         {
+         perror("Can't create the event loop for idle connections");
+         }
+      else
+         {
+         OMR::CriticalSection eventLoopSetup(compInfo->getCompilationMonitor());
+         _eventLoopFd = eventLoopFd;
+         }
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Idle connections %s watched by the listener thread",
+                                        (eventLoopFd >= 0) ? "are" : "cannot be");
+      }
+
+   // The following array accomodates three descriptors: healthSockfd, sockfd and the event loop descriptor.
    // The first one is used for readiness/liveness probes, the second one is used for compilation requests.
    // If we don't want to use readiness/liveness probes, healthSockfd will be -1 and will be ignored by poll().
-   struct pollfd pfd[2] = {{.fd = healthSockfd, .events = POLLIN, .revents = 0},
-                           {.fd = sockfd,       .events = POLLIN, .revents = 0}
+   // The last one becomes readable when a parked connection has data; it is -1 if the event loop is not used.
+   struct pollfd pfd[3] = {{.fd = healthSockfd, .events = POLLIN, .revents = 0},
+                           {.fd = sockfd,       .events = POLLIN, .revents = 0},
+                           {.fd = _eventLoopFd, .events = POLLIN, .revents = 0}
                           };
    static const size_t numFds = sizeof(pfd) / sizeof(pfd[0]);
+   static const size_t eventLoopFdIndex = numFds - 1;
 
    while (!getListenerThreadExitFlag())
       {
@@ -267,7 +429,17 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
          {
          break;
          }
-      else if (0 == rc) // poll() timed out and no fd is ready
+      // Close the parked connections whose clients went away without closing them
+      if (_eventLoopFd >= 0)
+         {
+         uint64_t crtTime = info->getElapsedTime();
+         if (crtTime - _timeLastEviction >= OPENJ9_LISTENER_EVICTION_INTERVAL)
+            {
+            _timeLastEviction = crtTime;
+            evictIdleStreams(compInfo);
+            }
+         }
+      if (0 == rc) // poll() timed out and no fd is ready
          {
          continue;
          }
@@ -283,8 +455,14 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
             exit(1);
             }
          }
+      // Wake up the parked connections that received a request
+      if (pfd[eventLoopFdIndex].revents != 0)
+         {
+         pfd[eventLoopFdIndex].revents = 0;
+         dispatchReadyStreams(compiler);
+         }
       // Check which file descriptor is ready
-      for (size_t fdIndex = 0; fdIndex < numFds; fdIndex++)
+      for (size_t fdIndex = 0; fdIndex < eventLoopFdIndex; fdIndex++)
          {
          if (pfd[fdIndex].revents == 0) // No event on this file descriptor
             continue;
@@ -344,6 +522,14 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
 
    // The following piece of code will be executed only if the server shuts down properly
    close(sockfd);
+   if (_eventLoopFd >= 0)
+      {
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Idle connections parked: %llu, woken up: %llu, evicted: %llu",
+                                        (unsigned long long)_numStreamsParked, (unsigned long long)_numStreamsWokenUp,
+                                        (unsigned long long)_numStreamsEvicted);
+      deleteParkedStreams(compInfo);
+      }
    if (sslCtx)
       {
       (*OSSL_CTX_free)(sslCtx);
@@ -38,6 +38,8 @@
  */
 
 #define OPENJ9_LISTENER_POLL_TIMEOUT 100 // in milliseconds
+#define OPENJ9_LISTENER_MAX_EVENTS 64 // max number of ready connections retrieved from the event loop at once
+#define OPENJ9_LISTENER_EVICTION_INTERVAL 1000 // in milliseconds; how often parked connections are checked for being idle too long
 
 class BaseCompileDispatcher;
 
@@ -77,12 +79,63 @@ public:
    bool getListenerThreadExitFlag() const { return _listenerThreadExitFlag; }
    void setListenerThreadExitFlag() { _listenerThreadExitFlag = true; }
 
+   /**
+      @brief Hand an idle connection over to the listener thread until the client sends its next request
+
+      Used with -XX:+JITServerEventLoop. Instead of requeueing the stream so that a compilation thread
+      blocks on it waiting for the next compilation request, the connection is registered with an epoll
+      instance that is polled by the listener thread. When data (or an error) arrives on the connection,
+      the listener passes the stream to the compilation handler, as if it were a new connection.
+      Connections that stay parked for longer than the socket timeout are closed.
+      Must be called with the compilation monitor in hand.
+
+      @param [in] stream The stream whose compilation request has been fully processed
+
+      @return true if the stream was parked, false if the caller must queue it as usual
+   */
+   bool parkIdleStream(JITServer::ServerStream *stream);
+
+   uint64_t getNumStreamsParked() const { return _numStreamsParked; }
+   uint64_t getNumStreamsWokenUp() const { return _numStreamsWokenUp; }
+   uint64_t getNumStreamsEvicted() const { return _numStreamsEvicted; }
+
 private:
+   /**
+      @brief Retrieve the parked connections that have data available and dispatch them for compilation
+   */
+   void dispatchReadyStreams(BaseCompileDispatcher *compiler);
+
+   /**
+      @brief Close the parked connections that have been idle for longer than the socket timeout
+
+      Without the event loop, a compilation thread waiting on such a connection would have
+      given up on it after the socket timeout as well; clients reopen connections left idle
+      for half of that time.
+   */
+   void evictIdleStreams(TR::CompilationInfo *compInfo);
+
+   /**
+      @brief Stop watching all parked connections and close them; used when the listener shuts down
+   */
+   void deleteParkedStreams(TR::CompilationInfo *compInfo);
+
+   /**
+      @brief Deregister a parked stream from the epoll instance and unlink it from the list of parked streams.
+      Must be called with the compilation monitor in hand.
+   */
+   void unparkStream(JITServer::ServerStream *stream);
+
    J9VMThread *_listenerThread;
    TR::Monitor *_listenerMonitor;
    j9thread_t _listenerOSThread;
    volatile bool _listenerThreadAttachAttempted;
    volatile bool _listenerThreadExitFlag;
+   int _eventLoopFd; // epoll instance watching idle connections; -1 if the event loop is not used
+   uint64_t _numStreamsParked; // updated under the compilation monitor
+   uint64_t _numStreamsWokenUp; // updated by the listener thread only
+   uint64_t _numStreamsEvicted; // updated by the listener thread only
+   JITServer::ServerStream *_parkedStreams; // list of parked streams, linked through ServerStream::_nextParked; guarded by the compilation monitor
+   uint64_t _timeLastEviction; // elapsed time (ms) when idle streams were last looked for; listener thread only
    };
 
 /**
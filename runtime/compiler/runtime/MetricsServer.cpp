@@ -33,13 +33,18 @@
 #include <stdlib.h>
 #include <unistd.h> // read, write
 
+#include "AtomicSupport.hpp"
+#include "compile/Compilation.hpp"
 #include "control/CompilationRuntime.hpp"
 #include "control/Options.hpp"
 #include "env/TRMemory.hpp"
 #include "env/PersistentInfo.hpp"
 #include "env/VerboseLog.hpp"
 #include "env/VMJ9.h"
+#include "infra/CriticalSection.hpp"
 #include "net/ServerStream.hpp"
+#include "runtime/JITClientSession.hpp"
+#include "runtime/JITServerAOTCache.hpp"
 #include "runtime/MetricsServer.hpp"
 
 bool MetricsServer::useSSL(TR::CompilationInfo *compInfo)
@@ -143,13 +148,178 @@ double ActiveThreadsMetric::computeValue(TR::CompilationInfo *compInfo)
    return getValue();
    }
 
+static const uint64_t compilationLatencyBucketsUs[] =
+   { 1000, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000, 30000000 };
+static const uint64_t queueWaitTimeBucketsUs[] =
+   { 100, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000, 10000000 };
+static const uint64_t messagesPerCompilationBuckets[] =
+   { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000 };
+
+#define NUM_BUCKETS(bounds) (sizeof(bounds) / sizeof(bounds[0]))
+
+CompilationMetrics::LatencyHistogram CompilationMetrics::_compilationLatency[numHotnessLevels];
+PrometheusHistogram CompilationMetrics::_queueWaitTime(queueWaitTimeBucketsUs, NUM_BUCKETS(queueWaitTimeBucketsUs));
+PrometheusHistogram CompilationMetrics::_messagesPerCompilation(messagesPerCompilationBuckets, NUM_BUCKETS(messagesPerCompilationBuckets));
+
+CompilationMetrics::LatencyHistogram::LatencyHistogram() :
+   PrometheusHistogram(compilationLatencyBucketsUs, NUM_BUCKETS(compilationLatencyBucketsUs))
+   {
+   }
+
+void
+CompilationMetrics::recordCompilation(TR_Hotness optLevel, uint64_t latencyUs, uint64_t numMessages)
+   {
+   if (optLevel < numHotnessLevels)
+      _compilationLatency[optLevel].observe(latencyUs);
+   _messagesPerCompilation.observe(numMessages);
+   }
+
+PrometheusHistogram::PrometheusHistogram(const uint64_t *upperBounds, size_t numBuckets) :
+   _upperBounds(upperBounds), _numBuckets(numBuckets), _bucketCounts(), _sum(0), _count(0)
+   {
+   TR_ASSERT_FATAL(numBuckets <= MAX_BUCKETS, "Too many histogram buckets: %zu", numBuckets);
+   }
+
+void
+PrometheusHistogram::observe(uint64_t value)
+   {
+   // Few buckets; a linear search is as fast as a binary one
+   size_t bucket = 0;
+   while ((bucket < _numBuckets) && (value > _upperBounds[bucket]))
+      bucket++;
+   VM_AtomicSupport::add(&_bucketCounts[bucket], 1);
+   VM_AtomicSupport::addU64(&_sum, value);
+   VM_AtomicSupport::add(&_count, 1);
+   }
+
+void
+PrometheusHistogram::serialize(std::string &output, const std::string &name, const std::string &labels, double unitScale) const
+   {
+   std::string labelPrefix = labels.empty() ? "" : labels + ",";
+   std::string labelSet = labels.empty() ? "" : "{" + labels + "}";
+   char bound[32];
+   uint64_t cumulativeCount = 0;
+   for (size_t i = 0; i < _numBuckets; ++i)
+      {
+      cumulativeCount += _bucketCounts[i];
+      snprintf(bound, sizeof(bound), "%g", _upperBounds[i] * unitScale);
+      output.append(name + "_bucket{" + labelPrefix + "le=\"" + bound + "\"} " + std::to_string(cumulativeCount) + "\n");
+      }
+   cumulativeCount += _bucketCounts[_numBuckets];
+   output.append(name + "_bucket{" + labelPrefix + "le=\"+Inf\"} " + std::to_string(cumulativeCount) + "\n");
+   snprintf(bound, sizeof(bound), "%g", _sum * unitScale);
+   output.append(name + "_sum" + labelSet + " " + bound + "\n");
+   output.append(name + "_count" + labelSet + " " + std::to_string(cumulativeCount) + "\n");
+   }
+
+double CompilationLatencyMetric::computeValue(TR::CompilationInfo *compInfo)
+   {
+   uint64_t count = 0;
+   for (int32_t i = 0; i < numHotnessLevels; ++i)
+      count += CompilationMetrics::_compilationLatency[i].getCount();
+   setValue(count);
+   return getValue();
+   }
+
+std::string CompilationLatencyMetric::serialize()
+   {
+   std::string output = serializeHeader("histogram");
+   for (int32_t i = 0; i < numHotnessLevels; ++i)
+      {
+      // Don't export optimization levels that the server never compiled at
+      const auto &histogram = CompilationMetrics::_compilationLatency[i];
+      if (histogram.getCount() == 0)
+         continue;
+      std::string labels = std::string("opt_level=\"") + TR::Compilation::getHotnessName((TR_Hotness)i) + "\"";
+      histogram.serialize(output, getName(), labels, 1e-6);
+      }
+   return output;
+   }
+
+double QueueWaitTimeMetric::computeValue(TR::CompilationInfo *compInfo)
+   {
+   setValue(CompilationMetrics::_queueWaitTime.getCount());
+   return getValue();
+   }
+
+std::string QueueWaitTimeMetric::serialize()
+   {
+   std::string output = serializeHeader("histogram");
+   CompilationMetrics::_queueWaitTime.serialize(output, getName(), "", 1e-6);
+   return output;
+   }
+
+double MessagesPerCompilationMetric::computeValue(TR::CompilationInfo *compInfo)
+   {
+   setValue(CompilationMetrics::_messagesPerCompilation.getCount());
+   return getValue();
+   }
+
+std::string MessagesPerCompilationMetric::serialize()
+   {
+   std::string output = serializeHeader("histogram");
+   CompilationMetrics::_messagesPerCompilation.serialize(output, getName(), "", 1.0);
+   return output;
+   }
+
+double AOTCacheRequestsMetric::computeValue(TR::CompilationInfo *compInfo)
+   {
+   if (auto aotCacheMap = compInfo->getJITServerAOTCacheMap())
+      aotCacheMap->getAccessStats(_numHits, _numMisses, _numBypasses);
+   setValue(_numHits + _numMisses + _numBypasses);
+   return getValue();
+   }
+
+std::string AOTCacheRequestsMetric::serialize()
+   {
+   return serializeHeader("counter") +
+      getName() + "{result=\"hit\"} " + std::to_string(_numHits) + "\n" +
+      getName() + "{result=\"miss\"} " + std::to_string(_numMisses) + "\n" +
+      getName() + "{result=\"bypass\"} " + std::to_string(_numBypasses) + "\n";
+   }
+
+double ClientNetworkTrafficMetric::computeValue(TR::CompilationInfo *compInfo)
+   {
+   double total = 0;
+   _clients.clear();
+      {
+      // Client sessions can be purged concurrently
+      OMR::CriticalSection clientSessions(compInfo->getCompilationMonitor());
+      for (const auto &it : compInfo->getClientSessionHT()->getClientSessionMap())
+         {
+         const ClientSessionData *clientSession = it.second;
+         _clients.push_back({ clientSession->getClientUID(), clientSession->getNumBytesReceived(), clientSession->getNumBytesSent() });
+         total += clientSession->getNumBytesReceived() + clientSession->getNumBytesSent();
+         }
+      }
+   setValue(total);
+   return getValue();
+   }
+
+std::string ClientNetworkTrafficMetric::serialize()
+   {
+   std::string output = serializeHeader("counter");
+   for (const auto &client : _clients)
+      {
+      std::string clientLabel = "{client_uid=\"" + std::to_string(client._clientUID) + "\",direction=\"";
+      output.append(getName() + clientLabel + "received\"} " + std::to_string(client._numBytesReceived) + "\n");
+      output.append(getName() + clientLabel + "sent\"} " + std::to_string(client._numBytesSent) + "\n");
+      }
+   return output;
+   }
+
 MetricsDatabase::MetricsDatabase(TR::CompilationInfo *compInfo) : _compInfo(compInfo)
    {
    _metrics[0] = new (PERSISTENT_NEW) CPUUtilMetric();
    _metrics[1] = new (PERSISTENT_NEW) AvailableMemoryMetric();
    _metrics[2] = new (PERSISTENT_NEW) ConnectedClientsMetric();
    _metrics[3] = new (PERSISTENT_NEW) ActiveThreadsMetric();
-   static_assert(3 == MAX_METRICS - 1, "Unsupported number of metrics");
+   _metrics[4] = new (PERSISTENT_NEW) CompilationLatencyMetric();
+   _metrics[5] = new (PERSISTENT_NEW) QueueWaitTimeMetric();
+   _metrics[6] = new (PERSISTENT_NEW) MessagesPerCompilationMetric();
+   _metrics[7] = new (PERSISTENT_NEW) AOTCacheRequestsMetric();
+   _metrics[8] = new (PERSISTENT_NEW) ClientNetworkTrafficMetric();
+   static_assert(8 == MAX_METRICS - 1, "Unsupported number of metrics");
    }
 
 MetricsDatabase::~MetricsDatabase()
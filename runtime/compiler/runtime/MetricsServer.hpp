@@ -25,7 +25,9 @@
 
 #include <poll.h> // for struct pollfd
 #include <string>
+#include <vector>
 #include "j9.h" // for J9JavaVM
+#include "compile/CompilationTypes.hpp" // for TR_Hotness
 #include "infra/Monitor.hpp"  // for TR::Monitor
 
 namespace TR { class CompilationInfo; }
@@ -36,7 +38,8 @@ namespace TR { class CompilationInfo; }
 
    PrometheusMetric is an abstract class and concrete classes need to be derived from it.
    Derived classes need to implement the `computeValue()` function and possibly the
-   destructor, if they allocate memory dynamically.
+   destructor, if they allocate memory dynamically. Metrics that are not gauges
+   (counters, histograms) also need to override `serialize()`.
  */
 class PrometheusMetric
    {
@@ -57,17 +60,78 @@ class PrometheusMetric
       @brief Build a std::string that encodes the value of the metric in a format understood by Prometheus
       @return Serialized value of the metric (as a std::string)
    */
-   std::string serialize()
+   virtual std::string serialize()
       {
-      return "# HELP " + getName() + " " + getHelp() + "\n# TYPE " + getName() + " gauge\n" + getName() + " " + std::to_string(getValue()) + "\n";
+      return serializeHeader("gauge") + getName() + " " + std::to_string(getValue()) + "\n";
       }
 
    protected:
+   std::string serializeHeader(const char *type) const
+      {
+      return "# HELP " + getName() + " " + getHelp() + "\n# TYPE " + getName() + " " + type + "\n";
+      }
+
    const std::string _name;
    const std::string _help;
    double _value;
    }; // class PrometheusMetric
 
+/**
+   @class PrometheusHistogram
+   @brief Distribution of values observed on the compilation path, with fixed bucket boundaries
+
+   Observing a value only performs atomic increments, so compilation threads never block
+   on the metrics thread. The serialized buckets are cumulative, as Prometheus expects, and
+   may be slightly inconsistent with the sum and count when a scrape races with an update.
+ */
+class PrometheusHistogram
+   {
+public:
+   static const size_t MAX_BUCKETS = 16;
+
+   /**
+      @param upperBounds Sorted upper bounds of the buckets, in the unit of the observed values
+      @param numBuckets Number of upper bounds; the implicit "+Inf" bucket is not included
+   */
+   PrometheusHistogram(const uint64_t *upperBounds, size_t numBuckets);
+   void observe(uint64_t value);
+   uint64_t getCount() const { return _count; }
+   /**
+      @brief Append the buckets, sum and count of this histogram to output
+      @param labels Comma separated labels that identify this histogram in the metric family (can be empty)
+      @param unitScale Factor that converts observed values to the unit of the metric (e.g. microseconds to seconds)
+   */
+   void serialize(std::string &output, const std::string &name, const std::string &labels, double unitScale) const;
+
+private:
+   const uint64_t *const _upperBounds;
+   const size_t _numBuckets;
+   volatile uintptr_t _bucketCounts[MAX_BUCKETS + 1]; // Not cumulative; the last one is "+Inf"
+   volatile uint64_t _sum; // 64 bits wide everywhere; a 32-bit sum of microseconds would wrap after about an hour of compilation time
+   volatile uintptr_t _count;
+   }; // class PrometheusHistogram
+
+/**
+   @class CompilationMetrics
+   @brief Metrics recorded by compilation threads and exported by the MetricsServer
+ */
+class CompilationMetrics
+   {
+public:
+   static void recordQueueWaitTime(uint64_t waitTimeUs) { _queueWaitTime.observe(waitTimeUs); }
+   static void recordCompilation(TR_Hotness optLevel, uint64_t latencyUs, uint64_t numMessages);
+
+   // Compilation latency in microseconds, from reading the request until the compilation ends
+   struct LatencyHistogram : public PrometheusHistogram
+      {
+      LatencyHistogram();
+      };
+
+   static LatencyHistogram _compilationLatency[numHotnessLevels];
+   static PrometheusHistogram _queueWaitTime; // Microseconds
+   static PrometheusHistogram _messagesPerCompilation; // Messages from the client (i.e. round trips)
+   }; // class CompilationMetrics
+
 /**
    @brief Class used to serialize CPU utilization of OpenJ9, as a metric understood by Prometheus
  */
@@ -112,6 +176,81 @@ public:
    virtual double computeValue(TR::CompilationInfo *compInfo);
    }; // class ActiveThreadsMetric
 
+/**
+   @brief Class used to serialize the distribution of compilation latencies for each optimization level
+ */
+class CompilationLatencyMetric : public PrometheusMetric
+   {
+public:
+   CompilationLatencyMetric() : PrometheusMetric("jitserver_compilation_latency_seconds", "Time spent serving a compilation request")
+      {}
+   virtual double computeValue(TR::CompilationInfo *compInfo);
+   virtual std::string serialize();
+   }; // class CompilationLatencyMetric
+
+/**
+   @brief Class used to serialize the distribution of the time compilation requests wait for a compilation thread
+ */
+class QueueWaitTimeMetric : public PrometheusMetric
+   {
+public:
+   QueueWaitTimeMetric() : PrometheusMetric("jitserver_queue_wait_seconds", "Time a compilation request waits in the queue")
+      {}
+   virtual double computeValue(TR::CompilationInfo *compInfo);
+   virtual std::string serialize();
+   }; // class QueueWaitTimeMetric
+
+/**
+   @brief Class used to serialize the distribution of the number of messages exchanged with the client per compilation
+ */
+class MessagesPerCompilationMetric : public PrometheusMetric
+   {
+public:
+   MessagesPerCompilationMetric() : PrometheusMetric("jitserver_messages_per_compilation", "Number of round trips to the client per compilation")
+      {}
+   virtual double computeValue(TR::CompilationInfo *compInfo);
+   virtual std::string serialize();
+   }; // class MessagesPerCompilationMetric
+
+/**
+   @brief Class used to serialize the number of AOT cache hits, misses and bypasses across all AOT caches
+ */
+class AOTCacheRequestsMetric : public PrometheusMetric
+   {
+public:
+   AOTCacheRequestsMetric() : PrometheusMetric("jitserver_aot_cache_requests_total", "Number of compilation requests served by the AOT cache"),
+      _numHits(0), _numMisses(0), _numBypasses(0)
+      {}
+   virtual double computeValue(TR::CompilationInfo *compInfo);
+   virtual std::string serialize();
+
+private:
+   size_t _numHits;
+   size_t _numMisses;
+   size_t _numBypasses;
+   }; // class AOTCacheRequestsMetric
+
+/**
+   @brief Class used to serialize the number of bytes received from and sent to each connected client
+ */
+class ClientNetworkTrafficMetric : public PrometheusMetric
+   {
+public:
+   ClientNetworkTrafficMetric() : PrometheusMetric("jitserver_client_network_bytes_total", "Bytes exchanged with a client during compilations")
+      {}
+   virtual double computeValue(TR::CompilationInfo *compInfo);
+   virtual std::string serialize();
+
+private:
+   struct ClientTraffic
+      {
+      uint64_t _clientUID;
+      uint64_t _numBytesReceived;
+      uint64_t _numBytesSent;
+      };
+   std::vector<ClientTraffic> _clients;
+   }; // class ClientNetworkTrafficMetric
+
 
 /**
    @class MetricsDatabase
@@ -125,7 +264,7 @@ public:
 class MetricsDatabase
    {
    public:
-   static const size_t MAX_METRICS = 4; // Maximum number of metrics our database can hold
+   static const size_t MAX_METRICS = 9; // Maximum number of metrics our database can hold
    MetricsDatabase(TR::CompilationInfo *compInfo);
    ~MetricsDatabase();
 
@@ -34,6 +34,7 @@
 #include "ClassHeapIterator.hpp"
 #include "ClassLoaderIterator.hpp"
 #include "ClassLoaderSegmentIterator.hpp"
+#include "ClassUnloadIdentificationTask.hpp"
 #include "ClassUnloadStats.hpp"
 #include "EnvironmentBase.hpp"
 #include "FinalizableClassLoaderBuffer.hpp"
@@ -41,6 +42,8 @@
 #include "GlobalCollector.hpp"
 #include "HeapMap.hpp"
 #include "ClassLoaderRememberedSet.hpp"
+#include "ParallelDispatcher.hpp"
+#include "Task.hpp"
 
 #if defined(J9VM_GC_REALTIME)
 extern "C" {
@@ -160,6 +163,8 @@ MM_ClassLoaderManager::flushUndeadSegments(MM_EnvironmentBase *env)
 	J9MemorySegment *walker = _firstUndeadSegment;
 	_firstUndeadSegment = NULL;
 	_undeadSegmentsTotalSize = 0;
+	/* anything handed to the finalizer earlier is freed here as well */
+	_undeadSegmentsFlushDeferred = false;
 	omrthread_monitor_exit(_undeadSegmentListMonitor);
 	
 	while (NULL != walker) {
@@ -170,6 +175,56 @@ MM_ClassLoaderManager::flushUndeadSegments(MM_EnvironmentBase *env)
 	}
 }
 
+bool
+MM_ClassLoaderManager::deferUndeadSegmentsFlush(MM_EnvironmentBase *env)
+{
+	bool deferred = false;
+#if defined(J9VM_GC_FINALIZATION)
+	/* if the finalizer has not yet freed what it was handed last time flush in the pause rather than let the cache grow */
+	if (_extensions->concurrentClassSegmentReclaim && !_undeadSegmentsFlushDeferred) {
+		omrthread_monitor_enter(_javaVM->finalizeMainMonitor);
+		if (J9_ARE_ANY_BITS_SET(_javaVM->finalizeMainFlags, J9_FINALIZE_FLAGS_ACTIVE)
+			&& J9_ARE_NO_BITS_SET(_javaVM->finalizeMainFlags, J9_FINALIZE_FLAGS_SHUTDOWN)
+		) {
+			_undeadSegmentsFlushDeferred = true;
+			_javaVM->finalizeMainFlags |= J9_FINALIZE_FLAGS_MAIN_WAKE_UP;
+			omrthread_monitor_notify_all(_javaVM->finalizeMainMonitor);
+			deferred = true;
+		}
+		omrthread_monitor_exit(_javaVM->finalizeMainMonitor);
+	}
+#endif /* J9VM_GC_FINALIZATION */
+	return deferred;
+}
+
+void
+MM_ClassLoaderManager::flushDeferredUndeadSegments(J9VMThread *vmThread)
+{
+	if (_undeadSegmentsFlushDeferred) {
+		J9InternalVMFunctions *vmFuncs = _javaVM->internalVMFunctions;
+
+		omrthread_monitor_enter(_undeadSegmentListMonitor);
+		J9MemorySegment *walker = _firstUndeadSegment;
+		_firstUndeadSegment = NULL;
+		_undeadSegmentsTotalSize = 0;
+		_undeadSegmentsFlushDeferred = false;
+		omrthread_monitor_exit(_undeadSegmentListMonitor);
+
+		uintptr_t segmentsFreed = 0;
+		while (NULL != walker) {
+			J9MemorySegment *thisWalk = walker;
+			walker = thisWalk->nextSegmentInClassLoader;
+			vmFuncs->freeMemorySegment(_javaVM, thisWalk, TRUE);
+			segmentsFreed += 1;
+			if (0 == (segmentsFreed % UNDEAD_SEGMENTS_PER_VM_ACCESS)) {
+				/* the segments left on the local list are out of reach of the collector, so let a pending collection run */
+				vmFuncs->internalReleaseVMAccess(vmThread);
+				vmFuncs->internalEnterVMFromJNI(vmThread);
+			}
+		}
+	}
+}
+
 void
 MM_ClassLoaderManager::setLastUnloadNumOfClassLoaders() 
 {
@@ -328,23 +383,48 @@ MM_ClassLoaderManager::cleanUpClassLoadersStart(MM_EnvironmentBase *env, J9Class
 	 * Anonymous classes suppose to be allocated one per segment
 	 * This is not relevant here however becomes important at segment removal time
 	 */
-	anonymousClassUnloadList = addDyingClassesToList(env, _javaVM->anonClassLoader, markMap, false, anonymousClassUnloadList, &anonymousClassUnloadCount);
+	bool identifiedInParallel = false;
+	uintptr_t parallelClassUnloadThreshold = _extensions->parallelClassUnloadThreshold;
+	if ((0 != parallelClassUnloadThreshold) && (_extensions->dispatcher->threadCountMaximum() > 1)) {
+		uintptr_t candidates = _javaVM->anonClassCount;
+		for (J9ClassLoader *classLoader = classLoaderUnloadList; NULL != classLoader; classLoader = classLoader->unloadLink) {
+			candidates += 1;
+		}
+		if (candidates >= parallelClassUnloadThreshold) {
+			/* Walking the class segments is spread over the GC threads; unloading itself stays on this thread */
+			for (J9ClassLoader *classLoader = classLoaderUnloadList; NULL != classLoader; classLoader = classLoader->unloadLink) {
+				Assert_MM_true( 0 == (classLoader->gcFlags & J9_GC_CLASS_LOADER_SCANNED) );
+				classLoaderUnloadCount += 1;
+				classLoader->gcFlags |= J9_GC_CLASS_LOADER_DEAD;
+			}
+			identifiedInParallel = identifyDyingClassesInParallel(env, classLoaderUnloadList, markMap,
+					&anonymousClassUnloadList, &anonymousClassUnloadCount, &classUnloadList, &classUnloadCount);
+			if (!identifiedInParallel) {
+				/* the serial walk below counts the class loaders again */
+				classLoaderUnloadCount = 0;
+			}
+		}
+	}
 
-	/* class unload list includes anonymous class unload list */
-	classUnloadList = anonymousClassUnloadList;
-	classUnloadCount += anonymousClassUnloadCount;
+	if (!identifiedInParallel) {
+		anonymousClassUnloadList = addDyingClassesToList(env, _javaVM->anonClassLoader, markMap, false, anonymousClassUnloadList, &anonymousClassUnloadCount);
 
-	/* Count all classes loaded by dying class loaders */
-	J9ClassLoader *classLoader = classLoaderUnloadList;
-	while (NULL != classLoader) {
-		Assert_MM_true( 0 == (classLoader->gcFlags & J9_GC_CLASS_LOADER_SCANNED) );
-		classLoaderUnloadCount += 1;
-		classLoader->gcFlags |= J9_GC_CLASS_LOADER_DEAD;
+		/* class unload list includes anonymous class unload list */
+		classUnloadList = anonymousClassUnloadList;
+		classUnloadCount += anonymousClassUnloadCount;
 
-		/* mark all of its classes as dying */
-		classUnloadList = addDyingClassesToList(env, classLoader, markMap, true, classUnloadList, &classUnloadCount);
+		/* Count all classes loaded by dying class loaders */
+		J9ClassLoader *classLoader = classLoaderUnloadList;
+		while (NULL != classLoader) {
+			Assert_MM_true( 0 == (classLoader->gcFlags & J9_GC_CLASS_LOADER_SCANNED) );
+			classLoaderUnloadCount += 1;
+			classLoader->gcFlags |= J9_GC_CLASS_LOADER_DEAD;
 
-		classLoader = classLoader->unloadLink;
+			/* mark all of its classes as dying */
+			classUnloadList = addDyingClassesToList(env, classLoader, markMap, true, classUnloadList, &classUnloadCount);
+
+			classLoader = classLoader->unloadLink;
+		}
 	}
 
 	if (0 != classUnloadCount) {
@@ -376,7 +456,6 @@ MM_ClassLoaderManager::cleanUpClassLoadersStart(MM_EnvironmentBase *env, J9Class
 J9Class *
 MM_ClassLoaderManager::addDyingClassesToList(MM_EnvironmentBase *env, J9ClassLoader *classLoader, MM_HeapMap *markMap, bool setAll, J9Class *classUnloadListStart, uintptr_t *classUnloadCountResult)
 {
-	J9VMThread *vmThread = (J9VMThread *)env->getLanguageVMThread();
 	J9Class *classUnloadList = classUnloadListStart;
 	uintptr_t classUnloadCount = 0;
 
@@ -395,23 +474,7 @@ MM_ClassLoaderManager::addDyingClassesToList(MM_EnvironmentBase *env, J9ClassLoa
 
 					classUnloadCount += 1;
 
-					/* Remove the class from the subclass traversal list */
-					removeFromSubclassHierarchy(env, clazz);
-
-					/* Mark class as dying */
-					clazz->classDepthAndFlags |= J9AccClassDying;
-
-					/* For CMVC 137275. For all dying classes we poison the classObject
-					 * field to J9_INVALID_OBJECT to investigate the origin of a class object
-					 * reference whose class has been unloaded.
-					 */
-					clazz->classObject = (j9object_t)J9_INVALID_OBJECT;
-
-					/* Call class unload hook */
-					Trc_MM_cleanUpClassLoadersStart_triggerClassUnload(env->getLanguageVMThread(),clazz,
-								(uintptr_t)J9UTF8_LENGTH(J9ROMCLASS_CLASSNAME(clazz->romClass)),
-								J9UTF8_DATA(J9ROMCLASS_CLASSNAME(clazz->romClass)));
-					TRIGGER_J9HOOK_VM_CLASS_UNLOAD(_javaVM->hookInterface, vmThread, clazz);
+					setClassDying(env, clazz);
 
 					/* add class to dying classes link list */
 					clazz->gcLink = classUnloadList;
@@ -425,6 +488,123 @@ MM_ClassLoaderManager::addDyingClassesToList(MM_EnvironmentBase *env, J9ClassLoa
 	return classUnloadList;
 }
 
+void
+MM_ClassLoaderManager::setClassDying(MM_EnvironmentBase *env, J9Class *clazz)
+{
+	J9VMThread *vmThread = (J9VMThread *)env->getLanguageVMThread();
+
+	/* Remove the class from the subclass traversal list */
+	removeFromSubclassHierarchy(env, clazz);
+
+	/* Mark class as dying */
+	clazz->classDepthAndFlags |= J9AccClassDying;
+
+	/* For CMVC 137275. For all dying classes we poison the classObject
+	 * field to J9_INVALID_OBJECT to investigate the origin of a class object
+	 * reference whose class has been unloaded.
+	 */
+	clazz->classObject = (j9object_t)J9_INVALID_OBJECT;
+
+	/* Call class unload hook */
+	Trc_MM_cleanUpClassLoadersStart_triggerClassUnload(env->getLanguageVMThread(),clazz,
+				(uintptr_t)J9UTF8_LENGTH(J9ROMCLASS_CLASSNAME(clazz->romClass)),
+				J9UTF8_DATA(J9ROMCLASS_CLASSNAME(clazz->romClass)));
+	TRIGGER_J9HOOK_VM_CLASS_UNLOAD(_javaVM->hookInterface, vmThread, clazz);
+}
+
+J9Class *
+MM_ClassLoaderManager::collectDyingClasses(MM_EnvironmentBase *env, J9ClassLoader *classLoader, MM_HeapMap *markMap, bool setAll, J9Class *classList, uintptr_t *classCount, DyingClassList *result)
+{
+	if (NULL != classLoader) {
+		GC_ClassLoaderSegmentIterator segmentIterator(classLoader, MEMORY_TYPE_RAM_CLASS);
+		J9MemorySegment *segment = NULL;
+		while (NULL != (segment = segmentIterator.nextSegment())) {
+			/* all threads walk the same segments in the same order, so they agree on the work units */
+			if (0 == (result->_segmentIndex % SEGMENTS_PER_WORK_UNIT)) {
+				result->_workUnitClaimed = J9MODRON_HANDLE_NEXT_WORK_UNIT(env);
+			}
+			result->_segmentIndex += 1;
+
+			if (result->_workUnitClaimed) {
+				GC_ClassHeapIterator classHeapIterator(_javaVM, segment);
+				J9Class *clazz = NULL;
+				while (NULL != (clazz = classHeapIterator.nextClass())) {
+					J9Object *classObject = clazz->classObject;
+					if (setAll || !markMap->isBitSet(classObject)) {
+
+						/* with setAll all classes must be unmarked */
+						Assert_MM_true(!markMap->isBitSet(classObject));
+
+						/* gcLink is only written by the thread which owns the segment */
+						clazz->gcLink = classList;
+						classList = clazz;
+						*classCount += 1;
+					}
+				}
+			}
+		}
+	}
+
+	return classList;
+}
+
+void
+MM_ClassLoaderManager::findDyingClasses(MM_EnvironmentBase *env, J9ClassLoader *classLoaderUnloadList, MM_HeapMap *markMap, DyingClassList *result)
+{
+	result->_anonymousClasses = collectDyingClasses(env, _javaVM->anonClassLoader, markMap, false, result->_anonymousClasses, &result->_anonymousClassCount, result);
+
+	for (J9ClassLoader *classLoader = classLoaderUnloadList; NULL != classLoader; classLoader = classLoader->unloadLink) {
+		result->_classes = collectDyingClasses(env, classLoader, markMap, true, result->_classes, &result->_classCount, result);
+	}
+}
+
+bool
+MM_ClassLoaderManager::identifyDyingClassesInParallel(MM_EnvironmentBase *env, J9ClassLoader *classLoaderUnloadList, MM_HeapMap *markMap,
+		J9Class **anonymousClassUnloadList, uintptr_t *anonymousClassUnloadCount, J9Class **classUnloadList, uintptr_t *classUnloadCount)
+{
+	uintptr_t threadCount = _extensions->dispatcher->threadCountMaximum();
+	DyingClassList *results = (DyingClassList *)env->getForge()->allocate(sizeof(DyingClassList) * threadCount, MM_AllocationCategory::FIXED, J9_GET_CALLSITE());
+	if (NULL == results) {
+		return false;
+	}
+	memset(results, 0, sizeof(DyingClassList) * threadCount);
+
+	MM_ClassUnloadIdentificationTask identificationTask(env, _extensions->dispatcher, this, classLoaderUnloadList, markMap, results);
+	_extensions->dispatcher->run(env, &identificationTask);
+
+	/* Anonymous classes go first so that they end up at the tail of the list of all dying classes */
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		J9Class *clazz = results[i]._anonymousClasses;
+		while (NULL != clazz) {
+			J9Class *next = clazz->gcLink;
+			setClassDying(env, clazz);
+			clazz->gcLink = *anonymousClassUnloadList;
+			*anonymousClassUnloadList = clazz;
+			clazz = next;
+		}
+		*anonymousClassUnloadCount += results[i]._anonymousClassCount;
+	}
+
+	/* class unload list includes anonymous class unload list */
+	*classUnloadList = *anonymousClassUnloadList;
+	*classUnloadCount += *anonymousClassUnloadCount;
+
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		J9Class *clazz = results[i]._classes;
+		while (NULL != clazz) {
+			J9Class *next = clazz->gcLink;
+			setClassDying(env, clazz);
+			clazz->gcLink = *classUnloadList;
+			*classUnloadList = clazz;
+			clazz = next;
+		}
+		*classUnloadCount += results[i]._classCount;
+	}
+
+	env->getForge()->free(results);
+	return true;
+}
+
 void
 MM_ClassLoaderManager::cleanUpClassLoadersEnd(MM_EnvironmentBase *env, J9ClassLoader *unloadLink)
 {
@@ -48,12 +48,31 @@ class MM_ClassLoaderManager : public MM_BaseNonVirtual
 friend class GC_ClassLoaderLinkedListIterator;
 	
 public:
+#if defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING)
+	/**
+	 * Dying classes found by one GC thread while identifying classes to unload in parallel
+	 */
+	struct DyingClassList {
+		J9Class *_anonymousClasses; /**< dying anonymous classes linked through gcLink */
+		uintptr_t _anonymousClassCount;
+		J9Class *_classes; /**< classes of dying class loaders linked through gcLink */
+		uintptr_t _classCount;
+		uintptr_t _segmentIndex; /**< index of the next segment in the walk shared by all threads */
+		bool _workUnitClaimed; /**< true if this thread owns the work unit _segmentIndex is in */
+	};
+#endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 protected:
 private:
 #if defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING)
+	/* number of consecutive RAM class segments claimed at once while identifying dying classes in parallel */
+	static const uintptr_t SEGMENTS_PER_WORK_UNIT = 32;
+	/* number of undead segments freed by the finalizer between checks for a pending collection */
+	static const uintptr_t UNDEAD_SEGMENTS_PER_VM_ACCESS = 64;
+
 	omrthread_monitor_t _undeadSegmentListMonitor;
 	J9MemorySegment *_firstUndeadSegment;
 	uintptr_t _undeadSegmentsTotalSize;
+	volatile bool _undeadSegmentsFlushDeferred; /**< true if the finalizer has been asked to free the cached undead segments */
 	uintptr_t _lastUnloadNumOfClassLoaders;  /**< number of class loaders last seen during a dynamic class unloading pass */
 	uintptr_t _lastUnloadNumOfAnonymousClasses; /**< number of anonymous classes last seen during a dynamic class unloading pass */
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
@@ -73,6 +92,7 @@ public:
 		,_undeadSegmentListMonitor(NULL)
 		,_firstUndeadSegment(NULL)
 		,_undeadSegmentsTotalSize(0)
+		,_undeadSegmentsFlushDeferred(false)
 		,_lastUnloadNumOfClassLoaders(0)
 		,_lastUnloadNumOfAnonymousClasses(0)
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
@@ -98,6 +118,22 @@ public:
 	 */
 	void flushUndeadSegments(MM_EnvironmentBase *env);
 	
+	/**
+	 * Ask the finalizer to free the cached segments once the current collection has completed, instead of
+	 * flushing them in the pause. Only valid for collectors which never walk dead objects after unloading.
+	 * @param env The environment
+	 * @return true if the finalizer will free the segments, false if the caller has to flush them
+	 */
+	bool deferUndeadSegmentsFlush(MM_EnvironmentBase *env);
+
+	/**
+	 * Free the segments handed to the finalizer by deferUndeadSegmentsFlush, if any. The current thread
+	 * must hold VM access so that no collection walks the segment lists while the segments are freed.
+	 * VM access is released periodically to let a pending collection proceed.
+	 * @param vmThread The current thread
+	 */
+	void flushDeferredUndeadSegments(J9VMThread *vmThread);
+
 	/**
 	 * Returns the total amount of memory (in bytes) which would be reclaimed if the buffer were to be flushed
 	 */
@@ -220,6 +256,16 @@ public:
 	 */
 	void cleanUpSegmentsInAnonymousClassLoader(MM_EnvironmentBase *env, J9MemorySegment **reclaimedSegments);
 
+	/**
+	 * Collect the dying anonymous classes and the classes of the dying class loaders from the RAM class
+	 * segments claimed by the current thread. Called by every thread of MM_ClassUnloadIdentificationTask.
+	 * @param env[in] the current thread
+	 * @param classLoaderUnloadList[in] the linked list of loaders to unload, connected through the unloadLink field
+	 * @param markMap[in] the markMap to use to test for class liveness
+	 * @param result[in/out] the dying classes found by the current thread
+	 */
+	void findDyingClasses(MM_EnvironmentBase *env, J9ClassLoader *classLoaderUnloadList, MM_HeapMap *markMap, DyingClassList *result);
+
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 	
 	/**
@@ -268,6 +314,40 @@ private:
 	 */
 	J9Class *addDyingClassesToList(MM_EnvironmentBase *env, J9ClassLoader *classLoader, MM_HeapMap *markMap, bool setAll, J9Class *classUnloadListStart, uintptr_t *classUnloadCountOut);
 
+	/**
+	 * Remove a dying class from the subclass hierarchy, mark it dying and report it to the class unload hook
+	 * @param env[in] the current thread
+	 * @param clazz[in] the dying class
+	 */
+	void setClassDying(MM_EnvironmentBase *env, J9Class *clazz);
+
+	/**
+	 * Collect dying classes of one class loader from the segments claimed by the current thread
+	 * @param env[in] the current thread
+	 * @param classLoader[in] the class loader to scan
+	 * @param markMap[in] the markMap to use to test for class liveness
+	 * @param setAll[in] if true all classes are dying, if false unmarked classes only
+	 * @param classList[in] root of the list dying classes are added to
+	 * @param classCount[in/out] incremented by the number of classes added to the list
+	 * @param result[in/out] the segment walk state of the current thread
+	 * @return new root of the list of dying classes
+	 */
+	J9Class *collectDyingClasses(MM_EnvironmentBase *env, J9ClassLoader *classLoader, MM_HeapMap *markMap, bool setAll, J9Class *classList, uintptr_t *classCount, DyingClassList *result);
+
+	/**
+	 * Identify dying classes with all GC threads and apply the side effects of unloading on the current thread.
+	 * @param env[in] the main GC thread
+	 * @param classLoaderUnloadList[in] the linked list of loaders to unload, connected through the unloadLink field
+	 * @param markMap[in] the markMap to use to test for class liveness
+	 * @param anonymousClassUnloadList[out] the dying anonymous classes
+	 * @param anonymousClassUnloadCount[out] the number of dying anonymous classes
+	 * @param classUnloadList[out] all dying classes, ending with the dying anonymous classes
+	 * @param classUnloadCount[out] the number of all dying classes
+	 * @return false if the work could not be distributed and the caller has to identify dying classes itself
+	 */
+	bool identifyDyingClassesInParallel(MM_EnvironmentBase *env, J9ClassLoader *classLoaderUnloadList, MM_HeapMap *markMap,
+			J9Class **anonymousClassUnloadList, uintptr_t *anonymousClassUnloadCount, J9Class **classUnloadList, uintptr_t *classUnloadCount);
+
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 
 };
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#if !defined(CLASSUNLOADIDENTIFICATIONTASK_HPP_)
+#define CLASSUNLOADIDENTIFICATIONTASK_HPP_
+
+#include "j9.h"
+#include "j9cfg.h"
+
+#if defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING)
+
+#include "ClassLoaderManager.hpp"
+#include "ParallelTask.hpp"
+
+class MM_HeapMap;
+
+/**
+ * Task used by MM_ClassLoaderManager to identify the dying classes of a class unloading cycle with
+ * all GC threads. Every thread collects the dying classes of the segments it claims into its own
+ * entry of the result array; the side effects of unloading are applied by the main thread afterwards.
+ * @ingroup GC_Base
+ */
+class MM_ClassUnloadIdentificationTask : public MM_ParallelTask
+{
+	/* Data Members */
+private:
+	MM_ClassLoaderManager * const _classLoaderManager;
+	J9ClassLoader * const _classLoaderUnloadList; /**< dying class loaders linked through unloadLink */
+	MM_HeapMap * const _markMap;
+	MM_ClassLoaderManager::DyingClassList * const _results; /**< one entry per GC thread, indexed by worker ID */
+protected:
+public:
+
+	/* Member Functions */
+private:
+protected:
+public:
+	virtual uintptr_t getVMStateID() { return OMRVMSTATE_GC_CLEANING_METADATA; }
+
+	virtual void run(MM_EnvironmentBase *env);
+
+	MM_ClassUnloadIdentificationTask(MM_EnvironmentBase *env, MM_ParallelDispatcher *dispatcher, MM_ClassLoaderManager *classLoaderManager,
+			J9ClassLoader *classLoaderUnloadList, MM_HeapMap *markMap, MM_ClassLoaderManager::DyingClassList *results)
+		: MM_ParallelTask(env, dispatcher)
+		, _classLoaderManager(classLoaderManager)
+		, _classLoaderUnloadList(classLoaderUnloadList)
+		, _markMap(markMap)
+		, _results(results)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
+
+#endif /* CLASSUNLOADIDENTIFICATIONTASK_HPP_ */
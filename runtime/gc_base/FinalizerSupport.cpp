@@ -33,6 +33,7 @@
 #include "FinalizerSupport.hpp"
 
 #include "AtomicOperations.hpp"
+#include "ClassLoaderManager.hpp"
 #include "ClassLoaderIterator.hpp"
 #include "EnvironmentBase.hpp"
 #include "FinalizeListManager.hpp"
@@ -42,6 +43,7 @@
 #include "ModronTypes.hpp"
 #include "ObjectAccessBarrier.hpp"
 #include "OMRVMInterface.hpp"
+#include "StringTable.hpp"
 #include "SublistFragment.hpp"
 #include "SublistIterator.hpp"
 #include "SublistSlotIterator.hpp"
@@ -522,8 +524,16 @@ static int J9THREAD_PROC FinalizeWorkerThread(void *arg)
 		omrthread_monitor_exit(monitor);
 
 		fns->internalEnterVMFromJNI(env);
-		
+
+		/* share the value arrays of equal long lived Strings found by the scavenger */
+		extensions->getStringTable()->deduplicateCandidates(env);
+
 #if defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING)
+		/* free class segments the collector left for us rather than freeing them in its pause */
+		if (NULL != extensions->classLoaderManager) {
+			extensions->classLoaderManager->flushDeferredUndeadSegments(env);
+		}
+
 		if(workerData->mode != FINALIZE_WORKER_MODE_CL_UNLOAD)
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 		{
@@ -57,6 +57,7 @@ class MM_HeapMap;
 class MM_MemorySubSpace;
 class MM_ObjectAccessBarrier;
 class MM_OwnableSynchronizerObjectList;
+class MM_PretenureClassTable;
 class MM_ContinuationObjectList;
 class MM_StringTable;
 class MM_UnfinalizedObjectList;
@@ -97,6 +98,7 @@ private:
 	MM_ContinuationObjectList* continuationObjectLists; /**< The global linked list of continuation object lists. */
 public:
 	MM_StringTable* stringTable; /**< top level String Table structure (internally organized as a set of hash sub-tables */
+	MM_PretenureClassTable* pretenureClassTable; /**< allocation and promotion samples of the classes considered for pretenuring (NULL if pretenuring is disabled) */
 
 	void* gcchkExtensions;
 
@@ -137,6 +139,10 @@ public:
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 
 	U_32 _stringTableListToTreeThreshold; /**< Threshold at which we start using trees instead of lists for collision resolution in the String table */
+	uintptr_t _stringTableLookupCacheSize; /**< Number of interned Strings cached for lookup without locking the String table (0 to disable) */
+	bool _stringDeduplication; /**< If true, Strings tenured by the scavenger share the value array of an equal long lived String */
+	bool _pretenure; /**< If true, the scavenger selects classes whose allocations mostly survive to tenure, and they are allocated directly in tenure */
+	uintptr_t _pretenureThreshold; /**< Minimum estimated percentage of the allocated bytes of a class reaching tenure for the class to be pretenured */
 
 #if defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING)
 	bool fvtest_forceFinalizeClassLoaders;
@@ -163,6 +169,8 @@ public:
 	MM_ClassLoaderManager* classLoaderManager; /**< Pointer to the gc's classloader manager to process classloaders/classes */
 #if defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING)
 	uintptr_t deadClassLoaderCacheSize; /**< threshold after which we flush class segments (not done for every class unloading, since it requires heap walk) */
+	uintptr_t parallelClassUnloadThreshold; /**< number of anonymous classes plus dying class loaders from which dying classes are identified by all GC threads (0 to disable) */
+	bool concurrentClassSegmentReclaim; /**< if true Balanced hands class segments of unloaded classes to the finalizer to be freed after the pause */
 #endif /*defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING) */
 
 	MM_UnfinalizedObjectList* unfinalizedObjectLists; /**< The global linked list of unfinalized object lists. */
@@ -170,6 +178,9 @@ public:
 	uintptr_t objectListFragmentCount; /**< the size of Local Object Buffer(per gc thread), used by referenceObjectBuffer, UnfinalizedObjectBuffer and OwnableSynchronizerObjectBuffer */
 
 	MM_Wildcard* numaCommonThreadClassNamePatterns; /**< A linked list of thread class names which should be associated with the common context */
+#if defined(J9VM_GC_VLHGC)
+	bool _copyForwardCommonToThreadNode; /**< If true, copy-forward copies objects of the common context into the context of the NUMA node of the copying thread (the local and remote copied bytes are reported by -Xtgc:numa) */
+#endif /* defined(J9VM_GC_VLHGC) */
 
 	class UserSpecifiedParameters {
 	private:
@@ -277,6 +288,12 @@ public:
 	 */
 	MMINLINE MM_StringTable* getStringTable() { return stringTable; }
 
+	/**
+	 * Fetch the pretenuring class table.
+	 * @return the pretenuring class table, NULL if pretenuring is disabled
+	 */
+	MMINLINE MM_PretenureClassTable* getPretenureClassTable() { return pretenureClassTable; }
+
 	MMINLINE uintptr_t getDynamicMaxSoftReferenceAge()
 	{
 		return dynamicMaxSoftReferenceAge;
@@ -401,6 +418,7 @@ public:
 		, ownableSynchronizerObjectLists(NULL)
 		, continuationObjectLists(NULL)
 		, stringTable(NULL)
+		, pretenureClassTable(NULL)
 		, gcchkExtensions(NULL)
 		, tgcExtensions(NULL)
 #if defined(J9VM_GC_FINALIZATION)
@@ -416,6 +434,10 @@ public:
 		, classUnloadingAnonymousClassWeight(1.0)
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 		, _stringTableListToTreeThreshold(1024)
+		, _stringTableLookupCacheSize(16 * 1024)
+		, _stringDeduplication(false)
+		, _pretenure(false)
+		, _pretenureThreshold(80)
 		, maxSoftReferenceAge(32)
 #if defined(J9VM_GC_FINALIZATION)
 		, finalizeMainPriority(J9THREAD_PRIORITY_NORMAL)
@@ -424,10 +446,15 @@ public:
 		, classLoaderManager(NULL)
 #if defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING)
 		, deadClassLoaderCacheSize(1024 * 1024) /* default is one MiB */
+		, parallelClassUnloadThreshold(4096)
+		, concurrentClassSegmentReclaim(true)
 #endif /* defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING) */
 		, unfinalizedObjectLists(NULL)
 		, objectListFragmentCount(0)
 		, numaCommonThreadClassNamePatterns(NULL)
+#if defined(J9VM_GC_VLHGC)
+		, _copyForwardCommonToThreadNode(false)
+#endif /* defined(J9VM_GC_VLHGC) */
 		, userSpecifiedParameters()
 		, tlhMaximumSizeSpecified(false)
 		, virtualLargeObjectHeap()
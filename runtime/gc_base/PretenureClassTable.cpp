@@ -0,0 +1,280 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "PretenureClassTable.hpp"
+
+#include "AtomicOperations.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensions.hpp"
+#include "ModronAssertions.h"
+#include "VMThreadListIterator.hpp"
+
+MM_PretenureClassTable *
+MM_PretenureClassTable::newInstance(MM_EnvironmentBase *env)
+{
+	MM_PretenureClassTable *pretenureClassTable = (MM_PretenureClassTable *)env->getForge()->allocate(sizeof(MM_PretenureClassTable), MM_AllocationCategory::FIXED, J9_GET_CALLSITE());
+	if (NULL != pretenureClassTable) {
+		new(pretenureClassTable) MM_PretenureClassTable(env);
+		if (!pretenureClassTable->initialize(env)) {
+			pretenureClassTable->kill(env);
+			pretenureClassTable = NULL;
+		}
+	}
+	return pretenureClassTable;
+}
+
+bool
+MM_PretenureClassTable::initialize(MM_EnvironmentBase *env)
+{
+	_entries = (Entry *)env->getForge()->allocate(sizeof(Entry) * tableSize, MM_AllocationCategory::FIXED, J9_GET_CALLSITE());
+	if (NULL == _entries) {
+		return false;
+	}
+	clear();
+	return true;
+}
+
+void
+MM_PretenureClassTable::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+void
+MM_PretenureClassTable::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _entries) {
+		env->getForge()->free(_entries);
+		_entries = NULL;
+	}
+}
+
+void
+MM_PretenureClassTable::clear()
+{
+	memset(_entries, 0, sizeof(Entry) * tableSize);
+	_pretenuredClassCount = 0;
+	_lookupFailures = 0;
+	_lastLookupFailures = 0;
+}
+
+void
+MM_PretenureClassTable::reinsertEntries(uintptr_t freeIndex)
+{
+	/* Starting right after a free entry, every entry is reinserted after the entries probed before it */
+	for (uintptr_t count = 1; count <= tableSize; count++) {
+		Entry *entry = &_entries[(freeIndex + count) & (tableSize - 1)];
+		if (NULL != entry->_clazz) {
+			Entry moved = *entry;
+			memset(entry, 0, sizeof(Entry));
+			Entry *newEntry = findOrAddEntry(moved._clazz);
+			Assert_MM_true(NULL != newEntry);
+			*newEntry = moved;
+		}
+	}
+}
+
+MM_PretenureClassTable::Entry *
+MM_PretenureClassTable::findOrAddEntry(J9Class *clazz)
+{
+	/* classes are aligned, so drop the low bits which are always zero */
+	uintptr_t index = ((uintptr_t)clazz / J9_REQUIRED_CLASS_ALIGNMENT) & (tableSize - 1);
+	for (uintptr_t probe = 0; probe < probeLimit; probe++) {
+		Entry *entry = &_entries[(index + probe) & (tableSize - 1)];
+		J9Class *entryClass = entry->_clazz;
+		if (NULL == entryClass) {
+			entryClass = (J9Class *)MM_AtomicOperations::lockCompareExchange((volatile uintptr_t *)&entry->_clazz, (uintptr_t)NULL, (uintptr_t)clazz);
+			if (NULL == entryClass) {
+				return entry;
+			}
+		}
+		if (clazz == entryClass) {
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+void
+MM_PretenureClassTable::mergeAllocationSample(GCpretenureAllocationSample *sample)
+{
+	Entry *entry = findOrAddEntry(sample->clazz);
+	if (NULL != entry) {
+		MM_AtomicOperations::add(&entry->_allocationSamples, sample->samples);
+		MM_AtomicOperations::add(&entry->_allocatedBytes, sample->bytes);
+	} else {
+		MM_AtomicOperations::add(&_lookupFailures, 1);
+	}
+	sample->clazz = NULL;
+	sample->samples = 0;
+	sample->bytes = 0;
+}
+
+void
+MM_PretenureClassTable::recordAllocationSample(MM_EnvironmentBase *env, J9Class *clazz, uintptr_t refreshSize)
+{
+	GCpretenureAllocationSample *samples = env->getGCEnvironment()->_pretenureAllocationSamples;
+	uintptr_t slot = ((uintptr_t)clazz / J9_REQUIRED_CLASS_ALIGNMENT) & (GC_PRETENURE_ALLOCATION_SAMPLE_SLOTS - 1);
+	GCpretenureAllocationSample *sample = &samples[slot];
+	if (clazz != sample->clazz) {
+		if (NULL != sample->clazz) {
+			mergeAllocationSample(sample);
+		}
+		sample->clazz = clazz;
+	}
+	sample->samples += 1;
+	sample->bytes += refreshSize;
+}
+
+void
+MM_PretenureClassTable::flushAllocationSamples(MM_EnvironmentBase *env)
+{
+	GCpretenureAllocationSample *samples = env->getGCEnvironment()->_pretenureAllocationSamples;
+	for (uintptr_t slot = 0; slot < GC_PRETENURE_ALLOCATION_SAMPLE_SLOTS; slot++) {
+		if (NULL != samples[slot].clazz) {
+			mergeAllocationSample(&samples[slot]);
+		}
+	}
+}
+
+void
+MM_PretenureClassTable::recordPromotion(J9Class *clazz, uintptr_t bytes)
+{
+	Entry *entry = findOrAddEntry(clazz);
+	if (NULL != entry) {
+		MM_AtomicOperations::add(&entry->_promotedBytes, bytes);
+	} else {
+		MM_AtomicOperations::add(&_lookupFailures, 1);
+	}
+}
+
+void
+MM_PretenureClassTable::removeDyingClasses(MM_EnvironmentBase *env)
+{
+	/* drop the samples of dying classes still cached by the mutators */
+	GC_VMThreadListIterator vmThreadListIterator((J9JavaVM *)env->getOmrVM()->_language_vm);
+	J9VMThread *walkThread = NULL;
+	while (NULL != (walkThread = vmThreadListIterator.nextVMThread())) {
+		MM_EnvironmentBase *walkEnv = MM_EnvironmentBase::getEnvironment(walkThread->omrVMThread);
+		GCpretenureAllocationSample *samples = walkEnv->getGCEnvironment()->_pretenureAllocationSamples;
+		for (uintptr_t slot = 0; slot < GC_PRETENURE_ALLOCATION_SAMPLE_SLOTS; slot++) {
+			J9Class *clazz = samples[slot].clazz;
+			if ((NULL != clazz) && J9_ARE_ANY_BITS_SET(J9CLASS_FLAGS(clazz), J9AccClassDying)) {
+				memset(&samples[slot], 0, sizeof(GCpretenureAllocationSample));
+			}
+		}
+	}
+
+	removeDyingEntries();
+}
+
+void
+MM_PretenureClassTable::removeDyingEntries()
+{
+	bool removed = false;
+	uintptr_t freeIndex = 0;
+	for (uintptr_t index = 0; index < tableSize; index++) {
+		Entry *entry = &_entries[index];
+		J9Class *clazz = entry->_clazz;
+		if ((NULL != clazz) && J9_ARE_ANY_BITS_SET(J9CLASS_FLAGS(clazz), J9AccClassDying)) {
+			if (J9_ARE_ANY_BITS_SET(clazz->classFlags, J9ClassPretenure)) {
+				_pretenuredClassCount -= 1;
+			}
+			memset(entry, 0, sizeof(Entry));
+			removed = true;
+		}
+		if (NULL == entry->_clazz) {
+			freeIndex = index;
+		}
+	}
+
+	if (removed) {
+		reinsertEntries(freeIndex);
+	}
+}
+
+void
+MM_PretenureClassTable::updatePretenuredClasses(MM_EnvironmentBase *env, uintptr_t threshold)
+{
+	uintptr_t lookupFailures = _lookupFailures;
+	MM_AtomicOperations::subtract(&_lookupFailures, lookupFailures);
+	_lastLookupFailures = lookupFailures;
+
+	bool removed = false;
+	uintptr_t freeIndex = 0;
+	for (uintptr_t index = 0; index < tableSize; index++) {
+		Entry *entry = &_entries[index];
+		J9Class *clazz = entry->_clazz;
+		entry->_newlyPretenured = false;
+		entry->_newlyReleased = false;
+		if (NULL != clazz) {
+			if (J9_ARE_ANY_BITS_SET(clazz->classFlags, J9ClassPretenure)) {
+				/* instances are promoted by their first scavenge, so the estimate is stale: measure the class again from time to time */
+				entry->_allocationSamples = 0;
+				entry->_allocatedBytes = 0;
+				entry->_promotedBytes = 0;
+				entry->_scavengesUntilReview -= 1;
+				if (0 == entry->_scavengesUntilReview) {
+					clazz->classFlags &= ~(uintptr_t)J9ClassPretenure;
+					entry->_survivalRate = 0;
+					entry->_newlyReleased = true;
+					_pretenuredClassCount -= 1;
+				}
+				continue;
+			}
+
+			uintptr_t samples = entry->_allocationSamples;
+			uintptr_t allocatedBytes = entry->_allocatedBytes;
+			if (0 != allocatedBytes) {
+				U_64 survivalRate = ((U_64)entry->_promotedBytes * 100) / allocatedBytes;
+				entry->_survivalRate = (uintptr_t)OMR_MIN(survivalRate, (U_64)100);
+			}
+			if ((samples >= minimumAllocationSamples) && (entry->_survivalRate >= threshold)) {
+				clazz->classFlags |= J9ClassPretenure;
+				entry->_reviewInterval = (0 == entry->_reviewInterval) ? initialReviewInterval : OMR_MIN(entry->_reviewInterval * 2, maximumReviewInterval);
+				entry->_scavengesUntilReview = entry->_reviewInterval;
+				entry->_newlyPretenured = true;
+				_pretenuredClassCount += 1;
+			} else if (samples >= minimumAllocationSamples) {
+				/* the class no longer qualifies, so it starts over with the initial interval if it qualifies again */
+				entry->_reviewInterval = 0;
+			}
+			/* halve the history so that recent scavenges weigh the most */
+			entry->_allocationSamples = samples / 2;
+			entry->_allocatedBytes = allocatedBytes / 2;
+			entry->_promotedBytes /= 2;
+			if (!entry->_newlyPretenured && (0 == entry->_allocationSamples) && (0 == entry->_allocatedBytes) && (0 == entry->_promotedBytes)) {
+				/* the class stopped allocating: give the entry to another class */
+				memset(entry, 0, sizeof(Entry));
+				removed = true;
+			}
+		}
+		if (NULL == entry->_clazz) {
+			freeIndex = index;
+		}
+	}
+
+	if (removed) {
+		reinsertEntries(freeIndex);
+	}
+}
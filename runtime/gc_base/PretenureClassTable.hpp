@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#if !defined(PRETENURECLASSTABLE_HPP_)
+#define PRETENURECLASSTABLE_HPP_
+
+#include "j9.h"
+#include "j9cfg.h"
+
+#include "BaseVirtual.hpp"
+#include "EnvironmentDelegate.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * Per class estimate of the fraction of allocated bytes which survive to tenure, used by the gencon
+ * policy to allocate the instances of long lived classes directly in tenure.
+ *
+ * The mutators sample the class of the object whose allocation refreshes a thread local heap, weighted
+ * by the size of the new TLH: a refresh is triggered by an object in proportion to its size, so the
+ * samples of a class estimate the bytes it allocates in the nursery, whichever path allocates it. The
+ * samples are accumulated in a small per-thread cache (see GC_Environment) and merged into the table
+ * when the cache entry is evicted or when the caches are flushed for a GC. The scavenger samples the
+ * bytes it copies to tenure. Both are aged at the end of every scavenge so the estimate follows the
+ * recent behaviour of the application.
+ *
+ * A class selected for pretenuring gets J9ClassPretenure set. Its instances are still allocated from
+ * the TLH, but with the maximum object age, so the first scavenge they survive copies them to tenure
+ * instead of the survivor space (code compiled afterwards calls the allocation helper for them, as the
+ * inline allocation sequence does not set the age). Placing them in tenure at allocation would save that
+ * copy, but would take every allocation of the class out of line to the locked tenure allocator.
+ * As every instance alive at its first scavenge is now promoted, the survival estimate of the class is
+ * no longer meaningful, so the flag is cleared again after a number of scavenges and the class is
+ * measured afresh. The interval doubles every time the class is selected again.
+ * @ingroup GC_Base
+ */
+class MM_PretenureClassTable : public MM_BaseVirtual
+{
+	/* Data Members */
+public:
+	struct Entry {
+		J9Class * volatile _clazz; /**< class described by the entry, NULL if the entry is free */
+		volatile uintptr_t _allocationSamples; /**< number of sampled TLH refreshes triggered by the class */
+		volatile uintptr_t _allocatedBytes; /**< estimated bytes of the class allocated in the nursery (sum of the sampled refresh sizes) */
+		volatile uintptr_t _promotedBytes; /**< estimated bytes of the class copied to tenure */
+		uintptr_t _survivalRate; /**< estimated percentage of allocated bytes reaching tenure, as of the last scavenge */
+		uintptr_t _reviewInterval; /**< number of scavenges the class stays pretenured the next time it is selected */
+		uintptr_t _scavengesUntilReview; /**< number of scavenges before a pretenured class is measured again */
+		bool _newlyPretenured; /**< true if the class was selected for pretenuring by the last scavenge */
+		bool _newlyReleased; /**< true if the class stopped being pretenured at the last scavenge, to be measured again */
+	};
+
+private:
+	uintptr_t _pretenuredClassCount; /**< number of classes currently pretenured */
+	volatile uintptr_t _lookupFailures; /**< number of samples dropped since the last scavenge because their class could not be placed */
+	uintptr_t _lastLookupFailures; /**< number of samples dropped during the last scavenge cycle */
+protected:
+	static const uintptr_t tableSize = 1024; /**< number of entries, a power of two */
+	static const uintptr_t probeLimit = 8; /**< number of entries searched for a class before its samples are dropped */
+	static const uintptr_t minimumAllocationSamples = 32; /**< samples required before a class may be pretenured */
+	static const uintptr_t initialReviewInterval = 16; /**< scavenges a class stays pretenured when it is first selected */
+	static const uintptr_t maximumReviewInterval = 1024; /**< upper bound of the scavenges a class stays pretenured */
+
+	Entry *_entries;
+public:
+
+	/* Member Functions */
+private:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+	/**
+	 * Reinsert the entries following a free entry, after entries have been removed. Lookups stop at the
+	 * first free entry, so the entries placed after a removed one must be moved to close the gaps.
+	 * Must be called while no other thread uses the table.
+	 * @param freeIndex index of a free entry
+	 */
+	void reinsertEntries(uintptr_t freeIndex);
+protected:
+	/**
+	 * Find the entry of a class, claiming a free entry for it if it has none.
+	 * @return the entry, or NULL if the class could not be placed
+	 */
+	Entry *findOrAddEntry(J9Class *clazz);
+
+	/**
+	 * Forget every entry.
+	 */
+	void clear();
+
+	/**
+	 * Add the allocation samples of a per-thread cache slot to the entry of its class.
+	 */
+	void mergeAllocationSample(GCpretenureAllocationSample *sample);
+
+	/**
+	 * Remove the entries of the classes which are being unloaded (J9AccClassDying), leaving the
+	 * per-thread caches alone. Must be called while no other thread uses the table.
+	 */
+	void removeDyingEntries();
+public:
+	static MM_PretenureClassTable *newInstance(MM_EnvironmentBase *env);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Record that the allocation of an instance of clazz refreshed the thread local heap of the
+	 * calling mutator. The sample is kept in the thread's cache.
+	 * @param env the mutator
+	 * @param clazz the class of the object which triggered the refresh
+	 * @param refreshSize the size of the new thread local heap
+	 */
+	void recordAllocationSample(MM_EnvironmentBase *env, J9Class *clazz, uintptr_t refreshSize);
+
+	/**
+	 * Merge the allocation samples cached by a thread into the table.
+	 * @param env the thread owning the cache, or any thread while the owner is stopped
+	 */
+	void flushAllocationSamples(MM_EnvironmentBase *env);
+
+	/**
+	 * Record bytes of clazz copied to tenure by the scavenger. Called by GC threads.
+	 */
+	void recordPromotion(J9Class *clazz, uintptr_t bytes);
+
+	/**
+	 * Forget the entries and the cached allocation samples of the classes which are being unloaded
+	 * (J9AccClassDying). They refer to classes by address, so this must be done by the collector when it
+	 * unloads classes, while mutators are stopped, before the classes are freed.
+	 */
+	void removeDyingClasses(MM_EnvironmentBase *env);
+
+	/**
+	 * Estimate the survival rate of every class and pretenure the ones at or above the threshold,
+	 * release the pretenured classes due for review, then age the samples. The entries of the classes
+	 * whose samples have all aged to zero are removed, so that classes which stopped allocating do not
+	 * fill the table. Must be called by the main GC thread at the end of a successful scavenge.
+	 * @param threshold minimum survival rate (percentage) of a pretenured class
+	 */
+	void updatePretenuredClasses(MM_EnvironmentBase *env, uintptr_t threshold);
+
+	/**
+	 * @return the entries of the table (represented as an array), for reporting
+	 */
+	Entry *getEntries() { return _entries; }
+	/**
+	 * @return number of entries in the table
+	 */
+	uintptr_t getEntryCount() { return tableSize; }
+	/**
+	 * @return number of classes currently pretenured
+	 */
+	uintptr_t getPretenuredClassCount() { return _pretenuredClassCount; }
+	/**
+	 * @return number of samples dropped during the last scavenge cycle because the table had no entry for their class
+	 */
+	uintptr_t getLookupFailureCount() { return _lastLookupFailures; }
+
+	MM_PretenureClassTable(MM_EnvironmentBase *env)
+		: MM_BaseVirtual()
+		, _pretenuredClassCount(0)
+		, _lookupFailures(0)
+		, _lastLookupFailures(0)
+		, _entries(NULL)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* PRETENURECLASSTABLE_HPP_ */
@@ -705,9 +705,28 @@ MM_RootScanner::scanStringTable(MM_EnvironmentBase *env)
 		}
 	}
 
+	/* The lookup cache and the deduplication structures are weak, just like the cache above */
+	scanStringCacheSlots(env, stringTable->getLookupCache(), stringTable->getLookupCacheSize());
+	scanStringCacheSlots(env, stringTable->getDeduplicationTable(), stringTable->getDeduplicationTableSize());
+	scanStringCacheSlots(env, stringTable->getDeduplicationCandidates(), stringTable->getDeduplicationCandidateCount());
+
 	reportScanningEnded(RootScannerEntity_StringTable);
 }
 
+void
+MM_RootScanner::scanStringCacheSlots(MM_EnvironmentBase *env, j9object_t *slots, uintptr_t slotCount)
+{
+	const uintptr_t slotsPerWorkUnit = 16 * 1024;
+	for (uintptr_t start = 0; start < slotCount; start += slotsPerWorkUnit) {
+		if (_singleThread || J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+			uintptr_t end = OMR_MIN(start + slotsPerWorkUnit, slotCount);
+			for (uintptr_t slotIndex = start; slotIndex < end; slotIndex++) {
+				doStringCacheTableSlot(&slots[slotIndex]);
+			}
+		}
+	}
+}
+
 /**
  * Scan the weak reference list.
  * @note Extra locking for NHRTs can be omitted, because it is impossible for
@@ -136,6 +136,14 @@ private:
 	 */
 	void scanClassloader(MM_EnvironmentBase *env, J9ClassLoader *classLoader);
 
+	/**
+	 * Scan an array of string cache slots, split into work units.
+	 * @param env thread GC environment
+	 * @param slots first slot of the array, NULL if the cache is disabled
+	 * @param slotCount number of slots in the array
+	 */
+	void scanStringCacheSlots(MM_EnvironmentBase *env, j9object_t *slots, uintptr_t slotCount);
+
 protected:
 	/* Family of yielding methods to be overridden by incremental scanners such
 	 * as the RealtimeRootScanner. The default implementations of these do
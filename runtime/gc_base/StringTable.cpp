@@ -27,6 +27,7 @@
 #include "j9consts.h"
 #include "objhelp.h"
 
+#include "AtomicOperations.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensions.hpp"
 #include "VMHelpers.hpp"
@@ -67,7 +68,8 @@ MM_StringTable::initialize(MM_EnvironmentBase *env)
 	J9JavaVM *javaVM = (J9JavaVM*)env->getOmrVM()->_language_vm;
 	PORT_ACCESS_FROM_ENVIRONMENT(env);
 	U_32 initialSize = 128;
-	U_32 listToTreeThreshold = MM_GCExtensions::getExtensions(env)->_stringTableListToTreeThreshold;
+	MM_GCExtensions *extensions = MM_GCExtensions::getExtensions(env);
+	U_32 listToTreeThreshold = extensions->_stringTableListToTreeThreshold;
 
 	_table = (J9HashTable **)j9mem_allocate_memory(sizeof(J9HashTable *) * _tableCount, OMRMEM_CATEGORY_MM);
 	if (NULL == _table) {
@@ -93,6 +95,40 @@ MM_StringTable::initialize(MM_EnvironmentBase *env)
 
 	memset(_cache, 0, sizeof(_cache));
 
+	_javaVM = javaVM;
+
+	UDATA lookupCacheSetCount = extensions->_stringTableLookupCacheSize / lookupCacheWays;
+	if (0 != lookupCacheSetCount) {
+		/* round the number of sets down to a power of two so that the set is selected by masking the hash */
+		UDATA setCount = 1;
+		while ((setCount << 1) <= lookupCacheSetCount) {
+			setCount <<= 1;
+		}
+		_lookupCache = (j9object_t *)j9mem_allocate_memory(sizeof(j9object_t) * setCount * lookupCacheWays, OMRMEM_CATEGORY_MM);
+		if (NULL == _lookupCache) {
+			return false;
+		}
+		memset(_lookupCache, 0, sizeof(j9object_t) * setCount * lookupCacheWays);
+		_lookupCacheSetMask = setCount - 1;
+	}
+
+#if (JAVA_SPEC_VERSION >= 11) && defined(J9VM_GC_FINALIZATION)
+	/* Candidates are found by the scavenger, and the GC must be able to clear them since they are not roots */
+	if (extensions->_stringDeduplication && extensions->scavengerEnabled && extensions->collectStringConstants) {
+		_deduplicationTable = (j9object_t *)j9mem_allocate_memory(sizeof(j9object_t) * deduplicationTableSize, OMRMEM_CATEGORY_MM);
+		if (NULL == _deduplicationTable) {
+			return false;
+		}
+		memset(_deduplicationTable, 0, sizeof(j9object_t) * deduplicationTableSize);
+
+		_deduplicationCandidates = (j9object_t *)j9mem_allocate_memory(sizeof(j9object_t) * deduplicationCandidateCapacity, OMRMEM_CATEGORY_MM);
+		if (NULL == _deduplicationCandidates) {
+			return false;
+		}
+		memset(_deduplicationCandidates, 0, sizeof(j9object_t) * deduplicationCandidateCapacity);
+	}
+#endif /* (JAVA_SPEC_VERSION >= 11) && defined(J9VM_GC_FINALIZATION) */
+
 	return true;
 }
 
@@ -123,6 +159,21 @@ MM_StringTable::tearDown(MM_EnvironmentBase *env)
 		j9mem_free_memory(_mutex);
 		_mutex = NULL;
 	}
+
+	if (NULL != _lookupCache) {
+		j9mem_free_memory(_lookupCache);
+		_lookupCache = NULL;
+	}
+
+	if (NULL != _deduplicationTable) {
+		j9mem_free_memory(_deduplicationTable);
+		_deduplicationTable = NULL;
+	}
+
+	if (NULL != _deduplicationCandidates) {
+		j9mem_free_memory(_deduplicationCandidates);
+		_deduplicationCandidates = NULL;
+	}
 }
 
 
@@ -178,6 +229,59 @@ MM_StringTable::hashAtPut(UDATA tableIndex, j9object_t string)
 }
 
 
+j9object_t
+MM_StringTable::lookupCacheAt(UDATA hash, j9object_t string)
+{
+	if (NULL != _lookupCache) {
+		j9object_t *set = &_lookupCache[(hash & _lookupCacheSetMask) * lookupCacheWays];
+		for (UDATA way = 0; way < lookupCacheWays; way++) {
+			/* Entries are only ever replaced by other interned strings, or cleared by the GC while no
+			 * thread holds VM access, so any entry read here is a valid String.
+			 */
+			j9object_t candidate = *(j9object_t volatile *)&set[way];
+			if ((NULL != candidate) && stringHashEqualFn(&candidate, &string, _javaVM)) {
+				return candidate;
+			}
+		}
+	}
+	return NULL;
+}
+
+j9object_t
+MM_StringTable::lookupCacheAtUTF8(U_8 *utf8Data, UDATA utf8Length, U_32 hash)
+{
+	stringTableUTF8Query query;
+	void *ptr;
+
+	query.utf8Data = utf8Data;
+	query.utf8Length = utf8Length;
+	query.hash = hash;
+	ptr = &query;
+	ptr = (void *) ((UDATA) ptr | TYPE_UTF8); /* Least significant bit indicates that this is a pointer to a stringTableUTF8Query */
+	return lookupCacheAt(hash, (j9object_t)ptr);
+}
+
+void
+MM_StringTable::lookupCacheAtPut(UDATA hash, j9object_t string)
+{
+	if (NULL != _lookupCache) {
+		j9object_t *set = &_lookupCache[(hash & _lookupCacheSetMask) * lookupCacheWays];
+		/* hash bits above the set index pick the entry to replace when the set is full */
+		UDATA victim = (hash >> 16) & (lookupCacheWays - 1);
+		for (UDATA way = 0; way < lookupCacheWays; way++) {
+			j9object_t entry = set[way];
+			if (string == entry) {
+				return;
+			}
+			if (NULL == entry) {
+				victim = way;
+				break;
+			}
+		}
+		set[victim] = string;
+	}
+}
+
 j9object_t
 MM_StringTable::addStringToInternTable(J9VMThread *vmThread, j9object_t string)
 {
@@ -198,11 +302,107 @@ MM_StringTable::addStringToInternTable(J9VMThread *vmThread, j9object_t string)
 
 	if (NULL == internedString) {
 		Trc_MM_StringTable_stringAddToInternTableFailed(vmThread, string, _table, tableIndex);
+	} else {
+		lookupCacheAtPut(hash, internedString);
 	}
 
 	return internedString;
 }
 
+void
+MM_StringTable::addDeduplicationCandidate(j9object_t string)
+{
+	UDATA index = _deduplicationCandidateCount;
+	while (index < deduplicationCandidateCapacity) {
+		UDATA previousIndex = MM_AtomicOperations::lockCompareExchange(&_deduplicationCandidateCount, index, index + 1);
+		if (previousIndex == index) {
+			_deduplicationCandidates[index] = string;
+			break;
+		}
+		index = previousIndex;
+	}
+}
+
+void
+MM_StringTable::discardDeduplicationCandidates(UDATA candidateCount)
+{
+	if (candidateCount < _deduplicationCandidateCount) {
+		_deduplicationCandidateCount = candidateCount;
+	}
+}
+
+void
+MM_StringTable::deduplicateCandidates(J9VMThread *vmThread)
+{
+#if JAVA_SPEC_VERSION >= 11
+	/* An abandoned finalizer worker may still be running, only one thread drains the candidates */
+	if ((0 != _deduplicationCandidateCount) && (0 == MM_AtomicOperations::lockCompareExchange(&_deduplicationActive, 0, 1))) {
+		J9InternalVMFunctions *vmFuncs = _javaVM->internalVMFunctions;
+		UDATA index = 0;
+
+		/* a GC may add candidates, or discard the ones it added, whenever VM access is released */
+		while (index < _deduplicationCandidateCount) {
+			j9object_t string = _deduplicationCandidates[index];
+			_deduplicationCandidates[index] = NULL;
+			index += 1;
+
+			/* the slot has been cleared by the GC if the candidate died */
+			if (NULL != string) {
+				deduplicate(vmThread, string);
+			}
+
+			if (0 == (index % deduplicationCandidatesPerVMAccess)) {
+				vmFuncs->internalReleaseVMAccess(vmThread);
+				vmFuncs->internalEnterVMFromJNI(vmThread);
+			}
+		}
+
+		/* no candidate can be added while VM access is held */
+		_deduplicationCandidateCount = 0;
+		MM_AtomicOperations::storeSync();
+		_deduplicationActive = 0;
+	}
+#endif /* JAVA_SPEC_VERSION >= 11 */
+}
+
+#if JAVA_SPEC_VERSION >= 11
+void
+MM_StringTable::deduplicate(J9VMThread *vmThread, j9object_t string)
+{
+	j9object_t value = J9VMJAVALANGSTRING_VALUE(vmThread, string);
+	if (NULL != value) {
+		UDATA hash = stringHashFn(&string, _javaVM);
+		j9object_t *set = &_deduplicationTable[(hash & ((deduplicationTableSize / lookupCacheWays) - 1)) * lookupCacheWays];
+		bool compressed = IS_STRING_COMPRESSED_VM(_javaVM, string);
+		UDATA victim = lookupCacheWays;
+
+		for (UDATA way = 0; way < lookupCacheWays; way++) {
+			j9object_t entry = set[way];
+			if (NULL == entry) {
+				/* the GC leaves holes when it clears dead entries, so keep looking for an equal string */
+				if (lookupCacheWays == victim) {
+					victim = way;
+				}
+			} else if (string == entry) {
+				return;
+			} else if ((compressed == IS_STRING_COMPRESSED_VM(_javaVM, entry)) && stringHashEqualFn(&entry, &string, _javaVM)) {
+				/* equal contents and coder, so the value arrays are interchangeable */
+				j9object_t entryValue = J9VMJAVALANGSTRING_VALUE(vmThread, entry);
+				if (entryValue != value) {
+					J9VMJAVALANGSTRING_SET_VALUE(vmThread, string, entryValue);
+				}
+				return;
+			}
+		}
+
+		if (lookupCacheWays == victim) {
+			victim = (hash >> 16) & (lookupCacheWays - 1);
+		}
+		set[victim] = string;
+	}
+}
+#endif /* JAVA_SPEC_VERSION >= 11 */
+
 
 static IDATA
 stringComparatorFn(struct J9AVLTree *tree, struct J9AVLTreeNode *leftNode, struct J9AVLTreeNode *rightNode)
@@ -643,9 +843,16 @@ j9gc_createJavaLangString(J9VMThread *vmThread, U_8 *data, UDATA length, UDATA s
 
 		UDATA tableIndex = stringTable->getTableIndex(hash);
 
-		stringTable->lockTable(tableIndex);
-		result = stringTable->hashAtUTF8(tableIndex, data, length, (U_32)hash);
-		stringTable->unlockTable(tableIndex);
+		result = stringTable->lookupCacheAtUTF8(data, length, (U_32)hash);
+		if (NULL == result) {
+			stringTable->lockTable(tableIndex);
+			result = stringTable->hashAtUTF8(tableIndex, data, length, (U_32)hash);
+			stringTable->unlockTable(tableIndex);
+
+			if (NULL != result) {
+				stringTable->lookupCacheAtPut((U_32)hash, result);
+			}
+		}
 	}
 
 	if (NULL == result) {
@@ -990,9 +1197,16 @@ j9gc_internString(J9VMThread *vmThread, j9object_t sourceString)
 
 	UDATA tableIndex = stringTable->getTableIndex(hash);
 
-	stringTable->lockTable(tableIndex);
-	internedString = stringTable->hashAt(tableIndex, sourceString);
-	stringTable->unlockTable(tableIndex);
+	internedString = stringTable->lookupCacheAt(hash, sourceString);
+	if (NULL == internedString) {
+		stringTable->lockTable(tableIndex);
+		internedString = stringTable->hashAt(tableIndex, sourceString);
+		stringTable->unlockTable(tableIndex);
+
+		if (NULL != internedString) {
+			stringTable->lookupCacheAtPut(hash, internedString);
+		}
+	}
 	
 	if (NULL == internedString) {
 		j9object_t newString = NULL;
@@ -43,12 +43,35 @@ private:
 
     ddr_constant(cacheSize, 511);
 	j9object_t _cache[cacheSize];   /**< interned string table cash */
+
+	static const UDATA lookupCacheWays = 4; /**< associativity of the lookup cache and the deduplication table */
+	static const UDATA deduplicationTableSize = 64 * 1024; /**< number of entries in the deduplication table */
+	static const UDATA deduplicationCandidateCapacity = 64 * 1024; /**< maximum number of strings waiting to be deduplicated */
+	static const UDATA deduplicationCandidatesPerVMAccess = 256; /**< number of candidates deduplicated between checks for a pending GC */
+
+	J9JavaVM *_javaVM;              /**< the VM, passed to the string hash and compare functions */
+	j9object_t *_lookupCache;       /**< set associative cache of interned strings which is searched without locking (NULL if disabled) */
+	UDATA _lookupCacheSetMask;      /**< number of sets in the lookup cache minus one */
+	j9object_t *_deduplicationTable; /**< set associative table of the strings whose value arrays are shared by equal strings (NULL if disabled) */
+	j9object_t *_deduplicationCandidates; /**< long lived strings waiting to be deduplicated, reported by the scavenger */
+	volatile UDATA _deduplicationCandidateCount; /**< number of used entries in _deduplicationCandidates */
+	volatile UDATA _deduplicationActive; /**< non-zero while a thread is deduplicating the candidates */
 public:
 
 private:
 	bool initialize(MM_EnvironmentBase *env);
 	void tearDown(MM_EnvironmentBase *env);
 
+#if JAVA_SPEC_VERSION >= 11
+	/**
+	 * Share the value array of an equal string recorded in the deduplication table, or record
+	 * the string in the table if there is none.
+	 * @param vmThread the current thread, which holds VM access
+	 * @param string the string to deduplicate
+	 */
+	void deduplicate(J9VMThread *vmThread, j9object_t string);
+#endif /* JAVA_SPEC_VERSION >= 11 */
+
 public:
 
 	/**
@@ -65,6 +88,37 @@ public:
 	 */
 	j9object_t *getStringInternCache(UDATA hash) { return &_cache[hash % cacheSize]; }
 
+	/**
+	 * The lookup cache, the deduplication table and the deduplication candidates are weak. The GC
+	 * processes their slots the same way as the slots of the interned string cache.
+	 * @return the address of the lookup cache (represented as an array), NULL if it is disabled
+	 */
+	j9object_t *getLookupCache() { return _lookupCache; }
+	/**
+	 * @return number of entries in the lookup cache
+	 */
+	UDATA getLookupCacheSize() { return (NULL == _lookupCache) ? 0 : ((_lookupCacheSetMask + 1) * lookupCacheWays); }
+	/**
+	 * @return the address of the deduplication table (represented as an array), NULL if deduplication is disabled
+	 */
+	j9object_t *getDeduplicationTable() { return _deduplicationTable; }
+	/**
+	 * @return number of entries in the deduplication table
+	 */
+	UDATA getDeduplicationTableSize() { return (NULL == _deduplicationTable) ? 0 : deduplicationTableSize; }
+	/**
+	 * @return the address of the deduplication candidates (represented as an array), NULL if deduplication is disabled
+	 */
+	j9object_t *getDeduplicationCandidates() { return _deduplicationCandidates; }
+	/**
+	 * @return number of deduplication candidates
+	 */
+	UDATA getDeduplicationCandidateCount() { return _deduplicationCandidateCount; }
+	/**
+	 * @return true if deduplication is enabled
+	 */
+	bool isDeduplicationEnabled() { return NULL != _deduplicationCandidates; }
+
 	/**
 	 * @return hash sub-table count
 	 */
@@ -105,6 +159,47 @@ public:
 	 */
 	j9object_t hashAtPut(UDATA tableIndex, j9object_t string);
 
+	/**
+	 * Find a string in the lookup cache. No lock is required, but the caller must hold VM access.
+	 * @param hash hash value of the string
+	 * @param string pointer to a String object or pointer to a stringTableUTF8Query, as for hashAt
+	 * @return pointer to a live interned String object or NULL if it is not cached
+	 */
+	j9object_t lookupCacheAt(UDATA hash, j9object_t string);
+	/**
+	 * wrapper function to allow user to look up UTF8 strings in the lookup cache
+	 * @param utf8Data pointer to UTF8 string data
+	 * @para utf8Length length of the string
+	 * @param hash hash value of the string
+	 */
+	j9object_t lookupCacheAtUTF8(U_8 *utf8Data, UDATA utf8Length, U_32 hash);
+	/**
+	 * Add an interned string to the lookup cache, replacing an entry of the same set if it is full.
+	 * @param hash hash value of the string
+	 * @param string pointer to an interned String object
+	 */
+	void lookupCacheAtPut(UDATA hash, j9object_t string);
+
+	/**
+	 * Record a long lived string to be deduplicated. Called by the GC; the candidate is dropped if
+	 * the buffer is full.
+	 * @param string pointer to a String object which will not move until the next global GC
+	 */
+	void addDeduplicationCandidate(j9object_t string);
+	/**
+	 * Drop the candidates recorded after the first candidateCount ones, e.g. when the
+	 * scavenge which found them backs out.
+	 * @param candidateCount number of candidates to keep
+	 */
+	void discardDeduplicationCandidates(UDATA candidateCount);
+	/**
+	 * Share the value array of every candidate with an equal string of the deduplication table,
+	 * or make the candidate the string other strings will share with. The current thread must
+	 * hold VM access, which is released periodically to let a pending GC proceed.
+	 * @param vmThread pointer to J9VMThread struct
+	 */
+	void deduplicateCandidates(J9VMThread *vmThread);
+
 	/*
 	 * Check if string is already in the string table and add if not added
 	 * @param vmThread pointer to J9VMThread struct
@@ -136,7 +231,14 @@ public:
 		MM_BaseVirtual(),
 		_tableCount(tableCount),
 		_table(NULL),
-		_mutex(NULL)
+		_mutex(NULL),
+		_javaVM(NULL),
+		_lookupCache(NULL),
+		_lookupCacheSetMask(0),
+		_deduplicationTable(NULL),
+		_deduplicationCandidates(NULL),
+		_deduplicationCandidateCount(0),
+		_deduplicationActive(0)
 	{
 		_typeId = __FUNCTION__;
 	}
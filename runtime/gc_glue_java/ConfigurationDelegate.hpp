@@ -44,6 +44,7 @@
 #include "HeapRegionIterator.hpp"
 #include "ObjectAccessBarrier.hpp"
 #include "ObjectAllocationInterface.hpp"
+#include "PretenureClassTable.hpp"
 #include "StringTable.hpp"
 
 class MM_ConfigurationDelegate
@@ -158,6 +159,11 @@ public:
 			extensions->stringTable->kill(env);
 			extensions->stringTable = NULL;
 		}
+
+		if (NULL != extensions->pretenureClassTable) {
+			extensions->pretenureClassTable->kill(env);
+			extensions->pretenureClassTable = NULL;
+		}
 	}
 
 	OMR_SizeClasses *getSegregatedSizeClasses(MM_EnvironmentBase *env)
@@ -30,6 +30,7 @@
 #include "OwnableSynchronizerObjectBufferRealtime.hpp"
 #include "OwnableSynchronizerObjectBufferStandard.hpp"
 #include "OwnableSynchronizerObjectBufferVLHGC.hpp"
+#include "PretenureClassTable.hpp"
 #include "ContinuationObjectBufferRealtime.hpp"
 #include "ContinuationObjectBufferStandard.hpp"
 #include "ContinuationObjectBufferVLHGC.hpp"
@@ -163,6 +164,11 @@ MM_EnvironmentDelegate::flushNonAllocationCaches()
 
 	_gcEnv._ownableSynchronizerObjectBuffer->flush(_env);
 	_gcEnv._continuationObjectBuffer->flush(_env);
+
+	MM_PretenureClassTable *pretenureClassTable = MM_GCExtensions::getExtensions(_env)->getPretenureClassTable();
+	if (NULL != pretenureClassTable) {
+		pretenureClassTable->flushAllocationSamples(_env);
+	}
 }
 
 void
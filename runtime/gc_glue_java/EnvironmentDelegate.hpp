@@ -40,6 +40,15 @@ typedef struct GCmovedObjectHashCode {
 	bool hasBeenHashed;
 } GCmovedObjectHashCode;
 
+/* Number of classes whose pretenuring allocation samples a thread caches, a power of two */
+#define GC_PRETENURE_ALLOCATION_SAMPLE_SLOTS 8
+
+typedef struct GCpretenureAllocationSample {
+	J9Class *clazz;
+	uintptr_t samples;
+	uintptr_t bytes;
+} GCpretenureAllocationSample;
+
 class MM_EnvironmentBase;
 class MM_OwnableSynchronizerObjectBuffer;
 class MM_ContinuationObjectBuffer;
@@ -68,6 +77,8 @@ public:
 #if defined(J9VM_ENV_DATA64)
 	bool _shouldFixupDataAddrForContiguous; /**< Boolean to check if dataAddr fixup is needed on contiguous indexable object movement */
 #endif /* defined(J9VM_ENV_DATA64) */
+	uintptr_t _pretenureSampleCountdown; /**< Number of objects the thread copies to tenure before it samples one for pretenuring */
+	GCpretenureAllocationSample _pretenureAllocationSamples[GC_PRETENURE_ALLOCATION_SAMPLE_SLOTS]; /**< Pretenuring allocation samples of the thread not yet merged into the MM_PretenureClassTable */
 
 	/* Function members */
 private:
@@ -81,7 +92,10 @@ public:
 #if defined(J9VM_ENV_DATA64)
 		,_shouldFixupDataAddrForContiguous(false)
 #endif /* defined(J9VM_ENV_DATA64) */
-	{}
+		,_pretenureSampleCountdown(0)
+	{
+		memset(_pretenureAllocationSamples, 0, sizeof(_pretenureAllocationSamples));
+	}
 };
 
 class MM_EnvironmentDelegate
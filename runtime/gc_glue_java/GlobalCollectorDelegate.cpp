@@ -51,6 +51,7 @@
 #include "ObjectModel.hpp"
 #include "ParallelGlobalGC.hpp"
 #include "ParallelHeapWalker.hpp"
+#include "PretenureClassTable.hpp"
 #if defined(OMR_ENV_DATA64) && defined(OMR_GC_FULL_POINTERS)
 #include "ReadBarrierVerifier.hpp"
 #endif /* defined(OMR_ENV_DATA64) && defined(OMR_GC_FULL_POINTERS) */
@@ -457,6 +458,12 @@ MM_GlobalCollectorDelegate::unloadDeadClassLoaders(MM_EnvironmentBase *env)
 	J9ClassLoader *classLoadersUnloadedList = _extensions->classLoaderManager->identifyClassLoadersToUnload(env, _markingScheme->getMarkMap(), classUnloadStats);
 	_extensions->classLoaderManager->cleanUpClassLoadersStart(env, classLoadersUnloadedList, _markingScheme->getMarkMap(), classUnloadStats);
 
+	MM_PretenureClassTable *pretenureClassTable = _extensions->getPretenureClassTable();
+	if ((NULL != pretenureClassTable) && ((0 != classUnloadStats->_classesUnloadedCount) || (0 != classUnloadStats->_anonymousClassesUnloadedCount))) {
+		/* the table refers to classes by address; the dying classes are flagged but not freed yet */
+		pretenureClassTable->removeDyingClasses(env);
+	}
+
 	classUnloadStats->_endSetupTime = j9time_hires_clock();
 	classUnloadStats->_startScanTime = classUnloadStats->_endSetupTime;
 
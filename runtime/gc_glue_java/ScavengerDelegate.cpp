@@ -96,6 +96,7 @@
 #include "ParallelHeapWalker.hpp"
 #include "ParallelSweepScheme.hpp"
 #include "PointerArrayObjectScanner.hpp"
+#include "PretenureClassTable.hpp"
 #if defined(OMR_ENV_DATA64) && defined(OMR_GC_FULL_POINTERS)
 #include "ReadBarrierVerifier.hpp"
 #endif /* defined(OMR_ENV_DATA64) && defined(OMR_GC_FULL_POINTERS) */
@@ -160,6 +161,23 @@ MM_ScavengerDelegate::tearDown(MM_EnvironmentBase *env)
 {
 }
 
+void
+MM_ScavengerDelegate::private_samplePromotedObject(MM_EnvironmentStandard *env, omrobjectptr_t objectPtr, J9Class *clazzPtr)
+{
+	/* objects rescanned from the remembered set were tenured by an earlier scavenge */
+	if (!_extensions->objectModel.isRemembered(objectPtr)) {
+		const uintptr_t sampleInterval = 16;
+		GC_Environment *gcEnv = env->getGCEnvironment();
+		if (0 == gcEnv->_pretenureSampleCountdown) {
+			gcEnv->_pretenureSampleCountdown = sampleInterval - 1;
+			uintptr_t objectSize = _extensions->objectModel.getConsumedSizeInBytesWithHeader(objectPtr);
+			_extensions->pretenureClassTable->recordPromotion(clazzPtr, objectSize * sampleInterval);
+		} else {
+			gcEnv->_pretenureSampleCountdown -= 1;
+		}
+	}
+}
+
 void
 MM_ScavengerDelegate::mainSetupForGC(MM_EnvironmentBase * envBase)
 {
@@ -194,6 +212,16 @@ MM_ScavengerDelegate::mainSetupForGC(MM_EnvironmentBase * envBase)
 	_shouldScavengeContinuationObjects = false;
 	_shouldIterateContinuationObjects = false;
 
+	/* Strings tenured or remembered in this scavenge are long lived, record them for deduplication.
+	 * Concurrent scavenger scans objects while mutators run, so it does not record any.
+	 */
+	MM_StringTable *stringTable = _extensions->getStringTable();
+	_deduplicationStringClass = NULL;
+	if (stringTable->isDeduplicationEnabled() && !_extensions->isConcurrentScavengerEnabled()) {
+		_deduplicationStringClass = J9VMJAVALANGSTRING_OR_NULL(_javaVM);
+		_deduplicationCandidatesAtStart = stringTable->getDeduplicationCandidateCount();
+	}
+
 	/* Sort all hot fields for all classes if scavenger dynamicBreadthFirstScanOrdering is enabled */
 	if (MM_GCExtensions::OMR_GC_SCAVENGER_SCANORDERING_DYNAMIC_BREADTH_FIRST == _extensions->scavengerScanOrdering) {
 		MM_HotFieldUtil::sortAllHotFieldData(_javaVM, _extensions->incrementScavengerStats._gcCount);
@@ -223,6 +251,11 @@ MM_ScavengerDelegate::reportScavengeEnd(MM_EnvironmentBase * envBase, bool scave
 		_extensions->scavengerJavaStats._ownableSynchronizerTotalSurvived = _extensions->scavengerJavaStats._ownableSynchronizerCandidates;
 
 		_extensions->scavengerJavaStats._ownableSynchronizerNurserySurvived = _extensions->scavengerJavaStats._ownableSynchronizerCandidates;
+
+		/* the tenured copies recorded as deduplication candidates are abandoned by the backout */
+		if (NULL != _deduplicationStringClass) {
+			_extensions->getStringTable()->discardDeduplicationCandidates(_deduplicationCandidatesAtStart);
+		}
 	}
 }
 
@@ -282,6 +315,21 @@ MM_ScavengerDelegate::mainThreadGarbageCollect_scavengeSuccess(MM_EnvironmentBas
 	if (!_extensions->isConcurrentScavengerEnabled()) {
 		_extensions->updateIdentityHashDataForSaltIndex(J9GC_HASH_SALT_NURSERY_INDEX);
 	}
+
+	MM_PretenureClassTable *pretenureClassTable = _extensions->getPretenureClassTable();
+	if (NULL != pretenureClassTable) {
+		pretenureClassTable->updatePretenuredClasses(envBase, _extensions->_pretenureThreshold);
+	}
+
+#if defined(J9VM_GC_FINALIZATION)
+	/* Deduplication of the recorded Strings is done by the finalizer */
+	if ((NULL != _deduplicationStringClass) && (_deduplicationCandidatesAtStart != _extensions->getStringTable()->getDeduplicationCandidateCount())) {
+		omrthread_monitor_enter(_javaVM->finalizeMainMonitor);
+		_javaVM->finalizeMainFlags |= J9_FINALIZE_FLAGS_MAIN_WAKE_UP;
+		omrthread_monitor_notify_all(_javaVM->finalizeMainMonitor);
+		omrthread_monitor_exit(_javaVM->finalizeMainMonitor);
+	}
+#endif /* J9VM_GC_FINALIZATION */
 }
 
 /**
@@ -433,6 +481,15 @@ MM_ScavengerDelegate::getObjectScanner(MM_EnvironmentStandard *env, omrobjectptr
 	case GC_ObjectModel::SCAN_MIXED_OBJECT:
 	case GC_ObjectModel::SCAN_CLASS_OBJECT:
 	case GC_ObjectModel::SCAN_CLASSLOADER_OBJECT:
+		/* both only look at objects copied to tenure, so spare the check when neither is enabled */
+		if (((NULL != _deduplicationStringClass) || (NULL != _extensions->pretenureClassTable)) && !_extensions->scavenger->isObjectInNewSpace(objectPtr)) {
+			if (clazzPtr == _deduplicationStringClass) {
+				_extensions->getStringTable()->addDeduplicationCandidate(objectPtr);
+			}
+			if ((NULL != _extensions->pretenureClassTable) && (SCAN_REASON_SCAVENGE == reason)) {
+				private_samplePromotedObject(env, objectPtr, clazzPtr);
+			}
+		}
 		objectScanner = GC_MixedObjectScanner::newInstance(env, objectPtr, allocSpace, flags);
 		break;
 	case GC_ObjectModel::SCAN_REFERENCE_MIXED_OBJECT:
@@ -941,6 +998,8 @@ MM_ScavengerDelegate::MM_ScavengerDelegate(MM_EnvironmentBase* env)
 #if defined(J9VM_GC_FINALIZATION)
 	, _finalizationRequired(false)
 #endif /* J9VM_GC_FINALIZATION */
+	, _deduplicationStringClass(NULL)
+	, _deduplicationCandidatesAtStart(0)
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	, _flushCachesAsyncCallbackKey(-1)
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
@@ -80,6 +80,8 @@ private:
 #if defined(J9VM_GC_FINALIZATION)
 	bool _finalizationRequired; /**< Scavenger variable used to determine if finalization should be triggered */
 #endif /* J9VM_GC_FINALIZATION */
+	J9Class *_deduplicationStringClass; /**< java/lang/String if long lived Strings are recorded for deduplication in this scavenge, NULL otherwise */
+	uintptr_t _deduplicationCandidatesAtStart; /**< number of deduplication candidates before this scavenge, restored if the scavenge is backed out */
 
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	IDATA _flushCachesAsyncCallbackKey;
@@ -102,6 +104,14 @@ private:
 	void private_addOwnableSynchronizerObjectInList(MM_EnvironmentStandard *env, omrobjectptr_t object);
 	void private_setupForOwnableSynchronizerProcessing(MM_EnvironmentStandard *env);
 
+	/**
+	 * Sample an object which was copied to tenure for the survival rate estimate of its class.
+	 * @param env the current GC thread
+	 * @param objectPtr the tenured copy of the object
+	 * @param clazzPtr the class of the object
+	 */
+	void private_samplePromotedObject(MM_EnvironmentStandard *env, omrobjectptr_t objectPtr, J9Class *clazzPtr);
+
 	/*
 	 * Scavenger Collector, Private
 	 */
@@ -405,23 +405,28 @@ public:
 		}
 
 		/* Initialize the object */
+		uintptr_t headerFlags = 0;
+		if (J9CLASS_IS_ENSUREHASHED(clazz)) {
+			headerFlags |= OBJECT_HEADER_HAS_BEEN_HASHED_IN_CLASS;
+		}
+		if (J9_ARE_ANY_BITS_SET(clazz->classFlags, J9ClassPretenure)) {
+			/* Instances of pretenured classes are tenured by the first scavenge they survive. The age bits of
+			 * an old object are its remembered state, so only age the object if the TLH is in the nursery.
+			 */
+			uintptr_t objectDelta = (uintptr_t)instance - (uintptr_t)currentThread->omrVMThread->heapBaseForBarrierRange0;
+			if (objectDelta >= currentThread->omrVMThread->heapSizeForBarrierRange0) {
+				headerFlags |= ((uintptr_t)OBJECT_HEADER_AGE_MAX << OBJECT_HEADER_AGE_SHIFT);
+			}
+		}
 		if (J9VMTHREAD_COMPRESS_OBJECT_REFERENCES(currentThread)) {
 			J9ObjectCompressed *objectHeader = (J9ObjectCompressed*) instance;
-			if (J9CLASS_IS_ENSUREHASHED(clazz)) {
-				objectHeader->clazz = (uint32_t)(uintptr_t)clazz | (uint32_t)OBJECT_HEADER_HAS_BEEN_HASHED_IN_CLASS;
-			} else {
-				objectHeader->clazz = (uint32_t)(uintptr_t)clazz;
-			}
+			objectHeader->clazz = (uint32_t)((uintptr_t)clazz | headerFlags);
 			if (initializeSlots) {
 				memset(objectHeader + 1, 0, dataSize);
 			}
 		} else {
 			J9ObjectFull *objectHeader = (J9ObjectFull*) instance;
-			if (J9CLASS_IS_ENSUREHASHED(clazz)) {
-				objectHeader->clazz = (uintptr_t)clazz | (uintptr_t)OBJECT_HEADER_HAS_BEEN_HASHED_IN_CLASS;
-			} else {
-				objectHeader->clazz = (uintptr_t)clazz;
-			}
+			objectHeader->clazz = (uintptr_t)clazz | headerFlags;
 			if (initializeSlots) {
 				memset(objectHeader + 1, 0, dataSize);
 			}
@@ -50,6 +50,7 @@
 #include "ObjectAllocationInterface.hpp"
 #include "ObjectModel.hpp"
 #include "ObjectMonitor.hpp"
+#include "PretenureClassTable.hpp"
 #if defined (J9VM_GC_REALTIME)
 #include "Scheduler.hpp"
 #endif /* J9VM_GC_REALTIME */
@@ -65,6 +66,45 @@ static bool traceObjectCheck(J9VMThread *vmThread, bool *shouldTriggerAllocation
 
 #define STACK_FRAMES_TO_DUMP	8
 
+#if defined(J9VM_GC_THREAD_LOCAL_HEAP)
+/**
+ * If the allocation of an object refreshed the thread local heap, sample its class for pretenuring,
+ * weighted by the size of the new TLH. A refresh is triggered by an object in proportion to its size,
+ * so the samples estimate the nursery bytes of each class, whichever path usually allocates it.
+ * @param heapBaseBeforeAllocation the base of the thread's TLH before the object was allocated
+ */
+static MMINLINE void
+samplePretenureAllocation(MM_EnvironmentBase *env, J9VMThread *vmThread, J9Class *clazz, U_8 *heapBaseBeforeAllocation)
+{
+	MM_PretenureClassTable *pretenureClassTable = MM_GCExtensions::getExtensions(env)->getPretenureClassTable();
+	J9ModronThreadLocalHeap *tlh = &vmThread->allocateThreadLocalHeap;
+	if ((NULL != pretenureClassTable) && (heapBaseBeforeAllocation != tlh->heapBase) && (NULL != tlh->heapBase)) {
+		U_8 *heapTop = (NULL != tlh->realHeapTop) ? tlh->realHeapTop : vmThread->heapTop;
+		pretenureClassTable->recordAllocationSample(env, clazz, (uintptr_t)(heapTop - tlh->heapBase));
+	}
+}
+#endif /* J9VM_GC_THREAD_LOCAL_HEAP */
+
+/**
+ * If the class of a new object is pretenured, set the object to the maximum age so that the first
+ * scavenge it survives copies it to tenure. The instance is still allocated from the TLH: allocating
+ * it in tenure instead would take every allocation of the class out of line to the locked tenure
+ * allocator, which costs more than the single copy done by the scavenger.
+ * The age bits of an old object are its remembered state, so objects allocated in tenure are left alone.
+ */
+static MMINLINE void
+agePretenuredObject(MM_EnvironmentBase *env, J9Class *clazz, J9Object *objectPtr)
+{
+	if (J9_ARE_ANY_BITS_SET(clazz->classFlags, J9ClassPretenure)) {
+		MM_GCExtensions *extensions = MM_GCExtensions::getExtensions(env);
+		if (!extensions->isOld(objectPtr)) {
+			uintptr_t objectFlags = J9GC_J9OBJECT_FLAGS_FROM_CLAZZ(objectPtr, env) & ~(uintptr_t)OBJECT_HEADER_AGE_MASK;
+			objectFlags |= ((uintptr_t)OBJECT_HEADER_AGE_MAX << OBJECT_HEADER_AGE_SHIFT);
+			extensions->objectModel.setObjectClassAndFlags(objectPtr, clazz, objectFlags);
+		}
+	}
+}
+
 /**
  * High level fast path allocate routine (used by VM and JIT) to allocate a single object.  This method does not need to be called with
  * a resolve frame as it cannot cause a GC.  If the attempt at allocation fails, the method will return null and it is the caller's 
@@ -102,6 +142,9 @@ J9AllocateObjectNoGC(J9VMThread *vmThread, J9Class *clazz, uintptr_t allocateFla
 	Assert_MM_false(allocateFlags & OMR_GC_ALLOCATE_OBJECT_NON_ZERO_TLH);
 
 	J9Object *objectPtr = NULL;
+#if defined(J9VM_GC_THREAD_LOCAL_HEAP)
+	U_8 *tlhBaseBeforeAllocation = vmThread->allocateThreadLocalHeap.heapBase;
+#endif /* J9VM_GC_THREAD_LOCAL_HEAP */
 	
 	if(!traceObjectCheck(vmThread)){
 		allocateFlags |= OMR_GC_ALLOCATE_OBJECT_NO_GC;
@@ -128,6 +171,7 @@ J9AllocateObjectNoGC(J9VMThread *vmThread, J9Class *clazz, uintptr_t allocateFla
 						J9_STORE_LOCKWORD(vmThread, lockEA, initialLockword);
 					}
 				}
+				agePretenuredObject(env, clazz, objectPtr);
 			}
 			env->_isInNoGCAllocationCall = false;
 		}
@@ -137,6 +181,12 @@ J9AllocateObjectNoGC(J9VMThread *vmThread, J9Class *clazz, uintptr_t allocateFla
 		vmThread->javaVM->internalVMFunctions->defaultValueWithUnflattenedFlattenables(vmThread, clazz, objectPtr);
 	}
 
+#if defined(J9VM_GC_THREAD_LOCAL_HEAP)
+	if (NULL != objectPtr) {
+		samplePretenureAllocation(env, vmThread, clazz, tlhBaseBeforeAllocation);
+	}
+#endif /* J9VM_GC_THREAD_LOCAL_HEAP */
+
 	return objectPtr;
 }
 
@@ -422,6 +472,9 @@ J9AllocateObject(J9VMThread *vmThread, J9Class *clazz, uintptr_t allocateFlags)
 	if (J9CLASS_IS_ENSUREHASHED(clazz)) {
 		allocateFlags |= OMR_GC_ALLOCATE_OBJECT_HASHED;
 	}
+#if defined(J9VM_GC_THREAD_LOCAL_HEAP)
+	U_8 *tlhBaseBeforeAllocation = vmThread->allocateThreadLocalHeap.heapBase;
+#endif /* J9VM_GC_THREAD_LOCAL_HEAP */
 	MM_MixedObjectAllocationModel mixedOAM(env, clazz, allocateFlags);
 	if (mixedOAM.initializeAllocateDescription(env)) {
 		objectPtr = OMR_GC_AllocateObject(vmThread->omrVMThread, &mixedOAM);
@@ -441,6 +494,7 @@ J9AllocateObject(J9VMThread *vmThread, J9Class *clazz, uintptr_t allocateFlags)
 					J9_STORE_LOCKWORD(vmThread, lockEA, initialLockword);
 				}
 			}
+			agePretenuredObject(env, clazz, objectPtr);
 		}
 	}
 
@@ -465,6 +519,10 @@ J9AllocateObject(J9VMThread *vmThread, J9Class *clazz, uintptr_t allocateFlags)
 
 	uintptr_t sizeInBytesRequired = mixedOAM.getAllocateDescription()->getBytesRequested();
 	if (NULL != objectPtr) {
+#if defined(J9VM_GC_THREAD_LOCAL_HEAP)
+		samplePretenureAllocation(env, vmThread, clazz, tlhBaseBeforeAllocation);
+#endif /* J9VM_GC_THREAD_LOCAL_HEAP */
+
 		/* The hook could release access and so the object address could change (the value is preserved). */
 		if (OMR_GC_ALLOCATE_OBJECT_INSTRUMENTABLE == (OMR_GC_ALLOCATE_OBJECT_INSTRUMENTABLE & allocateFlags)) {
 			TRIGGER_J9HOOK_VM_OBJECT_ALLOCATE_INSTRUMENTABLE(
@@ -102,6 +102,7 @@
 #include "RememberedSetSATB.hpp"
 #endif /* J9VM_GC_REALTIME */
 #include "Scavenger.hpp"
+#include "PretenureClassTable.hpp"
 #include "StringTable.hpp"
 #include "Validator.hpp"
 #if defined(OMR_GC_IDLE_HEAP_MANAGER)
@@ -511,6 +512,16 @@ j9gc_initialize_heap(J9JavaVM *vm, IDATA *memoryParameterTable, UDATA heapBytesR
 		goto error_no_memory;
 	}
 
+#if defined(J9VM_GC_MODRON_SCAVENGER)
+	/* Pretenuring is driven by the scavenger and allocates in the tenure of the generational heap */
+	if (extensions->_pretenure && extensions->scavengerEnabled) {
+		extensions->pretenureClassTable = MM_PretenureClassTable::newInstance(&env);
+		if (NULL == extensions->pretenureClassTable) {
+			goto error_no_memory;
+		}
+	}
+#endif /* J9VM_GC_MODRON_SCAVENGER */
+
 	/* Initialize statistic locks */
 	if (omrthread_monitor_init_with_name(&extensions->gcStatsMutex, 0, "MM_GCExtensions::gcStats")) {
 		vm->internalVMFunctions->setErrorJ9dll(
@@ -1115,6 +1115,14 @@ j9gc_initialize_parse_gc_colon(J9JavaVM *javaVM, char **scan_start)
 		goto _exit;
 	}
 #endif /* defined(OMR_GC_VLHGC_CONCURRENT_COPY_FORWARD) */
+	if (try_scan(scan_start, "copyForwardCommonToThreadNode")) {
+		extensions->_copyForwardCommonToThreadNode = true;
+		goto _exit;
+	}
+	if (try_scan(scan_start, "noCopyForwardCommonToThreadNode")) {
+		extensions->_copyForwardCommonToThreadNode = false;
+		goto _exit;
+	}
 #endif /* defined(J9VM_GC_VLHGC) */
 
 #if defined(J9VM_GC_MODRON_SCAVENGER) || defined(J9VM_GC_VLHGC)
@@ -1350,6 +1358,24 @@ gcParseXgcArguments(J9JavaVM *vm, char *optArg)
 			continue;
 		}
 		
+		if (try_scan(&scan_start, "parallelClassUnloadThreshold=")) {
+			if(!scan_udata_helper(vm, &scan_start, &extensions->parallelClassUnloadThreshold, "parallelClassUnloadThreshold=")) {
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			continue;
+		}
+
+		if (try_scan(&scan_start, "concurrentClassSegmentReclaim")) {
+			extensions->concurrentClassSegmentReclaim = true;
+			continue;
+		}
+
+		if (try_scan(&scan_start, "noConcurrentClassSegmentReclaim")) {
+			extensions->concurrentClassSegmentReclaim = false;
+			continue;
+		}
+
 		if (try_scan(&scan_start, "classUnloadingThreshold=")) {
 			if ( !scan_udata_helper(vm, &scan_start, &extensions->dynamicClassUnloadingThreshold, "classUnloadingThreshold=")) {
 				returnValue = JNI_EINVAL;
@@ -1386,6 +1412,46 @@ gcParseXgcArguments(J9JavaVM *vm, char *optArg)
 		}
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 
+		if (try_scan(&scan_start, "stringTableLookupCacheSize=")) {
+			if(!scan_udata_helper(vm, &scan_start, &extensions->_stringTableLookupCacheSize, "stringTableLookupCacheSize=")) {
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			continue;
+		}
+
+		if (try_scan(&scan_start, "stringDeduplication")) {
+			extensions->_stringDeduplication = true;
+			continue;
+		}
+
+		if (try_scan(&scan_start, "noStringDeduplication")) {
+			extensions->_stringDeduplication = false;
+			continue;
+		}
+
+		if (try_scan(&scan_start, "pretenureThreshold=")) {
+			if(!scan_udata_helper(vm, &scan_start, &extensions->_pretenureThreshold, "pretenureThreshold=")) {
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			if((0 == extensions->_pretenureThreshold) || (100 < extensions->_pretenureThreshold)) {
+				j9nls_printf(PORTLIB, J9NLS_ERROR, J9NLS_GC_OPTIONS_INTEGER_OUT_OF_RANGE, "pretenureThreshold=", (UDATA)1, (UDATA)100);
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			continue;
+		}
+
+		if (try_scan(&scan_start, "pretenure")) {
+			extensions->_pretenure = true;
+			continue;
+		}
+
+		if (try_scan(&scan_start, "noPretenure")) {
+			extensions->_pretenure = false;
+			continue;
+		}
 
 		if (try_scan(&scan_start, "allocationSamplingGranularity=")) {
 			if ( !scan_udata_memory_size_helper(vm, &scan_start, &extensions->oolObjectSamplingBytesGranularity, "allocationSamplingGranularity=")) {
@@ -79,6 +79,11 @@ public:
 	uintptr_t _doubleMappedArrayletsCandidates; /**< The number of double mapped arraylets that have been visited during marking */
 #endif /* J9VM_GC_ENABLE_DOUBLE_MAP */
 
+	uintptr_t _scanCachesFromLocalNode; /**< scan caches taken from the list of the thread's NUMA node (or the common list) */
+	uintptr_t _scanCachesFromRemoteNode; /**< scan caches stolen from the lists of other NUMA nodes */
+	uintptr_t _copyBytesToLocalNode; /**< bytes copied into regions of the thread's NUMA node or with no affinity (only updated at the merge point) */
+	uintptr_t _copyBytesToRemoteNode; /**< bytes copied into regions with affinity to another NUMA node (only updated at the merge point) */
+
 	uint64_t _cycleStartTime; /**< The start time of a copy forward cycle */
 
 private:
@@ -119,6 +124,11 @@ public:
 		_doubleMappedArrayletsCleared = 0;
 		_doubleMappedArrayletsCandidates = 0;
 #endif /* J9VM_GC_ENABLE_DOUBLE_MAP */
+
+		_scanCachesFromLocalNode = 0;
+		_scanCachesFromRemoteNode = 0;
+		_copyBytesToLocalNode = 0;
+		_copyBytesToRemoteNode = 0;
 	}
 	
 	/**
@@ -152,6 +162,11 @@ public:
 		_doubleMappedArrayletsCleared += stats->_doubleMappedArrayletsCleared;
 		_doubleMappedArrayletsCandidates += stats->_doubleMappedArrayletsCandidates;
 #endif /* J9VM_GC_ENABLE_DOUBLE_MAP */
+
+		_scanCachesFromLocalNode += stats->_scanCachesFromLocalNode;
+		_scanCachesFromRemoteNode += stats->_scanCachesFromRemoteNode;
+		_copyBytesToLocalNode += stats->_copyBytesToLocalNode;
+		_copyBytesToRemoteNode += stats->_copyBytesToRemoteNode;
 	}
 
 	MM_CopyForwardStats() :
@@ -177,6 +192,10 @@ public:
 		, _doubleMappedArrayletsCleared(0)
 		, _doubleMappedArrayletsCandidates(0)
 #endif /* J9VM_GC_ENABLE_DOUBLE_MAP */
+		, _scanCachesFromLocalNode(0)
+		, _scanCachesFromRemoteNode(0)
+		, _copyBytesToLocalNode(0)
+		, _copyBytesToRemoteNode(0)
 	{}
 };
 
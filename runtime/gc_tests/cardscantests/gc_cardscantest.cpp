@@ -0,0 +1,328 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "CuTest.h"
+#include "j9.h"
+
+#include "CardCleaner.hpp"
+#include "CompressedCardTable.hpp"
+
+/* 4MB worth of heap per compressed card word on 64 bit, so this covers a 32GB heap */
+#define NUMBER_OF_WORDS		((UDATA)64 * 1024)
+#define NUMBER_OF_CARDS		(NUMBER_OF_WORDS * COMPRESSED_CARDS_PER_WORD)
+#define BENCHMARK_PASSES	20
+
+extern J9PortLibrary *sharedPortLibrary;
+
+/* percentage of cards dirty for partial collect, from an idle heap to a fully dirty one */
+static const UDATA dirtyDensities[] = { 0, 1, 5, 25, 50, 100 };
+
+static const Card cleanStates[] = { CARD_CLEAN, CARD_GMP_MUST_SCAN };
+static const Card dirtyStates[] = { CARD_DIRTY, CARD_PGC_MUST_SCAN, CARD_REMEMBERED, CARD_REMEMBERED_AND_GMP_SCAN };
+
+/* fake heap address of the first card, only used to check the addresses passed to the card cleaner */
+#define HEAP_BASE	((U_8 *)((UDATA)1 << 20))
+#define CLEANED_MARK	((Card)0xA5)
+
+/**
+ * Card cleaner recording which cards it was asked to clean
+ */
+class MM_RecordingCardCleaner : public MM_CardCleaner
+{
+private:
+	Card *_cards; /**< first card of the table */
+public:
+	bool _addressMismatch; /**< true if a card was cleaned with an address range which does not match it */
+	UDATA _cleanCalls; /**< number of calls to clean() */
+
+public:
+	virtual void
+	clean(MM_EnvironmentBase *env, void *lowAddress, void *highAddress, Card *cardToClean)
+	{
+		UDATA cardIndex = (UDATA)(cardToClean - _cards);
+		if ((lowAddress != (void *)(HEAP_BASE + (cardIndex * CARD_SIZE))) || (highAddress != (void *)((U_8 *)lowAddress + CARD_SIZE))) {
+			_addressMismatch = true;
+		}
+		*cardToClean = CLEANED_MARK;
+		_cleanCalls += 1;
+	}
+
+	virtual UDATA getVMStateID() { return 0; }
+
+	MM_RecordingCardCleaner(Card *cards)
+		: MM_CardCleaner()
+		, _cards(cards)
+		, _addressMismatch(false)
+		, _cleanCalls(0)
+	{}
+};
+
+static U_32
+nextRandom(U_32 *seed)
+{
+	*seed = (*seed * 1103515245) + 12345;
+	return *seed >> 8;
+}
+
+/**
+ * Fill the card table with the given percentage of dirty cards, clustered in runs
+ * the way mutator stores to neighbouring objects dirty them.
+ */
+static void
+fillCards(Card *cards, UDATA dirtyPercent, U_32 seed)
+{
+	UDATA i = 0;
+	while (i < NUMBER_OF_CARDS) {
+		UDATA runLength = 1 + (nextRandom(&seed) % 8);
+		bool dirty = (nextRandom(&seed) % 100) < dirtyPercent;
+		for (UDATA j = 0; (j < runLength) && (i < NUMBER_OF_CARDS); j++, i++) {
+			if (dirty) {
+				cards[i] = dirtyStates[nextRandom(&seed) % (sizeof(dirtyStates) / sizeof(dirtyStates[0]))];
+			} else {
+				cards[i] = cleanStates[nextRandom(&seed) % (sizeof(cleanStates) / sizeof(cleanStates[0]))];
+			}
+		}
+	}
+}
+
+/**
+ * Reference classification of a single card
+ */
+static bool
+isDirtyForPartialCollect(Card state)
+{
+	return (CARD_CLEAN != state) && (CARD_GMP_MUST_SCAN != state);
+}
+
+/**
+ * Reference implementation, one card at a time
+ */
+static UDATA
+scalarDirtyCardMask(const Card *cards)
+{
+	UDATA dirtyMask = 0;
+	for (UDATA i = 0; i < COMPRESSED_CARDS_PER_WORD; i++) {
+		if (isDirtyForPartialCollect(cards[i])) {
+			dirtyMask |= ((UDATA)1) << i;
+		}
+	}
+	return dirtyMask;
+}
+
+/**
+ * @return a card value which is neither a clean nor a dirty state
+ */
+static Card
+unknownCardState()
+{
+	for (UDATA value = 0; value <= 0xFF; value++) {
+		bool known = false;
+		for (UDATA i = 0; i < (sizeof(cleanStates) / sizeof(cleanStates[0])); i++) {
+			known = known || (cleanStates[i] == (Card)value);
+		}
+		for (UDATA i = 0; i < (sizeof(dirtyStates) / sizeof(dirtyStates[0])); i++) {
+			known = known || (dirtyStates[i] == (Card)value);
+		}
+		if (!known && (CLEANED_MARK != (Card)value)) {
+			return (Card)value;
+		}
+	}
+	return CLEANED_MARK;
+}
+
+static Card *
+allocateCards(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	Card *cards = (Card *)j9mem_allocate_memory(NUMBER_OF_CARDS * sizeof(Card), OMRMEM_CATEGORY_MM);
+	CuAssertPtrNotNull(tc, cards);
+	return cards;
+}
+
+void
+Test_CardScan_MatchesScalarTest(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	Card *cards = allocateCards(tc);
+
+	for (UDATA d = 0; d < (sizeof(dirtyDensities) / sizeof(dirtyDensities[0])); d++) {
+		fillCards(cards, dirtyDensities[d], (U_32)d + 1);
+		for (UDATA word = 0; word < NUMBER_OF_WORDS; word++) {
+			const Card *wordCards = cards + (word * COMPRESSED_CARDS_PER_WORD);
+			if (scalarDirtyCardMask(wordCards) != MM_CompressedCardTable::dirtyCardMaskForPartialCollect(wordCards)) {
+				CuFail(tc, "dirty card mask does not match the scalar scan");
+				break;
+			}
+		}
+	}
+
+	j9mem_free_memory(cards);
+}
+
+/**
+ * Rebuild the compressed words of a range of cards, clean the cards they mark and compare the cleaned
+ * cards with the per card classification. The range starts and ends inside the table, so the words
+ * around it must be left alone, and the cards at both edges of the range and of every word are dirty.
+ */
+void
+Test_CardScan_RebuildAndCleanTest(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	Card *cards = allocateCards(tc);
+	Card *expected = allocateCards(tc);
+	UDATA *compressedCards = (UDATA *)j9mem_allocate_memory(NUMBER_OF_WORDS * sizeof(UDATA), OMRMEM_CATEGORY_MM);
+	CuAssertPtrNotNull(tc, compressedCards);
+	const UDATA sentinel = (UDATA)0x5A5A5A5A;
+	const UDATA startWord = 3;
+	const UDATA endWord = NUMBER_OF_WORDS - 5;
+
+	for (UDATA d = 0; d < (sizeof(dirtyDensities) / sizeof(dirtyDensities[0])); d++) {
+		fillCards(cards, dirtyDensities[d], (U_32)d + 1);
+		cards[startWord * COMPRESSED_CARDS_PER_WORD] = CARD_DIRTY;
+		cards[(endWord * COMPRESSED_CARDS_PER_WORD) - 1] = CARD_REMEMBERED;
+		cards[((startWord + 1) * COMPRESSED_CARDS_PER_WORD) - 1] = CARD_PGC_MUST_SCAN;
+		cards[(endWord - 1) * COMPRESSED_CARDS_PER_WORD] = CARD_REMEMBERED_AND_GMP_SCAN;
+
+		UDATA expectedCleaned = 0;
+		for (UDATA i = 0; i < NUMBER_OF_CARDS; i++) {
+			expected[i] = cards[i];
+			if ((i >= (startWord * COMPRESSED_CARDS_PER_WORD)) && (i < (endWord * COMPRESSED_CARDS_PER_WORD)) && isDirtyForPartialCollect(cards[i])) {
+				expected[i] = CLEANED_MARK;
+				expectedCleaned += 1;
+			}
+		}
+		for (UDATA word = 0; word < NUMBER_OF_WORDS; word++) {
+			compressedCards[word] = sentinel;
+		}
+
+		Card *rangeCards = cards + (startWord * COMPRESSED_CARDS_PER_WORD);
+		CuAssertTrue(tc, MM_CompressedCardTable::compressCardsForPartialCollect(rangeCards, endWord - startWord, compressedCards + startWord));
+		for (UDATA word = 0; word < NUMBER_OF_WORDS; word++) {
+			if ((word < startWord) || (word >= endWord)) {
+				CuAssertTrue(tc, sentinel == compressedCards[word]);
+			}
+		}
+
+		MM_RecordingCardCleaner cardCleaner(cards);
+		UDATA cleaned = MM_CompressedCardTable::cleanCompressedCards(NULL, &cardCleaner, compressedCards + startWord, endWord - startWord,
+				rangeCards, HEAP_BASE + (startWord * COMPRESSED_CARDS_PER_WORD * CARD_SIZE));
+		CuAssertIntEquals(tc, (int)expectedCleaned, (int)cleaned);
+		CuAssertIntEquals(tc, (int)expectedCleaned, (int)cardCleaner._cleanCalls);
+		CuAssertTrue(tc, !cardCleaner._addressMismatch);
+		if (0 != memcmp(cards, expected, NUMBER_OF_CARDS * sizeof(Card))) {
+			CuFail(tc, "cleaned cards do not match the per card classification");
+		}
+	}
+
+	j9mem_free_memory(compressedCards);
+	j9mem_free_memory(expected);
+	j9mem_free_memory(cards);
+}
+
+/**
+ * A card state the word scan does not know is classified dirty, and must be reported so the rebuild asserts
+ */
+void
+Test_CardScan_UnknownCardStateTest(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	Card *cards = allocateCards(tc);
+	UDATA compressedCards[2];
+	Card unknown = unknownCardState();
+	CuAssertTrue(tc, CLEANED_MARK != unknown);
+
+	for (UDATA d = 0; d < (sizeof(dirtyDensities) / sizeof(dirtyDensities[0])); d++) {
+		fillCards(cards, dirtyDensities[d], (U_32)d + 1);
+		CuAssertTrue(tc, MM_CompressedCardTable::compressCardsForPartialCollect(cards, 2, compressedCards));
+
+		/* first card of the first word, a card inside a vector chunk, last card of the last word */
+		const UDATA positions[] = { 0, 17, (2 * COMPRESSED_CARDS_PER_WORD) - 1 };
+		for (UDATA p = 0; p < (sizeof(positions) / sizeof(positions[0])); p++) {
+			Card saved = cards[positions[p]];
+			cards[positions[p]] = unknown;
+			CuAssertTrue(tc, !MM_CompressedCardTable::compressCardsForPartialCollect(cards, 2, compressedCards));
+			cards[positions[p]] = saved;
+		}
+	}
+
+	j9mem_free_memory(cards);
+}
+
+void
+Test_CardScan_Benchmark(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	Card *cards = allocateCards(tc);
+
+	for (UDATA d = 0; d < (sizeof(dirtyDensities) / sizeof(dirtyDensities[0])); d++) {
+		fillCards(cards, dirtyDensities[d], (U_32)d + 1);
+		/* accumulate results so the scans cannot be optimized away */
+		volatile UDATA scalarSink = 0;
+		volatile UDATA vectorSink = 0;
+
+		U_64 start = j9time_nano_time();
+		for (UDATA pass = 0; pass < BENCHMARK_PASSES; pass++) {
+			UDATA accumulator = 0;
+			for (UDATA word = 0; word < NUMBER_OF_WORDS; word++) {
+				accumulator ^= scalarDirtyCardMask(cards + (word * COMPRESSED_CARDS_PER_WORD));
+			}
+			scalarSink += accumulator;
+		}
+		U_64 scalarTime = j9time_nano_time() - start;
+
+		start = j9time_nano_time();
+		for (UDATA pass = 0; pass < BENCHMARK_PASSES; pass++) {
+			UDATA accumulator = 0;
+			for (UDATA word = 0; word < NUMBER_OF_WORDS; word++) {
+				accumulator ^= MM_CompressedCardTable::dirtyCardMaskForPartialCollect(cards + (word * COMPRESSED_CARDS_PER_WORD));
+			}
+			vectorSink += accumulator;
+		}
+		U_64 vectorTime = j9time_nano_time() - start;
+
+		CuAssertTrue(tc, scalarSink == vectorSink);
+		printf("dirty=%3zu%% scalar=%7.3f ns/card scan=%7.3f ns/card\n",
+			(size_t)dirtyDensities[d],
+			(double)scalarTime / (double)(NUMBER_OF_CARDS * BENCHMARK_PASSES),
+			(double)vectorTime / (double)(NUMBER_OF_CARDS * BENCHMARK_PASSES));
+	}
+
+	j9mem_free_memory(cards);
+}
+
+CuSuite
+*GetCardScanTestSuite()
+{
+	CuSuite *suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, Test_CardScan_MatchesScalarTest);
+	SUITE_ADD_TEST(suite, Test_CardScan_RebuildAndCleanTest);
+	SUITE_ADD_TEST(suite, Test_CardScan_UnknownCardStateTest);
+	return suite;
+}
+
+CuSuite
+*GetCardScanBenchmarkSuite()
+{
+	CuSuite *suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, Test_CardScan_Benchmark);
+	return suite;
+}
@@ -0,0 +1,348 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "CuTest.h"
+#include "j9.h"
+
+#include "PretenureClassTable.hpp"
+
+#define THRESHOLD			50
+/* a multiple of 100, so that the survival rates of the tests are exact */
+#define BYTES_PER_SAMPLE	((UDATA)100 * 1024)
+/* fake classes are spaced so that they do not overlap and hash to distinct entries */
+#define CLASS_SPACING		((UDATA)8 * J9_REQUIRED_CLASS_ALIGNMENT)
+#define CHAIN_LENGTH		12
+
+extern J9PortLibrary *sharedPortLibrary;
+
+/**
+ * Table over a caller provided array of entries, so that it can be driven without a VM.
+ */
+class MM_PretenureClassTableTester : public MM_PretenureClassTable
+{
+public:
+	using MM_PretenureClassTable::tableSize;
+	using MM_PretenureClassTable::probeLimit;
+	using MM_PretenureClassTable::minimumAllocationSamples;
+	using MM_PretenureClassTable::initialReviewInterval;
+	using MM_PretenureClassTable::maximumReviewInterval;
+	using MM_PretenureClassTable::removeDyingEntries;
+
+	/**
+	 * Record allocation samples of clazz, as a mutator evicting them from its cache would.
+	 * @param survivalPercent percentage of the sampled bytes recorded as promoted
+	 */
+	void
+	allocate(J9Class *clazz, UDATA samples, UDATA survivalPercent)
+	{
+		GCpretenureAllocationSample sample;
+		sample.clazz = clazz;
+		sample.samples = samples;
+		sample.bytes = samples * BYTES_PER_SAMPLE;
+		mergeAllocationSample(&sample);
+		if (0 != survivalPercent) {
+			recordPromotion(clazz, (samples * BYTES_PER_SAMPLE * survivalPercent) / 100);
+		}
+	}
+
+	/**
+	 * @return the entry of clazz, or NULL if it has none. Fails the test if it has several.
+	 */
+	Entry *
+	findEntry(CuTest *tc, J9Class *clazz)
+	{
+		Entry *found = NULL;
+		for (UDATA index = 0; index < tableSize; index++) {
+			if (clazz == _entries[index]._clazz) {
+				CuAssertPtrEquals_Msg(tc, "class has more than one entry", NULL, found);
+				found = &_entries[index];
+			}
+		}
+		return found;
+	}
+
+	UDATA
+	countEntries()
+	{
+		UDATA count = 0;
+		for (UDATA index = 0; index < tableSize; index++) {
+			if (NULL != _entries[index]._clazz) {
+				count += 1;
+			}
+		}
+		return count;
+	}
+
+	MM_PretenureClassTableTester(Entry *entries)
+		: MM_PretenureClassTable(NULL)
+	{
+		_entries = entries;
+		clear();
+	}
+};
+
+/**
+ * Zeroed fake classes. The classes of a slot hash to the same entry, chain position 0 first.
+ */
+class FakeClasses
+{
+	U_8 *_memory;
+	U_8 *_base;
+public:
+	J9Class *
+	get(UDATA slot, UDATA chainPosition = 0)
+	{
+		UDATA chainStride = MM_PretenureClassTableTester::tableSize * J9_REQUIRED_CLASS_ALIGNMENT;
+		return (J9Class *)(_base + (chainPosition * chainStride) + (slot * CLASS_SPACING));
+	}
+
+	bool
+	initialize()
+	{
+		PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+		UDATA chainStride = MM_PretenureClassTableTester::tableSize * J9_REQUIRED_CLASS_ALIGNMENT;
+		UDATA size = (CHAIN_LENGTH * chainStride) + J9_REQUIRED_CLASS_ALIGNMENT;
+		_memory = (U_8 *)j9mem_allocate_memory(size, OMRMEM_CATEGORY_MM);
+		if (NULL == _memory) {
+			return false;
+		}
+		memset(_memory, 0, size);
+		_base = (U_8 *)(((UDATA)_memory + J9_REQUIRED_CLASS_ALIGNMENT - 1) & ~(J9_REQUIRED_CLASS_ALIGNMENT - 1));
+		return true;
+	}
+
+	FakeClasses()
+		: _memory(NULL)
+		, _base(NULL)
+	{}
+
+	~FakeClasses()
+	{
+		PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+		j9mem_free_memory(_memory);
+	}
+};
+
+static MM_PretenureClassTable::Entry *
+allocateEntries(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	MM_PretenureClassTable::Entry *entries = (MM_PretenureClassTable::Entry *)j9mem_allocate_memory(
+			MM_PretenureClassTableTester::tableSize * sizeof(MM_PretenureClassTable::Entry), OMRMEM_CATEGORY_MM);
+	CuAssertPtrNotNull(tc, entries);
+	return entries;
+}
+
+static bool
+isPretenured(J9Class *clazz)
+{
+	return J9_ARE_ANY_BITS_SET(clazz->classFlags, J9ClassPretenure);
+}
+
+void
+Test_Pretenure_SurvivalThresholdTest(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	CuAssertTrue(tc, CLASS_SPACING >= sizeof(J9Class));
+	FakeClasses classes;
+	CuAssertTrue(tc, classes.initialize());
+	MM_PretenureClassTable::Entry *entries = allocateEntries(tc);
+	MM_PretenureClassTableTester table(entries);
+
+	J9Class *longLived = classes.get(0);
+	J9Class *shortLived = classes.get(1);
+	J9Class *atThreshold = classes.get(2);
+	J9Class *rarelyAllocated = classes.get(3);
+	UDATA enoughSamples = MM_PretenureClassTableTester::minimumAllocationSamples;
+
+	table.allocate(longLived, enoughSamples, 90);
+	table.allocate(shortLived, enoughSamples, 10);
+	table.allocate(atThreshold, enoughSamples, THRESHOLD);
+	table.allocate(rarelyAllocated, enoughSamples - 1, 100);
+	table.updatePretenuredClasses(NULL, THRESHOLD);
+
+	CuAssertTrue(tc, isPretenured(longLived));
+	CuAssertTrue(tc, table.findEntry(tc, longLived)->_newlyPretenured);
+	CuAssertIntEquals(tc, 90, (int)table.findEntry(tc, longLived)->_survivalRate);
+	CuAssertTrue(tc, !isPretenured(shortLived));
+	CuAssertIntEquals(tc, 10, (int)table.findEntry(tc, shortLived)->_survivalRate);
+	CuAssertTrue(tc, isPretenured(atThreshold));
+	/* too few samples to trust the estimate */
+	CuAssertTrue(tc, !isPretenured(rarelyAllocated));
+	CuAssertIntEquals(tc, 2, (int)table.getPretenuredClassCount());
+
+	/* the history was halved, so the rarely allocated class now has enough samples */
+	table.allocate(rarelyAllocated, (enoughSamples / 2) + 1, 100);
+	table.updatePretenuredClasses(NULL, THRESHOLD);
+	CuAssertTrue(tc, isPretenured(rarelyAllocated));
+	CuAssertTrue(tc, !table.findEntry(tc, longLived)->_newlyPretenured);
+	CuAssertIntEquals(tc, 3, (int)table.getPretenuredClassCount());
+
+	j9mem_free_memory(entries);
+}
+
+void
+Test_Pretenure_ReviewIntervalTest(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	FakeClasses classes;
+	CuAssertTrue(tc, classes.initialize());
+	MM_PretenureClassTable::Entry *entries = allocateEntries(tc);
+	MM_PretenureClassTableTester table(entries);
+
+	J9Class *clazz = classes.get(0);
+	UDATA enoughSamples = MM_PretenureClassTableTester::minimumAllocationSamples;
+	UDATA expectedInterval = MM_PretenureClassTableTester::initialReviewInterval;
+
+	/* the interval doubles every time the class qualifies again after a review, up to the maximum */
+	for (UDATA selection = 0; selection < 10; selection++) {
+		table.allocate(clazz, enoughSamples, 100);
+		table.updatePretenuredClasses(NULL, THRESHOLD);
+		CuAssertTrue(tc, isPretenured(clazz));
+		CuAssertIntEquals(tc, (int)expectedInterval, (int)table.findEntry(tc, clazz)->_reviewInterval);
+
+		for (UDATA scavenge = 1; scavenge < expectedInterval; scavenge++) {
+			/* samples of a pretenured class are discarded */
+			table.allocate(clazz, enoughSamples, 0);
+			table.updatePretenuredClasses(NULL, THRESHOLD);
+			CuAssertTrue(tc, isPretenured(clazz));
+		}
+		table.updatePretenuredClasses(NULL, THRESHOLD);
+		CuAssertTrue(tc, !isPretenured(clazz));
+		CuAssertTrue(tc, table.findEntry(tc, clazz)->_newlyReleased);
+		CuAssertIntEquals(tc, 0, (int)table.findEntry(tc, clazz)->_allocationSamples);
+		CuAssertIntEquals(tc, 0, (int)table.getPretenuredClassCount());
+
+		expectedInterval = OMR_MIN(expectedInterval * 2, MM_PretenureClassTableTester::maximumReviewInterval);
+	}
+
+	/* once the class no longer qualifies, the back-off starts over */
+	table.allocate(clazz, enoughSamples, 0);
+	table.updatePretenuredClasses(NULL, THRESHOLD);
+	CuAssertTrue(tc, !isPretenured(clazz));
+	CuAssertIntEquals(tc, 0, (int)table.findEntry(tc, clazz)->_reviewInterval);
+	/* outweigh the history of the scavenge without promotions */
+	table.allocate(clazz, enoughSamples * 8, 100);
+	table.updatePretenuredClasses(NULL, THRESHOLD);
+	CuAssertTrue(tc, isPretenured(clazz));
+	CuAssertIntEquals(tc, (int)MM_PretenureClassTableTester::initialReviewInterval, (int)table.findEntry(tc, clazz)->_reviewInterval);
+
+	j9mem_free_memory(entries);
+}
+
+void
+Test_Pretenure_RemoveDyingClassesTest(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	FakeClasses classes;
+	CuAssertTrue(tc, classes.initialize());
+	MM_PretenureClassTable::Entry *entries = allocateEntries(tc);
+	MM_PretenureClassTableTester table(entries);
+
+	/* three classes probing the same entries, and an unrelated one */
+	J9Class *first = classes.get(0, 0);
+	J9Class *second = classes.get(0, 1);
+	J9Class *third = classes.get(0, 2);
+	J9Class *other = classes.get(1);
+	UDATA enoughSamples = MM_PretenureClassTableTester::minimumAllocationSamples;
+
+	table.allocate(first, enoughSamples, 100);
+	table.allocate(second, enoughSamples, 10);
+	table.allocate(third, enoughSamples, 20);
+	table.allocate(other, enoughSamples, 30);
+	table.updatePretenuredClasses(NULL, THRESHOLD);
+	CuAssertTrue(tc, isPretenured(first));
+	CuAssertIntEquals(tc, 1, (int)table.getPretenuredClassCount());
+
+	/* unloading the head of the chain must not hide the classes placed after it */
+	first->classDepthAndFlags |= J9AccClassDying;
+	table.removeDyingEntries();
+	CuAssertPtrEquals(tc, NULL, table.findEntry(tc, first));
+	CuAssertIntEquals(tc, 0, (int)table.getPretenuredClassCount());
+	CuAssertIntEquals(tc, 3, (int)table.countEntries());
+	CuAssertIntEquals(tc, 10, (int)table.findEntry(tc, second)->_survivalRate);
+	CuAssertIntEquals(tc, 20, (int)table.findEntry(tc, third)->_survivalRate);
+	CuAssertIntEquals(tc, 30, (int)table.findEntry(tc, other)->_survivalRate);
+
+	/* new samples go to the existing entries rather than to new ones */
+	UDATA samplesBefore = table.findEntry(tc, third)->_allocationSamples;
+	table.allocate(third, 1, 0);
+	CuAssertIntEquals(tc, 3, (int)table.countEntries());
+	CuAssertIntEquals(tc, (int)(samplesBefore + 1), (int)table.findEntry(tc, third)->_allocationSamples);
+
+	j9mem_free_memory(entries);
+}
+
+void
+Test_Pretenure_EvictionTest(CuTest *tc)
+{
+	PORT_ACCESS_FROM_PORT(sharedPortLibrary);
+	FakeClasses classes;
+	CuAssertTrue(tc, classes.initialize());
+	MM_PretenureClassTable::Entry *entries = allocateEntries(tc);
+	MM_PretenureClassTableTester table(entries);
+
+	/* a class can be placed in one of probeLimit entries, so the next class of the chain is dropped */
+	UDATA probeLimit = MM_PretenureClassTableTester::probeLimit;
+	for (UDATA position = 0; position <= probeLimit; position++) {
+		table.allocate(classes.get(0, position), 1, 0);
+	}
+	CuAssertIntEquals(tc, (int)probeLimit, (int)table.countEntries());
+	CuAssertPtrEquals(tc, NULL, table.findEntry(tc, classes.get(0, probeLimit)));
+	table.updatePretenuredClasses(NULL, THRESHOLD);
+	CuAssertIntEquals(tc, 1, (int)table.getLookupFailureCount());
+	CuAssertIntEquals(tc, (int)probeLimit, (int)table.countEntries());
+
+	/* the classes stopped allocating, so once their history has decayed to zero their entries are given up */
+	for (UDATA scavenge = 0; scavenge < (sizeof(UDATA) * 8); scavenge++) {
+		table.updatePretenuredClasses(NULL, THRESHOLD);
+	}
+	CuAssertIntEquals(tc, 0, (int)table.countEntries());
+	CuAssertIntEquals(tc, 0, (int)table.getLookupFailureCount());
+	table.allocate(classes.get(0, probeLimit), 1, 0);
+	CuAssertPtrNotNull(tc, table.findEntry(tc, classes.get(0, probeLimit)));
+
+	/* a class still allocating keeps its entry, and so does a pretenured one */
+	J9Class *allocating = classes.get(1);
+	J9Class *pretenured = classes.get(2);
+	table.allocate(pretenured, MM_PretenureClassTableTester::minimumAllocationSamples, 100);
+	for (UDATA scavenge = 0; scavenge < 4; scavenge++) {
+		table.allocate(allocating, 1, 0);
+		table.updatePretenuredClasses(NULL, THRESHOLD);
+		CuAssertPtrNotNull(tc, table.findEntry(tc, allocating));
+		CuAssertPtrNotNull(tc, table.findEntry(tc, pretenured));
+	}
+	CuAssertTrue(tc, isPretenured(pretenured));
+
+	j9mem_free_memory(entries);
+}
+
+CuSuite
+*GetPretenureTestSuite()
+{
+	CuSuite *suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, Test_Pretenure_SurvivalThresholdTest);
+	SUITE_ADD_TEST(suite, Test_Pretenure_ReviewIntervalTest);
+	SUITE_ADD_TEST(suite, Test_Pretenure_RemoveDyingClassesTest);
+	SUITE_ADD_TEST(suite, Test_Pretenure_EvictionTest);
+	return suite;
+}
@@ -29,6 +29,7 @@
 
 #if defined(J9VM_GC_VLHGC)
 #include "EnvironmentBase.hpp"
+#include "EnvironmentVLHGC.hpp"
 #include "GCExtensions.hpp"
 #include "Heap.hpp"
 #include "HeapRegionIterator.hpp"
@@ -118,6 +119,60 @@ tgcHookReportNumaStatistics(J9HookInterface** hook, UDATA eventNum, void* eventD
 }
 
 
+/**
+ * Report the NUMA traffic of the GC threads during a copy forward
+ */
+static void
+tgcHookReportNumaCopyForwardTraffic(J9HookInterface** hook, UDATA eventNum, void* eventData, void* userData)
+{
+	MM_CopyForwardEndEvent* event = (MM_CopyForwardEndEvent*)eventData;
+	J9VMThread* vmThread = (J9VMThread*)event->currentThread->_language_vmthread;
+	MM_GCExtensions *extensions = MM_GCExtensions::getExtensions(vmThread->javaVM);
+	MM_TgcExtensions *tgcExtensions = MM_TgcExtensions::getExtensions(extensions);
+	TgcNumaExtensions *numaExtensions = &tgcExtensions->_numa;
+
+	if (NULL != numaExtensions->nodeData) {
+		for (UDATA i = 0; i <= numaExtensions->numaNodes; i++) {
+			numaExtensions->nodeData[i].scanCachesLocal = 0;
+			numaExtensions->nodeData[i].scanCachesStolen = 0;
+			numaExtensions->nodeData[i].copiedBytesLocal = 0;
+			numaExtensions->nodeData[i].copiedBytesRemote = 0;
+		}
+
+		/*
+		 * Sum the traffic of the GC threads by the node they have affinity with (the node used by the collector itself)
+		 */
+		GC_VMThreadListIterator threadIterator(vmThread);
+		J9VMThread * walkThread = NULL;
+		while (NULL != (walkThread = threadIterator.nextVMThread())) {
+			MM_EnvironmentVLHGC *env = MM_EnvironmentVLHGC::getEnvironment(walkThread);
+			if ((walkThread == vmThread) || (env->getThreadType() == GC_WORKER_THREAD)) {
+				UDATA threadNode = 0;
+				if (extensions->_numaManager.isPhysicalNUMASupported()) {
+					threadNode = OMR_MIN(env->getNumaAffinity(), numaExtensions->numaNodes);
+				}
+				numaExtensions->nodeData[threadNode].scanCachesLocal += env->_copyForwardStats._scanCachesFromLocalNode;
+				numaExtensions->nodeData[threadNode].scanCachesStolen += env->_copyForwardStats._scanCachesFromRemoteNode;
+				numaExtensions->nodeData[threadNode].copiedBytesLocal += env->_copyForwardStats._copyBytesToLocalNode;
+				numaExtensions->nodeData[threadNode].copiedBytesRemote += env->_copyForwardStats._copyBytesToRemoteNode;
+			}
+		}
+
+		/*
+		 * Report results
+		 */
+		for (UDATA i = 0; i <= numaExtensions->numaNodes; i++) {
+			tgcExtensions->printf(
+					"NUMA node %zu GC threads scanned %zu local caches, stole %zu remote caches, copied %zu bytes locally and %zu bytes remotely\n",
+					i,
+					numaExtensions->nodeData[i].scanCachesLocal,
+					numaExtensions->nodeData[i].scanCachesStolen,
+					numaExtensions->nodeData[i].copiedBytesLocal,
+					numaExtensions->nodeData[i].copiedBytesRemote);
+		}
+	}
+}
+
 /**
  * Initialize NUMA tgc tracing.
  * Attaches hooks to the appropriate functions handling events used by NUMA tgc tracing.
@@ -137,6 +192,9 @@ tgcNumaInitialize(J9JavaVM *javaVM)
 	(*hooks)->J9HookRegisterWithCallSite(hooks, J9HOOK_MM_OMR_LOCAL_GC_START, tgcHookReportNumaStatistics, OMR_GET_CALLSITE(), NULL);
 	(*hooks)->J9HookRegisterWithCallSite(hooks, J9HOOK_MM_OMR_LOCAL_GC_END, tgcHookReportNumaStatistics, OMR_GET_CALLSITE(), NULL);
 
+	J9HookInterface** privateHooks = J9_HOOK_INTERFACE(extensions->privateHookInterface);
+	(*privateHooks)->J9HookRegisterWithCallSite(privateHooks, J9HOOK_MM_PRIVATE_COPY_FORWARD_END, tgcHookReportNumaCopyForwardTraffic, OMR_GET_CALLSITE(), NULL);
+
 	return result;
 }
 
@@ -40,6 +40,10 @@ typedef struct TgcNumaExtensions {
 		UDATA freeRegions; /**< number of free regions with affinity to the node */
 		UDATA threads; /**< number of threads with affinity to the node */
 		UDATA gcThreads; /**< number of GC threads (workers/main) with affinity to the node */
+		UDATA scanCachesLocal; /**< scan caches taken by GC threads of the node from the node's own (or the common) list in the last copy forward */
+		UDATA scanCachesStolen; /**< scan caches stolen by GC threads of the node from other nodes in the last copy forward */
+		UDATA copiedBytesLocal; /**< bytes copied by GC threads of the node into regions of the node (or with no affinity) in the last copy forward */
+		UDATA copiedBytesRemote; /**< bytes copied by GC threads of the node into regions of other nodes in the last copy forward */
 	} *nodeData;
 } TgcNumaExtensions;
 	
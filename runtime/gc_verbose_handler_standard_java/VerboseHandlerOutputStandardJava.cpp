@@ -31,6 +31,7 @@
 #include "CycleState.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensions.hpp"
+#include "PretenureClassTable.hpp"
 #include "ScanClassesMode.hpp"
 #include "VerboseHandlerOutputStandardJava.hpp"
 #include "VerboseManager.hpp"
@@ -165,6 +166,33 @@ MM_VerboseHandlerOutputStandardJava::outputReferenceInfo(MM_EnvironmentBase *env
 	}
 }
 
+void
+MM_VerboseHandlerOutputStandardJava::outputPretenureInfo(MM_EnvironmentBase *env, uintptr_t indent)
+{
+	MM_PretenureClassTable *pretenureClassTable = MM_GCExtensions::getExtensions(env->getOmrVM())->getPretenureClassTable();
+	if (NULL != pretenureClassTable) {
+		MM_PretenureClassTable::Entry *entries = pretenureClassTable->getEntries();
+		uintptr_t trackedClassCount = 0;
+		for (uintptr_t index = 0; index < pretenureClassTable->getEntryCount(); index++) {
+			J9Class *clazz = entries[index]._clazz;
+			if (NULL != clazz) {
+				trackedClassCount += 1;
+				if (entries[index]._newlyPretenured) {
+					J9UTF8 *className = J9ROMCLASS_CLASSNAME(clazz->romClass);
+					_manager->getWriterChain()->formatAndOutput(env, indent, "<pretenured-class name=\"%.*s\" survivalrate=\"%zu\" scavenges=\"%zu\" />",
+							(int)J9UTF8_LENGTH(className), J9UTF8_DATA(className), entries[index]._survivalRate, entries[index]._reviewInterval);
+				} else if (entries[index]._newlyReleased) {
+					J9UTF8 *className = J9ROMCLASS_CLASSNAME(clazz->romClass);
+					_manager->getWriterChain()->formatAndOutput(env, indent, "<pretenured-class-review name=\"%.*s\" />",
+							(int)J9UTF8_LENGTH(className), J9UTF8_DATA(className));
+				}
+			}
+		}
+		_manager->getWriterChain()->formatAndOutput(env, indent, "<pretenuring classes=\"%zu\" pretenured=\"%zu\" droppedsamples=\"%zu\" />",
+				trackedClassCount, pretenureClassTable->getPretenuredClassCount(), pretenureClassTable->getLookupFailureCount());
+	}
+}
+
 void
 MM_VerboseHandlerOutputStandardJava::handleMarkEndInternal(MM_EnvironmentBase* env, void *eventData)
 {
@@ -268,6 +296,8 @@ MM_VerboseHandlerOutputStandardJava::handleScavengeEndInternal(MM_EnvironmentBas
 		outputReferenceInfo(env, 1, "phantom", &scavengerJavaStats->_phantomReferenceStats, 0, 0);
 
 		outputMonitorReferenceInfo(env, 1, scavengerJavaStats->_monitorReferenceCandidates, scavengerJavaStats->_monitorReferenceCleared);
+
+		outputPretenureInfo(env, 1);
 	}
 }
 #endif /*defined(J9VM_GC_MODRON_SCAVENGER) */
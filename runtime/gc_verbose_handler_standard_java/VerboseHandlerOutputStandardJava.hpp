@@ -68,6 +68,13 @@ private:
 	 */
 	void outputReferenceInfo(MM_EnvironmentBase *env, uintptr_t indent, const char *referenceType, MM_ReferenceStats *referenceStats, uintptr_t dynamicThreshold, uintptr_t maxThreshold);
 
+	/**
+	 * Output the classes selected for pretenuring by the last scavenge, and a pretenuring summary.
+	 * @param env GC thread used for output.
+	 * @param indent base level of indentation for the summary.
+	 */
+	void outputPretenureInfo(MM_EnvironmentBase *env, uintptr_t indent);
+
 protected:
 
 	virtual bool initialize(MM_EnvironmentBase *env, MM_VerboseManager *manager);
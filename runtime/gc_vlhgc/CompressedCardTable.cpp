@@ -31,6 +31,7 @@
 #include "j9modron.h"
 #include "ModronAssertions.h"
 
+#include "Bits.hpp"
 #include "CardCleaner.hpp"
 #include "CardTable.hpp"
 #include "CompressedCardTable.hpp"
@@ -159,6 +160,49 @@ MM_CompressedCardTable::setCompressedCardsDirtyForPartialCollect(void *startHeap
 	}
 }
 
+bool
+MM_CompressedCardTable::isKnownDirtyCardState(Card state)
+{
+	bool result = false;
+
+	switch(state) {
+	case CARD_REMEMBERED_AND_GMP_SCAN:
+	case CARD_REMEMBERED:
+	case CARD_DIRTY:
+	case CARD_PGC_MUST_SCAN:
+		result = true;
+		break;
+	default:
+		break;
+	}
+
+	return result;
+}
+
+bool
+MM_CompressedCardTable::compressCardsForPartialCollect(const Card *cards, UDATA wordCount, UDATA *compressedCards)
+{
+	bool knownCardStates = true;
+
+	/* build a whole compressed card word at a time */
+	for (UDATA i = 0; i < wordCount; i++) {
+		UDATA dirtyMask = dirtyCardMaskForPartialCollect(cards);
+		for (UDATA dirtyBits = dirtyMask; 0 != dirtyBits; dirtyBits &= (dirtyBits - 1)) {
+			if (!isKnownDirtyCardState(cards[MM_Bits::trailingZeroes(dirtyBits)])) {
+				knownCardStates = false;
+			}
+		}
+#if defined(COMPRESSED_CARD_TABLE_INVERTED)
+		compressedCards[i] = ~dirtyMask;
+#else /* defined(COMPRESSED_CARD_TABLE_INVERTED) */
+		compressedCards[i] = dirtyMask;
+#endif /* defined(COMPRESSED_CARD_TABLE_INVERTED) */
+		cards += COMPRESSED_CARDS_PER_WORD;
+	}
+
+	return knownCardStates;
+}
+
 void
 MM_CompressedCardTable::rebuildCompressedCardTableForPartialCollect(MM_EnvironmentBase *env, void *startHeapAddress, void *endHeapAddress)
 {
@@ -168,9 +212,6 @@ MM_CompressedCardTable::rebuildCompressedCardTableForPartialCollect(MM_Environme
 	UDATA compressedCardStartOffset = ((UDATA)startHeapAddress - _heapBase) / (CARD_SIZE * COMPRESSED_CARD_TABLE_DIV);
 	UDATA compressedCardStartIndex = compressedCardStartOffset / COMPRESSED_CARDS_PER_WORD;
 	UDATA *compressedCard = &_compressedCardTable[compressedCardStartIndex];
-	UDATA mask = 1;
-	const UDATA endOfWord = ((UDATA)1) << (COMPRESSED_CARDS_PER_WORD - 1);
-	UDATA compressedCardWord = AllCompressedCardsInWordClean;
 
 	/*
 	 *  To simplify test logic assume here that given addresses are aligned to correspondent compressed card word border
@@ -179,17 +220,21 @@ MM_CompressedCardTable::rebuildCompressedCardTableForPartialCollect(MM_Environme
 	 */
 	Assert_MM_true(0 == (compressedCardStartOffset % COMPRESSED_CARDS_PER_WORD));
 
-	while (card < cardLast) {
-
 #if (1 == COMPRESSED_CARD_TABLE_DIV)
+	/* end heap address must be aligned */
+	Assert_MM_true(0 == (((UDATA)(cardLast - card)) % COMPRESSED_CARDS_PER_WORD));
 
-		Card state = *card++;
-		if (isDirtyCardForPartialCollect(state)) {
-			/* invert bit */
-			compressedCardWord ^= mask;
-		}
+	/* the word scan classifies unknown card states as dirty, so a card with an unknown state is unreachable */
+	bool knownCardStates = compressCardsForPartialCollect(card, ((UDATA)(cardLast - card)) / COMPRESSED_CARDS_PER_WORD, compressedCard);
+	Assert_MM_true(knownCardStates);
 
 #else /* COMPRESSED_CARD_TABLE_DIV == 1 */
+	UDATA mask = 1;
+	const UDATA endOfWord = ((UDATA)1) << (COMPRESSED_CARDS_PER_WORD - 1);
+	UDATA compressedCardWord = AllCompressedCardsInWordClean;
+
+	while (card < cardLast) {
+
 		/*
 		 * This implementation supports case for COMPRESSED_CARD_TABLE_DIV == 1 as well
 		 * Special implementation above extracted with hope that it is faster
@@ -206,7 +251,6 @@ MM_CompressedCardTable::rebuildCompressedCardTableForPartialCollect(MM_Environme
 		}
 		/* rewind card pointer to first card for next bit */
 		card = next;
-#endif /* COMPRESSED_CARD_TABLE_DIV == 1 */
 
 		if (mask == endOfWord) {
 			/* last bit in word handled - save word and prepare mask for next one */
@@ -221,6 +265,7 @@ MM_CompressedCardTable::rebuildCompressedCardTableForPartialCollect(MM_Environme
 
 	/* end heap address must be aligned*/
 	Assert_MM_true(1 == mask);
+#endif /* COMPRESSED_CARD_TABLE_DIV == 1 */
 }
 
 bool
@@ -275,37 +320,47 @@ MM_CompressedCardTable::cleanCardsInRange(MM_EnvironmentBase *env, MM_CardCleane
 
 	MM_CardTable *cardTable = MM_GCExtensions::getExtensions(env)->cardTable;
 	Card *card = cardTable->heapAddrToCardAddr(env, startHeapAddress);
-	U_8 *address = (U_8 *)startHeapAddress;
+	UDATA cardsCleaned = cleanCompressedCards(env, cardCleaner, &_compressedCardTable[compressedCardStartIndex],
+			compressedCardEndIndex - compressedCardStartIndex, card, (U_8 *)startHeapAddress);
+
+	env->_cardCleaningStats._cardsCleaned += cardsCleaned;
+}
+
+UDATA
+MM_CompressedCardTable::cleanCompressedCards(MM_EnvironmentBase *env, MM_CardCleaner *cardCleaner, const UDATA *compressedCards, UDATA wordCount, Card *card, U_8 *address)
+{
 	UDATA cardsCleaned = 0;
 
-	for (UDATA i = compressedCardStartIndex; i < compressedCardEndIndex; i++) {
-		UDATA compressedCardWord = _compressedCardTable[i];
+	for (UDATA i = 0; i < wordCount; i++) {
+		UDATA compressedCardWord = compressedCards[i];
 		if (AllCompressedCardsInWordClean != compressedCardWord) {
-			/* search for dirty cards - iterate bits */
-			for (UDATA j = 0; j < COMPRESSED_CARDS_PER_WORD; j++) {
-				if (CompressedCardDirty == (compressedCardWord & 1)) {
-					for (UDATA k = 0; k < COMPRESSED_CARD_TABLE_DIV; k++) {
-						/* clean card */
-						cardCleaner->clean(env, address, address + CARD_SIZE, card);
-						card += 1;
-						address += CARD_SIZE;
-						cardsCleaned += 1;
-					}
-				} else {
-					/* skip cards this bit responsible for */
-					card += COMPRESSED_CARD_TABLE_DIV;
-					address += (CARD_SIZE * COMPRESSED_CARD_TABLE_DIV);
+#if defined(COMPRESSED_CARD_TABLE_INVERTED)
+			UDATA dirtyBits = ~compressedCardWord;
+#else /* defined(COMPRESSED_CARD_TABLE_INVERTED) */
+			UDATA dirtyBits = compressedCardWord;
+#endif /* defined(COMPRESSED_CARD_TABLE_INVERTED) */
+			/* search for dirty cards - jump from one set bit to the next instead of testing every bit */
+			while (0 != dirtyBits) {
+				UDATA bit = MM_Bits::trailingZeroes(dirtyBits);
+				Card *dirtyCard = card + (bit * COMPRESSED_CARD_TABLE_DIV);
+				U_8 *dirtyAddress = address + (bit * CARD_SIZE * COMPRESSED_CARD_TABLE_DIV);
+				for (UDATA k = 0; k < COMPRESSED_CARD_TABLE_DIV; k++) {
+					/* clean card */
+					cardCleaner->clean(env, dirtyAddress, dirtyAddress + CARD_SIZE, dirtyCard);
+					dirtyCard += 1;
+					dirtyAddress += CARD_SIZE;
+					cardsCleaned += 1;
 				}
-				compressedCardWord >>= 1;
+				/* clear lowest set bit */
+				dirtyBits &= (dirtyBits - 1);
 			}
-		} else {
-			/* skip cards this word responsible for */
-			card += (COMPRESSED_CARD_TABLE_DIV * COMPRESSED_CARDS_PER_WORD);
-			address += (CARD_SIZE * COMPRESSED_CARD_TABLE_DIV * COMPRESSED_CARDS_PER_WORD);
 		}
+		/* advance to cards next word is responsible for */
+		card += (COMPRESSED_CARD_TABLE_DIV * COMPRESSED_CARDS_PER_WORD);
+		address += (CARD_SIZE * COMPRESSED_CARD_TABLE_DIV * COMPRESSED_CARDS_PER_WORD);
 	}
 
-	env->_cardCleaningStats._cardsCleaned += cardsCleaned;
+	return cardsCleaned;
 }
 
 bool
@@ -380,12 +380,16 @@ MM_CopyForwardScheme::tearDown(MM_EnvironmentVLHGC *env)
 }
 
 MM_AllocationContextTarok *
-MM_CopyForwardScheme::getPreferredAllocationContext(MM_AllocationContextTarok *suggestedContext, J9Object *objectPtr)
+MM_CopyForwardScheme::getPreferredAllocationContext(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *suggestedContext, J9Object *objectPtr)
 {
 	MM_AllocationContextTarok *preferredContext = suggestedContext;
 
 	if (preferredContext == _commonContext) {
 		preferredContext = getContextForHeapAddress(objectPtr);
+		if ((preferredContext == _commonContext) && (NULL != env->_copyForwardNodeContext)) {
+			/* the copy is scanned from the scan cache list of its destination node, so keep it local to this thread */
+			preferredContext = env->_copyForwardNodeContext;
+		}
 	} /* no code beyond this point without modifying else statement below */
 	return preferredContext;
 }
@@ -1493,9 +1497,32 @@ MM_CopyForwardScheme::workerSetupForCopyForward(MM_EnvironmentVLHGC *env)
 		env->_copyForwardCompactGroups[compactGroup].initialize(env);
 	}
 
+	/* threads without node affinity (or with the option off) copy objects of the common context into the common context */
+	Assert_MM_true(NULL == env->_copyForwardNodeContext);
+	if (_extensions->_copyForwardCommonToThreadNode && (0 != getNumaNodeOfThread(env))) {
+		/* a thread with node affinity got it from its own context, which owns memory of that node */
+		MM_AllocationContextTarok *threadContext = (MM_AllocationContextTarok *)env->getAllocationContext();
+		if ((NULL != threadContext) && (_commonContext != threadContext)) {
+			env->_copyForwardNodeContext = threadContext;
+		}
+	}
+
 	Assert_MM_true(NULL == env->_lastOverflowedRsclWithReleasedBuffers);
 }
 
+MMINLINE uintptr_t
+MM_CopyForwardScheme::getNumaNodeOfThread(MM_EnvironmentVLHGC *env)
+{
+	uintptr_t nodeOfThread = 0;
+
+	/* if we aren't using NUMA, we don't want to check the thread affinity since we will have only one list of scan caches */
+	if (_extensions->_numaManager.isPhysicalNUMASupported()) {
+		nodeOfThread = env->getNumaAffinity();
+		Assert_MM_true(nodeOfThread <= _extensions->_numaManager.getMaximumNodeNumber());
+	}
+	return nodeOfThread;
+}
+
 /**
  * Merge any per thread GC stats into the main stat structure.
  */
@@ -1516,6 +1543,10 @@ MM_CopyForwardScheme::mergeGCStats(MM_EnvironmentVLHGC *env)
 	Assert_MM_true(0 == localStats->_copyObjectsNonEden);
 	Assert_MM_true(0 == localStats->_copyBytesNonEden);
 	Assert_MM_true(0 == localStats->_copyDiscardBytesNonEden);
+	Assert_MM_true(0 == localStats->_copyBytesToLocalNode);
+	Assert_MM_true(0 == localStats->_copyBytesToRemoteNode);
+
+	uintptr_t nodeOfThread = getNumaNodeOfThread(env);
 
 	/* sum up the per-compact group data before entering the lock */
 	for (uintptr_t compactGroupNumber = 0; compactGroupNumber < _compactGroupMaxCount; compactGroupNumber++) {
@@ -1523,6 +1554,16 @@ MM_CopyForwardScheme::mergeGCStats(MM_EnvironmentVLHGC *env)
 		uintptr_t totalCopiedBytes = compactGroup->_edenStats._copiedBytes + compactGroup->_nonEdenStats._copiedBytes;
 		uintptr_t totalLiveBytes = compactGroup->_edenStats._liveBytes + compactGroup->_nonEdenStats._liveBytes;
 
+		if (0 != totalCopiedBytes) {
+			uintptr_t contextNumber = MM_CompactGroupManager::getAllocationContextNumberFromGroup(env, compactGroupNumber);
+			uintptr_t destinationNode = ((MM_AllocationContextTarok *)_extensions->globalAllocationManager->getAllocationContextByIndex(contextNumber))->getNumaNode();
+			if ((0 == destinationNode) || (nodeOfThread == destinationNode)) {
+				localStats->_copyBytesToLocalNode += totalCopiedBytes;
+			} else {
+				localStats->_copyBytesToRemoteNode += totalCopiedBytes;
+			}
+		}
+
 		localStats->_copyObjectsTotal += compactGroup->_edenStats._copiedObjects + compactGroup->_nonEdenStats._copiedObjects;
 		localStats->_copyBytesTotal += totalCopiedBytes;
 		localStats->_scanObjectsTotal += compactGroup->_edenStats._scannedObjects + compactGroup->_nonEdenStats._scannedObjects;
@@ -1987,7 +2028,7 @@ MM_CopyForwardScheme::copy(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *
 		}
 #endif /* J9VM_INTERP_NATIVE_SUPPORT */
 
-		reservingContext = getPreferredAllocationContext(reservingContext, object);
+		reservingContext = getPreferredAllocationContext(env, reservingContext, object);
 
 		copyCache = reserveMemoryForCopy(env, object, reservingContext, objectReserveSizeInBytes);
 
@@ -2913,19 +2954,27 @@ MM_CopyForwardScheme::getNextWorkUnitNoWait(MM_EnvironmentVLHGC *env, uintptr_t
 	ScanReason ret = SCAN_REASON_NONE;
 	/* local node first */
 	ret = getNextWorkUnitOnNode(env, preferredNumaNode);
-	if (SCAN_REASON_NONE == ret) {
-		/* we failed to find a scan cache on our preferred node */
-		if (COMMON_CONTEXT_INDEX != preferredNumaNode) {
-			/* try the common node */
-			ret = getNextWorkUnitOnNode(env, COMMON_CONTEXT_INDEX);
-		}
-		/* now try the remaining nodes */
-		uintptr_t nextNode = (preferredNumaNode + 1) % nodeLists;
-		while ((SCAN_REASON_NONE == ret) && (nextNode != preferredNumaNode)) {
-			if (COMMON_CONTEXT_INDEX != nextNode) {
-				ret = getNextWorkUnitOnNode(env, nextNode);
+	if ((SCAN_REASON_NONE == ret) && (COMMON_CONTEXT_INDEX != preferredNumaNode)) {
+		/* we failed to find a scan cache on our preferred node so try the common node */
+		ret = getNextWorkUnitOnNode(env, COMMON_CONTEXT_INDEX);
+	}
+	if (SCAN_REASON_NONE != ret) {
+		env->_copyForwardStats._scanCachesFromLocalNode += 1;
+	} else if (nodeLists > 1) {
+		/* only steal from the remaining nodes (lists 1 and up, list 0 being the common node) once the local ones are drained.
+		 * Start with a victim chosen by the worker ID so that the threads of a drained node spread over the other nodes
+		 * instead of all contending on the same list
+		 */
+		uintptr_t remoteNodes = nodeLists - 1;
+		uintptr_t firstVictim = env->getWorkerID() % remoteNodes;
+		for (uintptr_t i = 0; (SCAN_REASON_NONE == ret) && (i < remoteNodes); i++) {
+			uintptr_t victimNode = 1 + ((firstVictim + i) % remoteNodes);
+			if (victimNode != preferredNumaNode) {
+				ret = getNextWorkUnitOnNode(env, victimNode);
 			}
-			nextNode = (nextNode + 1) % nodeLists;
+		}
+		if (SCAN_REASON_NONE != ret) {
+			env->_copyForwardStats._scanCachesFromRemoteNode += 1;
 		}
 	}
 	if (SCAN_REASON_NONE == ret && (0 != _regionCountCannotBeEvacuated) && !abortFlagRaised()) {
@@ -3461,13 +3510,7 @@ MM_CopyForwardScheme::completeScanWorkPacket(MM_EnvironmentVLHGC *env)
 void
 MM_CopyForwardScheme::completeScan(MM_EnvironmentVLHGC *env)
 {
-	uintptr_t nodeOfThread = 0;
-
-	/* if we aren't using NUMA, we don't want to check the thread affinity since we will have only one list of scan caches */
-	if (_extensions->_numaManager.isPhysicalNUMASupported()) {
-		nodeOfThread = env->getNumaAffinity();
-		Assert_MM_true(nodeOfThread <= _extensions->_numaManager.getMaximumNodeNumber());
-	}
+	uintptr_t nodeOfThread = getNumaNodeOfThread(env);
 	ScanReason scanReason = SCAN_REASON_NONE;
 	while (SCAN_REASON_NONE != (scanReason = getNextWorkUnit(env, nodeOfThread))) {
 		if (SCAN_REASON_COPYSCANCACHE == scanReason) {
@@ -4467,6 +4510,7 @@ MM_CopyForwardScheme::workThreadGarbageCollect(MM_EnvironmentVLHGC *env)
 	mergeGCStats(env);
 
 	env->_copyForwardCompactGroups = NULL;
+	env->_copyForwardNodeContext = NULL;
 
 	return ;
 }
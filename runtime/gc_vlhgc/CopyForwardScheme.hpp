@@ -609,6 +609,7 @@ private:
 	ScanReason getNextWorkUnit(MM_EnvironmentVLHGC *env, uintptr_t preferredNumaNode);
 
 	/**
+	 * Tries the scan caches of the preferred and common nodes, then steals from the other nodes, then work packets.
 	 * @param env[in] The GC thread
 	 * @param preferredNumaNode[in] The NUMA node number where the caller would prefer to find a scan cache
 	 * @return possible return value(SCAN_REASON_NONE, SCAN_REASON_COPYSCANCACHE, SCAN_REASON_PACKET)
@@ -1009,6 +1010,12 @@ protected:
 
 	void clearGCStats(MM_EnvironmentVLHGC *env);
 
+	/**
+	 * @param env[in] The GC thread
+	 * @return the NUMA node the thread has affinity with, which indexes its scan cache list (0 if NUMA is not in use)
+	 */
+	MMINLINE uintptr_t getNumaNodeOfThread(MM_EnvironmentVLHGC *env);
+
 	/**
 	 * Merge the current threads copy forward stats into the global copy forward stats.
 	 */
@@ -1067,12 +1074,14 @@ protected:
 	/**
 	 * Checks whether the suggestedContext passed in is a preferred allocation context for
 	 * object relocation. If so the same context is returned if not the object's original context
-	 * is returned.
+	 * is returned. With -Xgc:copyForwardCommonToThreadNode, objects that have no node affinity either way
+	 * are copied to the context of the NUMA node of the copying thread, whose threads will also scan them.
+	 * @param[in] env The current GC thread
 	 * @param[in] suggestedContext The allocation context we intended to copy the object into
 	 * @param[in] objectPtr A pointer to the object being copied
 	 * @return The reservingContext or the object's owning context if the suggestedContext is not a preferred object relocation context
 	 */
-	MMINLINE MM_AllocationContextTarok *getPreferredAllocationContext(MM_AllocationContextTarok *suggestedContext, J9Object *objectPtr);
+	MMINLINE MM_AllocationContextTarok *getPreferredAllocationContext(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *suggestedContext, J9Object *objectPtr);
 
 public:
 
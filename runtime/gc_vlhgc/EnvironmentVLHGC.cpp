@@ -35,6 +35,7 @@ MM_EnvironmentVLHGC::MM_EnvironmentVLHGC(OMR_VMThread *omrVMThread)
 	,_scanCache(NULL)
 	,_deferredScanCache(NULL)
 	, _copyForwardCompactGroups(NULL)
+	, _copyForwardNodeContext(NULL)
 	, _previousConcurrentYieldCheckBytesScanned(0)
 	, _rsclBufferControlBlockHead(NULL)
 	, _rsclBufferControlBlockTail(NULL)
@@ -54,6 +55,7 @@ MM_EnvironmentVLHGC::MM_EnvironmentVLHGC(J9JavaVM *javaVM)
 	,_scanCache(NULL)
 	,_deferredScanCache(NULL)
 	, _copyForwardCompactGroups(NULL)
+	, _copyForwardNodeContext(NULL)
 	, _previousConcurrentYieldCheckBytesScanned(0)
 	, _rsclBufferControlBlockHead(NULL)
 	, _rsclBufferControlBlockTail(NULL)
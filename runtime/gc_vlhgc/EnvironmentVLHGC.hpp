@@ -45,6 +45,7 @@
 #include "UnfinalizedObjectBufferVLHGC.hpp"
 #include "WorkStack.hpp"
 
+class MM_AllocationContextTarok;
 class MM_GCExtensions;
 class MM_CopyForwardCompactGroup;
 class MM_CopyScanCache;
@@ -66,6 +67,7 @@ public:
 	MM_CopyScanCache *_deferredScanCache; /**< a partially scanned cache, to be scanned later */
 
 	MM_CopyForwardCompactGroup *_copyForwardCompactGroups;  /**< List of copy-forward data for each compact group for the given GC thread (only for GC threads during copy forward operations) */
+	MM_AllocationContextTarok *_copyForwardNodeContext; /**< Allocation context of the NUMA node the GC thread runs on, or NULL without physical NUMA or -Xgc:copyForwardCommonToThreadNode (only for GC threads during copy forward operations) */
 	
 	uintptr_t _previousConcurrentYieldCheckBytesScanned;	/**< The number of bytes scanned in the mark stats at the end of the previous shouldYieldFromTask check in concurrent mark */
 
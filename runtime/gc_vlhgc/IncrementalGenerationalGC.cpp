@@ -2531,11 +2531,13 @@ MM_IncrementalGenerationalGC::unloadDeadClassLoaders(MM_EnvironmentVLHGC *env)
 		/* enqueue all the segments we just salvaged from the dead class loaders for delayed free (this work was historically attributed in the unload end operation so it goes after the timer start) */
 		_extensions->classLoaderManager->enqueueUndeadClassSegments(reclaimedSegments);
 		_extensions->classLoaderManager->cleanUpClassLoadersEnd(env, unloadLink);
-		/* we can now flush these since we don't need to walk any dead objects in Balanced */
+		/* we can now flush these since we don't need to walk any dead objects in Balanced, so leave it to the finalizer if it can take it */
 		if (_extensions->classLoaderManager->reclaimableMemory() > 0) {
-			Trc_MM_FlushUndeadSegments_Entry(env->getLanguageVMThread(), "Mark Map Completed");
-			_extensions->classLoaderManager->flushUndeadSegments(env);
-			Trc_MM_FlushUndeadSegments_Exit(env->getLanguageVMThread());
+			if (!_extensions->classLoaderManager->deferUndeadSegmentsFlush(env)) {
+				Trc_MM_FlushUndeadSegments_Entry(env->getLanguageVMThread(), "Mark Map Completed");
+				_extensions->classLoaderManager->flushUndeadSegments(env);
+				Trc_MM_FlushUndeadSegments_Exit(env->getLanguageVMThread());
+			}
 		}
 		classUnloadStats->_endPostTime = j9time_hires_clock();
 
@@ -0,0 +1,86 @@
+/*
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ */
+package com.ibm.tests.garbagecollector;
+
+/**
+ * Allocates instances of a class which all survive several scavenges, mixed with instances of a class
+ * which die young, for the tests of -Xgc:pretenure. The long lived instances are kept in a ring larger
+ * than the nursery, so each of them is copied to tenure before it is dropped.
+ */
+public class PretenureAllocate
+{
+	public static class LongLived
+	{
+		long _value1;
+		long _value2;
+		Object _next;
+	}
+
+	public static class ShortLived
+	{
+		long _value1;
+		long _value2;
+		Object _next;
+	}
+
+	private static final int RING_SIZE = 1024 * 1024;
+	private static final LongLived[] _ring = new LongLived[RING_SIZE];
+	public static Object _objectHolder;
+
+	/**
+	 * @param args Takes one argument:  number of times to fill the ring of long lived objects, in the range [1-100].
+	 */
+	public static void main(String[] args)
+	{
+		if (1 == args.length)
+		{
+			int iterations = Integer.parseInt(args[0]);
+
+			if ((iterations >= 1) && (iterations <= 100))
+			{
+				for (int iteration = 0; iteration < iterations; iteration++)
+				{
+					for (int i = 0; i < RING_SIZE; i++)
+					{
+						LongLived longLived = new LongLived();
+						longLived._value1 = i;
+						_ring[i] = longLived;
+						ShortLived shortLived = new ShortLived();
+						shortLived._next = longLived;
+						_objectHolder = shortLived;
+					}
+				}
+				System.out.println("Test ran to completion");
+			}
+			else
+			{
+				System.err.println("Invalid option given for iterations (" + iterations + ").  Value given must be in the range [1-100].");
+				System.exit(2);
+			}
+		}
+		else
+		{
+			System.err.println("Missing argument for the number of iterations.  Please specify the number of times to fill the ring (in the range [1-100]).");
+			System.exit(1);
+		}
+	}
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright IBM Corp. and others 2026
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ */
+package com.ibm.tests.garbagecollector;
+package com.ibm.tests.garbagecollector;
+
+import java.lang.reflect.Field;
+
+/**
+ * Exercises the weak String caches of the GC for the tests of -Xgc:stringTableLookupCacheSize= and -Xgc:stringDeduplication.
+ * In intern mode, half of a set of interned Strings die before the collections. Interning equal Strings afterwards must
+ * return the surviving instances, and the same instance each time for the others, whatever the cache still held.
+ * In dedup mode, many equal Strings with their own value arrays survive scavenges. They must keep their contents,
+ * and with expectShared some of them must end up sharing a value array (this reads String.value by reflection).
+ */
+public class StringInternCache
+{
+	private static final int INTERN_COUNT = 100000;
+	private static final int DEDUP_COUNT = 100000;
+	private static final int DEDUP_DISTINCT = 100;
+	private static final int GARBAGE_ROUNDS = 50;
+	public static Object _objectHolder;
+
+	private static String internContent(int i)
+	{
+		return new StringBuilder("intern").append(i).toString();
+	}
+
+	private static String dedupContent(int i)
+	{
+		return new StringBuilder("dedup").append(i % DEDUP_DISTINCT).toString();
+	}
+
+	/**
+	 * Allocate enough short lived objects to trigger scavenges
+	 */
+	private static void allocateGarbage()
+	{
+		for (int i = 0; i < 1024 * 1024; i++) {
+			_objectHolder = new Object[4];
+		}
+	}
+
+	private static boolean testIntern()
+	{
+		boolean passed = true;
+		String[] kept = new String[INTERN_COUNT / 2];
+		for (int i = 0; i < INTERN_COUNT; i++) {
+			String interned = internContent(i).intern();
+			if (0 == (i % 2)) {
+				kept[i / 2] = interned;
+			}
+		}
+
+		for (int round = 0; round < 4; round++) {
+			allocateGarbage();
+			System.gc();
+		}
+
+		for (int i = 0; i < INTERN_COUNT; i++) {
+			String content = internContent(i);
+			String interned = content.intern();
+			if (!interned.equals(content)) {
+				System.err.println("Interned String \"" + interned + "\" does not match \"" + content + "\"");
+				passed = false;
+			} else if ((0 == (i % 2)) && (interned != kept[i / 2])) {
+				System.err.println("Interning \"" + content + "\" did not return the live interned instance");
+				passed = false;
+			} else if (interned != internContent(i).intern()) {
+				System.err.println("Interning \"" + content + "\" twice returned different instances");
+				passed = false;
+			}
+		}
+		return passed;
+	}
+
+	private static boolean testDedup(boolean expectShared) throws Exception
+	{
+		boolean passed = true;
+		String[] strings = new String[DEDUP_COUNT];
+		for (int i = 0; i < DEDUP_COUNT; i++) {
+			/* each String gets its own value array */
+			strings[i] = new String(dedupContent(i).toCharArray());
+		}
+
+		Field valueField = null;
+		if (expectShared) {
+			valueField = String.class.getDeclaredField("value");
+			valueField.setAccessible(true);
+		}
+
+		/* the Strings are deduplicated by the finalizer after the scavenges which tenure them */
+		int shared = 0;
+		for (int round = 0; (round < GARBAGE_ROUNDS) && ((null == valueField) ? (round < 4) : (0 == shared)); round++) {
+			allocateGarbage();
+			Thread.sleep(100);
+			if (null != valueField) {
+				for (int i = DEDUP_DISTINCT; i < DEDUP_COUNT; i++) {
+					if (valueField.get(strings[i]) == valueField.get(strings[i % DEDUP_DISTINCT])) {
+						shared += 1;
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < DEDUP_COUNT; i++) {
+			String content = dedupContent(i);
+			if (!strings[i].equals(content) || (strings[i].hashCode() != content.hashCode()) || (strings[i].length() != content.length())) {
+				System.err.println("String " + i + " is \"" + strings[i] + "\" instead of \"" + content + "\"");
+				passed = false;
+			}
+		}
+		if (expectShared && (0 == shared)) {
+			System.err.println("No equal Strings share a value array");
+			passed = false;
+		}
+		return passed;
+	}
+
+	/**
+	 * @param args Takes one argument: intern, dedup or dedupExpectShared
+	 */
+	public static void main(String[] args) throws Exception
+	{
+		if (1 == args.length)
+		{
+			boolean passed = false;
+			if ("intern".equals(args[0]))
+			{
+				passed = testIntern();
+			}
+			else if ("dedup".equals(args[0]))
+			{
+				passed = testDedup(false);
+			}
+			else if ("dedupExpectShared".equals(args[0]))
+			{
+				passed = testDedup(true);
+			}
+			else
+			{
+				System.err.println("Invalid mode (" + args[0] + ").  Value given must be intern, dedup or dedupExpectShared.");
+				System.exit(2);
+			}
+			if (passed)
+			{
+				System.out.println("Test ran to completion");
+			}
+			else
+			{
+				System.exit(3);
+			}
+		}
+		else
+		{
+			System.err.println("Missing argument for the mode.  Please specify intern, dedup or dedupExpectShared.");
+			System.exit(1);
+		}
+	}
+}
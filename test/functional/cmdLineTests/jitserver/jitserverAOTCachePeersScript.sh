@@ -0,0 +1,88 @@
+#!/bin/sh
+
+#
+# Copyright IBM Corp. and others 2026
+#
+# This program and the accompanying materials are made available under
+# the terms of the Eclipse Public License 2.0 which accompanies this
+# distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+# or the Apache License, Version 2.0 which accompanies this distribution and
+# is available at https://www.apache.org/licenses/LICENSE-2.0.
+#
+# This Source Code may also be made available under the following
+# Secondary Licenses when the conditions for such availability set
+# forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+# General Public License, version 2 with the GNU Classpath
+# Exception [1] and GNU General Public License, version 2 with the
+# OpenJDK Assembly Exception [2].
+#
+# [1] https://www.gnu.org/software/classpath/license.html
+# [2] https://openjdk.org/legal/assembly-exception.html
+#
+# SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+#
+
+echo "start running script";
+# Starts two JITServer instances that exchange AOT cache entries with each other,
+# populates the AOT cache of the first one with a client, and then checks that a
+# second client connected to the other server benefits from the same AOT methods.
+# the expected arguments are:
+# $1 is the TEST_ROOT
+# $2 is the TEST_JDK_BIN
+# $3 is the JITServer Options
+# $4 is the JVM Options
+
+TEST_ROOT=$1
+TEST_JDK_BIN=$2
+JITSERVER_OPTS="$3"
+JVM_OPTS="$4"
+
+source $TEST_ROOT/jitserverconfig.sh
+
+JITSERVER_PORT1=$(random_port)
+JITSERVER_PORT2=$(random_port)
+while [ "$JITSERVER_PORT2" == "$JITSERVER_PORT1" ]; do
+    JITSERVER_PORT2=$(random_port)
+done
+HEALTH_PORT1=$(random_port)
+HEALTH_PORT2=$(random_port)
+
+# Each server can be given the full peer list; it recognizes and skips itself
+PEERS="localhost:$JITSERVER_PORT1,localhost:$JITSERVER_PORT2"
+JITSERVER_OPTIONS="-XX:+JITServerUseAOTCache -XX:JITServerAOTCachePeers=$PEERS $JITSERVER_OPTS"
+
+echo "Starting two $TEST_JDK_BIN/jitserver instances with $JITSERVER_OPTIONS"
+$TEST_JDK_BIN/jitserver -XX:JITServerPort=$JITSERVER_PORT1 -XX:JITServerHealthProbePort=$HEALTH_PORT1 $JITSERVER_OPTIONS &
+JITSERVER_PID1=$!
+$TEST_JDK_BIN/jitserver -XX:JITServerPort=$JITSERVER_PORT2 -XX:JITServerHealthProbePort=$HEALTH_PORT2 $JITSERVER_OPTIONS &
+JITSERVER_PID2=$!
+sleep 2
+
+if ps | grep $JITSERVER_PID1 | grep -q 'jitserver' && ps | grep $JITSERVER_PID2 | grep -q 'jitserver'; then
+    echo "JITSERVERS EXIST"
+
+    SCC_DIR=$(mktemp -d)
+    # Populate the AOT cache of the first server
+    $TEST_JDK_BIN/java -XX:JITServerPort=$JITSERVER_PORT1 -Xshareclasses:name=peer1,cacheDir=$SCC_DIR $JVM_OPTS -version;
+    # Compilations for the same cache make the second server pull the new methods from the first one
+    $TEST_JDK_BIN/java -XX:JITServerPort=$JITSERVER_PORT2 -Xshareclasses:name=peer2,cacheDir=$SCC_DIR $JVM_OPTS -version;
+    sleep 2
+    # By now, the methods compiled for the first client should be AOT cache hits at the second server
+    $TEST_JDK_BIN/java -XX:JITServerPort=$JITSERVER_PORT2 -Xshareclasses:name=peer3,cacheDir=$SCC_DIR $JVM_OPTS -version;
+
+    if ps | grep $JITSERVER_PID1 | grep -q 'jitserver' && ps | grep $JITSERVER_PID2 | grep -q 'jitserver'; then
+        echo "JITSERVERS STILL EXIST"
+    else
+        echo "JITSERVERS NO LONGER EXIST"
+    fi
+
+    echo "Terminating $TEST_JDK_BIN/jitserver instances"
+    kill -9 $JITSERVER_PID1 $JITSERVER_PID2
+    sleep 2
+    rm -rf $SCC_DIR
+else
+    echo "JITSERVERS DO NOT EXIST"
+    kill -9 $JITSERVER_PID1 $JITSERVER_PID2 2>/dev/null
+fi
+
+echo "finished script";